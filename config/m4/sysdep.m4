@@ -243,6 +243,14 @@ AC_CHECK_HEADERS([sys/eventfd.h])
 AC_CHECK_HEADERS([sys/event.h])
 
 
+#
+# io_uring
+#
+AC_CHECK_HEADERS([linux/io_uring.h],
+	[AC_CHECK_DECLS([IORING_OP_RECV, IORING_OP_SEND], [], [],
+	                [#include <linux/io_uring.h>])])
+
+
 #
 # FreeBSD-specific threading functions
 #
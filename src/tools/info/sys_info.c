@@ -205,6 +205,22 @@ static double measure_timer_accuracy()
            ucs_max(elapsed, elapsed_accurate);
 }
 
+static void print_shm_copy_limits()
+{
+    char local_thresh_str[32];
+    char remote_thresh_str[32];
+
+    ucs_config_sprintf_memunits(local_thresh_str, sizeof(local_thresh_str),
+                                &ucs_global_opts.shm_nt_copy_local_thresh,
+                                NULL);
+    ucs_config_sprintf_memunits(remote_thresh_str, sizeof(remote_thresh_str),
+                                &ucs_global_opts.shm_nt_copy_remote_thresh,
+                                NULL);
+    printf("# Using non-temporal copy to shared memory for sizes from %s "
+           "(same NUMA node), %s (other NUMA node)\n", local_thresh_str,
+           remote_thresh_str);
+}
+
 void print_sys_info(int print_opts)
 {
     size_t size;
@@ -225,6 +241,7 @@ void print_sys_info(int print_opts)
 
     if (print_opts & PRINT_MEMCPY_BW) {
         ucs_arch_print_memcpy_limits(&ucs_global_opts.arch);
+        print_shm_copy_limits();
         printf("# Memcpy bandwidth:\n");
         for (size = 4096; size <= 256 * UCS_MBYTE; size *= 2) {
             printf("#     %10zu bytes: %.3f MB/s\n", size,
@@ -236,7 +236,7 @@ static UCS_F_ALWAYS_INLINE size_t ucp_am_eager_multi_zcopy_add_payload(
 
     return ucp_datatype_iter_next_iov(&req->send.state.dt_iter, max_payload,
                                       lpriv->super.md_index,
-                                      UCP_DT_MASK_CONTIG_IOV, next_iter, iov,
+                                      UCP_DT_MASK_ZCOPY, next_iter, iov,
                                       lpriv->super.max_iov - 1);
 }
 
@@ -307,7 +307,7 @@ ucp_am_eager_multi_zcopy_proto_progress(uct_pending_req_t *self)
     /* coverity[tainted_data_downcast] */
     status = ucp_proto_multi_zcopy_progress(
             req, req->send.proto_config->priv, ucp_am_eager_multi_zcopy_init,
-            UCT_MD_MEM_ACCESS_LOCAL_READ, UCP_DT_MASK_CONTIG_IOV,
+            UCT_MD_MEM_ACCESS_LOCAL_READ, UCP_DT_MASK_ZCOPY,
             ucp_am_eager_multi_zcopy_send_func,
             ucp_request_invoke_uct_completion_success,
             ucp_am_eager_zcopy_completion);
@@ -293,7 +293,7 @@ enum ucp_ep_params_flags_field {
                                                            send to a particular
                                                            remote endpoint, for
                                                            example stream */
-    UCP_EP_PARAMS_FLAGS_SEND_CLIENT_ID = UCS_BIT(2)   /**< Send client id
+    UCP_EP_PARAMS_FLAGS_SEND_CLIENT_ID = UCS_BIT(2),  /**< Send client id
                                                            when connecting to remote
                                                            socket address as part of the
                                                            connection request payload.
@@ -301,6 +301,25 @@ enum ucp_ep_params_flags_field {
                                                            can be obtained from
                                                            @ref ucp_conn_request_h using
                                                            @ref ucp_conn_request_query */
+    UCP_EP_PARAMS_FLAGS_AM_COALESCE    = UCS_BIT(3)   /**< Coalesce small active
+                                                           messages sent with
+                                                           @ref ucp_am_send_nbx
+                                                           on this endpoint into
+                                                           batches, which are sent
+                                                           as a single transport
+                                                           message. Coalesced
+                                                           messages are completed
+                                                           immediately, and a batch
+                                                           is sent when it exceeds
+                                                           the size or time limit
+                                                           (see UCX_AM_COALESCE_MAX_SIZE
+                                                           and UCX_AM_COALESCE_TIMEOUT),
+                                                           during
+                                                           @ref ucp_worker_progress,
+                                                           or when the endpoint is
+                                                           flushed. The receiver
+                                                           invokes the active message
+                                                           handler once per message. */
 };
 
 
@@ -818,7 +837,11 @@ enum ucp_am_handler_param_field {
     /**
      * Indicates that @ref ucp_am_handler_param_t.arg field is valid.
      */
-    UCP_AM_HANDLER_PARAM_FIELD_ARG     = UCS_BIT(3)
+    UCP_AM_HANDLER_PARAM_FIELD_ARG      = UCS_BIT(3),
+    /**
+     * Indicates that @ref ucp_am_handler_param_t.batch_cb field is valid.
+     */
+    UCP_AM_HANDLER_PARAM_FIELD_BATCH_CB = UCS_BIT(4)
 };
 
 
@@ -988,6 +1011,79 @@ typedef struct ucp_generic_dt_ops {
 } ucp_generic_dt_ops_t;
 
 
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Maximal number of dimensions of a strided datatype.
+ */
+#define UCP_DT_STRIDED_MAX_DIMS 3
+
+
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief UCP strided datatype parameters field mask.
+ *
+ * The enumeration allows specifying which fields in
+ * @ref ucp_dt_strided_params_t are present. It is used to enable backward
+ * compatibility support.
+ */
+enum ucp_dt_strided_params_field {
+    UCP_DT_STRIDED_PARAM_FIELD_ELEM_SIZE = UCS_BIT(0), /**< Element size */
+    UCP_DT_STRIDED_PARAM_FIELD_DIMS      = UCS_BIT(1)  /**< Dimensions */
+};
+
+
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Dimension of a strided datatype.
+ */
+typedef struct ucp_dt_strided_dim {
+    size_t count;  /**< Number of items along the dimension */
+    size_t stride; /**< Distance in bytes between the beginnings of
+                        consecutive items */
+} ucp_dt_strided_dim_t;
+
+
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Strided datatype parameters.
+ *
+ * This structure describes a strided, possibly multi-dimensional, datatype.
+ * The items of the innermost dimension are contiguous elements of
+ * @a elem_size bytes, and the items of every other dimension are the items of
+ * the preceding one. For example, a column of a row-major matrix of doubles
+ * with @a N rows and @a M columns is described by @a elem_size 8 and a single
+ * dimension { @a N, 8 * @a M }.
+ *
+ * When a strided datatype is used with count larger than 1, consecutive
+ * datatype items are placed at distance of count * stride of the outermost
+ * dimension from each other.
+ */
+typedef struct ucp_dt_strided_params {
+    /**
+     * Mask of valid fields in this structure, using bits from
+     * @ref ucp_dt_strided_params_field. Fields not specified in this mask will
+     * be ignored. Provides ABI compatibility with respect to adding new fields.
+     * All currently defined fields are mandatory.
+     */
+    uint64_t                   field_mask;
+
+    /**
+     * Size in bytes of the contiguous element.
+     */
+    size_t                     elem_size;
+
+    /**
+     * Number of entries in @a dims, up to @ref UCP_DT_STRIDED_MAX_DIMS.
+     */
+    unsigned                   num_dims;
+
+    /**
+     * Array of dimensions, innermost first.
+     */
+    const ucp_dt_strided_dim_t *dims;
+} ucp_dt_strided_params_t;
+
+
 /**
  * @ingroup UCP_DATATYPE
  * @brief UCP datatype attributes
@@ -1901,6 +1997,13 @@ typedef struct ucp_am_handler_param {
      * @ref ucp_am_recv_callback_t function as the @a arg argument.
      */
     void                     *arg;
+
+    /**
+     * Active Message batch callback. If set to a non-NULL value, received
+     * messages are delivered to this callback in batches instead of calling
+     * @a cb for every message, and @a cb is ignored.
+     */
+    ucp_am_recv_batch_callback_t batch_cb;
 } ucp_am_handler_param_t;
 
 
@@ -1923,6 +2026,42 @@ struct ucp_am_recv_param {
 };
 
 
+/**
+ * @ingroup UCP_WORKER
+ * @brief Active Message provided in @ref ucp_am_recv_batch_callback_t callback.
+ */
+struct ucp_am_recv_msg {
+    /**
+     * User defined active message header. If @a header_length is 0, this
+     * value is undefined and must not be accessed.
+     */
+    const void          *header;
+
+    /**
+     * Active message header length in bytes.
+     */
+    size_t              header_length;
+
+    /**
+     * Received data, or the data descriptor if UCP_AM_RECV_ATTR_FLAG_RNDV
+     * flag is set in @a param.recv_attr, the same as the @a data argument of
+     * @ref ucp_am_recv_callback_t.
+     */
+    void                *data;
+
+    /**
+     * Length of data, the same as the @a length argument of
+     * @ref ucp_am_recv_callback_t.
+     */
+    size_t              length;
+
+    /**
+     * Data receive parameters.
+     */
+    ucp_am_recv_param_t param;
+};
+
+
 /**
  * @ingroup UCP_CONTEXT
  * @brief Get attributes of the UCP library.
@@ -3198,6 +3337,10 @@ void ucp_rkey_destroy(ucp_rkey_h rkey);
  * Message that was sent from the remote peer by @ref ucp_am_send_nbx is
  * received on this worker.
  *
+ * If @ref ucp_am_handler_param_t.batch_cb is set, messages received during
+ * one @ref ucp_worker_progress call are delivered to it together, which saves
+ * the per-message callback overhead when messages arrive in bursts.
+ *
  * @warning Handlers set by this function are not compatible with
             @ref ucp_am_send_nb routine.
  *
@@ -3337,6 +3480,23 @@ ucs_status_ptr_t ucp_am_recv_data_nbx(ucp_worker_h worker, void *data_desc,
 void ucp_am_data_release(ucp_worker_h worker, void *data);
 
 
+/**
+ * @ingroup UCP_COMM
+ * @brief Releases data of multiple Active Messages.
+ *
+ * This routine is equivalent to calling @ref ucp_am_data_release for every
+ * element of @a data, and is intended for releasing the data of messages
+ * delivered to @ref ucp_am_recv_batch_callback_t.
+ *
+ * @param [in] worker       Worker which received the Active Messages.
+ * @param [in] data         Array of pointers to data that was passed to the
+ *                          Active Message callback.
+ * @param [in] count        Number of elements in @a data.
+ */
+void ucp_am_data_release_batch(ucp_worker_h worker, void *const *data,
+                               size_t count);
+
+
 /**
  * @ingroup UCP_COMM
  * @brief Non-blocking stream send operation.
@@ -3957,6 +4117,30 @@ ucs_status_t ucp_dt_create_generic(const ucp_generic_dt_ops_t *ops, void *contex
                                    ucp_datatype_t *datatype_p);
 
 
+/**
+ * @ingroup UCP_DATATYPE
+ * @brief Create a strided datatype.
+ *
+ * This routine creates a strided datatype object, which describes a regular
+ * layout of contiguous elements in memory, such as a column of a matrix or a
+ * face of a multi-dimensional array. Unlike a generic datatype, it is packed
+ * and unpacked by the library, and can be sent with zero-copy protocols by
+ * transports that support enough scatter-gather entries.
+ * The application is responsible for releasing the @a datatype_p object using
+ * @ref ucp_dt_destroy "ucp_dt_destroy()" routine.
+ *
+ * @param [in]  params       Strided datatype parameters as defined by
+ *                           @ref ucp_dt_strided_params_t.
+ * @param [out] datatype_p   A pointer to datatype object.
+ *
+ * @return Error code as defined by @ref ucs_status_t
+ *
+ * @note Strided datatype supports only memory which is accessible from CPU.
+ */
+ucs_status_t ucp_dt_create_strided(const ucp_dt_strided_params_t *params,
+                                   ucp_datatype_t *datatype_p);
+
+
 /**
  * @ingroup UCP_DATATYPE
  * @brief Destroy a datatype and release its resources.
@@ -3964,7 +4148,8 @@ ucs_status_t ucp_dt_create_generic(const ucp_generic_dt_ops_t *ops, void *contex
  * This routine destroys the @a datatype object and
  * releases any resources that are associated with the object.
  * The @a datatype object must be allocated using @ref ucp_dt_create_generic
- * "ucp_dt_create_generic()" routine.
+ * "ucp_dt_create_generic()" or @ref ucp_dt_create_strided
+ * "ucp_dt_create_strided()" routine.
  *
  * @warning
  * @li Once the @a datatype object is released an access to this object may
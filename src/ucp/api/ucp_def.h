@@ -37,6 +37,13 @@ typedef struct ucp_tag_recv_info             ucp_tag_recv_info_t;
 typedef struct ucp_am_recv_param             ucp_am_recv_param_t;
 
 
+/**
+ * @ingroup UCP_WORKER
+ * @brief Active Message provided in @ref ucp_am_recv_batch_callback_t callback.
+ */
+typedef struct ucp_am_recv_msg               ucp_am_recv_msg_t;
+
+
 /**
  * @ingroup UCP_CONTEXT
  * @brief UCP Application Context
@@ -673,6 +680,43 @@ typedef ucs_status_t (*ucp_am_recv_callback_t)(void *arg, const void *header,
                                                const ucp_am_recv_param_t *param);
 
 
+/**
+ * @ingroup UCP_ENDPOINT
+ * @brief Callback to process a batch of incoming Active Messages sent by
+ * @ref ucp_am_send_nbx routine.
+ *
+ * The callback is called from @ref ucp_worker_progress with all Active
+ * Messages with the same id which were received during one progress pass, in
+ * the order of their arrival. Calling @ref ucp_worker_progress from the
+ * callback is not allowed.
+ *
+ * Unlike @ref ucp_am_recv_callback_t, the data of every message persists
+ * after the callback returns: @ref ucp_am_recv_param_t.recv_attr of every
+ * message contains either UCP_AM_RECV_ATTR_FLAG_DATA or
+ * UCP_AM_RECV_ATTR_FLAG_RNDV. The user header of a message stays valid as long
+ * as its data. The application must eventually pass the data of every message
+ * to @ref ucp_am_data_release, @ref ucp_am_data_release_batch or
+ * @ref ucp_am_recv_data_nbx.
+ *
+ * @note To make the data persist, a message which the transport received
+ *       inline (without a receive descriptor) is copied, together with its
+ *       user header, to a descriptor allocated by UCP. This adds a memory copy
+ *       per message compared to @ref ucp_am_recv_callback_t, in the same way
+ *       as @ref UCP_AM_FLAG_PERSISTENT_DATA.
+ *
+ * @param [in]  arg           User-defined argument.
+ * @param [in]  msgs          Array of received messages. The array itself is
+ *                            valid only during the callback.
+ * @param [in]  count         Number of messages in @a msgs.
+ *
+ * @note This callback should be set and released
+ *       by @ref ucp_worker_set_am_recv_handler function.
+ */
+typedef void (*ucp_am_recv_batch_callback_t)(void *arg,
+                                             const ucp_am_recv_msg_t *msgs,
+                                             size_t count);
+
+
 /**
  * @ingroup UCP_ENDPOINT
  * @brief Tuning parameters for the UCP endpoint.
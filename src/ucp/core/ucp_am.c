@@ -24,6 +24,33 @@
 #include <ucp/dt/dt.inl>
 
 
+/**
+ * Batch of coalesced active messages, which were not sent yet
+ */
+typedef struct ucp_am_batch {
+    ucs_list_link_t          list;        /* Entry in worker's list of batches */
+    ucp_ep_h                 ep;          /* Endpoint to send the batch on */
+    void                     *buffer;     /* Packed messages, see
+                                             ucp_am_batch_hdr_t */
+    size_t                   buffer_size; /* Size of the buffer */
+    size_t                   length;      /* Length of the packed messages */
+    unsigned                 count;       /* Number of packed messages */
+    ucs_time_t               start_time;  /* Time when the first message was
+                                             added to the batch */
+} ucp_am_batch_t;
+
+
+typedef struct {
+    const void               *data;
+    size_t                   length;
+} ucp_am_batch_pack_ctx_t;
+
+
+static unsigned ucp_am_batch_progress_cb(void *arg);
+
+static void ucp_am_recv_batch_purge(ucp_worker_h worker);
+
+
 ucs_status_t ucp_am_init(ucp_worker_h worker)
 {
     if (!(worker->context->config.features & UCP_FEATURE_AM)) {
@@ -31,6 +58,11 @@ ucs_status_t ucp_am_init(ucp_worker_h worker)
     }
 
     ucs_array_init_dynamic(&worker->am.cbs);
+    ucs_array_init_dynamic(&worker->am.recv_msgs);
+    ucs_array_init_dynamic(&worker->am.recv_ids);
+    ucs_list_head_init(&worker->am.batches);
+    worker->am.batch_prog_id    = UCS_CALLBACKQ_ID_NULL;
+    worker->am.num_coalesce_eps = 0;
     return UCS_OK;
 }
 
@@ -40,6 +72,15 @@ void ucp_am_cleanup(ucp_worker_h worker)
         return;
     }
 
+    ucs_assertv(ucs_list_is_empty(&worker->am.batches),
+                "worker %p: %zu active message batches were not sent", worker,
+                ucs_list_length(&worker->am.batches));
+    ucs_assertv(worker->am.num_coalesce_eps == 0,
+                "worker %p: %u endpoints still coalesce active messages",
+                worker, worker->am.num_coalesce_eps);
+    ucp_am_recv_batch_purge(worker);
+    ucs_array_cleanup_dynamic(&worker->am.recv_ids);
+    ucs_array_cleanup_dynamic(&worker->am.recv_msgs);
     ucs_array_cleanup_dynamic(&worker->am.cbs);
 }
 
@@ -50,9 +91,70 @@ void ucp_am_ep_init(ucp_ep_h ep)
     if (ep->worker->context->config.features & UCP_FEATURE_AM) {
         ucs_list_head_init(&ep_ext->am.started_ams);
         ucs_queue_head_init(&ep_ext->am.mid_rdesc_q);
+        ep_ext->am.batch = NULL;
     }
 }
 
+void ucp_am_ep_coalesce_enable(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+
+    if (!(worker->context->config.features & UCP_FEATURE_AM)) {
+        ucs_debug("ep %p: not enabling active message coalescing, since"
+                  " UCP_FEATURE_AM was not requested", ep);
+        return;
+    }
+
+    ucs_debug("ep %p: enable active message coalescing, max size %zu"
+              " timeout %.2f us", ep,
+              worker->context->config.ext.am_coalesce_max_size,
+              ucs_time_to_usec(worker->context->config.ext.am_coalesce_timeout));
+    ucs_assert(!(ep->flags & UCP_EP_FLAG_AM_COALESCE));
+    ucp_ep_update_flags(ep, UCP_EP_FLAG_AM_COALESCE, 0);
+    if (worker->am.num_coalesce_eps++ == 0) {
+        uct_worker_progress_register_safe(worker->uct,
+                                          ucp_am_batch_progress_cb, worker, 0,
+                                          &worker->am.batch_prog_id);
+    }
+}
+
+static void ucp_am_ep_coalesce_disable(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+
+    if (!(ep->flags & UCP_EP_FLAG_AM_COALESCE)) {
+        return;
+    }
+
+    ucp_ep_update_flags(ep, 0, UCP_EP_FLAG_AM_COALESCE);
+
+    /* Stop polling the batches when no endpoint is coalescing anymore */
+    ucs_assert(worker->am.num_coalesce_eps > 0);
+    if (--worker->am.num_coalesce_eps == 0) {
+        uct_worker_progress_unregister_safe(worker->uct,
+                                            &worker->am.batch_prog_id);
+    }
+}
+
+static void ucp_am_ep_batch_destroy(ucp_ep_h ep)
+{
+    ucp_am_batch_t *batch = ep->ext->am.batch;
+
+    if (batch == NULL) {
+        return;
+    }
+
+    if (batch->length > 0) {
+        ucs_list_del(&batch->list);
+        ucs_trace_data("ep %p: %u coalesced active messages have been dropped",
+                       ep, batch->count);
+    }
+
+    ucs_free(batch->buffer);
+    ucs_free(batch);
+    ep->ext->am.batch = NULL;
+}
+
 void ucp_am_ep_cleanup(ucp_ep_h ep)
 {
     ucp_ep_ext_t *ep_ext = ep->ext;
@@ -64,6 +166,9 @@ void ucp_am_ep_cleanup(ucp_ep_h ep)
         return;
     }
 
+    ucp_am_ep_batch_destroy(ep);
+    ucp_am_ep_coalesce_disable(ep);
+
     count = 0;
     ucs_list_for_each_safe(rdesc, tmp_rdesc, &ep_ext->am.started_ams,
                            am_first.list) {
@@ -164,6 +269,45 @@ UCS_PROFILE_FUNC_VOID(ucp_am_data_release, (worker, data),
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
 }
 
+/*
+ * Release the messages which were not delivered to the batch callback. The
+ * endpoints are already destroyed, so rendezvous senders are not notified.
+ */
+static void ucp_am_recv_batch_purge(ucp_worker_h worker)
+{
+    ucp_am_recv_msg_t *msg;
+    ucp_recv_desc_t *rdesc;
+
+    if (!ucs_array_is_empty(&worker->am.recv_msgs)) {
+        ucs_debug("worker %p: dropping %u active messages which were not"
+                  " delivered", worker, ucs_array_length(&worker->am.recv_msgs));
+    }
+
+    ucs_array_for_each(msg, &worker->am.recv_msgs) {
+        rdesc = (ucp_recv_desc_t*)msg->data - 1;
+        if (rdesc->flags & UCP_RECV_DESC_FLAG_MALLOC) {
+            ucp_am_release_long_desc(rdesc);
+        } else {
+            ucp_recv_desc_release(rdesc);
+        }
+    }
+
+    ucs_array_clear(&worker->am.recv_msgs);
+    ucs_array_clear(&worker->am.recv_ids);
+}
+
+void ucp_am_data_release_batch(ucp_worker_h worker, void *const *data,
+                               size_t count)
+{
+    size_t i;
+
+    UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
+    for (i = 0; i < count; ++i) {
+        ucp_am_data_release(worker, data[i]);
+    }
+    UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
+}
+
 static void ucp_worker_am_init_handler(ucp_worker_h worker, uint16_t id,
                                        void *context, unsigned flags,
                                        ucp_am_callback_t cb_old,
@@ -323,12 +467,14 @@ static ucs_status_t ucp_am_check_id(unsigned am_id)
 ucs_status_t ucp_worker_set_am_recv_handler(ucp_worker_h worker,
                                             const ucp_am_handler_param_t *param)
 {
+    ucp_am_recv_batch_callback_t batch_cb;
     ucs_status_t status;
     uint16_t id;
     unsigned flags;
 
-    if (!ucs_test_all_flags(param->field_mask, UCP_AM_HANDLER_PARAM_FIELD_ID |
-                                               UCP_AM_HANDLER_PARAM_FIELD_CB)) {
+    if (!(param->field_mask & UCP_AM_HANDLER_PARAM_FIELD_ID) ||
+        !(param->field_mask & (UCP_AM_HANDLER_PARAM_FIELD_CB |
+                               UCP_AM_HANDLER_PARAM_FIELD_BATCH_CB))) {
         return UCS_ERR_INVALID_PARAM;
     }
 
@@ -337,8 +483,9 @@ ucs_status_t ucp_worker_set_am_recv_handler(ucp_worker_h worker,
         return status;
     }
 
-    id    = param->id;
-    flags = UCP_PARAM_VALUE(AM_HANDLER, param, flags, FLAGS, 0);
+    id       = param->id;
+    flags    = UCP_PARAM_VALUE(AM_HANDLER, param, flags, FLAGS, 0);
+    batch_cb = UCP_PARAM_VALUE(AM_HANDLER, param, batch_cb, BATCH_CB, NULL);
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
 
@@ -347,11 +494,37 @@ ucs_status_t ucp_worker_set_am_recv_handler(ucp_worker_h worker,
         goto out;
     }
 
+    if (batch_cb != NULL) {
+        /* Allocate the arrays in advance, so adding a received message never
+         * fails */
+        status = ucs_array_reserve(&worker->am.recv_msgs,
+                                   UCP_AM_RECV_BATCH_MAX);
+        if (status != UCS_OK) {
+            goto out;
+        }
+
+        status = ucs_array_reserve(&worker->am.recv_ids, UCP_AM_RECV_BATCH_MAX);
+        if (status != UCS_OK) {
+            goto out;
+        }
+
+        ucp_worker_am_init_handler(worker, id,
+                                   UCP_PARAM_VALUE(AM_HANDLER, param, arg, ARG,
+                                                   NULL),
+                                   flags | UCP_AM_CB_PRIV_FLAG_NBX |
+                                           UCP_AM_CB_PRIV_FLAG_BATCH,
+                                   NULL, NULL);
+        ucs_array_elem(&worker->am.cbs, id).batch_cb = batch_cb;
+        goto out;
+    }
+
     /* cb should always be set (can be NULL) */
     ucp_worker_am_init_handler(worker, id,
                                UCP_PARAM_VALUE(AM_HANDLER, param, arg, ARG, NULL),
                                flags | UCP_AM_CB_PRIV_FLAG_NBX,
-                               NULL, param->cb);
+                               NULL,
+                               UCP_PARAM_VALUE(AM_HANDLER, param, cb, CB,
+                                               NULL));
 
 out:
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(worker);
@@ -936,6 +1109,291 @@ ucp_am_send_nbx_check_header_length(ucp_worker_h worker, size_t header_length)
     return UCS_OK;
 }
 
+static size_t ucp_am_batch_pack(void *dest, void *arg)
+{
+    ucp_am_batch_pack_ctx_t *pack_ctx = arg;
+
+    memcpy(dest, pack_ctx->data, pack_ctx->length);
+    return pack_ctx->length;
+}
+
+/**
+ * Send the packed messages in @a buffer starting from @a offset_p, in as few
+ * active messages as the maximal bcopy size of the AM lane allows. Messages
+ * are never split between active messages.
+ */
+static ucs_status_t ucp_am_batch_send(ucp_ep_h ep, const void *buffer,
+                                      size_t length, size_t *offset_p)
+{
+    ucp_lane_index_t lane = ucp_ep_get_am_lane(ep);
+    size_t max_bcopy      = ucp_ep_get_max_bcopy(ep, lane);
+    const ucp_am_batch_hdr_t *batch_hdr;
+    ucp_am_batch_pack_ctx_t pack_ctx;
+    size_t msg_length;
+    ssize_t packed_len;
+
+    while (*offset_p < length) {
+        pack_ctx.data   = UCS_PTR_BYTE_OFFSET(buffer, *offset_p);
+        pack_ctx.length = 0;
+        do {
+            batch_hdr  = UCS_PTR_BYTE_OFFSET(pack_ctx.data, pack_ctx.length);
+            msg_length = sizeof(*batch_hdr) + batch_hdr->length;
+            if ((pack_ctx.length + msg_length) > max_bcopy) {
+                break;
+            }
+
+            pack_ctx.length += msg_length;
+        } while ((*offset_p + pack_ctx.length) < length);
+
+        if (ucs_unlikely(pack_ctx.length == 0)) {
+            /* The endpoint configuration was changed after the message was
+             * added to the batch */
+            ucs_error("ep %p: coalesced active message of %zu bytes exceeds"
+                      " max_bcopy %zu", ep, msg_length, max_bcopy);
+            *offset_p += msg_length;
+            continue;
+        }
+
+        packed_len = uct_ep_am_bcopy(ucp_ep_get_fast_lane(ep, lane),
+                                     UCP_AM_ID_AM_BATCH, ucp_am_batch_pack,
+                                     &pack_ctx, 0);
+        if (ucs_unlikely(packed_len < 0)) {
+            return (ucs_status_t)packed_len;
+        }
+
+        ucs_assertv((size_t)packed_len == pack_ctx.length,
+                    "packed_len=%zd length=%zu", packed_len, pack_ctx.length);
+        *offset_p += pack_ctx.length;
+        UCS_STATS_UPDATE_COUNTER(ep->stats, UCP_EP_STAT_AM_TX_BATCH, 1);
+    }
+
+    return UCS_OK;
+}
+
+/**
+ * The messages of the batch were already reported as completed to the user, so
+ * losing them must fail the endpoint rather than go unnoticed.
+ */
+static void ucp_am_batch_send_failed(ucp_ep_h ep, ucs_status_t status)
+{
+    ucs_error("ep %p: failed to send active message batch: %s", ep,
+              ucs_status_string(status));
+    ucp_ep_set_failed_schedule(ep, ucp_ep_get_am_lane(ep), status);
+}
+
+ucs_status_t ucp_am_batch_progress(uct_pending_req_t *self)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
+    ucs_status_t status;
+
+    status = ucp_am_batch_send(req->send.ep, req->send.buffer,
+                               req->send.length, &req->send.state.dt.offset);
+    if (status == UCS_ERR_NO_RESOURCE) {
+        return UCS_ERR_NO_RESOURCE;
+    } else if (status != UCS_OK) {
+        ucp_am_batch_send_failed(req->send.ep, status);
+    }
+
+    ucs_free(req->send.buffer);
+    ucp_request_put(req);
+    return UCS_OK;
+}
+
+static void ucp_am_batch_flush(ucp_am_batch_t *batch)
+{
+    ucp_ep_h ep   = batch->ep;
+    size_t offset = 0;
+    ucp_request_t *req;
+    ucs_status_t status;
+
+    ucs_assert(batch->length > 0);
+    ucs_trace_req("ep %p: send batch of %u active messages, length %zu", ep,
+                  batch->count, batch->length);
+
+    ucs_list_del(&batch->list);
+
+    status = ucp_am_batch_send(ep, batch->buffer, batch->length, &offset);
+    if (ucs_likely(status != UCS_ERR_NO_RESOURCE)) {
+        if (ucs_unlikely(status != UCS_OK)) {
+            ucp_am_batch_send_failed(ep, status);
+        }
+        goto out;
+    }
+
+    req = ucp_request_get(ep->worker);
+    if (req == NULL) {
+        ucp_am_batch_send_failed(ep, UCS_ERR_NO_MEMORY);
+        goto out;
+    }
+
+    /* The request takes ownership of the buffer, and a new buffer will be
+     * allocated for the next batch */
+    req->flags                = 0;
+    req->send.ep              = ep;
+    req->send.buffer          = batch->buffer;
+    req->send.length          = batch->length;
+    req->send.state.dt.offset = offset;
+    req->send.lane            = ucp_ep_get_am_lane(ep);
+    req->send.uct.func        = ucp_am_batch_progress;
+    batch->buffer             = NULL;
+    ucp_request_send(req);
+
+out:
+    batch->length = 0;
+    batch->count  = 0;
+}
+
+void ucp_am_ep_batch_flush(ucp_ep_h ep)
+{
+    ucp_am_batch_t *batch = ep->ext->am.batch;
+
+    if ((batch != NULL) && (batch->length > 0)) {
+        ucp_am_batch_flush(batch);
+    }
+}
+
+static unsigned ucp_am_batch_progress_cb(void *arg)
+{
+    ucp_worker_h worker = arg;
+    unsigned count      = 0;
+    ucp_am_batch_t *batch, *tmp_batch;
+
+    ucs_list_for_each_safe(batch, tmp_batch, &worker->am.batches, list) {
+        ucp_am_batch_flush(batch);
+        ++count;
+    }
+
+    return count;
+}
+
+static ucp_am_batch_t *ucp_am_ep_batch_get(ucp_ep_h ep, size_t max_length)
+{
+    ucp_am_batch_t *batch = ep->ext->am.batch;
+
+    if (batch == NULL) {
+        batch = ucs_calloc(1, sizeof(*batch), "ucp_am_batch");
+        if (batch == NULL) {
+            ucs_error("ep %p: failed to allocate active message batch", ep);
+            return NULL;
+        }
+
+        batch->ep         = ep;
+        ep->ext->am.batch = batch;
+    } else if ((batch->length == 0) && (batch->buffer_size < max_length)) {
+        /* The endpoint was reconfigured, and now allows larger batches */
+        ucs_free(batch->buffer);
+        batch->buffer = NULL;
+    }
+
+    if (batch->buffer == NULL) {
+        batch->buffer = ucs_malloc(max_length, "ucp_am_batch_buffer");
+        if (batch->buffer == NULL) {
+            ucs_error("ep %p: failed to allocate active message batch buffer"
+                      " of %zu bytes", ep, max_length);
+            return NULL;
+        }
+
+        batch->buffer_size = max_length;
+    }
+
+    return batch;
+}
+
+/**
+ * Add an active message to the batch of the endpoint.
+ *
+ * @return UCS_OK if the message was added to the batch and can be completed,
+ *         or UCS_ERR_NO_RESOURCE if it has to be sent by a regular protocol.
+ */
+static ucs_status_t
+ucp_am_coalesce_send(ucp_ep_h ep, uint16_t id, uint32_t flags,
+                     const void *header, size_t header_length,
+                     const void *buffer, size_t count,
+                     const ucp_request_param_t *param)
+{
+    ucp_worker_h worker   = ep->worker;
+    ucp_context_h context = worker->context;
+    ucp_am_batch_t *batch = ep->ext->am.batch;
+    ucp_am_batch_hdr_t *batch_hdr;
+    ucp_memory_info_t mem_info;
+    size_t length, msg_length, max_length;
+    ucp_am_hdr_t *am_hdr;
+    ucs_time_t now;
+
+    if ((flags & (UCP_AM_SEND_FLAG_REPLY | UCP_AM_SEND_FLAG_RNDV)) ||
+        (param->op_attr_mask & UCP_OP_ATTR_FLAG_NO_IMM_CMPL)) {
+        goto not_coalesced;
+    }
+
+    if (param->op_attr_mask & UCP_OP_ATTR_FIELD_DATATYPE) {
+        if (!UCP_DT_IS_CONTIG(param->datatype)) {
+            goto not_coalesced;
+        }
+
+        length = ucp_contig_dt_length(param->datatype, count);
+    } else {
+        length = count;
+    }
+
+    msg_length = sizeof(*am_hdr) + length + header_length;
+    max_length = ucs_min(context->config.ext.am_coalesce_max_size,
+                         ucp_ep_get_max_bcopy(ep, ucp_ep_get_am_lane(ep)));
+    if ((sizeof(*batch_hdr) + msg_length) > max_length) {
+        goto not_coalesced;
+    }
+
+    if (param->op_attr_mask & UCP_OP_ATTR_FIELD_MEMORY_TYPE) {
+        mem_info.type = param->memory_type;
+    } else {
+        ucp_memory_detect(context, buffer, length, &mem_info);
+    }
+
+    if (mem_info.type != UCS_MEMORY_TYPE_HOST) {
+        goto not_coalesced;
+    }
+
+    if ((batch != NULL) && (batch->length > 0) &&
+        ((batch->length + sizeof(*batch_hdr) + msg_length) >
+         ucs_min(batch->buffer_size, max_length))) {
+        ucp_am_batch_flush(batch);
+    }
+
+    batch = ucp_am_ep_batch_get(ep, max_length);
+    if (batch == NULL) {
+        goto not_coalesced;
+    }
+
+    now = ucs_get_time();
+    if (batch->length == 0) {
+        batch->start_time = now;
+        ucs_list_add_tail(&worker->am.batches, &batch->list);
+    }
+
+    batch_hdr         = UCS_PTR_BYTE_OFFSET(batch->buffer, batch->length);
+    batch_hdr->length = msg_length;
+    am_hdr            = (ucp_am_hdr_t*)(batch_hdr + 1);
+    am_hdr->am_id         = id;
+    am_hdr->flags         = flags;
+    am_hdr->header_length = header_length;
+    memcpy(am_hdr + 1, buffer, length);
+    memcpy(UCS_PTR_BYTE_OFFSET(am_hdr + 1, length), header, header_length);
+
+    batch->length += sizeof(*batch_hdr) + msg_length;
+    ++batch->count;
+    UCS_STATS_UPDATE_COUNTER(ep->stats, UCP_EP_STAT_AM_TX_COALESCED, 1);
+
+    if ((now - batch->start_time) >= context->config.ext.am_coalesce_timeout) {
+        ucp_am_batch_flush(batch);
+    }
+
+    return UCS_OK;
+
+not_coalesced:
+    /* Send the pending messages first to keep the order */
+    ucp_am_ep_batch_flush(ep);
+    return UCS_ERR_NO_RESOURCE;
+}
+
 UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
                  (ep, id, header, header_length, buffer, count, param),
                  ucp_ep_h ep, unsigned id, const void *header,
@@ -991,6 +1449,12 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
         goto out;
     }
 
+    if (ucs_unlikely(ep->flags & UCP_EP_FLAG_AM_COALESCE)) {
+        status = ucp_am_coalesce_send(ep, id, flags, header, header_length,
+                                      buffer, count, param);
+        ucp_request_send_check_status(status, ret, goto out);
+    }
+
     if (ucs_likely(attr_mask == 0)) {
         status = ucp_am_try_send_short(ep, id, flags, header, header_length,
                                        buffer, count, max_short, param);
@@ -1202,6 +1666,79 @@ out:
     return ret;
 }
 
+void ucp_am_recv_batch_dispatch(ucp_worker_h worker)
+{
+    ucp_am_recv_msg_t *msgs = ucs_array_begin(&worker->am.recv_msgs);
+    uint16_t *ids           = ucs_array_begin(&worker->am.recv_ids);
+    unsigned length         = ucs_array_length(&worker->am.recv_msgs);
+    unsigned start, end;
+    ucp_am_entry_t *am_cb;
+
+    ucs_assert(ucs_array_length(&worker->am.recv_ids) == length);
+
+    /* Deliver every run of consecutive messages with the same id in one call,
+     * to keep the order of arrival */
+    for (start = 0; start < length; start = end) {
+        end = start + 1;
+        while ((end < length) && (ids[end] == ids[start])) {
+            ++end;
+        }
+
+        am_cb = &ucs_array_elem(&worker->am.cbs, ids[start]);
+        if (ucs_likely(am_cb->flags & UCP_AM_CB_PRIV_FLAG_BATCH)) {
+            am_cb->batch_cb(am_cb->context, &msgs[start], end - start);
+            continue;
+        }
+
+        /* The handler was replaced after the messages were received */
+        ucs_debug("worker %p: dropping %u active messages with id %u",
+                  worker, end - start, ids[start]);
+        for (; start < end; ++start) {
+            ucp_am_data_release(worker, msgs[start].data);
+        }
+    }
+
+    ucs_assertv(ucs_array_length(&worker->am.recv_msgs) == length,
+                "worker %p: active messages were received during dispatch",
+                worker);
+    ucs_array_clear(&worker->am.recv_msgs);
+    ucs_array_clear(&worker->am.recv_ids);
+}
+
+/*
+ * Keep a received message to deliver it to the batch callback when the current
+ * progress pass is over. The data descriptor must be persistent.
+ */
+static ucs_status_t
+ucp_am_recv_batch_add(ucp_worker_h worker, uint16_t am_id,
+                      const void *user_hdr, uint32_t user_hdr_length,
+                      void *data, size_t data_length, ucp_ep_h reply_ep,
+                      uint64_t recv_flags)
+{
+    ucp_am_recv_msg_t *msg;
+
+    ucs_assert(recv_flags & (UCP_AM_RECV_ATTR_FLAG_DATA |
+                             UCP_AM_RECV_ATTR_FLAG_RNDV));
+
+    /* Descriptors of the messages which were already added are finalized, so
+     * it is safe to deliver them now */
+    if (ucs_unlikely(ucs_array_length(&worker->am.recv_msgs) >=
+                     UCP_AM_RECV_BATCH_MAX)) {
+        ucp_am_recv_batch_dispatch(worker);
+    }
+
+    msg                  = ucs_array_append_fixed(&worker->am.recv_msgs);
+    msg->header          = user_hdr;
+    msg->header_length   = user_hdr_length;
+    msg->data            = data;
+    msg->length          = data_length;
+    msg->param.recv_attr = recv_flags;
+    msg->param.reply_ep  = reply_ep;
+    *ucs_array_append_fixed(&worker->am.recv_ids) = am_id;
+
+    return UCS_INPROGRESS;
+}
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_am_invoke_cb(ucp_worker_h worker, uint16_t am_id, void *user_hdr,
                  uint32_t user_hdr_length, void *data, size_t data_length,
@@ -1216,6 +1753,12 @@ ucp_am_invoke_cb(ucp_worker_h worker, uint16_t am_id, void *user_hdr,
     }
 
     if (ucs_likely(am_cb->flags & UCP_AM_CB_PRIV_FLAG_NBX)) {
+        if (ucs_unlikely(am_cb->flags & UCP_AM_CB_PRIV_FLAG_BATCH)) {
+            return ucp_am_recv_batch_add(worker, am_id, user_hdr,
+                                         user_hdr_length, data, data_length,
+                                         reply_ep, recv_flags);
+        }
+
         param.recv_attr = recv_flags;
         param.reply_ep  = reply_ep;
 
@@ -1250,6 +1793,7 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_am_handler_common(
                                (sizeof(*am_hdr) + am_hdr->header_length);
     void *user_hdr           = UCS_PTR_BYTE_OFFSET(data, data_length);
     ucs_status_t desc_status = UCS_OK;
+    size_t desc_length;
     ucs_status_t status;
 
     ucs_assert(total_length >= am_hdr->header_length + sizeof(*am_hdr));
@@ -1259,7 +1803,8 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_am_handler_common(
      * AM callback is registered without UCP_AM_FLAG_PERSISTENT_DATA flag.
      */
     if ((am_flags & UCT_CB_PARAM_FLAG_DESC) ||
-        (am_cb->flags & UCP_AM_FLAG_PERSISTENT_DATA)) {
+        (am_cb->flags &
+         (UCP_AM_FLAG_PERSISTENT_DATA | UCP_AM_CB_PRIV_FLAG_BATCH))) {
 
         /* UCT may not support AM data alignment. If unaligned data ptr is
          * provided in UCT descriptor, allocate new aligned data buffer from UCP
@@ -1272,10 +1817,19 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_am_handler_common(
         /* User header can not be accessed outside the user callback, so do not
          * include it to the total descriptor length. It helps to avoid extra
          * memory copy of the user header if the message is short/inlined
-         * (i.e. received without UCT_CB_PARAM_FLAG_DESC flag).
+         * (i.e. received without UCT_CB_PARAM_FLAG_DESC flag). The batch
+         * callback is called after the UCT receive buffer is released, so
+         * a short message is copied to the descriptor together with its user
+         * header. This copy is the price of delivering messages in batches.
          */
-        desc_status = ucp_recv_desc_init(worker, data, data_length, 0, am_flags,
-                                         0, UCP_RECV_DESC_FLAG_AM_CB_INPROGRESS,
+        desc_length = data_length;
+        if (am_cb->flags & UCP_AM_CB_PRIV_FLAG_BATCH) {
+            desc_length += user_hdr_size;
+        }
+
+        desc_status = ucp_recv_desc_init(worker, data, desc_length, 0,
+                                         am_flags, 0,
+                                         UCP_RECV_DESC_FLAG_AM_CB_INPROGRESS,
                                          -(int)sizeof(*am_hdr),
                                          worker->am.alignment, name, &desc);
         if (ucs_unlikely(UCS_STATUS_IS_ERR(desc_status))) {
@@ -1286,6 +1840,11 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_am_handler_common(
         }
         data        = desc + 1;
         recv_flags |= UCP_AM_RECV_ATTR_FLAG_DATA;
+        if (am_cb->flags & UCP_AM_CB_PRIV_FLAG_BATCH) {
+            /* The user header is not a part of the data */
+            desc->length = data_length;
+            user_hdr     = UCS_PTR_BYTE_OFFSET(data, data_length);
+        }
     }
 
     status = ucp_am_invoke_cb(worker, am_id, user_hdr, user_hdr_size, data,
@@ -1343,6 +1902,32 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_am_handler,
                                  "am_handler");
 }
 
+UCS_PROFILE_FUNC(ucs_status_t, ucp_am_batch_handler,
+                 (am_arg, am_data, am_length, am_flags),
+                 void *am_arg, void *am_data, size_t am_length,
+                 unsigned am_flags)
+{
+    ucp_worker_h worker           = am_arg;
+    void *end                     = UCS_PTR_BYTE_OFFSET(am_data, am_length);
+    ucp_am_batch_hdr_t *batch_hdr = am_data;
+
+    /* The transport descriptor is released when this function returns, so
+     * every message is handled as if it was received without
+     * UCT_CB_PARAM_FLAG_DESC, and its data is copied if the user callback
+     * needs to keep it */
+    while ((void*)batch_hdr < end) {
+        ucs_assertv(UCS_PTR_BYTE_OFFSET(batch_hdr + 1, batch_hdr->length) <=
+                    end, "batch_hdr=%p length=%u end=%p", batch_hdr,
+                    batch_hdr->length, end);
+        ucp_am_handler_common(worker, (ucp_am_hdr_t*)(batch_hdr + 1),
+                              batch_hdr->length, NULL, 0, 0ul,
+                              "am_batch_handler");
+        batch_hdr = UCS_PTR_BYTE_OFFSET(batch_hdr + 1, batch_hdr->length);
+    }
+
+    return UCS_OK;
+}
+
 static UCS_F_ALWAYS_INLINE ucp_recv_desc_t *
 ucp_am_find_first_rdesc(ucp_worker_h worker, ucp_ep_ext_t *ep_ext,
                         uint64_t msg_id)
@@ -1652,13 +2237,6 @@ ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
         goto out_send_ats;
     }
 
-    if (am->header_length != 0) {
-        ucs_assert(length >= am->header_length + sizeof(*rts));
-        hdr = UCS_PTR_BYTE_OFFSET(rts, length - am->header_length);
-    } else {
-        hdr = NULL;
-    }
-
     desc_status = ucp_recv_desc_init(worker, data, length, 0, tl_flags, 0,
                                      UCP_RECV_DESC_FLAG_RNDV |
                                      UCP_RECV_DESC_FLAG_AM_CB_INPROGRESS, 0, 1,
@@ -1670,11 +2248,26 @@ ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
         goto out_send_ats;
     }
 
+    /* Take the user header from the descriptor, so it persists as long as the
+     * descriptor */
+    if (am->header_length != 0) {
+        ucs_assert(length >= am->header_length + sizeof(*rts));
+        hdr = UCS_PTR_BYTE_OFFSET(desc + 1, length - am->header_length);
+    } else {
+        hdr = NULL;
+    }
+
     param.recv_attr = UCP_AM_RECV_ATTR_FLAG_RNDV |
                       ucp_am_hdr_reply_ep(worker, am->flags, ep,
                                           &param.reply_ep);
-    status          = am_cb->cb(am_cb->context, hdr, am->header_length,
-                                desc + 1, rts->size, &param);
+    if (ucs_unlikely(am_cb->flags & UCP_AM_CB_PRIV_FLAG_BATCH)) {
+        status = ucp_am_recv_batch_add(worker, am_id, hdr, am->header_length,
+                                       desc + 1, rts->size, param.reply_ep,
+                                       param.recv_attr);
+    } else {
+        status = am_cb->cb(am_cb->context, hdr, am->header_length, desc + 1,
+                           rts->size, &param);
+    }
     if (ucp_am_rdesc_in_progress(desc, status)) {
         /* User either wants to save descriptor for later use or initiated
          * rendezvous receive (by ucp_am_recv_data_nbx) in the callback. */
@@ -1727,6 +2320,8 @@ UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_AM, UCP_AM_ID_AM_MIDDLE,
                          ucp_am_long_middle_handler, NULL, 0);
 UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_AM, UCP_AM_ID_AM_SINGLE_REPLY,
                          ucp_am_handler_reply, NULL, 0);
+UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_AM, UCP_AM_ID_AM_BATCH,
+                         ucp_am_batch_handler, NULL, 0);
 
 const ucp_request_send_proto_t ucp_am_proto = {
     .contig_short           = ucp_am_contig_short,
@@ -25,11 +25,20 @@
  */
 #define UCP_AM_SEND_SHORT_MIN_IOV 4
 
+/*
+ * Maximal number of received messages which are kept before being delivered to
+ * batch receive callbacks, even if the progress pass is not over yet
+ */
+#define UCP_AM_RECV_BATCH_MAX     256
+
 enum {
     UCP_AM_CB_PRIV_FIRST_FLAG = UCS_BIT(15),
 
     /* Indicates that cb was set with ucp_worker_set_am_recv_handler */
-    UCP_AM_CB_PRIV_FLAG_NBX   = UCP_AM_CB_PRIV_FIRST_FLAG
+    UCP_AM_CB_PRIV_FLAG_NBX   = UCP_AM_CB_PRIV_FIRST_FLAG,
+
+    /* Indicates that batch_cb was set with ucp_worker_set_am_recv_handler */
+    UCP_AM_CB_PRIV_FLAG_BATCH = UCS_BIT(16)
 };
 
 
@@ -40,6 +49,7 @@ typedef struct ucp_am_entry {
     union {
         ucp_am_callback_t      cb_old;   /* user defined callback, used by legacy API */
         ucp_am_recv_callback_t cb;       /* user defined callback */
+        ucp_am_recv_batch_callback_t batch_cb; /* user defined batch callback */
     };
     void                       *context;   /* user defined callback argument */
     unsigned                   flags;      /* flags affecting callback behavior
@@ -50,6 +60,21 @@ typedef struct ucp_am_entry {
 typedef struct ucp_am_info {
     size_t                                alignment;
     ucs_array_s(unsigned, ucp_am_entry_t) cbs;
+    ucs_list_link_t                       batches;       /* Batches of coalesced
+                                                            messages which were
+                                                            not sent yet */
+    uct_worker_cb_id_t                    batch_prog_id; /* Progress callback
+                                                            which sends the
+                                                            batches */
+    unsigned                              num_coalesce_eps; /* Endpoints which
+                                                               coalesce active
+                                                               messages */
+    ucs_array_s(unsigned, ucp_am_recv_msg_t) recv_msgs;  /* Received messages
+                                                            to deliver to batch
+                                                            callbacks */
+    ucs_array_s(unsigned, uint16_t)       recv_ids;      /* AM ids of the
+                                                            messages in
+                                                            recv_msgs */
 } ucp_am_info_t;
 
 
@@ -78,6 +103,12 @@ typedef struct ucp_am_info {
  *  +------------------+---------+------------------+
  *  | ucp_am_mid_hdr_t | payload | ucp_am_mid_ftr_t |
  *  +------------------+---------+------------------+
+ *
+ * Batch of coalesced single fragment messages, where every message is
+ * preceded by its length:
+ *  +--------------------+--------------+---------+----------+--------------------+----
+ *  | ucp_am_batch_hdr_t | ucp_am_hdr_t | payload | user hdr | ucp_am_batch_hdr_t | ...
+ *  +--------------------+--------------+---------+----------+--------------------+----
  */
 
 
@@ -103,6 +134,12 @@ typedef struct {
 } UCS_S_PACKED ucp_am_reply_ftr_t;
 
 
+typedef struct {
+    uint32_t                 length; /* length of the message which follows,
+                                        including ucp_am_hdr_t */
+} UCS_S_PACKED ucp_am_batch_hdr_t;
+
+
 typedef struct {
     uint64_t                 msg_id; /* method to match parts of the same AM */
     uint64_t                 ep_id; /* ep which can be used for reply */
@@ -137,6 +174,14 @@ void ucp_am_ep_init(ucp_ep_h ep);
 
 void ucp_am_ep_cleanup(ucp_ep_h ep);
 
+void ucp_am_ep_coalesce_enable(ucp_ep_h ep);
+
+void ucp_am_ep_batch_flush(ucp_ep_h ep);
+
+ucs_status_t ucp_am_batch_progress(uct_pending_req_t *self);
+
+void ucp_am_recv_batch_dispatch(ucp_worker_h worker);
+
 ucs_status_t ucp_proto_progress_am_rndv_rts(uct_pending_req_t *self);
 
 ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
@@ -55,7 +55,8 @@
     _macro(UCP_AM_ID_AM_SINGLE) \
     _macro(UCP_AM_ID_AM_FIRST) \
     _macro(UCP_AM_ID_AM_MIDDLE) \
-    _macro(UCP_AM_ID_AM_SINGLE_REPLY)
+    _macro(UCP_AM_ID_AM_SINGLE_REPLY) \
+    _macro(UCP_AM_ID_AM_BATCH)
 
 #define UCP_AM_HANDLER_DECL(_id) extern ucp_am_handler_t ucp_am_handler_##_id;
 
@@ -71,6 +72,10 @@
 /* Factor to multiply with in order to get infinite latency */
 #define UCP_CONTEXT_INFINITE_LAT_FACTOR 100
 
+/* Source bits of the tag as set by Open MPI and MPICH UCX layers */
+#define UCP_TM_SOURCE_MASK_OMPI  0x000000fffff00000ul
+#define UCP_TM_SOURCE_MASK_MPICH 0x0000ffff00000000ul
+
 typedef enum ucp_transports_list_search_result {
     UCP_TRANSPORTS_LIST_SEARCH_RESULT_PRIMARY             = UCS_BIT(0),
     UCP_TRANSPORTS_LIST_SEARCH_RESULT_AUX_IN_MAIN         = UCS_BIT(1),
@@ -337,6 +342,23 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "selected automatically according to the performance characteristics.",
    ucs_offsetof(ucp_context_config_t, tm_sw_rndv), UCS_CONFIG_TYPE_TERNARY},
 
+  {"TM_SOURCE_MASK", "none",
+   "Index unexpected tagged messages by the tag bits which identify the sender,\n"
+   "to match receives with a wildcard in either the source or the other tag bits\n"
+   "without walking the whole unexpected queue. Possible values are:\n"
+   " none  - do not index unexpected messages by source.\n"
+   " auto  - use the sender mask passed to ucp_init() as 'tag_sender_mask'.\n"
+   " ompi  - tag layout of Open MPI: 24-bit tag, 20-bit rank, 20-bit context id.\n"
+   " mpich - tag layout of MPICH: 16-bit context id, 16-bit rank, 32-bit tag.\n"
+   " <hex> - explicit mask of the source bits, for example 0xffff00000000.",
+   ucs_offsetof(ucp_context_config_t, tm_source_mask), UCS_CONFIG_TYPE_STRING},
+
+  {"TM_HISTOGRAM", "n",
+   "Collect per-worker histograms of tag matching search length, match latency\n"
+   "and unexpected queue depth. The histograms are shown in the worker directory\n"
+   "of the VFS tree, and their totals are reported by the statistics module.",
+   ucs_offsetof(ucp_context_config_t, tm_histogram), UCS_CONFIG_TYPE_BOOL},
+
   {"NUM_EPS", "auto",
    "An optimization hint of how many endpoints would be created on this context.\n"
    "Does not affect semantics, but only transport selection criteria and the\n"
@@ -378,6 +400,14 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "even if invalidation workflow isn't supported",
    ucs_offsetof(ucp_context_config_t, rndv_errh_ppln_enable), UCS_CONFIG_TYPE_BOOL},
 
+  {"RNDV_ASYNC_REG_THRESH", "inf",
+   "Minimal size of a host memory rendezvous send buffer which is registered\n"
+   "by a helper thread when it is not found in the registration cache. Until\n"
+   "the registration is completed, the rendezvous request is resumed from\n"
+   "worker progress instead of blocking the send call.",
+   ucs_offsetof(ucp_context_config_t, rndv_async_reg_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
   {"FLUSH_WORKER_EPS", "y",
    "Enable flushing the worker by flushing its endpoints. Allows completing\n"
    "the flush operation in a bounded time even if there are new requests on\n"
@@ -475,6 +505,35 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "dynamically allocated memory.",
    ucs_offsetof(ucp_context_config_t, rkey_mpool_max_md), UCS_CONFIG_TYPE_INT},
 
+  {"REQUEST_THREAD_CACHE", "32",
+   "Number of free requests cached by each thread which uses a worker created\n"
+   "with UCS_THREAD_MODE_MULTI. The cache is refilled from and flushed to the\n"
+   "worker request pool in batches, which reduces contention on the pool.\n"
+   "0 disables the cache.",
+   ucs_offsetof(ucp_context_config_t, request_thread_cache), UCS_CONFIG_TYPE_UINT},
+
+  {"MPOOL_NUMA_NODE", "auto",
+   "NUMA node to allocate worker request and bounce buffer memory pools on.\n"
+   "\"auto\" selects the node of the CPUs the worker is created on, if they all\n"
+   "belong to one node. \"inf\" keeps the memory policy of the process.",
+   ucs_offsetof(ucp_context_config_t, mpool_numa_node), UCS_CONFIG_TYPE_ULUNITS},
+
+  {"AM_COALESCE_MAX_SIZE", "8k",
+   "Maximal size of a batch of active messages which are coalesced into a single\n"
+   "transport message, on endpoints created with UCP_EP_PARAMS_FLAGS_AM_COALESCE.\n"
+   "The effective value is limited by the maximal bcopy size of the active\n"
+   "message lane.",
+   ucs_offsetof(ucp_context_config_t, am_coalesce_max_size),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"AM_COALESCE_TIMEOUT", "10us",
+   "Maximal time an active message may wait in a batch before the batch is sent,\n"
+   "on endpoints created with UCP_EP_PARAMS_FLAGS_AM_COALESCE. A pending batch is\n"
+   "also sent on every ucp_worker_progress() call and when the endpoint or the\n"
+   "worker is flushed.",
+   ucs_offsetof(ucp_context_config_t, am_coalesce_timeout),
+   UCS_CONFIG_TYPE_TIME_UNITS},
+
   {"ADDRESS_VERSION", "v1",
    "Defines UCP worker address format obtained with ucp_worker_get_address() or\n"
    "ucp_worker_query() routines.",
@@ -499,6 +558,35 @@ static ucs_config_field_t ucp_context_config_table[] = {
    "directory.",
    ucs_offsetof(ucp_context_config_t, proto_info_dir), UCS_CONFIG_TYPE_STRING},
 
+  {"PROTO_TUNE", "n",
+   "Experimental: tune protocol selection thresholds at runtime. The completion\n"
+   "time of sampled send operations is compared with the estimated performance\n"
+   "of their protocol, and the threshold between two adjacent protocols is moved\n"
+   "to the point where their measured performance is equal. Thresholds of short\n"
+   "protocols and thresholds set by the user are not changed.",
+   ucs_offsetof(ucp_context_config_t, proto_tune), UCS_CONFIG_TYPE_BOOL},
+
+  {"PROTO_TUNE_SAMPLE_RATE", "64",
+   "When protocol tuning is enabled, time one of every this number of send\n"
+   "operations. Must be non-zero value.",
+   ucs_offsetof(ucp_context_config_t, proto_tune_sample_rate),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"PROTO_TUNE_MIN_SAMPLES", "32",
+   "Minimal number of timed operations of each of two adjacent protocols\n"
+   "required to move the threshold between them.",
+   ucs_offsetof(ucp_context_config_t, proto_tune_min_samples),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"PROTO_CACHE_DIR", "",
+   "If non-empty, protocol selection results are saved to a file in this\n"
+   "directory when a worker is destroyed, and loaded by workers which are\n"
+   "created later, to avoid selecting the protocols again. The file name\n"
+   "depends on the library version, the transports and devices in use and the\n"
+   "UCX configuration environment variables, so a cache file is not used after\n"
+   "any of them is changed. Protocol thresholds tuned at runtime are also saved.",
+   ucs_offsetof(ucp_context_config_t, proto_cache_dir), UCS_CONFIG_TYPE_STRING},
+
   {"REG_NONBLOCK_MEM_TYPES", "",
    "Perform only non-blocking memory registration for these memory types.\n"
    "Non-blocking registration means that the page registration may be\n"
@@ -2061,6 +2149,32 @@ ucp_dynamic_tl_switch_config_valid(const ucp_context_config_t *config)
     return 1;
 }
 
+static ucs_status_t ucp_fill_tm_source_mask(ucp_context_h context)
+{
+    const char *str = context->config.ext.tm_source_mask;
+    char *end;
+
+    if (!strcasecmp(str, "none")) {
+        context->config.tm_source_mask = 0;
+    } else if (!strcasecmp(str, "auto")) {
+        context->config.tm_source_mask = context->config.tag_sender_mask;
+    } else if (!strcasecmp(str, "ompi")) {
+        context->config.tm_source_mask = UCP_TM_SOURCE_MASK_OMPI;
+    } else if (!strcasecmp(str, "mpich")) {
+        context->config.tm_source_mask = UCP_TM_SOURCE_MASK_MPICH;
+    } else {
+        context->config.tm_source_mask = strtoull(str, &end, 16);
+        if ((*str == '\0') || (*end != '\0')) {
+            ucs_error("invalid value of UCX_TM_SOURCE_MASK: '%s'", str);
+            return UCS_ERR_INVALID_PARAM;
+        }
+    }
+
+    ucs_debug("tag matching source mask is 0x%" PRIx64,
+              context->config.tm_source_mask);
+    return UCS_OK;
+}
+
 static ucs_status_t ucp_fill_config(ucp_context_h context,
                                     const ucp_params_t *params,
                                     const ucp_config_t *config)
@@ -2220,6 +2334,11 @@ static ucs_status_t ucp_fill_config(ucp_context_h context,
         }
     }
 
+    status = ucp_fill_tm_source_mask(context);
+    if (status != UCS_OK) {
+        goto err_free_alloc_methods;
+    }
+
     if (context->config.ext.keepalive_num_eps == 0) {
         ucs_error("UCX_KEEPALIVE_NUM_EPS value must be greater than 0");
         status = UCS_ERR_INVALID_PARAM;
@@ -2237,6 +2356,12 @@ static ucs_status_t ucp_fill_config(ucp_context_h context,
         goto err_free_alloc_methods;
     }
 
+    if (context->config.ext.proto_tune_sample_rate == 0) {
+        ucs_error("UCX_PROTO_TUNE_SAMPLE_RATE value must be greater than 0");
+        status = UCS_ERR_INVALID_PARAM;
+        goto err_free_alloc_methods;
+    }
+
     ucs_list_for_each(key_val, &config->cached_key_list, list) {
         status = ucp_config_cached_key_add(&context->cached_key_list,
                                            key_val->key, key_val->value);
@@ -98,6 +98,8 @@ typedef struct ucp_context_config {
     int                                    rndv_shm_ppln_enable;
     /** Enable error handling for rndv pipeline protocol */
     int                                    rndv_errh_ppln_enable;
+    /** Minimal size of RNDV send buffer to register by a helper thread */
+    size_t                                 rndv_async_reg_thresh;
     /** Threshold for using tag matching offload capabilities. Smaller buffers
      *  will not be posted to the transport. */
     size_t                                 tm_thresh;
@@ -108,6 +110,11 @@ typedef struct ucp_context_config {
     size_t                                 tm_max_bb_size;
     /** Enabling SW rndv protocol with tag offload mode */
     ucs_ternary_auto_value_t               tm_sw_rndv;
+    /** Layout of the tag bits which identify the sender, used for indexing
+     *  unexpected messages */
+    char                                   *tm_source_mask;
+    /** Collect tag matching histograms */
+    int                                    tm_histogram;
     /** Pack debug information in worker address */
     int                                    address_debug_info;
     /** Maximal size of worker address name for debugging */
@@ -171,6 +178,15 @@ typedef struct ucp_context_config {
     /** Remote keys with that many remote MDs or less would be allocated from a
       * memory pool.*/
     int                                    rkey_mpool_max_md;
+    /** Number of free requests cached by each thread of a multi-threaded
+      * worker */
+    unsigned                               request_thread_cache;
+    /** NUMA node to allocate worker memory pools on */
+    unsigned long                          mpool_numa_node;
+    /** Maximal size of a batch of coalesced active messages */
+    size_t                                 am_coalesce_max_size;
+    /** Maximal time an active message may wait in a batch */
+    ucs_time_t                             am_coalesce_timeout;
     /** Worker address format version */
     ucp_object_version_t                   worker_addr_version;
     /** Threshold for enabling RNDV data split alignment */
@@ -181,6 +197,14 @@ typedef struct ucp_context_config {
     char                                   *select_distance_md;
     /** Directory to write protocol selection information */
     char                                   *proto_info_dir;
+    /** Tune protocol thresholds according to measured performance */
+    int                                    proto_tune;
+    /** Time one of every this number of send operations */
+    unsigned                               proto_tune_sample_rate;
+    /** Minimal number of timed operations to move a threshold */
+    unsigned                               proto_tune_min_samples;
+    /** Directory of persistent protocol selection cache */
+    char                                   *proto_cache_dir;
     /** Memory types that perform non-blocking registration by default */
     uint64_t                               reg_nb_mem_types;
     /** Prefer native RMA transports for RMA/AMO protocols */
@@ -401,6 +425,10 @@ typedef struct ucp_context {
         uint64_t                  features;
         uint64_t                  tag_sender_mask;
 
+        /* Tag bits which identify the sender in unexpected messages index,
+         * 0 if the index is disabled */
+        uint64_t                  tm_source_mask;
+
         /* How many endpoints are expected to be created */
         int                       est_num_eps;
 
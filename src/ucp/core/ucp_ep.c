@@ -90,7 +90,9 @@ static ucs_stats_class_t ucp_ep_stats_class = {
     .counter_names  = {
         [UCP_EP_STAT_TAG_TX_EAGER]      = "tx_eager",
         [UCP_EP_STAT_TAG_TX_EAGER_SYNC] = "tx_eager_sync",
-        [UCP_EP_STAT_TAG_TX_RNDV]       = "tx_rndv"
+        [UCP_EP_STAT_TAG_TX_RNDV]       = "tx_rndv",
+        [UCP_EP_STAT_AM_TX_COALESCED]   = "am_tx_coalesced",
+        [UCP_EP_STAT_AM_TX_BATCH]       = "am_tx_batch"
     }
 };
 #endif
@@ -1215,6 +1217,10 @@ ucs_status_t ucp_ep_create(ucp_worker_h worker, const ucp_ep_params_t *params,
 #endif
 
         ucp_ep_params_check_err_handling(ep, params);
+        if (flags & UCP_EP_PARAMS_FLAGS_AM_COALESCE) {
+            ucp_am_ep_coalesce_enable(ep);
+        }
+
         ucp_ep_update_flags(ep, UCP_EP_FLAG_USED, 0);
         *ep_p = ep;
     } else {
@@ -1624,6 +1630,22 @@ void ucp_ep_cleanup_lanes(ucp_ep_h ep)
     ucp_ep_config_deactivate_worker_ifaces(ep->worker, ep->cfg_index);
 }
 
+/* Abort send requests which wait for registration of their buffer. They were
+ * not passed to the transport yet, so flush or discard of the lanes does not
+ * complete them. */
+static void ucp_ep_async_reg_reqs_abort(ucp_ep_h ep, ucs_status_t status)
+{
+    ucp_request_t *req, *tmp_req;
+    ucs_hlist_head_t thead;
+
+    ucs_hlist_for_each_safe(req, tmp_req, &ep->ext->proto_reqs, &thead,
+                            send.list) {
+        if (req->flags & UCP_REQUEST_FLAG_RNDV_ASYNC_REG) {
+            ucp_proto_request_abort(req, status);
+        }
+    }
+}
+
 void ucp_ep_disconnected(ucp_ep_h ep, int force)
 {
     ucp_worker_h worker = ep->worker;
@@ -1647,6 +1669,7 @@ void ucp_ep_disconnected(ucp_ep_h ep, int force)
         return;
     }
 
+    ucp_ep_async_reg_reqs_abort(ep, UCS_ERR_CANCELED);
     ucp_ep_match_remove_ep(worker, ep);
     ucp_ep_destroy_internal(ep);
 }
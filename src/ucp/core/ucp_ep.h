@@ -104,7 +104,8 @@ enum {
                                                         while merging pending queues */
     UCP_EP_FLAG_CONNECT_PRE_REQ_QUEUED = UCS_BIT(9), /* Pre-Connection request was queued */
     UCP_EP_FLAG_CLOSED                 = UCS_BIT(10),/* EP was closed */
-    /* 11 bit is vacant for a flag */
+    UCP_EP_FLAG_AM_COALESCE            = UCS_BIT(11),/* Small active messages are
+                                                        coalesced into batches */
     UCP_EP_FLAG_ERR_HANDLER_INVOKED    = UCS_BIT(12),/* error handler was called */
     UCP_EP_FLAG_INTERNAL               = UCS_BIT(13),/* the internal EP which holds
                                                         temporary wireup configuration or
@@ -139,6 +140,8 @@ enum {
     UCP_EP_STAT_TAG_TX_EAGER,
     UCP_EP_STAT_TAG_TX_EAGER_SYNC,
     UCP_EP_STAT_TAG_TX_RNDV,
+    UCP_EP_STAT_AM_TX_COALESCED,
+    UCP_EP_STAT_AM_TX_BATCH,
     UCP_EP_STAT_LAST
 };
 
@@ -542,6 +545,7 @@ typedef struct ucp_ep_ext {
         ucs_list_link_t           started_ams;
         ucs_queue_head_t          mid_rdesc_q;    /* Queue of middle fragments, which
                                                      arrived before the first one */
+        struct ucp_am_batch       *batch;         /* Batch of coalesced messages */
     } am;
 
     ucp_lane_map_t                unflushed_lanes; /* Bitmap of lanes which have
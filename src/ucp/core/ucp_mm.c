@@ -13,6 +13,7 @@
 #include "ucp_worker.h"
 #include "ucp_mm.inl"
 
+#include <ucs/arch/atomic.h>
 #include <ucs/debug/log.h>
 #include <ucs/debug/memtrack_int.h>
 #include <ucs/sys/math.h>
@@ -826,7 +827,7 @@ static ucs_status_t ucp_memh_init_uct_reg(ucp_context_h context, ucp_mem_h memh,
             goto err;
         }
 
-        memh->reg_id = context->next_memh_reg_id++;
+        memh->reg_id = ucs_atomic_fadd64(&context->next_memh_reg_id, 1);
         memh->parent = memh;
     } else {
         status = ucp_memh_get(context, address, length, mem_type, cache_md_map,
@@ -975,6 +976,61 @@ err_free_memh:
     goto out;
 }
 
+ucs_status_t
+ucp_memh_get_async(ucp_context_h context, void *address, size_t length,
+                   ucs_memory_type_t mem_type, ucp_md_map_t reg_md_map,
+                   unsigned uct_flags, const char *alloc_name,
+                   ucp_mem_h *memh_p)
+{
+    ucp_mem_rcache_reg_ctx_t reg_ctx = {
+        .mem_type   = mem_type,
+        .reg_md_map = reg_md_map,
+        .uct_flags  = uct_flags,
+        .alloc_name = alloc_name
+    };
+    ucs_rcache_region_t *rregion;
+    ucs_status_t status;
+
+    ucs_assert(context->rcache != NULL);
+
+    UCP_THREAD_CS_ENTER(&context->mt_lock);
+    status = ucs_rcache_get_async(context->rcache, address, length,
+                                  ucp_memh_reg_align(context, reg_md_map),
+                                  PROT_READ | PROT_WRITE, &reg_ctx,
+                                  sizeof(reg_ctx), &rregion);
+    UCP_THREAD_CS_EXIT(&context->mt_lock);
+    if ((status != UCS_OK) && (status != UCS_INPROGRESS)) {
+        return status;
+    }
+
+    *memh_p = ucs_derived_of(rregion, ucp_mem_t);
+    ucs_trace("memh %p: address %p length %zu md_map %" PRIx64 " %s", *memh_p,
+              address, length, reg_md_map,
+              (status == UCS_OK) ? "obtained from rcache" :
+                                   "registration started");
+    return status;
+}
+
+ucs_status_t ucp_memh_async_status(ucp_context_h context, ucp_mem_h memh,
+                                   ucp_md_map_t reg_md_map, unsigned uct_flags)
+{
+    ucs_status_t status;
+
+    status = ucs_rcache_region_status(context->rcache, &memh->super);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* The region could be registered by another caller with less resources */
+    if (!ucs_test_all_flags(memh->md_map, reg_md_map) ||
+        !ucs_test_all_flags(memh->uct_flags,
+                            UCP_MM_UCT_ACCESS_FLAGS(uct_flags))) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
 static ucs_status_t ucp_memh_alloc(ucp_context_h context, void *address,
                                    size_t length, ucs_memory_type_t mem_type,
                                    ucs_sys_device_t sys_dev, uint8_t memh_flags,
@@ -1597,7 +1653,8 @@ ucp_mem_rcache_mem_reg_cb(void *ctx, ucs_rcache_t *rcache, void *arg,
 
     ucp_memh_init(memh, context, 0, reg_ctx->uct_flags, UCT_ALLOC_METHOD_LAST,
                   reg_ctx->mem_type);
-    memh->reg_id = context->next_memh_reg_id++;
+    /* May be called from the rcache helper thread */
+    memh->reg_id = ucs_atomic_fadd64(&context->next_memh_reg_id, 1);
 
     if (rcache_mem_reg_flags & UCS_RCACHE_MEM_REG_HIDE_ERRORS) {
         /* Hide errors during registration but fail if any memory domain failed
@@ -1694,6 +1751,9 @@ ucs_status_t ucp_mem_rcache_init(ucp_context_h context,
     ucs_rcache_params_t rcache_params;
 
     ucs_rcache_set_params(&rcache_params, rcache_config);
+    if (context->config.ext.rndv_async_reg_thresh != UCS_MEMUNITS_INF) {
+        rcache_params.flags |= UCS_RCACHE_FLAG_ASYNC_REG;
+    }
 
     status = ucp_mem_rcache_create(context, "ucp_rcache", &context->rcache, 1,
                                    &rcache_params);
@@ -190,6 +190,26 @@ ucs_status_t ucp_memh_get_slow(ucp_context_h context, void *address,
                                ucp_md_map_t reg_md_map, unsigned uct_flags,
                                const char *alloc_name, ucp_mem_h *memh_p);
 
+/*
+ * Get a memory handle from the registration cache, without waiting for the
+ * registration of a new region. Returns UCS_INPROGRESS if the memory handle is
+ * being registered by a helper thread, and should be checked by
+ * @ref ucp_memh_async_status before using it.
+ */
+ucs_status_t
+ucp_memh_get_async(ucp_context_h context, void *address, size_t length,
+                   ucs_memory_type_t mem_type, ucp_md_map_t reg_md_map,
+                   unsigned uct_flags, const char *alloc_name,
+                   ucp_mem_h *memh_p);
+
+/*
+ * Returns UCS_INPROGRESS while the memory handle obtained by
+ * @ref ucp_memh_get_async is being registered, UCS_OK if it is registered on
+ * all requested memory domains, or error if it cannot be used as is.
+ */
+ucs_status_t ucp_memh_async_status(ucp_context_h context, ucp_mem_h memh,
+                                   ucp_md_map_t reg_md_map, unsigned uct_flags);
+
 ucs_status_t ucp_memh_register(ucp_context_h context, ucp_mem_h memh,
                                ucp_md_map_t md_map, unsigned uct_flags,
                                const char *alloc_name);
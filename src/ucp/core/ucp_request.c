@@ -677,6 +677,9 @@ void ucp_request_send_state_ff(ucp_request_t *req, ucs_status_t status)
     } else if (req->send.uct.func == ucp_wireup_msg_progress) {
         ucs_free(req->send.buffer);
         ucp_request_mem_free(req);
+    } else if (req->send.uct.func == ucp_am_batch_progress) {
+        ucs_free(req->send.buffer);
+        ucp_request_put(req);
     } else if (req->send.state.uct_comp.func == ucp_ep_flush_completion) {
         ucp_ep_flush_request_ff(req, status);
     } else if (req->send.uct.func == ucp_worker_discard_uct_ep_pending_cb) {
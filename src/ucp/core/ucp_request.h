@@ -37,6 +37,7 @@ enum {
     UCP_REQUEST_FLAG_COMPLETED             = UCS_BIT(0),
     UCP_REQUEST_FLAG_RELEASED              = UCS_BIT(1),
     UCP_REQUEST_FLAG_PROTO_SEND            = UCS_BIT(2),
+    UCP_REQUEST_FLAG_PROTO_TUNE            = UCS_BIT(3),
     UCP_REQUEST_FLAG_SYNC_LOCAL_COMPLETED  = UCS_BIT(4),
     UCP_REQUEST_FLAG_SYNC_REMOTE_COMPLETED = UCS_BIT(5),
     UCP_REQUEST_FLAG_CALLBACK              = UCS_BIT(6),
@@ -55,6 +56,9 @@ enum {
     UCP_REQUEST_FLAG_USER_HEADER_COPIED    = UCS_BIT(19),
     UCP_REQUEST_FLAG_USAGE_TRACKED         = UCS_BIT(20),
     UCP_REQUEST_FLAG_FENCE_REQUIRED        = UCS_BIT(21),
+    UCP_REQUEST_FLAG_RNDV_ASYNC_REG        = UCS_BIT(25), /* Waiting for async
+                                                             registration of
+                                                             the send buffer */
 #if UCS_ENABLE_ASSERT
     UCP_REQUEST_FLAG_STREAM_RECV           = UCS_BIT(22),
     UCP_REQUEST_DEBUG_FLAG_EXTERNAL        = UCS_BIT(23),
@@ -348,6 +352,9 @@ struct ucp_request {
                     unsigned           ep_flush_flags;
                     /* Index of UCT EP to be flushed and destroyed */
                     ucp_rsc_index_t    rsc_index;
+                    /* Progress callback which retries the flush while the
+                     * UCT EP is out of resources */
+                    uct_worker_cb_id_t cb_id;
                 } discard_uct_ep;
 
                 struct {
@@ -423,6 +430,9 @@ struct ucp_request {
                     ucp_tag_t                   tag;        /* Expected tag */
                     ucp_tag_t                   tag_mask;   /* Expected tag mask */
                     uint64_t                    sn;         /* Tag match sequence */
+                    uint32_t                    post_time;  /* Posting time, used
+                                                               for tag-matching
+                                                               histograms */
                     ucp_tag_recv_nbx_callback_t cb;         /* Completion callback */
                     ucp_tag_recv_info_t         info;       /* Completion info to fill */
 
@@ -503,6 +513,9 @@ struct ucp_recv_desc {
                                                     AM memory pool or freeing it
                                                     in case of assembled
                                                     multi-fragment active message */
+    uint32_t                timestamp;       /* Arrival time of unexpected tag
+                                                message, used for tag-matching
+                                                histograms */
 #if ENABLE_DEBUG_DATA
     const char              *name;           /* Object name, debug only */
 #endif
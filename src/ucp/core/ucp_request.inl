@@ -56,7 +56,7 @@ UCS_PTR_MAP_IMPL(request, 0);
 /* defined as a macro to print the call site */
 #define ucp_request_get(_worker) \
     ({ \
-        ucp_request_t *_req = ucs_mpool_get_inline(&(_worker)->req_mp); \
+        ucp_request_t *_req = ucp_request_mpool_get(_worker); \
         if (_req != NULL) { \
             ucs_trace_req("allocated request %p", _req); \
             ucp_request_reset_internal(_req, _worker); \
@@ -222,6 +222,16 @@ static UCS_F_ALWAYS_INLINE void ucp_request_id_reset(ucp_request_t *req)
     req->id = UCS_PTR_MAP_KEY_INVALID;
 }
 
+static UCS_F_ALWAYS_INLINE ucp_request_t *
+ucp_request_mpool_get(ucp_worker_h worker)
+{
+    if (worker->flags & UCP_WORKER_FLAG_REQ_THREAD_CACHE) {
+        return (ucp_request_t*)ucs_mpool_get_mt_inline(&worker->req_mp);
+    }
+
+    return (ucp_request_t*)ucs_mpool_get_inline(&worker->req_mp);
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucp_request_reset_internal(ucp_request_t *req, ucp_worker_h worker)
 {
@@ -233,11 +243,18 @@ ucp_request_reset_internal(ucp_request_t *req, ucp_worker_h worker)
 static UCS_F_ALWAYS_INLINE void
 ucp_request_put(ucp_request_t *req)
 {
+    ucp_worker_h worker = ucs_container_of(ucs_mpool_obj_owner(req),
+                                           ucp_worker_t, req_mp);
+
     ucs_trace_req("put request %p", req);
     ucp_request_id_check(req, ==, UCS_PTR_MAP_KEY_INVALID);
     UCS_PROFILE_REQUEST_FREE(req);
     UCP_REQUEST_RESET(req);
-    ucs_mpool_put_inline(req);
+    if (worker->flags & UCP_WORKER_FLAG_REQ_THREAD_CACHE) {
+        ucs_mpool_put_mt_inline(req);
+    } else {
+        ucs_mpool_put_inline(req);
+    }
 }
 
 static UCS_F_ALWAYS_INLINE void
@@ -248,6 +265,9 @@ ucp_request_complete_send(ucp_request_t *req, ucs_status_t status)
                   req, req + 1, UCP_REQUEST_FLAGS_ARG(req->flags),
                   ucs_status_string(status));
     UCS_PROFILE_REQUEST_EVENT(req, "complete_send", status);
+    if (ucs_unlikely(req->flags & UCP_REQUEST_FLAG_PROTO_TUNE)) {
+        ucp_proto_tune_complete(req, status);
+    }
     /* Coverity wrongly resolves completion callback function to
      * 'ucp_cm_client_connect_progress'/'ucp_cm_server_conn_request_progress'
      */
@@ -365,6 +385,9 @@ ucp_request_send_state_init(ucp_request_t *req, ucp_datatype_t datatype,
         req->send.state.dt.dt.iov.iovcnt        = dt_count;
         req->send.state.dt.dt.iov.memhs         = NULL;
         return;
+    case UCP_DATATYPE_STRIDED:
+        req->send.state.dt.dt.strided.count     = dt_count;
+        return;
     case UCP_DATATYPE_GENERIC:
         dt_gen    = ucp_dt_to_generic(datatype);
         state_gen = dt_gen->ops.start_pack(dt_gen->context, req->send.buffer,
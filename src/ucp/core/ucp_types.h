@@ -201,6 +201,8 @@ typedef enum {
                                           defined AM */
     UCP_AM_ID_AM_SINGLE_REPLY   =  26, /* Single fragment user defined AM
                                           carrying remote ep for reply */
+    UCP_AM_ID_AM_BATCH          =  27, /* Batch of coalesced single fragment
+                                          user defined AMs */
     UCP_AM_ID_LAST
 } ucp_am_id_t;
 
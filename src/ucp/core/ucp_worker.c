@@ -1903,6 +1903,19 @@ ucp_worker_print_used_tls(ucp_worker_h worker, ucp_worker_cfg_index_t cfg_index)
     ucs_info("%s", ucs_string_buffer_cstr(&strb));
 }
 
+static ucs_numa_node_t ucp_worker_mpool_numa_node(ucp_context_h context)
+{
+    unsigned long numa_node = context->config.ext.mpool_numa_node;
+
+    if (numa_node == UCS_ULUNITS_AUTO) {
+        return ucs_numa_node_of_thread();
+    } else if (numa_node < UCS_NUMA_POLICY_MAX_NODES) {
+        return numa_node;
+    }
+
+    return UCS_NUMA_NODE_UNDEFINED;
+}
+
 static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
 {
     size_t           max_mp_entry_size = 0;
@@ -1911,6 +1924,7 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     ucp_rsc_index_t  iface_id;
     ucs_status_t     status;
     ucs_mpool_params_t mp_params;
+    ucs_numa_node_t  numa_node;
 
     for (iface_id = 0; iface_id < worker->num_ifaces; ++iface_id) {
         if_attr           = &worker->ifaces[iface_id]->attr;
@@ -1925,12 +1939,20 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     /* Create a hashtable of memory pools for mem_type devices */
     kh_init_inplace(ucp_worker_mpool_hash, &worker->mpool_hash);
 
+    numa_node = ucp_worker_mpool_numa_node(context);
+
     ucs_mpool_params_reset(&mp_params);
     mp_params.elem_size       = sizeof(ucp_request_t) +
                                 context->config.request.size;
     mp_params.elems_per_chunk = 128;
+    mp_params.numa_node       = numa_node;
     mp_params.ops             = &ucp_request_mpool_ops;
     mp_params.name            = "ucp_requests";
+    if ((worker->flags & UCP_WORKER_FLAG_THREAD_MULTI) &&
+        (context->config.ext.request_thread_cache > 0)) {
+        mp_params.thread_cache_size = context->config.ext.request_thread_cache;
+        worker->flags              |= UCP_WORKER_FLAG_REQ_THREAD_CACHE;
+    }
     /* Create memory pool for requests */
     status = ucs_mpool_init(&mp_params, &worker->req_mp);
     if (status != UCS_OK) {
@@ -1983,6 +2005,7 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     mp_params.elem_size       = context->config.ext.seg_size + sizeof(ucp_mem_desc_t);
     mp_params.align_offset    = sizeof(ucp_mem_desc_t);
     mp_params.elems_per_chunk = 128;
+    mp_params.numa_node       = numa_node;
     mp_params.ops             = &ucp_reg_mpool_ops;
     mp_params.name            = "ucp_reg_bufs";
     /* Create memory pool of bounce buffers */
@@ -2322,9 +2345,21 @@ ucp_worker_vfs_show_primitive(void *obj, ucs_string_buffer_t *strb,
     UCS_ASYNC_UNBLOCK(&worker->async);
 }
 
+static void
+ucp_worker_vfs_show_tag_hist(void *obj, ucs_string_buffer_t *strb,
+                             void *arg_ptr, uint64_t arg_u64)
+{
+    ucp_worker_h worker = obj;
+
+    UCS_ASYNC_BLOCK(&worker->async);
+    ucp_tag_hist_str(&worker->tm.hist.h[arg_u64], strb);
+    UCS_ASYNC_UNBLOCK(&worker->async);
+}
+
 void ucp_worker_create_vfs(ucp_context_h context, ucp_worker_h worker)
 {
     ucs_thread_mode_t thread_mode;
+    ucp_tag_hist_id_t hist_id;
 
     ucs_vfs_obj_add_dir(context, worker, "worker/%s", worker->name);
     ucs_vfs_obj_add_ro_file(worker, ucs_vfs_show_memory_address, NULL, 0,
@@ -2360,6 +2395,14 @@ void ucp_worker_create_vfs(ucp_context_h context, ucp_worker_h worker)
     ucs_vfs_obj_add_ro_file(worker, ucp_worker_vfs_show_primitive,
                             &worker->counters.ep_failures, UCS_VFS_TYPE_ULONG,
                             "counters/ep_failures");
+
+    if (worker->tm.hist.enabled) {
+        for (hist_id = 0; hist_id < UCP_TAG_HIST_LAST; ++hist_id) {
+            ucs_vfs_obj_add_ro_file(worker, ucp_worker_vfs_show_tag_hist, NULL,
+                                    hist_id, "tag_match/%s",
+                                    ucp_tag_hist_name(hist_id));
+        }
+    }
 }
 
 static void ucp_worker_set_max_am_header(ucp_worker_h worker)
@@ -2579,6 +2622,9 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
      * of the use-cases. Will be extended automatically otherwise. */
     ucs_array_reserve(&worker->ep_config, 32);
 
+    ucp_proto_tune_init(worker);
+    ucp_proto_cache_init(worker);
+
     /* Create statistics */
     status = UCS_STATS_NODE_ALLOC(&worker->stats, &ucp_worker_stats_class,
                                   ucs_stats_get_root(), "-%p", worker);
@@ -2629,6 +2675,9 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
         goto err_conn_match_cleanup;
     }
 
+    /* Load cached protocol selections, which depend on interface attributes */
+    ucp_proto_cache_load(worker);
+
     /* Open all resources as connection managers on this worker */
     status = ucp_worker_add_resource_cms(worker);
     if (status != UCS_OK) {
@@ -2648,7 +2697,9 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     }
 
     /* Initialize tag matching */
-    status = ucp_tag_match_init(&worker->tm);
+    status = ucp_tag_match_init(&worker->tm, context->config.tm_source_mask,
+                                context->config.ext.tm_histogram
+                                UCS_STATS_ARG(worker->stats));
     if (status != UCS_OK) {
         goto err_destroy_mpools;
     }
@@ -2714,6 +2765,7 @@ err_free:
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
     kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucp_proto_cache_cleanup(worker);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
     return status;
@@ -2807,35 +2859,60 @@ ucs_status_t ucp_worker_discard_uct_ep_pending_cb(uct_pending_req_t *self)
     return UCS_OK;
 }
 
-unsigned ucp_worker_discard_uct_ep_progress(void *arg)
+/* Try to flush the UCT EP, or add the request to its pending queue */
+static ucs_status_t ucp_worker_discard_uct_ep_flush(ucp_request_t *req)
 {
-    ucp_request_t *req = (ucp_request_t*)arg;
-    uct_ep_h uct_ep    = req->send.discard_uct_ep.uct_ep;
+    uct_ep_h uct_ep = req->send.discard_uct_ep.uct_ep;
     ucs_status_t status;
 
     status = ucp_worker_discard_uct_ep_pending_cb(&req->send.uct);
-    if (status == UCS_ERR_NO_RESOURCE) {
-        status = uct_ep_pending_add(uct_ep, &req->send.uct, 0);
-        ucs_assert((status == UCS_ERR_BUSY) || (status == UCS_OK));
-        if (status == UCS_ERR_BUSY) {
-            /* adding to the pending queue failed, schedule the UCT EP discard
-             * operation on UCT worker progress again */
-            ucp_worker_discard_uct_ep_progress_register(
-                    req, ucp_worker_discard_uct_ep_progress);
-        }
+    if (status != UCS_ERR_NO_RESOURCE) {
+        return UCS_OK;
+    }
+
+    status = uct_ep_pending_add(uct_ep, &req->send.uct, 0);
+    ucs_assert((status == UCS_ERR_BUSY) || (status == UCS_OK));
+    return (status == UCS_ERR_BUSY) ? UCS_ERR_NO_RESOURCE : UCS_INPROGRESS;
+}
+
+static unsigned ucp_worker_discard_uct_ep_retry_progress(void *arg)
+{
+    ucp_request_t *req  = (ucp_request_t*)arg;
+    ucp_worker_h worker = req->send.ep->worker;
 
+    if (ucp_worker_discard_uct_ep_flush(req) == UCS_ERR_NO_RESOURCE) {
         return 0;
     }
 
+    uct_worker_progress_unregister_safe(worker->uct,
+                                        &req->send.discard_uct_ep.cb_id);
     return 1;
 }
 
+unsigned ucp_worker_discard_uct_ep_progress(void *arg)
+{
+    ucp_request_t *req = (ucp_request_t*)arg;
+    ucs_status_t status;
+
+    status = ucp_worker_discard_uct_ep_flush(req);
+    if (status == UCS_ERR_NO_RESOURCE) {
+        /* adding to the pending queue failed, retry the UCT EP discard
+         * operation from UCT worker progress, which is polled less often
+         * while the UCT EP stays busy */
+        uct_worker_progress_register_safe(
+                req->send.ep->worker->uct,
+                ucp_worker_discard_uct_ep_retry_progress, req,
+                UCS_CALLBACKQ_FLAG_BACKOFF, &req->send.discard_uct_ep.cb_id);
+    }
+
+    return status == UCS_OK;
+}
+
 static int
 ucp_worker_discard_remove_filter(const ucs_callbackq_elem_t *elem, void *arg)
 {
     if ((elem->arg == arg) &&
-        ((elem->cb == ucp_worker_discard_uct_ep_destroy_progress) ||
-         (elem->cb == ucp_worker_discard_uct_ep_progress))) {
+        (elem->cb == ucp_worker_discard_uct_ep_destroy_progress)) {
         ucp_worker_discard_uct_ep_complete((ucp_request_t*)elem->arg);
         return 1;
     }
@@ -2881,8 +2958,14 @@ static void ucp_worker_discard_uct_ep_cleanup(ucp_worker_h worker)
 
         /* We must do this operation as a last step, because uct_ep_destroy()
          * could move a discard operation to the progress queue */
-        ucs_callbackq_remove_oneshot(&worker->uct->progress_q, req,
-                                     ucp_worker_discard_remove_filter, req);
+        if (req->send.discard_uct_ep.cb_id != UCS_CALLBACKQ_ID_NULL) {
+            uct_worker_progress_unregister_safe(
+                    worker->uct, &req->send.discard_uct_ep.cb_id);
+            ucp_worker_discard_uct_ep_complete(req);
+        } else {
+            ucs_callbackq_remove_oneshot(&worker->uct->progress_q, req,
+                                         ucp_worker_discard_remove_filter, req);
+        }
     })
 
     worker->flags |= UCP_WORKER_FLAG_DISCARD_DISABLED;
@@ -2964,6 +3047,8 @@ void ucp_worker_destroy(ucp_worker_h worker)
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
     kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucp_proto_cache_save(worker);
+    ucp_proto_cache_cleanup(worker);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
 }
@@ -3059,6 +3144,11 @@ unsigned ucp_worker_progress(ucp_worker_h worker)
     count = uct_worker_progress(worker->uct);
     ucs_async_check_miss(&worker->async);
 
+    /* Deliver the active messages which were received during this pass */
+    if (ucs_unlikely(!ucs_array_is_empty(&worker->am.recv_msgs))) {
+        ucp_am_recv_batch_dispatch(worker);
+    }
+
     /* coverity[assert_side_effect] */
     ucs_assert(--worker->inprogress == 0);
 
@@ -3571,7 +3661,8 @@ void ucp_worker_keepalive_add_ep(ucp_ep_h ep)
     ucs_trace("ep %p flags 0x%x: set keepalive lane to %u", ep,
               ep->flags, ucp_ep_config(ep)->key.keepalive_lane);
     uct_worker_progress_register_safe(worker->uct,
-                                      ucp_worker_keepalive_progress, worker, 0,
+                                      ucp_worker_keepalive_progress, worker,
+                                      UCS_CALLBACKQ_FLAG_BACKOFF,
                                       &worker->keepalive.cb_id);
 }
 
@@ -3649,6 +3740,7 @@ ucp_worker_discard_tl_uct_ep(ucp_ep_h ucp_ep, uct_ep_h uct_ep,
     req->send.discard_uct_ep.uct_ep         = uct_ep;
     req->send.discard_uct_ep.ep_flush_flags = ep_flush_flags;
     req->send.discard_uct_ep.rsc_index      = rsc_index;
+    req->send.discard_uct_ep.cb_id          = UCS_CALLBACKQ_ID_NULL;
     ucp_request_set_user_callback(req, send.cb, discarded_cb, discarded_cb_arg);
 
     if (worker->flags & UCP_WORKER_FLAG_DISCARD_DISABLED) {
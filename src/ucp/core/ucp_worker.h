@@ -14,6 +14,8 @@
 #include "ucp_rkey.h"
 
 #include <ucp/core/ucp_am.h>
+#include <ucp/proto/proto_cache.h>
+#include <ucp/proto/proto_tune.h>
 #include <ucp/tag/tag_match.h>
 #include <ucs/datastruct/mpool.h>
 #include <ucs/datastruct/mpool_set.h>
@@ -110,7 +112,11 @@ enum {
 
     /** Indicates that UCT EP discarding was disabled on this worker */
     UCP_WORKER_FLAG_DISCARD_DISABLED =
-            UCS_BIT(UCP_WORKER_INTERNAL_FLAGS_SHIFT + 5)
+            UCS_BIT(UCP_WORKER_INTERNAL_FLAGS_SHIFT + 5),
+
+    /** Requests are allocated using per-thread caches of the request pool */
+    UCP_WORKER_FLAG_REQ_THREAD_CACHE =
+            UCS_BIT(UCP_WORKER_INTERNAL_FLAGS_SHIFT + 6)
 };
 
 
@@ -344,6 +350,9 @@ typedef struct ucp_worker {
                                                              ptr mapping */
 
     ucp_ep_config_arr_t              ep_config; /* EP configurations storage */
+    ucp_proto_tune_t                 proto_tune; /* Protocol thresholds tuning */
+    ucp_proto_cache_t                proto_cache; /* Persistent protocol
+                                                     selection cache */
 
     unsigned                         rkey_config_count;   /* Current number of rkey configurations */
     ucp_rkey_config_t                rkey_config[UCP_WORKER_MAX_RKEY_CONFIG];
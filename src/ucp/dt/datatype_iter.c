@@ -326,6 +326,12 @@ void ucp_datatype_iter_str(const ucp_datatype_iter_t *dt_iter,
             ++iov_index;
         }
         break;
+    case UCP_DATATYPE_STRIDED:
+        ucs_string_buffer_appendf(strb, " buffer:%p count:%zu dt_strided:%p",
+                                  dt_iter->type.strided.buffer,
+                                  dt_iter->type.strided.count,
+                                  dt_iter->type.strided.dt_strided);
+        break;
     case UCP_DATATYPE_GENERIC:
         ucs_string_buffer_appendf(strb, " dt_gen:%p state:%p",
                                   dt_iter->type.generic.dt_gen,
@@ -341,7 +347,7 @@ int ucp_datatype_iter_is_user_memh_valid(const ucp_datatype_iter_t *dt_iter,
                                          const ucp_mem_h memh)
 {
     UCS_STRING_BUFFER_ONSTACK(err_msg, 256);
-    size_t iov_count;
+    size_t iov_count, span;
 
     if (memh == NULL) {
         ucs_error("got NULL memory handle");
@@ -365,6 +371,15 @@ int ucp_datatype_iter_is_user_memh_valid(const ucp_datatype_iter_t *dt_iter,
             goto err_memh_mismatch;
         }
         break;
+    case UCP_DATATYPE_STRIDED:
+        span = ucp_datatype_iter_strided_span(dt_iter);
+        if (!ucp_memh_is_buffer_in_range(memh, dt_iter->type.strided.buffer,
+                                         span)) {
+            ucs_string_buffer_appendf(&err_msg, "[strided buffer %p span %zu]",
+                                      dt_iter->type.strided.buffer, span);
+            goto err_memh_mismatch;
+        }
+        break;
     default:
         ucs_error("unsupported memory handle datatype: [%s]",
                   ucp_datatype_class_names[dt_iter->dt_class]);
@@ -9,6 +9,7 @@
 
 #include "dt.h"
 #include "dt_generic.h"
+#include "dt_strided.h"
 
 #include <ucp/api/ucp.h>
 #include <ucp/core/ucp_mm.h>
@@ -27,6 +28,12 @@
 #define UCP_DT_MASK_CONTIG_IOV \
     (UCS_BIT(UCP_DATATYPE_CONTIG) | UCS_BIT(UCP_DATATYPE_IOV))
 
+/*
+ * dt_mask argument which contains all datatypes that support zero-copy
+ */
+#define UCP_DT_MASK_ZCOPY \
+    (UCP_DT_MASK_CONTIG_IOV | UCS_BIT(UCP_DATATYPE_STRIDED))
+
 
 /*
  * Iterator on a datatype, used to produce data from send buffer or consume data
@@ -49,6 +56,13 @@ typedef struct {
             ucp_dt_generic_t      *dt_gen;    /* Generic datatype handle */
             void                  *state;     /* User-defined state */
         } generic;
+        struct {
+            void                  *buffer;    /* Strided buffer pointer */
+            size_t                count;      /* Number of datatype items */
+            ucp_dt_strided_t      *dt_strided; /* Strided datatype handle */
+            ucp_mem_h             memh;       /* Registration of the whole
+                                                 range of the buffer */
+        } strided;
         struct {
             const ucp_dt_iov_t    *iov;       /* IOV list */
 #if UCS_ENABLE_ASSERT
@@ -118,6 +118,52 @@ ucp_datatype_iter_iov_set_sg_count(uint8_t *sg_count, size_t iov_count)
     *sg_count = ucs_min(iov_count, (size_t)UINT8_MAX);
 }
 
+static UCS_F_ALWAYS_INLINE size_t
+ucp_datatype_iter_strided_span(const ucp_datatype_iter_t *dt_iter)
+{
+    return ucp_dt_strided_span(dt_iter->type.strided.dt_strided,
+                               dt_iter->type.strided.count);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_datatype_strided_iter_init(ucp_context_h context, void *buffer,
+                               size_t count, ucp_datatype_t datatype,
+                               ucp_datatype_iter_t *dt_iter,
+                               const ucp_request_param_t *param)
+{
+    ucp_dt_strided_t *dt_strided = ucp_dt_to_strided(datatype);
+    ucs_status_t status;
+
+    dt_iter->length                  = ucp_dt_strided_length(dt_strided, count);
+    dt_iter->type.strided.buffer     = buffer;
+    dt_iter->type.strided.count      = count;
+    dt_iter->type.strided.dt_strided = dt_strided;
+
+    if (param->op_attr_mask & UCP_OP_ATTR_FIELD_MEMH) {
+        status = ucp_datatype_iter_init_mem_info_from_user_memh(dt_iter,
+                                                                param->memh);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        dt_iter->type.strided.memh = param->memh;
+    } else {
+        dt_iter->type.strided.memh = NULL;
+        ucp_datatype_iter_detect_mem_info(
+                context, buffer, ucp_datatype_iter_strided_span(dt_iter),
+                dt_iter, param);
+    }
+
+    /* Strided pack and unpack are done by CPU */
+    if (!UCP_MEM_IS_ACCESSIBLE_FROM_CPU(dt_iter->mem_info.type)) {
+        ucs_error("strided datatype does not support memory type %s",
+                  ucs_memory_type_names[dt_iter->mem_info.type]);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
 /*
  * Initialize a datatype iterator, also returns number of scatter-gather entries
  * for protocol selection.
@@ -142,6 +188,12 @@ ucp_datatype_iter_init(ucp_context_h context, void *buffer, size_t count,
         length = ucp_dt_iov_length((const ucp_dt_iov_t*)buffer, count);
         return ucp_datatype_iov_iter_init(context, buffer, count, length,
                                           dt_iter, param);
+    } else if (dt_iter->dt_class == UCP_DATATYPE_STRIDED) {
+        ucp_datatype_iter_iov_set_sg_count(
+                sg_count, ucp_dt_strided_zcopy_iov_count(
+                                  ucp_dt_to_strided(datatype), count));
+        return ucp_datatype_strided_iter_init(context, buffer, count,
+                                              datatype, dt_iter, param);
     } else if (!ENABLE_PARAMS_CHECK ||
                (dt_iter->dt_class == UCP_DATATYPE_GENERIC)) {
         *sg_count = 0;
@@ -180,6 +232,9 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_datatype_iter_init_unpack(
         length = ucp_dt_iov_length((const ucp_dt_iov_t*)buffer, count);
         return ucp_datatype_iov_iter_init(context, buffer, count, length,
                                           dt_iter, param);
+    } else if (dt_iter->dt_class == UCP_DATATYPE_STRIDED) {
+        return ucp_datatype_strided_iter_init(context, buffer, count,
+                                              datatype, dt_iter, param);
     } else if (!ENABLE_PARAMS_CHECK ||
                (dt_iter->dt_class == UCP_DATATYPE_GENERIC)) {
         ucp_datatype_generic_iter_init(context, buffer, count, datatype, 0,
@@ -226,6 +281,11 @@ ucp_datatype_iter_move(ucp_datatype_iter_t *dst_iter,
     } else if (src_iter->dt_class == UCP_DATATYPE_IOV) {
         iov_count = ucp_datatype_iter_iov_count(src_iter);
         ucp_datatype_iter_iov_set_sg_count(sg_count, iov_count);
+    } else if (src_iter->dt_class == UCP_DATATYPE_STRIDED) {
+        iov_count = ucp_dt_strided_zcopy_iov_count(
+                src_iter->type.strided.dt_strided,
+                src_iter->type.strided.count);
+        ucp_datatype_iter_iov_set_sg_count(sg_count, iov_count);
     } else {
         *sg_count = 0;
     }
@@ -335,6 +395,12 @@ ucp_datatype_iter_cleanup(ucp_datatype_iter_t *dt_iter, int dereg,
         ucp_datatatype_iter_memh_cleanup_check(dt_iter->type.contig.memh);
     } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_IOV, dt_mask)) {
         ucp_datatype_iter_iov_cleanup(dt_iter, dereg);
+    } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_STRIDED,
+                                          dt_mask)) {
+        if (dereg) {
+            ucp_datatype_iter_mem_dereg_single(&dt_iter->type.strided.memh);
+        }
+        ucp_datatatype_iter_memh_cleanup_check(dt_iter->type.strided.memh);
     } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_GENERIC,
                                           dt_mask)) {
         dt_iter->type.generic.dt_gen->ops.finish(dt_iter->type.generic.state);
@@ -393,6 +459,14 @@ ucp_datatype_iter_next_pack(const ucp_datatype_iter_t *dt_iter,
                               (ucs_memory_type_t)dt_iter->mem_info.type,
                               dt_iter->length);
         break;
+    case UCP_DATATYPE_STRIDED:
+        length = ucs_min(dt_iter->length - dt_iter->offset, max_length);
+        UCS_PROFILE_CALL_VOID(ucp_dt_strided_pack,
+                              dt_iter->type.strided.dt_strided,
+                              dt_iter->type.strided.count,
+                              dt_iter->type.strided.buffer, dt_iter->offset,
+                              dest, length);
+        break;
     case UCP_DATATYPE_GENERIC:
         if (max_length != 0) {
             dt_gen = dt_iter->type.generic.dt_gen;
@@ -462,6 +536,14 @@ ucp_datatype_iter_unpack(ucp_datatype_iter_t *dt_iter, ucp_worker_h worker,
         dt_iter->offset += unpacked_length;
         status           = UCS_OK;
         break;
+    case UCP_DATATYPE_STRIDED:
+        UCS_PROFILE_CALL_VOID(ucp_dt_strided_unpack,
+                              dt_iter->type.strided.dt_strided,
+                              dt_iter->type.strided.count,
+                              dt_iter->type.strided.buffer, offset, src,
+                              length);
+        status = UCS_OK;
+        break;
     case UCP_DATATYPE_GENERIC:
         if (length != 0) {
             dt_gen = dt_iter->type.generic.dt_gen;
@@ -570,6 +652,8 @@ ucp_datatype_iter_next_iov(const ucp_datatype_iter_t *dt_iter,
                            unsigned dt_mask, ucp_datatype_iter_t *next_iter,
                            uct_iov_t *iov, size_t max_iov)
 {
+    size_t iov_count, length;
+
     ucs_assert(max_iov >= 1);
     if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_CONTIG, dt_mask)) {
 #ifdef __clang_analyzer__
@@ -588,6 +672,17 @@ ucp_datatype_iter_next_iov(const ucp_datatype_iter_t *dt_iter,
     } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_IOV, dt_mask)) {
         return ucp_datatype_iter_iov_next_iov(dt_iter, max_length, memh_index,
                                               next_iter, iov, max_iov);
+    } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_STRIDED,
+                                          dt_mask)) {
+        iov_count = ucp_dt_strided_to_iov(
+                dt_iter->type.strided.dt_strided, dt_iter->type.strided.count,
+                dt_iter->type.strided.buffer, dt_iter->offset,
+                ucs_min(max_length, dt_iter->length - dt_iter->offset),
+                ucp_datatype_iter_uct_memh(dt_iter->type.strided.memh,
+                                           memh_index),
+                iov, max_iov, &length);
+        next_iter->offset = dt_iter->offset + length;
+        return iov_count;
     } else {
         /* Silence compiler warning */
         next_iter->offset = dt_iter->offset;
@@ -670,6 +765,13 @@ static UCS_F_ALWAYS_INLINE ucs_status_t ucp_datatype_iter_mem_reg(
     } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_IOV, dt_mask)) {
         return ucp_datatype_iter_iov_mem_reg(context, dt_iter, md_map,
                                              uct_flags);
+    } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_STRIDED,
+                                          dt_mask)) {
+        return ucp_datatype_iter_mem_reg_single(
+                context, dt_iter->type.strided.buffer,
+                ucp_datatype_iter_strided_span(dt_iter),
+                (ucs_memory_type_t)dt_iter->mem_info.type, md_map, uct_flags,
+                &dt_iter->type.strided.memh);
     } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_GENERIC,
                                           dt_mask)) {
         return UCS_OK;
@@ -692,6 +794,9 @@ ucp_datatype_iter_mem_dereg(ucp_datatype_iter_t *dt_iter, unsigned dt_mask)
         if (dt_iter->type.iov.memh != NULL) {
             ucp_datatype_iter_iov_mem_dereg(dt_iter);
         }
+    } else if (ucp_datatype_iter_is_class(dt_iter, UCP_DATATYPE_STRIDED,
+                                          dt_mask)) {
+        ucp_datatype_iter_mem_dereg_single(&dt_iter->type.strided.memh);
     }
 }
 
@@ -12,6 +12,7 @@
 #include "dt.h"
 #include "dt_iov.h"
 #include "dt_contig.h"
+#include "dt_strided.h"
 
 #include <ucp/core/ucp_ep.inl>
 #include <ucp/core/ucp_request.h>
@@ -123,6 +124,14 @@ size_t ucp_dt_pack(ucp_worker_h worker, ucp_datatype_t datatype,
         result_len = length;
         break;
 
+    case UCP_DATATYPE_STRIDED:
+        UCS_PROFILE_CALL_VOID(ucp_dt_strided_pack,
+                              ucp_dt_to_strided(datatype),
+                              state->dt.strided.count, src, state->offset,
+                              dest, length);
+        result_len = length;
+        break;
+
     case UCP_DATATYPE_GENERIC:
         dt         = ucp_dt_to_generic(datatype);
         result_len = UCS_PROFILE_NAMED_CALL("dt_pack", dt->ops.pack,
@@ -163,6 +172,10 @@ ucs_status_t ucp_dt_query(ucp_datatype_t datatype, ucp_datatype_attr_t *attr)
 
         attr->packed_size = ucp_dt_iov_length(attr->buffer, count);
         return UCS_OK;
+    case UCP_DATATYPE_STRIDED:
+        attr->packed_size = ucp_dt_strided_length(ucp_dt_to_strided(datatype),
+                                                  count);
+        return UCS_OK;
     case UCP_DATATYPE_GENERIC:
         if (!(attr->field_mask & UCP_DATATYPE_ATTR_FIELD_BUFFER) ||
             (attr->buffer == NULL)) {
@@ -12,6 +12,7 @@
 #include <ucp/api/ucp.h>
 #include <ucp/core/ucp_types.h>
 #include <ucs/arch/cpu.h>
+#include <ucs/config/global_opts.h>
 #include <ucs/profile/profile.h>
 #include <uct/api/uct.h>
 
@@ -37,6 +38,9 @@ typedef struct ucp_dt_state {
             size_t                iovcnt;         /* Number of IOV buffers */
             ucp_mem_h             *memhs;         /* Pointer to IOV memh[iovcnt] */
         } iov;
+        struct {
+            size_t                count;          /* Number of items */
+        } strided;
         struct {
             void                  *state;
         } generic;
@@ -71,6 +75,15 @@ static UCS_F_ALWAYS_INLINE void
 ucp_memcpy_pack(void *buffer, const void *data, size_t length,
                 size_t total_len, const char *name)
 {
+    /* Large messages are sent by bcopy mostly over shared memory, since other
+     * transports switch to zero-copy much earlier. The NUMA node of the peer is
+     * not known here, so use the threshold of a local receiver. */
+    if (ucs_unlikely(total_len >= ucs_global_opts.shm_nt_copy_local_thresh)) {
+        UCS_PROFILE_NAMED_CALL_VOID(name, ucs_memcpy_shm, buffer, data, length,
+                                    total_len, 0);
+        return;
+    }
+
     UCS_PROFILE_NAMED_CALL(name, ucs_memcpy_relaxed, buffer, data, length,
                            UCS_ARCH_MEMCPY_NT_DEST, total_len);
 }
@@ -11,6 +11,7 @@
 #include "dt_contig.h"
 #include "dt_generic.h"
 #include "dt_iov.h"
+#include "dt_strided.h"
 
 #include <ucp/core/ucp_mm.h>
 #include <ucs/profile/profile.h>
@@ -47,6 +48,9 @@ size_t ucp_dt_length(ucp_datatype_t datatype, size_t count,
         ucs_assert(NULL != iov);
         return ucp_dt_iov_length(iov, count);
 
+    case UCP_DATATYPE_STRIDED:
+        return ucp_dt_strided_length(ucp_dt_to_strided(datatype), count);
+
     case UCP_DATATYPE_GENERIC:
         dt_gen = ucp_dt_to_generic(datatype);
         ucs_assert(NULL != state);
@@ -9,6 +9,7 @@
 #endif
 
 #include "dt_generic.h"
+#include "dt_strided.h"
 
 #include <ucs/sys/math.h>
 #include <ucs/debug/memtrack_int.h>
@@ -44,6 +45,9 @@ void ucp_dt_destroy(ucp_datatype_t datatype)
         dt_gen = ucp_dt_to_generic(datatype);
         ucs_free(dt_gen);
         break;
+    case UCP_DATATYPE_STRIDED:
+        ucs_free(ucp_dt_to_strided(datatype));
+        break;
     default:
         break;
     }
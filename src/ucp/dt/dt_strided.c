@@ -0,0 +1,382 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "dt_strided.h"
+
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/math.h>
+#include <string.h>
+
+
+/*
+ * Position of a packed offset in a strided buffer. The items of the operation
+ * are handled as an additional, outermost, dimension.
+ */
+typedef struct {
+    size_t               block_size;
+    unsigned             num_dims;
+    ucp_dt_strided_dim_t dims[UCP_DT_STRIDED_MAX_DIMS + 1];
+    size_t               index[UCP_DT_STRIDED_MAX_DIMS + 1];
+    void                 *buffer;
+    void                 *ptr;    /* Start of the current block */
+} ucp_dt_strided_cursor_t;
+
+
+static void ucp_dt_strided_cursor_update_ptr(ucp_dt_strided_cursor_t *cursor)
+{
+    unsigned dim;
+
+    cursor->ptr = cursor->buffer;
+    for (dim = 0; dim < cursor->num_dims; ++dim) {
+        cursor->ptr = UCS_PTR_BYTE_OFFSET(cursor->ptr,
+                                          cursor->index[dim] *
+                                          cursor->dims[dim].stride);
+    }
+}
+
+/**
+ * @return Offset of the initial position within the current block.
+ */
+static size_t ucp_dt_strided_cursor_init(ucp_dt_strided_cursor_t *cursor,
+                                         const ucp_dt_strided_t *dt_strided,
+                                         size_t count, void *buffer,
+                                         size_t offset)
+{
+    ucp_dt_strided_dim_t *last_dim;
+    size_t block_index;
+    unsigned dim;
+
+    cursor->block_size = dt_strided->block_size;
+    cursor->num_dims   = dt_strided->num_dims;
+    for (dim = 0; dim < dt_strided->num_dims; ++dim) {
+        cursor->dims[dim] = dt_strided->dims[dim];
+    }
+
+    /* Add the items dimension, or merge it if the items are adjacent */
+    if (cursor->num_dims == 0) {
+        if (dt_strided->extent == cursor->block_size) {
+            cursor->block_size *= count;
+            count               = 1;
+        }
+    } else {
+        last_dim = &cursor->dims[cursor->num_dims - 1];
+        if (dt_strided->extent == (last_dim->count * last_dim->stride)) {
+            last_dim->count *= count;
+            count            = 1;
+        }
+    }
+
+    if ((count > 1) || (cursor->num_dims == 0)) {
+        cursor->dims[cursor->num_dims].count  = count;
+        cursor->dims[cursor->num_dims].stride = dt_strided->extent;
+        ++cursor->num_dims;
+    }
+
+    block_index = offset / cursor->block_size;
+    for (dim = 0; dim < cursor->num_dims; ++dim) {
+        cursor->index[dim] = block_index % cursor->dims[dim].count;
+        block_index       /= cursor->dims[dim].count;
+    }
+
+    cursor->buffer = buffer;
+    ucp_dt_strided_cursor_update_ptr(cursor);
+    return offset % cursor->block_size;
+}
+
+/**
+ * @return Number of blocks from the current one to the end of the innermost
+ *         dimension.
+ */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_dt_strided_cursor_run(const ucp_dt_strided_cursor_t *cursor)
+{
+    return cursor->dims[0].count - cursor->index[0];
+}
+
+/*
+ * Advance the cursor by 'num_blocks', which must not exceed the value returned
+ * by ucp_dt_strided_cursor_run().
+ */
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_cursor_advance(ucp_dt_strided_cursor_t *cursor,
+                              size_t num_blocks)
+{
+    unsigned dim;
+
+    cursor->index[0] += num_blocks;
+    if (ucs_likely(cursor->index[0] < cursor->dims[0].count)) {
+        cursor->ptr = UCS_PTR_BYTE_OFFSET(cursor->ptr,
+                                          num_blocks * cursor->dims[0].stride);
+        return;
+    }
+
+    /* When the last block is passed, the cursor remains past the end */
+    for (dim = 1; dim < cursor->num_dims; ++dim) {
+        cursor->index[dim - 1] = 0;
+        if (++cursor->index[dim] < cursor->dims[dim].count) {
+            break;
+        }
+    }
+
+    ucp_dt_strided_cursor_update_ptr(cursor);
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_copy_blocks_fixed(void *dst, size_t dst_stride, const void *src,
+                                 size_t src_stride, size_t block_size,
+                                 size_t num_blocks)
+{
+    size_t i;
+
+    for (i = 0; i < num_blocks; ++i) {
+        memcpy(dst, src, block_size);
+        dst = UCS_PTR_BYTE_OFFSET(dst, dst_stride);
+        src = UCS_PTR_BYTE_OFFSET(src, src_stride);
+    }
+}
+
+/*
+ * Blocks of common element sizes are copied with a constant size, which lets
+ * the compiler replace the memcpy() by single scalar or vector load and store.
+ */
+static void ucp_dt_strided_copy_blocks(void *dst, size_t dst_stride,
+                                       const void *src, size_t src_stride,
+                                       size_t block_size, size_t num_blocks)
+{
+    switch (block_size) {
+    case 1:
+        ucp_dt_strided_copy_blocks_fixed(dst, dst_stride, src, src_stride, 1,
+                                         num_blocks);
+        break;
+    case 2:
+        ucp_dt_strided_copy_blocks_fixed(dst, dst_stride, src, src_stride, 2,
+                                         num_blocks);
+        break;
+    case 4:
+        ucp_dt_strided_copy_blocks_fixed(dst, dst_stride, src, src_stride, 4,
+                                         num_blocks);
+        break;
+    case 8:
+        ucp_dt_strided_copy_blocks_fixed(dst, dst_stride, src, src_stride, 8,
+                                         num_blocks);
+        break;
+    case 16:
+        ucp_dt_strided_copy_blocks_fixed(dst, dst_stride, src, src_stride, 16,
+                                         num_blocks);
+        break;
+    case 32:
+        ucp_dt_strided_copy_blocks_fixed(dst, dst_stride, src, src_stride, 32,
+                                         num_blocks);
+        break;
+    case 64:
+        ucp_dt_strided_copy_blocks_fixed(dst, dst_stride, src, src_stride, 64,
+                                         num_blocks);
+        break;
+    default:
+        ucp_dt_strided_copy_blocks_fixed(dst, dst_stride, src, src_stride,
+                                         block_size, num_blocks);
+        break;
+    }
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_dt_strided_copy(const ucp_dt_strided_t *dt_strided, size_t count,
+                    void *buffer, size_t offset, void *data, size_t length,
+                    int is_pack)
+{
+    ucp_dt_strided_cursor_t cursor;
+    size_t block_offset, block_size, stride, num_blocks, copy_length;
+    void *block;
+
+    if (length == 0) {
+        return;
+    }
+
+    block_offset = ucp_dt_strided_cursor_init(&cursor, dt_strided, count,
+                                              buffer, offset);
+    block_size   = cursor.block_size;
+
+    /* Partial first block */
+    if (block_offset != 0) {
+        copy_length = ucs_min(block_size - block_offset, length);
+        block       = UCS_PTR_BYTE_OFFSET(cursor.ptr, block_offset);
+        if (is_pack) {
+            memcpy(data, block, copy_length);
+        } else {
+            memcpy(block, data, copy_length);
+        }
+
+        data    = UCS_PTR_BYTE_OFFSET(data, copy_length);
+        length -= copy_length;
+        ucp_dt_strided_cursor_advance(&cursor, 1);
+    }
+
+    /* Whole blocks, in runs along the innermost dimension */
+    while (length >= block_size) {
+        num_blocks = ucs_min(length / block_size,
+                             ucp_dt_strided_cursor_run(&cursor));
+        stride     = cursor.dims[0].stride;
+        if (is_pack) {
+            ucp_dt_strided_copy_blocks(data, block_size, cursor.ptr, stride,
+                                       block_size, num_blocks);
+        } else {
+            ucp_dt_strided_copy_blocks(cursor.ptr, stride, data, block_size,
+                                       block_size, num_blocks);
+        }
+
+        data    = UCS_PTR_BYTE_OFFSET(data, num_blocks * block_size);
+        length -= num_blocks * block_size;
+        ucp_dt_strided_cursor_advance(&cursor, num_blocks);
+    }
+
+    /* Partial last block */
+    if (length > 0) {
+        if (is_pack) {
+            memcpy(data, cursor.ptr, length);
+        } else {
+            memcpy(cursor.ptr, data, length);
+        }
+    }
+}
+
+void ucp_dt_strided_pack(const ucp_dt_strided_t *dt_strided, size_t count,
+                         const void *buffer, size_t offset, void *dest,
+                         size_t length)
+{
+    ucp_dt_strided_copy(dt_strided, count, (void*)buffer, offset, dest, length,
+                        1);
+}
+
+void ucp_dt_strided_unpack(const ucp_dt_strided_t *dt_strided, size_t count,
+                           void *buffer, size_t offset, const void *src,
+                           size_t length)
+{
+    ucp_dt_strided_copy(dt_strided, count, buffer, offset, (void*)src, length,
+                        0);
+}
+
+size_t ucp_dt_strided_to_iov(const ucp_dt_strided_t *dt_strided, size_t count,
+                             void *buffer, size_t offset, size_t max_length,
+                             uct_mem_h memh, uct_iov_t *iov, size_t max_iov,
+                             size_t *length_p)
+{
+    size_t length    = 0;
+    size_t iov_count = 0;
+    ucp_dt_strided_cursor_t cursor;
+    size_t block_offset, iov_length;
+
+    if (max_length == 0) {
+        *length_p = 0;
+        return 0;
+    }
+
+    block_offset = ucp_dt_strided_cursor_init(&cursor, dt_strided, count,
+                                              buffer, offset);
+    while ((iov_count < max_iov) && (length < max_length)) {
+        iov_length = ucs_min(cursor.block_size - block_offset,
+                             max_length - length);
+
+        iov[iov_count].buffer = UCS_PTR_BYTE_OFFSET(cursor.ptr, block_offset);
+        iov[iov_count].length = iov_length;
+        iov[iov_count].memh   = memh;
+        iov[iov_count].stride = 0;
+        iov[iov_count].count  = 1;
+
+        ++iov_count;
+        length      += iov_length;
+        block_offset = 0;
+        ucp_dt_strided_cursor_advance(&cursor, 1);
+    }
+
+    *length_p = length;
+    return iov_count;
+}
+
+ucs_status_t ucp_dt_create_strided(const ucp_dt_strided_params_t *params,
+                                   ucp_datatype_t *datatype_p)
+{
+    const ucp_dt_strided_dim_t *dim;
+    ucp_dt_strided_dim_t *prev_dim;
+    ucp_dt_strided_t *dt_strided;
+    unsigned i;
+    int ret;
+
+    if (!ucs_test_all_flags(params->field_mask,
+                            UCP_DT_STRIDED_PARAM_FIELD_ELEM_SIZE |
+                            UCP_DT_STRIDED_PARAM_FIELD_DIMS)) {
+        ucs_error("strided datatype element size and dimensions must be "
+                  "specified");
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if ((params->elem_size == 0) || (params->num_dims == 0) ||
+        (params->num_dims > UCP_DT_STRIDED_MAX_DIMS)) {
+        ucs_error("invalid strided datatype element size %zu or number of "
+                  "dimensions %u (maximum: %d)", params->elem_size,
+                  params->num_dims, UCP_DT_STRIDED_MAX_DIMS);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < params->num_dims; ++i) {
+        if (params->dims[i].count == 0) {
+            ucs_error("strided datatype dimension %u has zero count", i);
+            return UCS_ERR_INVALID_PARAM;
+        }
+    }
+
+    ret = ucs_posix_memalign((void**)&dt_strided,
+                             ucs_max(sizeof(void*), UCS_BIT(UCP_DATATYPE_SHIFT)),
+                             sizeof(*dt_strided), "strided_dt");
+    if (ret != 0) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    dt_strided->block_size = params->elem_size;
+    dt_strided->num_blocks = 1;
+    dt_strided->span       = params->elem_size;
+    dt_strided->num_dims   = 0;
+
+    /* Merge dimensions which describe a contiguous layout */
+    for (i = 0; i < params->num_dims; ++i) {
+        dim                     = &params->dims[i];
+        dt_strided->span       += (dim->count - 1) * dim->stride;
+        dt_strided->num_blocks *= dim->count;
+
+        if (dim->count == 1) {
+            continue;
+        } else if (dt_strided->num_dims == 0) {
+            if (dim->stride == dt_strided->block_size) {
+                dt_strided->block_size *= dim->count;
+                dt_strided->num_blocks  = 1;
+                continue;
+            }
+        } else {
+            prev_dim = &dt_strided->dims[dt_strided->num_dims - 1];
+            if (dim->stride == (prev_dim->count * prev_dim->stride)) {
+                prev_dim->count *= dim->count;
+                continue;
+            }
+        }
+
+        dt_strided->dims[dt_strided->num_dims++] = *dim;
+    }
+
+    dim                = &params->dims[params->num_dims - 1];
+    dt_strided->extent = dim->count * dim->stride;
+
+    ucs_debug("created strided datatype %p: block_size %zu num_blocks %zu "
+              "num_dims %u extent %zu span %zu", dt_strided,
+              dt_strided->block_size, dt_strided->num_blocks,
+              dt_strided->num_dims, dt_strided->extent, dt_strided->span);
+
+    *datatype_p = ucp_dt_from_strided(dt_strided);
+    return UCS_OK;
+}
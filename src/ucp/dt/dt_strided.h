@@ -0,0 +1,166 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+
+#ifndef UCP_DT_STRIDED_H_
+#define UCP_DT_STRIDED_H_
+
+#include <ucp/api/ucp.h>
+#include <uct/api/uct.h>
+
+
+/**
+ * Strided datatype structure.
+ *
+ * A single item of the datatype consists of contiguous blocks of @a block_size
+ * bytes, placed according to @a dims (innermost dimension first). Dimensions
+ * which describe a contiguous layout are merged into the block when the
+ * datatype is created, so @a num_dims may be smaller than the number of
+ * dimensions passed by the user, and may also be 0.
+ */
+typedef struct ucp_dt_strided {
+    size_t               block_size;  /* Size of a contiguous block */
+    size_t               num_blocks;  /* Number of blocks in a single item */
+    size_t               extent;      /* Distance between consecutive items */
+    size_t               span;        /* Distance from the first to the last
+                                         byte of a single item, plus one */
+    unsigned             num_dims;    /* Number of dimensions */
+    ucp_dt_strided_dim_t dims[UCP_DT_STRIDED_MAX_DIMS];
+} ucp_dt_strided_t;
+
+
+#define UCP_DT_IS_STRIDED(_datatype) \
+    (((_datatype) & UCP_DATATYPE_CLASS_MASK) == UCP_DATATYPE_STRIDED)
+
+
+static UCS_F_ALWAYS_INLINE
+ucp_dt_strided_t* ucp_dt_to_strided(ucp_datatype_t datatype)
+{
+    return (ucp_dt_strided_t*)(void*)(datatype & ~UCP_DATATYPE_CLASS_MASK);
+}
+
+
+static UCS_F_ALWAYS_INLINE
+ucp_datatype_t ucp_dt_from_strided(ucp_dt_strided_t* dt_strided)
+{
+    return ((uintptr_t)dt_strided) | UCP_DATATYPE_STRIDED;
+}
+
+
+/**
+ * @return Packed length of @a count items of the strided datatype.
+ */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_dt_strided_length(const ucp_dt_strided_t *dt_strided, size_t count)
+{
+    return count * dt_strided->num_blocks * dt_strided->block_size;
+}
+
+
+/**
+ * @return Total number of contiguous blocks in @a count items of the strided
+ *         datatype.
+ */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_dt_strided_block_count(const ucp_dt_strided_t *dt_strided, size_t count)
+{
+    return count * dt_strided->num_blocks;
+}
+
+
+/*
+ * Smallest contiguous block of a strided datatype which is sent with zero-copy.
+ * A zero-copy fragment carries at most UCP_MAX_IOV blocks, so smaller blocks
+ * would split the message to many short fragments, which is slower than
+ * packing it to bcopy fragments.
+ */
+#define UCP_DT_STRIDED_ZCOPY_MIN_BLOCK 256
+
+
+/**
+ * @return Number of UCT iov entries needed to send @a count items of the
+ *         strided datatype with zero-copy, or 0 if the blocks of the datatype
+ *         are too small for zero-copy.
+ */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_dt_strided_zcopy_iov_count(const ucp_dt_strided_t *dt_strided, size_t count)
+{
+    if (dt_strided->block_size < UCP_DT_STRIDED_ZCOPY_MIN_BLOCK) {
+        return 0;
+    }
+
+    return ucp_dt_strided_block_count(dt_strided, count);
+}
+
+
+/**
+ * @return Length of the memory range which contains @a count items of the
+ *         strided datatype, starting from the beginning of the buffer.
+ */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_dt_strided_span(const ucp_dt_strided_t *dt_strided, size_t count)
+{
+    return (count == 0) ? 0 :
+           ((count - 1) * dt_strided->extent) + dt_strided->span;
+}
+
+
+/**
+ * Copy packed data from strided buffer @a buffer to contiguous buffer @a dest.
+ *
+ * @param [in]  dt_strided  Strided datatype.
+ * @param [in]  count       Number of datatype items in @a buffer.
+ * @param [in]  buffer      Strided source buffer.
+ * @param [in]  offset      Packed offset to start copying from.
+ * @param [in]  dest        Contiguous destination buffer.
+ * @param [in]  length      Number of bytes to copy. @a offset + @a length must
+ *                          not exceed the packed length of the buffer.
+ */
+void ucp_dt_strided_pack(const ucp_dt_strided_t *dt_strided, size_t count,
+                         const void *buffer, size_t offset, void *dest,
+                         size_t length);
+
+
+/**
+ * Copy contiguous data from @a src to strided buffer @a buffer.
+ *
+ * @param [in]  dt_strided  Strided datatype.
+ * @param [in]  count       Number of datatype items in @a buffer.
+ * @param [in]  buffer      Strided destination buffer.
+ * @param [in]  offset      Packed offset to start copying to.
+ * @param [in]  src         Contiguous source buffer.
+ * @param [in]  length      Number of bytes to copy. @a offset + @a length must
+ *                          not exceed the packed length of the buffer.
+ */
+void ucp_dt_strided_unpack(const ucp_dt_strided_t *dt_strided, size_t count,
+                           void *buffer, size_t offset, const void *src,
+                           size_t length);
+
+
+/**
+ * Fill UCT iov entries, one per contiguous block, which describe the packed
+ * range starting at @a offset.
+ *
+ * @param [in]  dt_strided  Strided datatype.
+ * @param [in]  count       Number of datatype items in @a buffer.
+ * @param [in]  buffer      Strided buffer.
+ * @param [in]  offset      Packed offset of the first iov entry.
+ * @param [in]  max_length  Maximal total length of the iov entries. @a offset
+ *                          + @a max_length must not exceed the packed length of
+ *                          the buffer.
+ * @param [in]  memh        UCT memory handle to set in all iov entries.
+ * @param [out] iov         Filled with iov entries.
+ * @param [in]  max_iov     Maximal number of iov entries to fill.
+ * @param [out] length_p    Filled with total length of the iov entries.
+ *
+ * @return Number of iov entries.
+ */
+size_t ucp_dt_strided_to_iov(const ucp_dt_strided_t *dt_strided, size_t count,
+                             void *buffer, size_t offset, size_t max_length,
+                             uct_mem_h memh, uct_iov_t *iov, size_t max_iov,
+                             size_t *length_p);
+
+#endif
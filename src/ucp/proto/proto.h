@@ -133,6 +133,10 @@ typedef struct {
        protocol depends on remote side decision as well. */
     int    is_estimation;
 
+    /* Whether the range was adjusted at runtime according to the measured
+       performance of the protocols. */
+    int    is_tuned;
+
     /* High-level description of what the protocol is doing in this range */
     char   desc[UCP_PROTO_DESC_STR_MAX];
 
@@ -628,7 +628,8 @@ ucp_proto_get_zcopy_threshold(const ucp_request_t *req,
                               ucp_worker_iface_bandwidth(worker, rsc_index));
         }
         return ucs_min(max_zcopy, zcopy_thresh);
-    } else if (UCP_DT_IS_GENERIC(req->send.datatype)) {
+    } else if (UCP_DT_IS_GENERIC(req->send.datatype) ||
+               UCP_DT_IS_STRIDED(req->send.datatype)) {
         return max_zcopy;
     }
 
@@ -0,0 +1,542 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "proto_cache.h"
+#include "proto_select.inl"
+
+#include <ucp/core/ucp_context.h>
+#include <ucp/core/ucp_worker.h>
+#include <ucs/algorithm/crc.h>
+#include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/string.h>
+#include <stdio.h>
+#include <unistd.h>
+
+
+/* File format identifier and version */
+#define UCP_PROTO_CACHE_MAGIC      0x45484341434f5250ul /* "PROCACHE" */
+#define UCP_PROTO_CACHE_VERSION    1
+
+/* Maximal number of ranges in a cache entry, to detect corrupted files */
+#define UCP_PROTO_CACHE_MAX_RANGES 1024
+
+
+#define ucp_proto_cache_crc_field(_crc, _field) \
+    ucs_crc32(_crc, &(_field), sizeof(_field))
+
+
+/* Cache file header */
+typedef struct {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t config_crc;
+    uint32_t num_entries;
+} UCS_S_PACKED ucp_proto_cache_file_header_t;
+
+
+/* Cache file entry, followed by its ranges */
+typedef struct {
+    ucp_proto_cache_key_t key;
+    uint32_t              num_ranges;
+} UCS_S_PACKED ucp_proto_cache_file_entry_t;
+
+
+extern char **environ;
+
+
+static UCS_F_ALWAYS_INLINE khint32_t
+ucp_proto_cache_key_hash(ucp_proto_cache_key_t key)
+{
+    return ucs_crc32(0, &key, sizeof(key));
+}
+
+static UCS_F_ALWAYS_INLINE int
+ucp_proto_cache_key_equal(ucp_proto_cache_key_t key1,
+                          ucp_proto_cache_key_t key2)
+{
+    return !memcmp(&key1, &key2, sizeof(key1));
+}
+
+KHASH_IMPL(ucp_proto_cache_hash, ucp_proto_cache_key_t, unsigned, 1,
+           ucp_proto_cache_key_hash, ucp_proto_cache_key_equal);
+
+
+static uint32_t ucp_proto_cache_crc_str(uint32_t crc, const char *str)
+{
+    return ucs_crc32(crc, str, strlen(str) + 1);
+}
+
+static uint32_t ucp_proto_cache_ep_key_crc(const ucp_ep_config_key_t *key)
+{
+    const ucp_ep_config_key_lane_t *lane;
+    uint32_t crc = 0;
+
+    crc = ucp_proto_cache_crc_field(crc, key->num_lanes);
+    for (lane = key->lanes; lane < (key->lanes + key->num_lanes); ++lane) {
+        crc = ucp_proto_cache_crc_field(crc, lane->rsc_index);
+        crc = ucp_proto_cache_crc_field(crc, lane->dst_md_index);
+        crc = ucp_proto_cache_crc_field(crc, lane->dst_sys_dev);
+        crc = ucp_proto_cache_crc_field(crc, lane->path_index);
+        crc = ucp_proto_cache_crc_field(crc, lane->lane_types);
+        crc = ucp_proto_cache_crc_field(crc, lane->seg_size);
+    }
+
+    crc = ucp_proto_cache_crc_field(crc, key->am_lane);
+    crc = ucp_proto_cache_crc_field(crc, key->tag_lane);
+    crc = ucp_proto_cache_crc_field(crc, key->wireup_msg_lane);
+    crc = ucp_proto_cache_crc_field(crc, key->cm_lane);
+    crc = ucp_proto_cache_crc_field(crc, key->keepalive_lane);
+    crc = ucp_proto_cache_crc_field(crc, key->rma_lanes);
+    crc = ucp_proto_cache_crc_field(crc, key->rma_bw_lanes);
+    crc = ucp_proto_cache_crc_field(crc, key->rkey_ptr_lane);
+    crc = ucp_proto_cache_crc_field(crc, key->amo_lanes);
+    crc = ucp_proto_cache_crc_field(crc, key->am_bw_lanes);
+    crc = ucp_proto_cache_crc_field(crc, key->rma_bw_md_map);
+    crc = ucp_proto_cache_crc_field(crc, key->rma_md_map);
+    crc = ucp_proto_cache_crc_field(crc, key->reachable_md_map);
+    crc = ucp_proto_cache_crc_field(crc, key->err_mode);
+    crc = ucp_proto_cache_crc_field(crc, key->flags);
+    crc = ucp_proto_cache_crc_field(crc, key->dst_version);
+    return crc;
+}
+
+static uint32_t ucp_proto_cache_rkey_key_crc(const ucp_rkey_config_key_t *key)
+{
+    uint32_t crc = 0;
+
+    /* Endpoint configuration is a separate part of the cache key */
+    crc = ucp_proto_cache_crc_field(crc, key->md_map);
+    crc = ucp_proto_cache_crc_field(crc, key->sys_dev);
+    crc = ucp_proto_cache_crc_field(crc, key->mem_type);
+    crc = ucp_proto_cache_crc_field(crc, key->unreachable_md_map);
+    return crc;
+}
+
+/*
+ * Checksum of everything which affects protocol selection, except for the
+ * endpoint and remote key configurations: library version, available
+ * protocols, transport resources and their attributes, and configuration
+ * environment variables.
+ */
+static uint32_t ucp_proto_cache_config_crc(ucp_worker_h worker)
+{
+    ucp_context_h context  = worker->context;
+    const char *env_prefix = context->config.env_prefix;
+    const uct_tl_resource_desc_t *tl_rsc;
+    const uct_iface_attr_t *attr;
+    ucp_proto_id_t proto_id;
+    ucp_rsc_index_t iface_id;
+    uint32_t crc;
+    char **envp;
+
+    crc = ucp_proto_cache_crc_str(0, ucp_get_version_string());
+    for (proto_id = 0; proto_id < ucp_protocols_count(); ++proto_id) {
+        crc = ucp_proto_cache_crc_str(crc,
+                                      ucp_proto_id_field(proto_id, name));
+    }
+    crc = ucp_proto_cache_crc_field(crc, context->proto_bitmap);
+
+    for (iface_id = 0; iface_id < worker->num_ifaces; ++iface_id) {
+        tl_rsc = &context->tl_rscs[worker->ifaces[iface_id]->rsc_index].tl_rsc;
+        attr   = &worker->ifaces[iface_id]->attr;
+        crc    = ucp_proto_cache_crc_str(crc, tl_rsc->tl_name);
+        crc    = ucp_proto_cache_crc_str(crc, tl_rsc->dev_name);
+        crc    = ucp_proto_cache_crc_field(crc, tl_rsc->dev_type);
+        crc    = ucp_proto_cache_crc_field(crc, tl_rsc->sys_device);
+        crc    = ucp_proto_cache_crc_field(crc, attr->cap.flags);
+        crc    = ucp_proto_cache_crc_field(crc, attr->cap.am);
+        crc    = ucp_proto_cache_crc_field(crc, attr->cap.put);
+        crc    = ucp_proto_cache_crc_field(crc, attr->cap.get);
+        crc    = ucp_proto_cache_crc_field(crc, attr->overhead);
+        crc    = ucp_proto_cache_crc_field(crc, attr->bandwidth);
+        crc    = ucp_proto_cache_crc_field(crc, attr->latency);
+        crc    = ucp_proto_cache_crc_field(crc, attr->priority);
+    }
+
+    for (envp = environ; *envp != NULL; ++envp) {
+        if (!strncmp(*envp, env_prefix, strlen(env_prefix))) {
+            crc = ucp_proto_cache_crc_str(crc, *envp);
+        }
+    }
+
+    return crc;
+}
+
+static void ucp_proto_cache_key_init(ucp_worker_h worker,
+                                     ucp_worker_cfg_index_t ep_cfg_index,
+                                     ucp_worker_cfg_index_t rkey_cfg_index,
+                                     const ucp_proto_select_param_t *select_param,
+                                     ucp_proto_cache_key_t *key)
+{
+    ucp_proto_select_key_t select_key;
+
+    select_key.param  = *select_param;
+    key->select_param = select_key.u64;
+    key->ep_key_crc   = ucp_proto_cache_ep_key_crc(
+            &ucs_array_elem(&worker->ep_config, ep_cfg_index).key);
+    key->rkey_key_crc = (rkey_cfg_index == UCP_WORKER_CFG_INDEX_NULL) ?
+                        0 : ucp_proto_cache_rkey_key_crc(
+                                    &worker->rkey_config[rkey_cfg_index].key);
+}
+
+static void ucp_proto_cache_path(ucp_worker_h worker, char *path,
+                                 size_t max_length)
+{
+    ucs_snprintf_safe(path, max_length, "%s/ucp_proto_cache_%08x.bin",
+                      worker->context->config.ext.proto_cache_dir,
+                      worker->proto_cache.config_crc);
+}
+
+static void ucp_proto_cache_clear(ucp_proto_cache_t *cache)
+{
+    kh_clear(ucp_proto_cache_hash, &cache->hash);
+    ucs_array_clear(&cache->entries);
+    ucs_array_clear(&cache->ranges);
+}
+
+/*
+ * Add a new entry, or replace the ranges of an existing entry.
+ *
+ * @return Pointer to the array of 'num_ranges' ranges to fill, or NULL if
+ *         failed to allocate memory.
+ */
+static ucp_proto_cache_range_t *
+ucp_proto_cache_entry_add(ucp_proto_cache_t *cache,
+                          const ucp_proto_cache_key_t *key, unsigned num_ranges)
+{
+    unsigned first_range = ucs_array_length(&cache->ranges);
+    ucp_proto_cache_entry_t *entry;
+    ucs_status_t status;
+    khiter_t khiter;
+    int khret;
+
+    ucs_assert(num_ranges > 0);
+
+    status = ucs_array_reserve(&cache->ranges, first_range + num_ranges);
+    if (status != UCS_OK) {
+        return NULL;
+    }
+
+    khiter = kh_put(ucp_proto_cache_hash, &cache->hash, *key, &khret);
+    if (khret == UCS_KH_PUT_FAILED) {
+        return NULL;
+    } else if (khret == UCS_KH_PUT_KEY_PRESENT) {
+        /* The old ranges remain unused in the array */
+        entry = &ucs_array_elem(&cache->entries,
+                                kh_value(&cache->hash, khiter));
+    } else {
+        entry = ucs_array_append(&cache->entries,
+                                 kh_del(ucp_proto_cache_hash, &cache->hash,
+                                        khiter);
+                                 return NULL);
+        entry->key                     = *key;
+        kh_value(&cache->hash, khiter) = ucs_array_length(&cache->entries) - 1;
+    }
+
+    entry->first_range = first_range;
+    entry->num_ranges  = num_ranges;
+    ucs_array_set_length(&cache->ranges, first_range + num_ranges);
+    return &ucs_array_elem(&cache->ranges, first_range);
+}
+
+static ucs_status_t ucp_proto_cache_read(ucp_proto_cache_t *cache, FILE *stream)
+{
+    ucp_proto_cache_file_entry_t file_entry;
+    ucp_proto_cache_file_header_t header;
+    ucp_proto_cache_range_t *ranges;
+    uint32_t entry_idx, range_idx;
+
+    if (fread(&header, sizeof(header), 1, stream) != 1) {
+        return UCS_ERR_IO_ERROR;
+    }
+
+    if ((header.magic != UCP_PROTO_CACHE_MAGIC) ||
+        (header.version != UCP_PROTO_CACHE_VERSION) ||
+        (header.config_crc != cache->config_crc)) {
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    for (entry_idx = 0; entry_idx < header.num_entries; ++entry_idx) {
+        if (fread(&file_entry, sizeof(file_entry), 1, stream) != 1) {
+            return UCS_ERR_IO_ERROR;
+        }
+
+        if ((file_entry.num_ranges == 0) ||
+            (file_entry.num_ranges > UCP_PROTO_CACHE_MAX_RANGES)) {
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        ranges = ucp_proto_cache_entry_add(cache, &file_entry.key,
+                                           file_entry.num_ranges);
+        if (ranges == NULL) {
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        if (fread(ranges, sizeof(*ranges), file_entry.num_ranges, stream) !=
+            file_entry.num_ranges) {
+            return UCS_ERR_IO_ERROR;
+        }
+
+        for (range_idx = 0; range_idx < file_entry.num_ranges; ++range_idx) {
+            if (ranges[range_idx].proto_id >= ucp_protocols_count()) {
+                return UCS_ERR_INVALID_PARAM;
+            }
+        }
+    }
+
+    return UCS_OK;
+}
+
+static uint8_t
+ucp_proto_cache_variant(const ucp_proto_select_init_protocols_t *proto_init,
+                        const ucp_proto_init_elem_t *init_elem)
+{
+    const ucp_proto_init_elem_t *elem;
+    uint8_t variant = 0;
+
+    ucs_array_for_each(elem, &proto_init->protocols) {
+        if (elem == init_elem) {
+            break;
+        }
+
+        variant += (elem->proto_id == init_elem->proto_id);
+    }
+
+    return variant;
+}
+
+static void
+ucp_proto_cache_add_thresholds(ucp_proto_cache_t *cache,
+                               const ucp_proto_cache_key_t *key,
+                               const ucp_proto_select_elem_t *select_elem)
+{
+    const ucp_proto_threshold_elem_t *thresh_elem;
+    const ucp_proto_init_elem_t *init_elem;
+    ucp_proto_cache_range_t *range;
+    unsigned num_ranges;
+
+    num_ranges = 1;
+    for (thresh_elem = select_elem->thresholds;
+         thresh_elem->max_msg_length != SIZE_MAX; ++thresh_elem) {
+        ++num_ranges;
+    }
+
+    range = ucp_proto_cache_entry_add(cache, key, num_ranges);
+    if (range == NULL) {
+        return;
+    }
+
+    thresh_elem = select_elem->thresholds;
+    do {
+        init_elem             = thresh_elem->proto_config.init_elem;
+        range->max_msg_length = thresh_elem->max_msg_length;
+        range->proto_id       = init_elem->proto_id;
+        range->proto_variant  = ucp_proto_cache_variant(&select_elem->proto_init,
+                                                        init_elem);
+        range->flags          = thresh_elem->tune.flags &
+                                UCP_PROTO_TUNE_FLAG_TUNED;
+        ++range;
+    } while ((thresh_elem++)->max_msg_length != SIZE_MAX);
+}
+
+static void ucp_proto_cache_add_select(ucp_worker_h worker,
+                                       const ucp_proto_select_t *proto_select,
+                                       ucp_worker_cfg_index_t ep_cfg_index,
+                                       ucp_worker_cfg_index_t rkey_cfg_index)
+{
+    ucp_proto_select_elem_t select_elem;
+    ucp_proto_select_key_t select_key;
+    ucp_proto_cache_key_t key;
+
+    kh_foreach(proto_select->hash, select_key.u64, select_elem,
+               ucp_proto_cache_key_init(worker, ep_cfg_index, rkey_cfg_index,
+                                        &select_key.param, &key);
+               ucp_proto_cache_add_thresholds(&worker->proto_cache, &key,
+                                              &select_elem))
+}
+
+static ucs_status_t
+ucp_proto_cache_write(const ucp_proto_cache_t *cache, FILE *stream)
+{
+    ucp_proto_cache_file_entry_t file_entry;
+    ucp_proto_cache_file_header_t header;
+    const ucp_proto_cache_entry_t *entry;
+
+    header.magic       = UCP_PROTO_CACHE_MAGIC;
+    header.version     = UCP_PROTO_CACHE_VERSION;
+    header.config_crc  = cache->config_crc;
+    header.num_entries = ucs_array_length(&cache->entries);
+    fwrite(&header, sizeof(header), 1, stream);
+
+    ucs_array_for_each(entry, &cache->entries) {
+        file_entry.key        = entry->key;
+        file_entry.num_ranges = entry->num_ranges;
+        fwrite(&file_entry, sizeof(file_entry), 1, stream);
+        fwrite(&ucs_array_elem(&cache->ranges, entry->first_range),
+               sizeof(ucp_proto_cache_range_t), entry->num_ranges, stream);
+    }
+
+    return ferror(stream) ? UCS_ERR_IO_ERROR : UCS_OK;
+}
+
+void ucp_proto_cache_init(ucp_worker_h worker)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+
+    cache->config_crc = 0;
+    cache->dirty      = 0;
+    kh_init_inplace(ucp_proto_cache_hash, &cache->hash);
+    ucs_array_init_dynamic(&cache->entries);
+    ucs_array_init_dynamic(&cache->ranges);
+}
+
+void ucp_proto_cache_cleanup(ucp_worker_h worker)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+
+    kh_destroy_inplace(ucp_proto_cache_hash, &cache->hash);
+    ucs_array_cleanup_dynamic(&cache->entries);
+    ucs_array_cleanup_dynamic(&cache->ranges);
+}
+
+void ucp_proto_cache_load(ucp_worker_h worker)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+    char path[PATH_MAX];
+    ucs_status_t status;
+    FILE *stream;
+
+    if (ucs_string_is_empty(worker->context->config.ext.proto_cache_dir)) {
+        return;
+    }
+
+    cache->config_crc = ucp_proto_cache_config_crc(worker);
+    ucp_proto_cache_path(worker, path, sizeof(path));
+
+    stream = fopen(path, "r");
+    if (stream == NULL) {
+        ucs_debug("worker %p: protocol cache '%s' not found", worker, path);
+        return;
+    }
+
+    status = ucp_proto_cache_read(cache, stream);
+    fclose(stream);
+    if (status != UCS_OK) {
+        ucs_debug("worker %p: ignoring protocol cache '%s': %s", worker, path,
+                  ucs_status_string(status));
+        ucp_proto_cache_clear(cache);
+        return;
+    }
+
+    ucs_debug("worker %p: loaded %u protocol selections from '%s'", worker,
+              ucs_array_length(&cache->entries), path);
+}
+
+void ucp_proto_cache_save(ucp_worker_h worker)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+    ucp_rkey_config_t *rkey_config;
+    char path[PATH_MAX], *tmp_path;
+    ucp_ep_config_t *ep_config;
+    ucs_status_t status;
+    FILE *stream;
+    unsigned i;
+    int fd;
+
+    if (ucs_string_is_empty(worker->context->config.ext.proto_cache_dir) ||
+        !cache->dirty) {
+        return;
+    }
+
+    /* Merge the selections of this worker into the loaded ones, so the cache
+     * keeps the selections for peers this worker did not connect to */
+    ucs_array_for_each(ep_config, &worker->ep_config) {
+        ucp_proto_cache_add_select(worker, &ep_config->proto_select,
+                                   ep_config -
+                                   ucs_array_begin(&worker->ep_config),
+                                   UCP_WORKER_CFG_INDEX_NULL);
+    }
+
+    for (i = 0; i < worker->rkey_config_count; ++i) {
+        rkey_config = &worker->rkey_config[i];
+        ucp_proto_cache_add_select(worker, &rkey_config->proto_select,
+                                   rkey_config->key.ep_cfg_index, i);
+    }
+
+    /* Write to a temporary file and rename it, so that processes which are
+     * saving or loading the same cache at the same time never see a partially
+     * written file */
+    ucp_proto_cache_path(worker, path, sizeof(path));
+    tmp_path = ucs_malloc(strlen(path) + 8, "proto_cache_tmp_path");
+    if (tmp_path == NULL) {
+        return;
+    }
+
+    sprintf(tmp_path, "%s.XXXXXX", path);
+    fd = mkstemp(tmp_path);
+    if (fd < 0) {
+        ucs_debug("worker %p: failed to create '%s': %m", worker, tmp_path);
+        goto err_free;
+    }
+
+    stream = fdopen(fd, "w");
+    if (stream == NULL) {
+        ucs_debug("worker %p: fdopen(%s) failed: %m", worker, tmp_path);
+        close(fd);
+        goto err_unlink;
+    }
+
+    status = ucp_proto_cache_write(cache, stream);
+    if ((fclose(stream) != 0) || (status != UCS_OK)) {
+        ucs_debug("worker %p: failed to write '%s'", worker, tmp_path);
+        goto err_unlink;
+    }
+
+    if (rename(tmp_path, path) != 0) {
+        ucs_debug("worker %p: failed to rename '%s' to '%s': %m", worker,
+                  tmp_path, path);
+        goto err_unlink;
+    }
+
+    ucs_debug("worker %p: saved %u protocol selections to '%s'", worker,
+              ucs_array_length(&cache->entries), path);
+    cache->dirty = 0;
+    ucs_free(tmp_path);
+    return;
+
+err_unlink:
+    unlink(tmp_path);
+err_free:
+    ucs_free(tmp_path);
+}
+
+const ucp_proto_cache_entry_t *
+ucp_proto_cache_lookup(ucp_worker_h worker, ucp_worker_cfg_index_t ep_cfg_index,
+                       ucp_worker_cfg_index_t rkey_cfg_index,
+                       const ucp_proto_select_param_t *select_param)
+{
+    ucp_proto_cache_t *cache = &worker->proto_cache;
+    ucp_proto_cache_key_t key;
+    khiter_t khiter;
+
+    if (kh_size(&cache->hash) == 0) {
+        return NULL;
+    }
+
+    ucp_proto_cache_key_init(worker, ep_cfg_index, rkey_cfg_index,
+                             select_param, &key);
+    khiter = kh_get(ucp_proto_cache_hash, &cache->hash, key);
+    if (khiter == kh_end(&cache->hash)) {
+        return NULL;
+    }
+
+    return &ucs_array_elem(&cache->entries, kh_value(&cache->hash, khiter));
+}
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_PROTO_CACHE_H_
+#define UCP_PROTO_CACHE_H_
+
+#include "proto_select.h"
+
+#include <ucp/core/ucp_types.h>
+#include <ucs/datastruct/array.h>
+#include <ucs/datastruct/khash.h>
+
+
+/**
+ * Key of a cached protocol selection. Configuration indices are specific to a
+ * worker, so the endpoint and remote key configurations are identified by a
+ * checksum of their contents.
+ */
+typedef struct {
+    uint64_t select_param; /* Protocol selection parameters */
+    uint32_t ep_key_crc;   /* Checksum of endpoint configuration key */
+    uint32_t rkey_key_crc; /* Checksum of remote key configuration key, or 0 */
+} UCS_S_PACKED ucp_proto_cache_key_t;
+
+
+/**
+ * Cached message size range of a protocol selection
+ */
+typedef struct {
+    uint64_t max_msg_length; /* Max message length, inclusive */
+    uint16_t proto_id;       /* Protocol to use */
+    uint8_t  proto_variant;  /* Index among the initialized instances of the
+                                protocol, since a protocol may be added several
+                                times with different private configurations */
+    uint8_t  flags;          /* UCP_PROTO_TUNE_FLAG_TUNED or 0 */
+} UCS_S_PACKED ucp_proto_cache_range_t;
+
+
+/**
+ * Cached protocol selection
+ */
+typedef struct {
+    ucp_proto_cache_key_t key;
+    unsigned              first_range; /* Index of the first range */
+    unsigned              num_ranges;  /* Number of ranges */
+} ucp_proto_cache_entry_t;
+
+
+/* Hash of cache key to entry index */
+KHASH_TYPE(ucp_proto_cache_hash, ucp_proto_cache_key_t, unsigned);
+
+
+/**
+ * Protocol selections of a worker, which are saved to a file when the worker
+ * is destroyed and loaded when a worker with the same configuration is created
+ */
+typedef struct {
+    /* Checksum of the library version, protocols, transports and
+     * configuration, which is a part of the file name */
+    uint32_t                                       config_crc;
+
+    /* Whether there are selections or thresholds which are not saved yet */
+    int                                            dirty;
+
+    /* Lookup of cache entries */
+    khash_t(ucp_proto_cache_hash)                  hash;
+
+    /* Cache entries */
+    ucs_array_s(unsigned, ucp_proto_cache_entry_t) entries;
+
+    /* Ranges of all cache entries */
+    ucs_array_s(unsigned, ucp_proto_cache_range_t) ranges;
+} ucp_proto_cache_t;
+
+
+/**
+ * Iterate over the ranges of a cache entry.
+ */
+#define ucp_proto_cache_for_each_range(_range, _cache, _entry) \
+    for (_range = &ucs_array_elem(&(_cache)->ranges, (_entry)->first_range); \
+         _range < (&ucs_array_elem(&(_cache)->ranges, (_entry)->first_range) + \
+                   (_entry)->num_ranges); \
+         ++(_range))
+
+
+/**
+ * Initialize an empty protocol selection cache of a worker.
+ */
+void ucp_proto_cache_init(ucp_worker_h worker);
+
+
+/**
+ * Release the resources of the protocol selection cache of a worker.
+ */
+void ucp_proto_cache_cleanup(ucp_worker_h worker);
+
+
+/**
+ * Load the protocol selection cache of a worker from @a UCX_PROTO_CACHE_DIR, if
+ * it is set. Must be called after the worker interfaces are opened, since their
+ * attributes are part of the cache file name. Failure to load the cache is not
+ * an error.
+ */
+void ucp_proto_cache_load(ucp_worker_h worker);
+
+
+/**
+ * Save the protocol selections of a worker to @a UCX_PROTO_CACHE_DIR, if it is
+ * set and there are selections which were not saved yet. Must be called before
+ * the worker configurations are destroyed.
+ */
+void ucp_proto_cache_save(ucp_worker_h worker);
+
+
+/**
+ * Find a cached protocol selection.
+ *
+ * @return Cache entry, or NULL if not found.
+ */
+const ucp_proto_cache_entry_t *
+ucp_proto_cache_lookup(ucp_worker_h worker, ucp_worker_cfg_index_t ep_cfg_index,
+                       ucp_worker_cfg_index_t rkey_cfg_index,
+                       const ucp_proto_select_param_t *select_param);
+
+#endif
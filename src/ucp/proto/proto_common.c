@@ -498,6 +498,15 @@ ucp_proto_common_find_lanes(const ucp_proto_init_params_t *params,
         goto out;
     }
 
+    if ((flags & (UCP_PROTO_COMMON_INIT_FLAG_SEND_ZCOPY |
+                  UCP_PROTO_COMMON_INIT_FLAG_RECV_ZCOPY)) &&
+        (select_param->dt_class == UCP_DATATYPE_STRIDED) &&
+        (select_param->sg_count == 0)) {
+        /* Strided datatype with small blocks is packed by bcopy protocols */
+        ucs_trace("strided datatype blocks are too small for zcopy");
+        goto out;
+    }
+
     lane_map = UCS_MASK(ep_config_key->num_lanes) & ~exclude_map;
     ucs_for_each_bit(lane, lane_map) {
         if (num_lanes >= max_lanes) {
@@ -604,6 +613,17 @@ ucp_proto_common_find_lanes(const ucp_proto_init_params_t *params,
             continue;
         }
 
+        /* Sending a strided datatype by fragments of only few blocks is
+         * slower than packing it */
+        if ((select_param->dt_class == UCP_DATATYPE_STRIDED) &&
+            (flags & (UCP_PROTO_COMMON_INIT_FLAG_SEND_ZCOPY |
+                      UCP_PROTO_COMMON_INIT_FLAG_RECV_ZCOPY)) &&
+            (max_iov < ucs_min(select_param->sg_count, UCP_MAX_IOV))) {
+            ucs_trace("%s: max_iov %zu is too small for %u strided blocks",
+                      lane_desc, max_iov, select_param->sg_count);
+            continue;
+        }
+
         ucs_trace("%s: added as lane %d", lane_desc, lane);
         lanes[num_lanes++] = lane;
     }
@@ -807,6 +827,10 @@ void ucp_proto_request_restart(ucp_request_t *req)
     ucp_trace_req(req, "proto %s at stage %d restarting",
                   proto_config->proto->name, req->send.proto_stage);
 
+    if (ucs_unlikely(req->flags & UCP_REQUEST_FLAG_PROTO_TUNE)) {
+        ucp_proto_tune_cancel(req);
+    }
+
     status = proto_config->proto->reset(req);
     if (status != UCS_OK) {
         ucs_assert_always(status == UCS_ERR_CANCELED);
@@ -92,7 +92,7 @@ static UCS_F_ALWAYS_INLINE void
 ucp_proto_request_zcopy_complete(ucp_request_t *req, ucs_status_t status)
 {
     ucp_datatype_iter_cleanup(&req->send.state.dt_iter, 1,
-                              UCP_DT_MASK_CONTIG_IOV);
+                              UCP_DT_MASK_ZCOPY);
     if (ucp_proto_select_op_id(&req->send.proto_config->select_param) ==
         UCP_OP_ID_TAG_SEND) {
         UCP_EP_STAT_TAG_OP(req->send.ep, EAGER)
@@ -248,6 +248,10 @@ static UCS_F_ALWAYS_INLINE ucs_status_ptr_t ucp_proto_request_send_op_common(
         return UCS_STATUS_PTR(status);
     }
 
+    if (ucs_unlikely(--worker->proto_tune.countdown == 0)) {
+        ucp_proto_tune_start(worker, req, msg_length);
+    }
+
     UCS_PROFILE_CALL_VOID(ucp_request_send, req);
     if (req->flags & UCP_REQUEST_FLAG_COMPLETED) {
         /* coverity[offset_free] */
@@ -212,7 +212,8 @@ void ucp_proto_select_elem_info(ucp_worker_h worker,
 
         row_elem = ucs_array_append(&table, break);
 
-        ucs_snprintf_safe(row_elem->desc, sizeof(row_elem->desc), "%s%s",
+        ucs_snprintf_safe(row_elem->desc, sizeof(row_elem->desc), "%s%s%s",
+                          proto_attr.is_tuned ? "(tuned) " : "",
                           proto_attr.is_estimation ? "(?) " : "",
                           proto_attr.desc);
         ucs_strncpy_safe(row_elem->config, proto_attr.config,
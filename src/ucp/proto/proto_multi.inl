@@ -361,7 +361,7 @@ ucp_proto_am_zcopy_multi_common_send_func(
     max_payload = ucp_proto_multi_max_payload(req, lpriv, hdr_size);
     iov_count   = ucp_datatype_iter_next_iov(&req->send.state.dt_iter,
                                              max_payload, lpriv->super.md_index,
-                                             UCP_DT_MASK_CONTIG_IOV, next_iter,
+                                             UCP_DT_MASK_ZCOPY, next_iter,
                                              iov, lpriv->super.max_iov);
     return uct_ep_am_zcopy(ucp_ep_get_lane(req->send.ep, lpriv->super.lane),
                            am_id, hdr, hdr_size, iov, iov_count, 0,
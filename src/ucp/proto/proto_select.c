@@ -9,8 +9,10 @@
 #endif
 
 #include "proto_init.h"
+#include "proto_cache.h"
 #include "proto_debug.h"
 #include "proto_single.h"
+#include "proto_tune.h"
 #include "proto_select.inl"
 
 #include <ucp/core/ucp_context.h>
@@ -183,6 +185,7 @@ ucp_proto_select_init_protocols(ucp_worker_h worker,
                                 ucp_worker_cfg_index_t ep_cfg_index,
                                 ucp_worker_cfg_index_t rkey_cfg_index,
                                 const ucp_proto_select_param_t *select_param,
+                                ucp_proto_id_mask_t proto_mask,
                                 ucp_proto_select_init_protocols_t *proto_init)
 {
     UCS_STRING_BUFFER_ONSTACK(strb, UCP_PROTO_CONFIG_STR_MAX);
@@ -213,7 +216,7 @@ ucp_proto_select_init_protocols(ucp_worker_h worker,
     ucs_array_init_dynamic(&proto_init->protocols);
     ucs_array_init_dynamic(&proto_init->priv_buf);
 
-    ucs_for_each_bit(init_params.proto_id, worker->context->proto_bitmap) {
+    ucs_for_each_bit(init_params.proto_id, proto_mask) {
         ucs_assert(init_params.proto_id < ucp_protocols_count()); /* Coverity */
         ucs_trace("probing %s", ucp_proto_id_field(init_params.proto_id, name));
         ucs_log_indent(1);
@@ -386,6 +389,8 @@ ucp_proto_select_elem_init_thresh(ucp_worker_h worker,
 
     ucs_assert_always(!ucs_array_is_empty(&thresholds));
 
+    ucp_proto_tune_thresholds_init(ucs_array_begin(&thresholds));
+
     /* Set pointer to priv buffer (to release it during cleanup) */
     select_elem->thresholds  = ucs_array_extract_buffer(&thresholds);
     select_elem->proto_init  = *proto_init;
@@ -404,6 +409,122 @@ err:
     return status;
 }
 
+static int
+ucp_proto_select_init_elem_supports(const ucp_proto_init_elem_t *init_elem,
+                                    size_t msg_length)
+{
+    const ucp_proto_flat_perf_range_t *range;
+
+    range = ucp_proto_flat_perf_find_lb(init_elem->flat_perf, msg_length);
+    return (range != NULL) && (range->start <= msg_length);
+}
+
+/*
+ * Initialize the thresholds from a cached selection, probing only the
+ * protocols which are used by it. Fails if any of the cached protocols is not
+ * available anymore or does not support its cached message size range, in
+ * which case the caller falls back to a full protocol selection.
+ */
+static ucs_status_t
+ucp_proto_select_elem_init_cached(ucp_worker_h worker,
+                                  ucp_proto_select_elem_t *select_elem,
+                                  const ucp_proto_cache_entry_t *cache_entry,
+                                  ucp_worker_cfg_index_t ep_cfg_index,
+                                  ucp_worker_cfg_index_t rkey_cfg_index,
+                                  const ucp_proto_select_param_t *select_param)
+{
+    ucp_proto_thresh_t thresholds  = UCS_ARRAY_DYNAMIC_INITIALIZER;
+    ucp_proto_cache_t *cache       = &worker->proto_cache;
+    ucp_proto_id_mask_t proto_mask = 0;
+    const ucp_proto_cache_range_t *cache_range;
+    ucp_proto_select_init_protocols_t proto_init;
+    ucp_proto_threshold_elem_t *thresh_elem;
+    const ucp_proto_init_elem_t *init_elem;
+    ucp_proto_config_t *proto_config;
+    size_t range_start;
+    ucs_status_t status;
+    unsigned variant;
+
+    ucp_proto_cache_for_each_range(cache_range, cache, cache_entry) {
+        proto_mask |= UCS_BIT(cache_range->proto_id);
+    }
+
+    if (proto_mask & ~worker->context->proto_bitmap) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    status = ucp_proto_select_init_protocols(worker, ep_cfg_index,
+                                             rkey_cfg_index, select_param,
+                                             proto_mask, &proto_init);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    range_start = 0;
+    ucp_proto_cache_for_each_range(cache_range, cache, cache_entry) {
+        variant = cache_range->proto_variant;
+        ucs_array_for_each(init_elem, &proto_init.protocols) {
+            if ((init_elem->proto_id == cache_range->proto_id) &&
+                (variant-- == 0)) {
+                break;
+            }
+        }
+
+        if (init_elem == ucs_array_end(&proto_init.protocols)) {
+            status = UCS_ERR_UNSUPPORTED;
+            goto err;
+        }
+
+        if (!ucp_proto_select_init_elem_supports(init_elem, range_start) ||
+            !ucp_proto_select_init_elem_supports(
+                    init_elem, cache_range->max_msg_length)) {
+            status = UCS_ERR_UNSUPPORTED;
+            goto err;
+        }
+
+        thresh_elem = ucs_array_append(&thresholds, status = UCS_ERR_NO_MEMORY;
+                                       goto err);
+        thresh_elem->max_msg_length  = cache_range->max_msg_length;
+        proto_config                 = &thresh_elem->proto_config;
+        proto_config->proto          = ucp_protocols[init_elem->proto_id];
+        proto_config->priv           = ucp_proto_select_init_priv_buf(
+                &proto_init, init_elem - ucs_array_begin(&proto_init.protocols));
+        proto_config->ep_cfg_index   = ep_cfg_index;
+        proto_config->rkey_cfg_index = rkey_cfg_index;
+        proto_config->select_param   = *select_param;
+        proto_config->init_elem      = init_elem;
+
+        if (cache_range->max_msg_length == SIZE_MAX) {
+            break;
+        }
+
+        range_start = cache_range->max_msg_length + 1;
+    }
+
+    if (ucs_array_is_empty(&thresholds) ||
+        (ucs_array_last(&thresholds)->max_msg_length != SIZE_MAX)) {
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
+    /* Keep showing the thresholds which were tuned by a previous run */
+    ucp_proto_tune_thresholds_init(ucs_array_begin(&thresholds));
+    cache_range = &ucs_array_elem(&cache->ranges, cache_entry->first_range);
+    ucs_array_for_each(thresh_elem, &thresholds) {
+        thresh_elem->tune.flags |= (cache_range++)->flags &
+                                   UCP_PROTO_TUNE_FLAG_TUNED;
+    }
+
+    select_elem->thresholds = ucs_array_extract_buffer(&thresholds);
+    select_elem->proto_init = proto_init;
+    return UCS_OK;
+
+err:
+    ucs_array_cleanup_dynamic(&thresholds);
+    ucp_proto_select_cleanup_protocols(&proto_init);
+    return status;
+}
+
 /**
  * Get map of lanes used in the selected protocols.
  */
@@ -460,6 +581,7 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
     ucp_proto_select_param_t select_param_copy = *select_param;
     UCS_STRING_BUFFER_ONSTACK(sel_param_strb, UCP_PROTO_SELECT_PARAM_STR_MAX);
     UCS_STRING_BUFFER_ONSTACK(config_name_strb, UCP_PROTO_SELECT_PARAM_STR_MAX);
+    const ucp_proto_cache_entry_t *cache_entry;
     ucp_proto_select_init_protocols_t proto_init;
     ucs_status_t status;
 
@@ -475,8 +597,29 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
 
     ucs_log_indent(1);
 
+    /* Internal selections are not taken from the cache, since other protocols
+     * use all their candidate protocols, and not only the selected ones. For
+     * example, rendezvous adds a variant for every remote protocol. */
+    cache_entry = internal ? NULL :
+                  ucp_proto_cache_lookup(worker, ep_cfg_index, rkey_cfg_index,
+                                         select_param);
+    if (cache_entry != NULL) {
+        status = ucp_proto_select_elem_init_cached(worker, select_elem,
+                                                   cache_entry, ep_cfg_index,
+                                                   rkey_cfg_index,
+                                                   &select_param_copy);
+        if (status == UCS_OK) {
+            ucs_trace("using cached protocol selection");
+            goto out_activate;
+        }
+
+        ucs_debug("worker %p: cached protocol selection is not valid: %s",
+                  worker, ucs_status_string(status));
+    }
+
     status = ucp_proto_select_init_protocols(worker, ep_cfg_index,
                                              rkey_cfg_index, &select_param_copy,
+                                             worker->context->proto_bitmap,
                                              &proto_init);
     if (status != UCS_OK) {
         goto out;
@@ -485,10 +628,16 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
     status = ucp_proto_select_elem_init_thresh(worker, select_elem, &proto_init,
                                                ep_cfg_index, rkey_cfg_index,
                                                &select_param_copy, internal);
+    ucp_proto_select_cleanup_protocols(&proto_init);
     if (status != UCS_OK) {
-        goto out_cleanup_proto_init;
+        goto out;
     }
 
+    if (!internal) {
+        worker->proto_cache.dirty = 1;
+    }
+
+out_activate:
     ucp_proto_select_wiface_activate(worker, select_elem, ep_cfg_index);
 
     if (!internal) {
@@ -498,8 +647,6 @@ ucp_proto_select_elem_init(ucp_worker_h worker, int internal,
 
     status = UCS_OK;
 
-out_cleanup_proto_init:
-    ucp_proto_select_cleanup_protocols(&proto_init);
 out:
     ucs_log_indent(-1);
     return status;
@@ -846,6 +993,7 @@ void ucp_proto_config_query(ucp_worker_h worker,
         .msg_length    = msg_length
     };
 
+    proto_attr->is_tuned = 0;
     proto_config->proto->query(&params, proto_attr);
 }
 
@@ -864,6 +1012,8 @@ int ucp_proto_select_elem_query(ucp_worker_h worker,
 
     proto_attr->max_msg_length = ucs_min(proto_attr->max_msg_length,
                                          thresh_elem->max_msg_length);
+    proto_attr->is_tuned       = !!(thresh_elem->tune.flags &
+                                    UCP_PROTO_TUNE_FLAG_TUNED);
 
     return !(thresh_elem->proto_config.proto->flags & UCP_PROTO_FLAG_INVALID);
 }
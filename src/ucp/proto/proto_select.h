@@ -124,12 +124,36 @@ typedef struct {
 } ucp_proto_config_t;
 
 
+/**
+ * Flags of a protocol threshold element, related to runtime tuning
+ */
+enum {
+    UCP_PROTO_TUNE_FLAG_FIRST = UCS_BIT(0), /* First element in the array */
+    UCP_PROTO_TUNE_FLAG_PREV  = UCS_BIT(1), /* Start of the range may be moved */
+    UCP_PROTO_TUNE_FLAG_NEXT  = UCS_BIT(2), /* End of the range may be moved */
+    UCP_PROTO_TUNE_FLAG_TUNED = UCS_BIT(3)  /* The range was moved according to
+                                               measured performance */
+};
+
+
+/**
+ * Measured performance of a protocol threshold element
+ */
+typedef struct {
+    double                      ratio_sum; /* Sum of measured to estimated
+                                              time ratios */
+    uint32_t                    count;     /* Number of timed operations */
+    uint32_t                    flags;     /* UCP_PROTO_TUNE_FLAG_xx */
+} ucp_proto_tune_stats_t;
+
+
 /**
  * Entry which defines which protocol should be used for a message size range.
  */
 typedef struct {
     ucp_proto_config_t          proto_config;   /* Protocol configuration to use */
     size_t                      max_msg_length; /* Max message length, inclusive */
+    ucp_proto_tune_stats_t      tune;           /* Runtime tuning data */
 } ucp_proto_threshold_elem_t;
 
 
@@ -121,7 +121,8 @@ static UCS_F_ALWAYS_INLINE void ucp_proto_select_param_init_common(
 {
     if (dt_class == UCP_DATATYPE_CONTIG) {
         ucs_assert(sg_count == 1);
-    } else if (dt_class != UCP_DATATYPE_IOV) {
+    } else if ((dt_class != UCP_DATATYPE_IOV) &&
+               (dt_class != UCP_DATATYPE_STRIDED)) {
         ucs_assert(sg_count == 0);
     }
 
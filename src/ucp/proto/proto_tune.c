@@ -0,0 +1,328 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "proto_tune.h"
+
+#include <ucp/core/ucp_request.h>
+#include <ucp/core/ucp_worker.h>
+#include <ucs/datastruct/linear_func.h>
+#include <ucs/time/time.h>
+
+
+/* A sampling slot is reclaimed if its request did not complete in this time,
+ * for example if it was released without going through the send completion */
+#define UCP_PROTO_TUNE_SAMPLE_TIMEOUT 1.0
+
+/* Maximal factor by which a threshold is moved in a single step */
+#define UCP_PROTO_TUNE_MAX_STEP       4
+
+
+/* Protocols whose thresholds are also cached outside of the selection data */
+#define UCP_PROTO_TUNE_FIXED_PROTO_FLAGS \
+    (UCP_PROTO_FLAG_AM_SHORT | UCP_PROTO_FLAG_PUT_SHORT | \
+     UCP_PROTO_FLAG_TAG_SHORT | UCP_PROTO_FLAG_INVALID)
+
+
+/*
+ * Check whether the boundary between 'elem' and the element after it may be
+ * moved. The boundary is fixed if either of the protocols is a placeholder or
+ * a fast-path short protocol, or has a user-configured threshold.
+ */
+static int
+ucp_proto_tune_is_boundary_tunable(const ucp_proto_threshold_elem_t *elem)
+{
+    const ucp_proto_config_t *proto_config      = &elem[0].proto_config;
+    const ucp_proto_config_t *next_proto_config = &elem[1].proto_config;
+
+    return !(proto_config->proto->flags & UCP_PROTO_TUNE_FIXED_PROTO_FLAGS) &&
+           !(next_proto_config->proto->flags &
+             UCP_PROTO_TUNE_FIXED_PROTO_FLAGS) &&
+           (proto_config->init_elem != next_proto_config->init_elem) &&
+           (proto_config->init_elem->cfg_thresh == UCS_MEMUNITS_AUTO) &&
+           (next_proto_config->init_elem->cfg_thresh == UCS_MEMUNITS_AUTO);
+}
+
+/*
+ * Find the estimated performance range of a protocol for a message length.
+ */
+static const ucp_proto_flat_perf_range_t *
+ucp_proto_tune_perf_range(const ucp_proto_threshold_elem_t *elem,
+                          size_t msg_length)
+{
+    const ucp_proto_flat_perf_range_t *range;
+
+    range = ucp_proto_flat_perf_find_lb(elem->proto_config.init_elem->flat_perf,
+                                        msg_length);
+    if ((range == NULL) || (range->start > msg_length)) {
+        return NULL;
+    }
+
+    return range;
+}
+
+static void ucp_proto_tune_stats_reset(ucp_proto_threshold_elem_t *elem)
+{
+    elem->tune.ratio_sum = 0;
+    elem->tune.count     = 0;
+}
+
+static double ucp_proto_tune_ratio(const ucp_proto_threshold_elem_t *elem)
+{
+    return elem->tune.ratio_sum / elem->tune.count;
+}
+
+/*
+ * Move the boundary between 'elem' and the element after it to the point where
+ * the measured performance of both protocols is equal. The estimated
+ * performance of each protocol is scaled by the average ratio between its
+ * measured and estimated time, and the new boundary is limited to the range
+ * where both protocols are valid and both elements remain non-empty.
+ */
+static void ucp_proto_tune_boundary(ucp_worker_h worker,
+                                    ucp_proto_threshold_elem_t *elem)
+{
+    unsigned min_samples                   =
+            worker->context->config.ext.proto_tune_min_samples;
+    ucp_proto_threshold_elem_t *next       = elem + 1;
+    size_t thresh                          = elem->max_msg_length;
+    const ucp_proto_flat_perf_range_t *range, *next_range;
+    size_t min_thresh, max_thresh, new_thresh;
+    double ratio, next_ratio, x_intersect;
+    ucs_linear_func_t perf, next_perf;
+    double diff_min, diff_max;
+
+    if ((elem->tune.count < min_samples) || (next->tune.count < min_samples)) {
+        return;
+    }
+
+    range      = ucp_proto_tune_perf_range(elem, thresh);
+    next_range = ucp_proto_tune_perf_range(next, thresh + 1);
+    if ((range == NULL) || (next_range == NULL)) {
+        goto out_reset;
+    }
+
+    min_thresh = ucs_max(thresh / UCP_PROTO_TUNE_MAX_STEP, range->start);
+    if (next_range->start > 0) {
+        min_thresh = ucs_max(min_thresh, next_range->start - 1);
+    }
+    if (!(elem->tune.flags & UCP_PROTO_TUNE_FLAG_FIRST)) {
+        min_thresh = ucs_max(min_thresh, elem[-1].max_msg_length + 1);
+    }
+
+    max_thresh = ucs_min(range->end, next_range->end - 1);
+    max_thresh = ucs_min(max_thresh, next->max_msg_length - 1);
+    if (thresh <= (SIZE_MAX / UCP_PROTO_TUNE_MAX_STEP)) {
+        max_thresh = ucs_min(max_thresh, thresh * UCP_PROTO_TUNE_MAX_STEP);
+    }
+
+    ucs_assertv((min_thresh <= thresh) && (thresh <= max_thresh),
+                "min_thresh=%zu thresh=%zu max_thresh=%zu", min_thresh, thresh,
+                max_thresh);
+
+    ratio      = ucp_proto_tune_ratio(elem);
+    next_ratio = ucp_proto_tune_ratio(next);
+    perf       = ucs_linear_func_make(range->value.c * ratio,
+                                      range->value.m * ratio);
+    next_perf  = ucs_linear_func_make(next_range->value.c * next_ratio,
+                                      next_range->value.m * next_ratio);
+
+    /* Positive difference means the current protocol is faster */
+    diff_min = ucs_linear_func_apply(next_perf, min_thresh) -
+               ucs_linear_func_apply(perf, min_thresh);
+    diff_max = ucs_linear_func_apply(next_perf, max_thresh) -
+               ucs_linear_func_apply(perf, max_thresh);
+    if ((diff_min >= 0) && (diff_max >= 0)) {
+        new_thresh = max_thresh;
+    } else if ((diff_min < 0) && (diff_max < 0)) {
+        new_thresh = min_thresh;
+    } else if ((diff_min >= 0) &&
+               (ucs_linear_func_intersect(perf, next_perf, &x_intersect) ==
+                UCS_OK)) {
+        new_thresh = ucs_min(ucs_max((size_t)x_intersect, min_thresh),
+                             max_thresh);
+    } else {
+        /* The next protocol is faster for smaller messages, which contradicts
+         * the order of the protocols, so keep the current threshold */
+        new_thresh = thresh;
+    }
+
+    if (new_thresh != thresh) {
+        ucs_debug("worker %p: %s/%s threshold moved from %zu to %zu "
+                  "(measured/estimated time ratio %.2f/%.2f)", worker,
+                  elem->proto_config.proto->name,
+                  next->proto_config.proto->name, thresh, new_thresh, ratio,
+                  next_ratio);
+        elem->max_msg_length      = new_thresh;
+        elem->tune.flags         |= UCP_PROTO_TUNE_FLAG_TUNED;
+        next->tune.flags         |= UCP_PROTO_TUNE_FLAG_TUNED;
+        worker->proto_cache.dirty = 1;
+    }
+
+out_reset:
+    ucp_proto_tune_stats_reset(elem);
+    ucp_proto_tune_stats_reset(next);
+}
+
+void ucp_proto_tune_init(ucp_worker_h worker)
+{
+    ucp_context_h context = worker->context;
+    ucp_proto_tune_sample_t *sample;
+
+    worker->proto_tune.countdown = context->config.ext.proto_tune ?
+                                   context->config.ext.proto_tune_sample_rate :
+                                   UINT_MAX;
+    ucs_carray_for_each(sample, worker->proto_tune.samples,
+                        UCP_PROTO_TUNE_MAX_SAMPLES) {
+        sample->req = NULL;
+    }
+}
+
+void ucp_proto_tune_thresholds_init(ucp_proto_threshold_elem_t *thresholds)
+{
+    ucp_proto_threshold_elem_t *elem = thresholds;
+    uint32_t flags                   = UCP_PROTO_TUNE_FLAG_FIRST;
+
+    for (;;) {
+        ucp_proto_tune_stats_reset(elem);
+        elem->tune.flags = flags;
+        if (elem->max_msg_length == SIZE_MAX) {
+            break;
+        }
+
+        if (ucp_proto_tune_is_boundary_tunable(elem)) {
+            elem->tune.flags |= UCP_PROTO_TUNE_FLAG_NEXT;
+            flags             = UCP_PROTO_TUNE_FLAG_PREV;
+        } else {
+            flags             = 0;
+        }
+
+        ++elem;
+    }
+}
+
+void ucp_proto_tune_start(ucp_worker_h worker, ucp_request_t *req,
+                          size_t msg_length)
+{
+    ucp_context_h context                  = worker->context;
+    ucp_proto_tune_sample_t *found_sample  = NULL;
+    ucp_proto_threshold_elem_t *thresh_elem;
+    ucp_proto_tune_sample_t *sample;
+    ucs_time_t now;
+
+    if (!context->config.ext.proto_tune) {
+        worker->proto_tune.countdown = UINT_MAX;
+        return;
+    }
+
+    worker->proto_tune.countdown = context->config.ext.proto_tune_sample_rate;
+
+    /* The thresholds array is owned by the selection data of the worker, and
+     * the request points to one of its elements */
+    thresh_elem = ucs_container_of(req->send.proto_config,
+                                   ucp_proto_threshold_elem_t, proto_config);
+    if (!(thresh_elem->tune.flags &
+          (UCP_PROTO_TUNE_FLAG_PREV | UCP_PROTO_TUNE_FLAG_NEXT))) {
+        return;
+    }
+
+    now = ucs_get_time();
+    ucs_carray_for_each(sample, worker->proto_tune.samples,
+                        UCP_PROTO_TUNE_MAX_SAMPLES) {
+        if (sample->req == req) {
+            /* Stale entry of a reused request */
+            found_sample = sample;
+            break;
+        }
+
+        if ((found_sample == NULL) &&
+            ((sample->req == NULL) ||
+             (ucs_time_to_sec(now - sample->start_time) >
+              UCP_PROTO_TUNE_SAMPLE_TIMEOUT))) {
+            found_sample = sample;
+        }
+    }
+
+    if (found_sample == NULL) {
+        return;
+    }
+
+    found_sample->req         = req;
+    found_sample->thresh_elem = thresh_elem;
+    found_sample->msg_length  = msg_length;
+    found_sample->start_time  = now;
+    req->flags               |= UCP_REQUEST_FLAG_PROTO_TUNE;
+}
+
+/*
+ * Release the sampling slot of a request.
+ *
+ * @return The released slot, or NULL if the slot was already reclaimed.
+ */
+static ucp_proto_tune_sample_t *ucp_proto_tune_release(ucp_request_t *req)
+{
+    ucp_worker_h worker = req->send.ep->worker;
+    ucp_proto_tune_sample_t *sample;
+
+    req->flags &= ~UCP_REQUEST_FLAG_PROTO_TUNE;
+
+    ucs_carray_for_each(sample, worker->proto_tune.samples,
+                        UCP_PROTO_TUNE_MAX_SAMPLES) {
+        if (sample->req == req) {
+            sample->req = NULL;
+            return sample;
+        }
+    }
+
+    return NULL;
+}
+
+void ucp_proto_tune_complete(ucp_request_t *req, ucs_status_t status)
+{
+    ucp_worker_h worker = req->send.ep->worker;
+    ucp_proto_threshold_elem_t *thresh_elem;
+    const ucp_proto_flat_perf_range_t *range;
+    ucp_proto_tune_sample_t *sample;
+    double elapsed, estimated;
+
+    sample = ucp_proto_tune_release(req);
+    if ((sample == NULL) || (status != UCS_OK)) {
+        return;
+    }
+
+    /* The request may have switched to another protocol during the operation,
+     * for example to a rendezvous data transfer protocol, but the total time
+     * is attributed to the protocol which was selected for the message */
+    thresh_elem = sample->thresh_elem;
+    range       = ucp_proto_tune_perf_range(thresh_elem, sample->msg_length);
+    if (range == NULL) {
+        return;
+    }
+
+    estimated = ucs_linear_func_apply(range->value, sample->msg_length);
+    if (estimated <= 0) {
+        return;
+    }
+
+    elapsed = ucs_time_to_sec(ucs_get_time() - sample->start_time);
+    thresh_elem->tune.ratio_sum += elapsed / estimated;
+    ++thresh_elem->tune.count;
+
+    if (thresh_elem->tune.flags & UCP_PROTO_TUNE_FLAG_PREV) {
+        ucp_proto_tune_boundary(worker, thresh_elem - 1);
+    }
+    if (thresh_elem->tune.flags & UCP_PROTO_TUNE_FLAG_NEXT) {
+        ucp_proto_tune_boundary(worker, thresh_elem);
+    }
+}
+
+void ucp_proto_tune_cancel(ucp_request_t *req)
+{
+    ucp_proto_tune_release(req);
+}
@@ -0,0 +1,99 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_PROTO_TUNE_H_
+#define UCP_PROTO_TUNE_H_
+
+#include "proto_select.h"
+
+#include <ucp/core/ucp_types.h>
+#include <ucs/time/time_def.h>
+
+
+/* Maximal number of send operations which are timed at the same time */
+#define UCP_PROTO_TUNE_MAX_SAMPLES 8
+
+
+/**
+ * Send operation which is being timed
+ */
+typedef struct {
+    /* Timed request, NULL if the entry is free */
+    ucp_request_t              *req;
+
+    /* Threshold element which was selected for the request */
+    ucp_proto_threshold_elem_t *thresh_elem;
+
+    /* Message length */
+    size_t                     msg_length;
+
+    /* Time when the operation was started */
+    ucs_time_t                 start_time;
+} ucp_proto_tune_sample_t;
+
+
+/**
+ * Per-worker state of protocol thresholds tuning
+ */
+typedef struct {
+    /* Number of send operations until the next one is timed */
+    unsigned                countdown;
+
+    /* Operations which are currently being timed */
+    ucp_proto_tune_sample_t samples[UCP_PROTO_TUNE_MAX_SAMPLES];
+} ucp_proto_tune_t;
+
+
+/**
+ * Initialize protocol thresholds tuning state of a worker.
+ */
+void ucp_proto_tune_init(ucp_worker_h worker);
+
+
+/**
+ * Set the tuning flags of newly created protocol thresholds array, which mark
+ * the boundaries that may be moved at runtime.
+ *
+ * @param [in]  thresholds  Thresholds array, terminated by an element whose
+ *                          @a max_msg_length is SIZE_MAX.
+ */
+void ucp_proto_tune_thresholds_init(ucp_proto_threshold_elem_t *thresholds);
+
+
+/**
+ * Start timing a send request, if its protocol is tunable and there is a free
+ * sampling slot. Called once per @a UCX_PROTO_TUNE_SAMPLE_RATE send operations.
+ *
+ * @param [in]  worker      Worker the request belongs to.
+ * @param [in]  req         Send request, after its protocol was selected.
+ * @param [in]  msg_length  Message length.
+ */
+void ucp_proto_tune_start(ucp_worker_h worker, ucp_request_t *req,
+                          size_t msg_length);
+
+
+/**
+ * Finish timing a send request. Updates the statistics of its protocol, and
+ * moves the protocol thresholds if there are enough samples.
+ *
+ * @param [in]  req     Send request which has the UCP_REQUEST_FLAG_PROTO_TUNE
+ *                      flag set.
+ * @param [in]  status  Completion status of the request.
+ */
+void ucp_proto_tune_complete(ucp_request_t *req, ucs_status_t status);
+
+
+/**
+ * Stop timing a send request without updating the statistics. Called when the
+ * request is restarted with a newly selected protocol, since its completion
+ * time would not represent the originally selected protocol.
+ *
+ * @param [in]  req     Send request which has the UCP_REQUEST_FLAG_PROTO_TUNE
+ *                      flag set.
+ */
+void ucp_proto_tune_cancel(ucp_request_t *req);
+
+#endif
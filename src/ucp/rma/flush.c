@@ -386,6 +386,10 @@ ucs_status_ptr_t ucp_ep_flush_internal(ucp_ep_h ep, unsigned req_flags,
 
     ucs_debug("%s ep %p", debug_name, ep);
 
+    if (ep->flags & UCP_EP_FLAG_AM_COALESCE) {
+        ucp_am_ep_batch_flush(ep);
+    }
+
     req = ucp_request_get_param(ep->worker, param,
                                 {return UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);});
 
@@ -164,7 +164,7 @@ ucp_proto_get_offload_zcopy_send_func(ucp_request_t *req,
 
     ucp_datatype_iter_next_iov(&req->send.state.dt_iter,
                                ucp_proto_multi_max_payload(req, lpriv, 0),
-                               lpriv->super.md_index, UCP_DT_MASK_CONTIG_IOV,
+                               lpriv->super.md_index, UCP_DT_MASK_ZCOPY,
                                next_iter, &iov, 1);
 
     mpriv = req->send.proto_config->priv;
@@ -182,7 +182,7 @@ static ucs_status_t ucp_proto_get_offload_zcopy_progress(uct_pending_req_t *self
     /* coverity[tainted_data_downcast] */
     return ucp_proto_multi_zcopy_progress(
             req, req->send.proto_config->priv, ucp_proto_multi_rma_init_func,
-            UCT_MD_MEM_ACCESS_LOCAL_WRITE, UCP_DT_MASK_CONTIG_IOV,
+            UCT_MD_MEM_ACCESS_LOCAL_WRITE, UCP_DT_MASK_ZCOPY,
             ucp_proto_get_offload_zcopy_send_func,
             ucp_request_invoke_uct_completion_success,
             ucp_proto_request_zcopy_completion);
@@ -584,8 +584,62 @@ void ucp_proto_rndv_rts_abort(ucp_request_t *req, ucs_status_t status)
     ucp_request_complete_send(req, status);
 }
 
+static unsigned ucp_proto_rndv_rts_async_reg_progress(void *arg)
+{
+    ucp_request_t *req  = arg;
+    ucp_ep_h ep         = req->send.ep;
+    ucp_worker_h worker = ep->worker;
+    ucs_rcache_region_t *rregion;
+
+    ucs_assert(req->flags & UCP_REQUEST_FLAG_RNDV_ASYNC_REG);
+
+    rregion = &req->send.state.dt_iter.type.contig.memh->super;
+    if (ucs_rcache_region_status(worker->context->rcache, rregion) ==
+        UCS_INPROGRESS) {
+        ucs_callbackq_add_oneshot(&worker->uct->progress_q, req,
+                                  ucp_proto_rndv_rts_async_reg_progress, req);
+        return 0;
+    }
+
+    ucp_trace_req(req, "send buffer registration completed, resume rts");
+    ucs_hlist_del(&ep->ext->proto_reqs, &req->send.list);
+    req->flags &= ~UCP_REQUEST_FLAG_RNDV_ASYNC_REG;
+    ucp_request_send(req);
+    return 1;
+}
+
+static int
+ucp_proto_rndv_rts_async_reg_filter(const ucs_callbackq_elem_t *elem,
+                                    void *arg)
+{
+    return (elem->cb == ucp_proto_rndv_rts_async_reg_progress) &&
+           (elem->arg == arg);
+}
+
+static void ucp_proto_rndv_rts_async_reg_cancel(ucp_request_t *req)
+{
+    ucp_ep_h ep                  = req->send.ep;
+    ucp_datatype_iter_t *dt_iter = &req->send.state.dt_iter;
+
+    ucp_trace_req(req, "cancel waiting for registration of memh %p",
+                  dt_iter->type.contig.memh);
+
+    ucs_callbackq_remove_oneshot(&ep->worker->uct->progress_q, req,
+                                 ucp_proto_rndv_rts_async_reg_filter, req);
+    ucs_hlist_del(&ep->ext->proto_reqs, &req->send.list);
+    req->flags &= ~UCP_REQUEST_FLAG_RNDV_ASYNC_REG;
+
+    /* Releasing a pending region cancels its registration */
+    ucp_memh_put(dt_iter->type.contig.memh);
+    dt_iter->type.contig.memh = NULL;
+}
+
 ucs_status_t ucp_proto_rndv_rts_reset(ucp_request_t *req)
 {
+    if (req->flags & UCP_REQUEST_FLAG_RNDV_ASYNC_REG) {
+        ucp_proto_rndv_rts_async_reg_cancel(req);
+    }
+
     if (req->flags & UCP_REQUEST_FLAG_PROTO_INITIALIZED) {
         ucs_assert(req->send.state.completed_size == 0);
     }
@@ -593,6 +647,61 @@ ucs_status_t ucp_proto_rndv_rts_reset(ucp_request_t *req)
     return ucp_proto_request_zcopy_id_reset(req);
 }
 
+ucs_status_t ucp_proto_rndv_rts_async_reg(ucp_request_t *req,
+                                          ucp_md_map_t md_map)
+{
+    static const unsigned uct_flags = UCT_MD_MEM_ACCESS_RMA |
+                                      UCT_MD_MEM_FLAG_HIDE_ERRORS;
+    ucp_datatype_iter_t *dt_iter    = &req->send.state.dt_iter;
+    ucp_worker_h worker             = req->send.ep->worker;
+    ucp_context_h context           = worker->context;
+    ucp_mem_h memh                  = dt_iter->type.contig.memh;
+    ucs_status_t status;
+
+    if (context->rcache == NULL) {
+        return UCS_OK;
+    }
+
+    if (memh == NULL) {
+        if ((dt_iter->length == 0) ||
+            (dt_iter->mem_info.type != UCS_MEMORY_TYPE_HOST) ||
+            (context->config.ext.reg_whole_alloc_bitmap &
+             UCS_BIT(UCS_MEMORY_TYPE_HOST))) {
+            return UCS_OK;
+        }
+
+        status = ucp_memh_get_async(context, dt_iter->type.contig.buffer,
+                                    dt_iter->length, dt_iter->mem_info.type,
+                                    md_map, uct_flags, "rndv_async", &memh);
+        if ((status != UCS_OK) && (status != UCS_INPROGRESS)) {
+            /* Fall back to registering the buffer in place */
+            return UCS_OK;
+        }
+
+        dt_iter->type.contig.memh = memh;
+    } else if (memh->parent != NULL) {
+        return UCS_OK; /* User-provided or zero-length memory handle */
+    }
+
+    status = ucp_memh_async_status(context, memh, md_map, uct_flags);
+    if (status == UCS_INPROGRESS) {
+        ucp_trace_req(req, "deferring rts until memh %p is registered", memh);
+        /* Track the request on the endpoint, so it is aborted if the endpoint
+         * is closed or fails before the registration completes */
+        req->flags |= UCP_REQUEST_FLAG_RNDV_ASYNC_REG;
+        ucs_hlist_add_tail(&req->send.ep->ext->proto_reqs, &req->send.list);
+        ucs_callbackq_add_oneshot(&worker->uct->progress_q, req,
+                                  ucp_proto_rndv_rts_async_reg_progress, req);
+        return UCS_INPROGRESS;
+    } else if (status != UCS_OK) {
+        /* Release the handle, the buffer is registered in place */
+        ucp_memh_put(memh);
+        dt_iter->type.contig.memh = NULL;
+    }
+
+    return UCS_OK;
+}
+
 ucs_status_t
 ucp_proto_rndv_ack_init(const ucp_proto_common_init_params_t *init_params,
                         const char *name, double overhead,
@@ -849,7 +958,7 @@ UCS_PROFILE_FUNC_VOID(ucp_proto_rndv_receive_start,
                                        rkey_buffer, rkey_length, sg_count);
     if (status != UCS_OK) {
         ucp_datatype_iter_cleanup(&req->send.state.dt_iter, 1, UCP_DT_MASK_ALL);
-        ucs_mpool_put(req);
+        ucp_request_put(req);
         return;
     }
 
@@ -168,6 +168,10 @@ void ucp_proto_rndv_rts_abort(ucp_request_t *req, ucs_status_t status);
 ucs_status_t ucp_proto_rndv_rts_reset(ucp_request_t *req);
 
 
+ucs_status_t ucp_proto_rndv_rts_async_reg(ucp_request_t *req,
+                                          ucp_md_map_t md_map);
+
+
 ucs_status_t
 ucp_proto_rndv_ack_init(const ucp_proto_common_init_params_t *init_params,
                         const char *name, double overhead,
@@ -46,6 +46,16 @@ ucp_proto_rndv_rts_request_init(ucp_request_t *req)
         return status;
     }
 
+    if ((req->send.state.dt_iter.dt_class == UCP_DATATYPE_CONTIG) &&
+        (req->send.state.dt_iter.length >=
+         ep->worker->context->config.ext.rndv_async_reg_thresh)) {
+        /* UCS_INPROGRESS means the request is resumed from worker progress */
+        status = ucp_proto_rndv_rts_async_reg(req, rpriv->md_map);
+        if (status != UCS_OK) {
+            return status;
+        }
+    }
+
     status = ucp_datatype_iter_mem_reg(ep->worker->context,
                                        &req->send.state.dt_iter,
                                        rpriv->md_map,
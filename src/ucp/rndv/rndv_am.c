@@ -170,7 +170,7 @@ static ucs_status_t ucp_rndv_am_zcopy_proto_progress(uct_pending_req_t *uct_req)
     /* coverity[tainted_data_downcast] */
     return ucp_proto_multi_zcopy_progress(req, req->send.proto_config->priv,
                                           NULL, UCT_MD_MEM_ACCESS_LOCAL_READ,
-                                          UCP_DT_MASK_CONTIG_IOV,
+                                          UCP_DT_MASK_ZCOPY,
                                           ucp_rndv_am_zcopy_send_func,
                                           ucp_rndv_am_zcopy_complete,
                                           ucp_proto_request_zcopy_completion);
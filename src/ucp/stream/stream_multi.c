@@ -137,7 +137,7 @@ static ucs_status_t ucp_stream_multi_zcopy_progress(uct_pending_req_t *uct_req)
     /* coverity[tainted_data_downcast] */
     return ucp_proto_multi_zcopy_progress(
             req, req->send.proto_config->priv, NULL,
-            UCT_MD_MEM_ACCESS_LOCAL_READ, UCP_DT_MASK_CONTIG_IOV,
+            UCT_MD_MEM_ACCESS_LOCAL_READ, UCP_DT_MASK_ZCOPY,
             ucp_stream_multi_zcopy_send_func,
             ucp_request_invoke_uct_completion_success,
             ucp_proto_request_zcopy_completion);
@@ -282,7 +282,7 @@ static ucs_status_t ucp_proto_eager_zcopy_multi_progress(uct_pending_req_t *self
     /* coverity[tainted_data_downcast] */
     return ucp_proto_multi_zcopy_progress(
             req, req->send.proto_config->priv, ucp_proto_msg_multi_request_init,
-            UCT_MD_MEM_ACCESS_LOCAL_READ, UCP_DT_MASK_CONTIG_IOV,
+            UCT_MD_MEM_ACCESS_LOCAL_READ, UCP_DT_MASK_ZCOPY,
             ucp_proto_eager_zcopy_multi_send_func,
             ucp_request_invoke_uct_completion_success,
             ucp_proto_request_zcopy_completion);
@@ -210,7 +210,9 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_rndv_offload_sw_proto_progress, (self),
     size_t rts_hdr_size;
 
     status = UCS_PROFILE_CALL(ucp_proto_rndv_rts_request_init, req);
-    if (status != UCS_OK) {
+    if (status == UCS_INPROGRESS) {
+        return UCS_OK; /* Resumed when the send buffer is registered */
+    } else if (status != UCS_OK) {
         ucp_proto_request_abort(req, status);
         return UCS_OK;
     }
@@ -12,9 +12,70 @@
 #include <ucp/tag/offload.h>
 
 
-ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
+#ifdef ENABLE_STATS
+static ucs_stats_class_t ucp_tag_match_stats_class = {
+    .name           = "tag_match",
+    .num_counters   = UCP_TAG_MATCH_STAT_LAST,
+    .class_id       = UCS_STATS_CLASS_ID_INVALID,
+    .counter_names  = {
+        [UCP_TAG_MATCH_STAT_EXP_SEARCH]       = "exp_search",
+        [UCP_TAG_MATCH_STAT_EXP_SEARCH_LEN]   = "exp_search_len",
+        [UCP_TAG_MATCH_STAT_UNEXP_SEARCH]     = "unexp_search",
+        [UCP_TAG_MATCH_STAT_UNEXP_SEARCH_LEN] = "unexp_search_len",
+        [UCP_TAG_MATCH_STAT_EXP_MATCH]        = "exp_match",
+        [UCP_TAG_MATCH_STAT_EXP_MATCH_TIME]   = "exp_match_time_ns",
+        [UCP_TAG_MATCH_STAT_UNEXP_MATCH]      = "unexp_match",
+        [UCP_TAG_MATCH_STAT_UNEXP_MATCH_TIME] = "unexp_match_time_ns",
+        [UCP_TAG_MATCH_STAT_UNEXP_ARRIVAL]    = "unexp_arrival",
+        [UCP_TAG_MATCH_STAT_UNEXP_DEPTH]      = "unexp_depth"
+    }
+};
+#endif
+
+static const char *ucp_tag_hist_names[] = {
+    [UCP_TAG_HIST_EXP_SEARCH_LEN]   = "exp_search_length",
+    [UCP_TAG_HIST_UNEXP_SEARCH_LEN] = "unexp_search_length",
+    [UCP_TAG_HIST_EXP_MATCH_TIME]   = "exp_match_time_ns",
+    [UCP_TAG_HIST_UNEXP_MATCH_TIME] = "unexp_match_time_ns",
+    [UCP_TAG_HIST_UNEXP_DEPTH]      = "unexp_queue_depth"
+};
+
+static ucs_mpool_ops_t ucp_tag_unexp_index_mpool_ops = {
+    .chunk_alloc   = ucs_mpool_chunk_malloc,
+    .chunk_release = ucs_mpool_chunk_free,
+    .obj_init      = NULL,
+    .obj_cleanup   = NULL,
+    .obj_str       = NULL
+};
+
+static ucs_list_link_t *ucp_tag_match_unexp_hash_alloc(size_t hash_size,
+                                                       const char *name)
+{
+    ucs_list_link_t *hash;
+    size_t bucket;
+
+    hash = ucs_malloc(sizeof(*hash) * hash_size, name);
+    if (hash == NULL) {
+        return NULL;
+    }
+
+    for (bucket = 0; bucket < hash_size; ++bucket) {
+        ucs_list_head_init(&hash[bucket]);
+    }
+
+    return hash;
+}
+
+ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm, uint64_t source_mask,
+                                int enable_hist
+                                UCS_STATS_ARG(ucs_stats_node_t *stats_parent))
 {
+    ucs_mpool_params_t mp_params;
     size_t hash_size, bucket;
+    ucs_status_t status;
+
+    /* Every histogram has a pair of statistics counters */
+    UCS_STATIC_ASSERT(UCP_TAG_MATCH_STAT_LAST == (2 * UCP_TAG_HIST_LAST));
 
     hash_size = ucs_roundup_pow2(UCP_TAG_MATCH_HASH_SIZE);
 
@@ -23,24 +84,60 @@ ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
     ucs_queue_head_init(&tm->expected.wildcard.queue);
     ucs_list_head_init(&tm->unexpected.all);
 
+    status = UCS_STATS_NODE_ALLOC(&tm->stats, &ucp_tag_match_stats_class,
+                                  stats_parent, "");
+    if (status != UCS_OK) {
+        return status;
+    }
+
     tm->expected.hash = ucs_malloc(sizeof(*tm->expected.hash) * hash_size,
                                    "ucp_tm_exp_hash");
     if (tm->expected.hash == NULL) {
-        return UCS_ERR_NO_MEMORY;
+        goto err_free_stats;
     }
 
-    tm->unexpected.hash = ucs_malloc(sizeof(*tm->unexpected.hash) * hash_size,
-                                     "ucp_tm_unexp_hash");
+    tm->unexpected.hash = ucp_tag_match_unexp_hash_alloc(hash_size,
+                                                         "ucp_tm_unexp_hash");
     if (tm->unexpected.hash == NULL) {
-        ucs_free(tm->expected.hash);
-        return UCS_ERR_NO_MEMORY;
+        goto err_free_exp_hash;
+    }
+
+    tm->unexpected.source_mask    = source_mask;
+    tm->unexpected.source_hash    = NULL;
+    tm->unexpected.nonsource_hash = NULL;
+    if (source_mask != 0) {
+        tm->unexpected.source_hash = ucp_tag_match_unexp_hash_alloc(
+                hash_size, "ucp_tm_unexp_source_hash");
+        if (tm->unexpected.source_hash == NULL) {
+            goto err_free_unexp_hash;
+        }
+
+        tm->unexpected.nonsource_hash = ucp_tag_match_unexp_hash_alloc(
+                hash_size, "ucp_tm_unexp_nonsource_hash");
+        if (tm->unexpected.nonsource_hash == NULL) {
+            goto err_free_unexp_source_hash;
+        }
+
+        ucs_mpool_params_reset(&mp_params);
+        mp_params.elem_size       = sizeof(ucp_tag_unexp_index_elem_t);
+        mp_params.elems_per_chunk = 128;
+        mp_params.ops             = &ucp_tag_unexp_index_mpool_ops;
+        mp_params.name            = "ucp_tm_unexp_index";
+        status = ucs_mpool_init(&mp_params, &tm->unexpected.index_mp);
+        if (status != UCS_OK) {
+            goto err_free_unexp_nonsource_hash;
+        }
+
+        kh_init_inplace(ucp_tag_unexp_index, &tm->unexpected.index);
+
+        ucs_debug("tag matching: unexpected messages indexed by source mask "
+                  "0x%" PRIx64, source_mask);
     }
 
     for (bucket = 0; bucket < hash_size; ++bucket) {
         tm->expected.hash[bucket].sw_count    = 0;
         tm->expected.hash[bucket].block_count = 0;
         ucs_queue_head_init(&tm->expected.hash[bucket].queue);
-        ucs_list_head_init(&tm->unexpected.hash[bucket]);
     }
 
     kh_init_inplace(ucp_tag_frag_hash, &tm->frag_hash);
@@ -50,7 +147,22 @@ ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm)
     tm->offload.zcopy_thresh = SIZE_MAX;
     tm->offload.iface        = NULL;
 
+    memset(&tm->hist, 0, sizeof(tm->hist));
+    tm->hist.enabled = enable_hist;
+
     return UCS_OK;
+
+err_free_unexp_nonsource_hash:
+    ucs_free(tm->unexpected.nonsource_hash);
+err_free_unexp_source_hash:
+    ucs_free(tm->unexpected.source_hash);
+err_free_unexp_hash:
+    ucs_free(tm->unexpected.hash);
+err_free_exp_hash:
+    ucs_free(tm->expected.hash);
+err_free_stats:
+    UCS_STATS_NODE_FREE(tm->stats);
+    return UCS_ERR_NO_MEMORY;
 }
 
 void ucp_tag_match_cleanup(ucp_tag_match_t *tm)
@@ -60,16 +172,173 @@ void ucp_tag_match_cleanup(ucp_tag_match_t *tm)
     ucs_list_for_each_safe(rdesc, tmp_rdesc, &tm->unexpected.all,
                            tag_list[UCP_RDESC_ALL_LIST]) {
         ucs_warn("unexpected tag-receive descriptor %p was not matched", rdesc);
-        ucp_tag_unexp_remove(rdesc);
+        ucp_tag_unexp_remove(tm, rdesc);
         ucp_recv_desc_release(rdesc);
     }
 
+    UCS_STATS_NODE_FREE(tm->stats);
     kh_destroy_inplace(ucp_tag_offload_hash, &tm->offload.tag_hash);
     kh_destroy_inplace(ucp_tag_frag_hash, &tm->frag_hash);
+    if (tm->unexpected.source_hash != NULL) {
+        kh_destroy_inplace(ucp_tag_unexp_index, &tm->unexpected.index);
+        ucs_mpool_cleanup(&tm->unexpected.index_mp, 1);
+    }
+    ucs_free(tm->unexpected.nonsource_hash);
+    ucs_free(tm->unexpected.source_hash);
     ucs_free(tm->unexpected.hash);
     ucs_free(tm->expected.hash);
 }
 
+static ucs_list_link_t *
+ucp_tag_unexp_index_source_list(ucp_tag_match_t *tm, ucp_tag_t tag)
+{
+    return &tm->unexpected.source_hash[
+            ucp_tag_match_calc_hash(tag & tm->unexpected.source_mask)];
+}
+
+static ucs_list_link_t *
+ucp_tag_unexp_index_nonsource_list(ucp_tag_match_t *tm, ucp_tag_t tag)
+{
+    return &tm->unexpected.nonsource_hash[
+            ucp_tag_match_calc_hash(tag & ~tm->unexpected.source_mask)];
+}
+
+static void ucp_tag_unexp_index_disable(ucp_tag_match_t *tm)
+{
+    ucp_tag_unexp_index_elem_t *elem;
+
+    ucs_warn("tag matching: failed to allocate unexpected messages index "
+             "entry, disabling the index");
+
+    kh_foreach_value(&tm->unexpected.index, elem, {
+        ucs_mpool_put(elem);
+    });
+    kh_clear(ucp_tag_unexp_index, &tm->unexpected.index);
+
+    /* Wildcard receives walk the full unexpected list from now on */
+    tm->unexpected.source_mask = 0;
+}
+
+void ucp_tag_unexp_index_add(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc,
+                             ucp_tag_t tag)
+{
+    ucp_tag_unexp_index_elem_t *elem;
+    khiter_t iter;
+    int ret;
+
+    elem = ucs_mpool_get(&tm->unexpected.index_mp);
+    if (elem == NULL) {
+        goto err_disable;
+    }
+
+    iter = kh_put(ucp_tag_unexp_index, &tm->unexpected.index,
+                  (uintptr_t)rdesc, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        ucs_mpool_put(elem);
+        goto err_disable;
+    }
+
+    ucs_assert(ret != UCS_KH_PUT_KEY_PRESENT);
+    kh_value(&tm->unexpected.index, iter) = elem;
+
+    elem->rdesc = rdesc;
+    ucs_list_add_tail(ucp_tag_unexp_index_source_list(tm, tag),
+                      &elem->source_list);
+    ucs_list_add_tail(ucp_tag_unexp_index_nonsource_list(tm, tag),
+                      &elem->nonsource_list);
+    return;
+
+err_disable:
+    ucp_tag_unexp_index_disable(tm);
+}
+
+void ucp_tag_unexp_index_remove(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc)
+{
+    ucp_tag_unexp_index_elem_t *elem;
+    khiter_t iter;
+
+    iter = kh_get(ucp_tag_unexp_index, &tm->unexpected.index,
+                  (uintptr_t)rdesc);
+    ucs_assert(iter != kh_end(&tm->unexpected.index));
+
+    elem = kh_value(&tm->unexpected.index, iter);
+    kh_del(ucp_tag_unexp_index, &tm->unexpected.index, iter);
+
+    ucs_list_del(&elem->source_list);
+    ucs_list_del(&elem->nonsource_list);
+    ucs_mpool_put(elem);
+}
+
+ucp_recv_desc_t *
+ucp_tag_unexp_index_search(ucp_tag_match_t *tm, ucp_tag_t tag,
+                           uint64_t tag_mask, int rem, const char *title)
+{
+    uint64_t source_mask = tm->unexpected.source_mask;
+    unsigned length      = 0;
+    ucp_tag_unexp_index_elem_t *elem;
+    ucp_recv_desc_t *rdesc;
+    ucs_list_link_t *list;
+    ucs_list_link_t *link;
+    size_t offset;
+
+    /* Every index list keeps the descriptors in arrival order, and contains
+     * all descriptors which may match the tag/mask. So the first match in the
+     * list is also the first match in the global unexpected queue. */
+    if ((tag_mask & source_mask) == source_mask) {
+        /* Specific source, wildcard in the other bits */
+        list   = ucp_tag_unexp_index_source_list(tm, tag);
+        offset = ucs_offsetof(ucp_tag_unexp_index_elem_t, source_list);
+    } else if ((tag_mask | source_mask) == UCP_TAG_MASK_FULL) {
+        /* Wildcard in the source bits only */
+        list   = ucp_tag_unexp_index_nonsource_list(tm, tag);
+        offset = ucs_offsetof(ucp_tag_unexp_index_elem_t, nonsource_list);
+    } else {
+        return ucp_tag_unexp_list_search(tm, &tm->unexpected.all,
+                                         UCP_RDESC_ALL_LIST, tag, tag_mask,
+                                         rem, title);
+    }
+
+    for (link = list->next; link != list; link = link->next) {
+        elem  = UCS_PTR_BYTE_OFFSET(link, -offset);
+        rdesc = elem->rdesc;
+        ++length;
+        if (ucp_tag_unexp_desc_is_match(rdesc, tag, tag_mask)) {
+            ucp_tag_unexp_desc_matched(tm, rdesc, tag, tag_mask, length, rem,
+                                       title);
+            return rdesc;
+        }
+    }
+
+    ucp_tag_unexp_search_done(tm, NULL, length);
+    return NULL;
+}
+
+const char *ucp_tag_hist_name(ucp_tag_hist_id_t id)
+{
+    return ucp_tag_hist_names[id];
+}
+
+void ucp_tag_hist_str(const ucp_tag_hist_t *hist, ucs_string_buffer_t *strb)
+{
+    unsigned bin;
+
+    for (bin = 0; bin < UCP_TAG_HIST_NUM_BINS; ++bin) {
+        if (hist->bins[bin] == 0) {
+            continue;
+        }
+
+        if (bin == 0) {
+            ucs_string_buffer_appendf(strb, "0");
+        } else if (bin == (UCP_TAG_HIST_NUM_BINS - 1)) {
+            ucs_string_buffer_appendf(strb, "%lu+", UCS_BIT(bin - 1));
+        } else {
+            ucs_string_buffer_appendf(strb, "%lu-%lu", UCS_BIT(bin - 1),
+                                      UCS_BIT(bin) - 1);
+        }
+        ucs_string_buffer_appendf(strb, ": %" PRIu64 "\n", hist->bins[bin]);
+    }
+}
+
 int ucp_tag_unexp_is_empty(ucp_tag_match_t *tm)
 {
     return ucs_list_is_empty(&tm->unexpected.all);
@@ -109,6 +378,7 @@ ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
     ucp_request_queue_t *queue;
     ucs_queue_iter_t hash_iter, wild_iter, *iter;
     uint64_t hash_sn, wild_sn, *sn_p;
+    unsigned length = 0;
     ucp_request_t *req;
 
     *hash_queue->ptail                 = NULL;
@@ -132,9 +402,11 @@ ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
         }
 
         req = ucs_container_of(**iter, ucp_request_t, recv.queue);
+        ++length;
         if (ucp_tag_is_match(tag, req->recv.tag.tag, req->recv.tag.tag_mask)) {
             ucs_trace_req("matched received tag %"PRIx64" to req %p", tag, req);
             ucp_tag_exp_delete(req, tm, queue, *iter);
+            ucp_tag_exp_search_done(tm, req, length);
             return req;
         }
 
@@ -146,6 +418,7 @@ ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                 "hash_seq=%"PRIu64" wild_seq=%"PRIu64, hash_sn, wild_sn);
     ucs_assert(ucs_queue_iter_end(hash_queue, hash_iter));
     ucs_assert(ucs_queue_iter_end(&tm->expected.wildcard.queue, wild_iter));
+    ucp_tag_exp_search_done(tm, NULL, length);
     return NULL;
 }
 
@@ -11,12 +11,17 @@
 #include <ucp/core/ucp_types.h>
 #include <ucs/datastruct/queue_types.h>
 #include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/list.h>
+#include <ucs/datastruct/mpool.h>
+#include <ucs/datastruct/string_buffer.h>
 #include <ucs/sys/compiler_def.h>
 #include <ucs/stats/stats.h>
 
 
 #define UCP_TAG_MASK_FULL     0xffffffffffffffffUL  /* All 1-s */
 
+#define UCP_TAG_HIST_NUM_BINS 32   /* Number of bins in tag-matching histograms */
+
 
 KHASH_INIT(ucp_tag_offload_hash, ucp_tag_t, ucp_worker_iface_t *, 1,
            kh_int64_hash_func, kh_int64_hash_equal);
@@ -55,6 +60,68 @@ KHASH_INIT(ucp_tag_frag_hash, uint64_t, ucp_tag_frag_match_t, 1,
            kh_int64_hash_func, kh_int64_hash_equal);
 
 
+/**
+ * Entry of the unexpected messages index by source. It is allocated only when
+ * the index is enabled, to keep the receive descriptor small.
+ */
+typedef struct {
+    ucs_list_link_t   source_list;    /* Element in a hash list by the source
+                                         bits of the tag */
+    ucs_list_link_t   nonsource_list; /* Element in a hash list by the
+                                         non-source bits of the tag */
+    ucp_recv_desc_t   *rdesc;         /* Indexed unexpected descriptor */
+} ucp_tag_unexp_index_elem_t;
+
+
+/* Map from unexpected descriptor to its index entry */
+KHASH_MAP_INIT_INT64(ucp_tag_unexp_index, ucp_tag_unexp_index_elem_t*);
+
+
+/**
+ * Tag-matching histograms
+ */
+typedef enum {
+    UCP_TAG_HIST_EXP_SEARCH_LEN,   /* Expected requests scanned by a search */
+    UCP_TAG_HIST_UNEXP_SEARCH_LEN, /* Unexpected messages scanned by a search */
+    UCP_TAG_HIST_EXP_MATCH_TIME,   /* Nanoseconds from posting a receive until
+                                      a message is matched to it */
+    UCP_TAG_HIST_UNEXP_MATCH_TIME, /* Nanoseconds from arrival of a message
+                                      until a receive is matched to it */
+    UCP_TAG_HIST_UNEXP_DEPTH,      /* Unexpected queue depth on arrival of
+                                      an unexpected message */
+    UCP_TAG_HIST_LAST
+} ucp_tag_hist_id_t;
+
+
+/**
+ * Tag-matching statistics counters, a pair of counters per histogram: number
+ * of samples and their sum.
+ */
+enum {
+    UCP_TAG_MATCH_STAT_EXP_SEARCH,
+    UCP_TAG_MATCH_STAT_EXP_SEARCH_LEN,
+    UCP_TAG_MATCH_STAT_UNEXP_SEARCH,
+    UCP_TAG_MATCH_STAT_UNEXP_SEARCH_LEN,
+    UCP_TAG_MATCH_STAT_EXP_MATCH,
+    UCP_TAG_MATCH_STAT_EXP_MATCH_TIME,
+    UCP_TAG_MATCH_STAT_UNEXP_MATCH,
+    UCP_TAG_MATCH_STAT_UNEXP_MATCH_TIME,
+    UCP_TAG_MATCH_STAT_UNEXP_ARRIVAL,
+    UCP_TAG_MATCH_STAT_UNEXP_DEPTH,
+    UCP_TAG_MATCH_STAT_LAST
+};
+
+
+/**
+ * Histogram with power-of-2 bins: bin 0 counts zero values, and bin i > 0
+ * counts values in the range [2^(i-1), 2^i). The last bin also counts all
+ * larger values.
+ */
+typedef struct {
+    uint64_t              bins[UCP_TAG_HIST_NUM_BINS];
+} ucp_tag_hist_t;
+
+
 /**
  * Tag-matching context
  */
@@ -73,6 +140,19 @@ typedef struct ucp_tag_match {
     struct {
         ucs_list_link_t       all;        /* Linked list of all tags */
         ucs_list_link_t       *hash;      /* Hash table of unexpected tags */
+        uint64_t              source_mask; /* Tag bits which identify the
+                                              sender, 0 if source indexing
+                                              is disabled */
+        ucs_list_link_t       *source_hash; /* Hash table of unexpected tags,
+                                               by the source bits, used to
+                                               match any-tag receives */
+        ucs_list_link_t       *nonsource_hash; /* Hash table of unexpected
+                                                  tags, by the non-source bits,
+                                                  used to match any-source
+                                                  receives */
+        ucs_mpool_t           index_mp;   /* Memory pool of index entries */
+        khash_t(ucp_tag_unexp_index) index; /* Index entries of unexpected
+                                               descriptors */
     } unexpected;
 
     /* Hash for fragment assembly, the key is a globally unique tag message id */
@@ -98,10 +178,21 @@ typedef struct ucp_tag_match {
                                                    'thresh' configuration. */
     } offload;
 
+    /* Instrumentation, collected only if enabled by configuration */
+    struct {
+        int                   enabled;
+        unsigned              unexp_count;      /* Unexpected queue depth */
+        ucp_tag_hist_t        h[UCP_TAG_HIST_LAST];
+    } hist;
+
+    UCS_STATS_NODE_DECLARE(stats)
+
 } ucp_tag_match_t;
 
 
-ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm);
+ucs_status_t ucp_tag_match_init(ucp_tag_match_t *tm, uint64_t source_mask,
+                                int enable_hist
+                                UCS_STATS_ARG(ucs_stats_node_t *stats_parent));
 
 void ucp_tag_match_cleanup(ucp_tag_match_t *tm);
 
@@ -109,10 +200,23 @@ int ucp_tag_exp_remove(ucp_tag_match_t *tm, ucp_request_t *req);
 
 int ucp_tag_unexp_is_empty(ucp_tag_match_t *tm);
 
+void ucp_tag_unexp_index_add(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc,
+                             ucp_tag_t tag);
+
+void ucp_tag_unexp_index_remove(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc);
+
+ucp_recv_desc_t *
+ucp_tag_unexp_index_search(ucp_tag_match_t *tm, ucp_tag_t tag,
+                           uint64_t tag_mask, int rem, const char *title);
+
 ucp_request_t*
 ucp_tag_exp_search_all(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                        ucp_tag_t tag);
 
+const char *ucp_tag_hist_name(ucp_tag_hist_id_t id);
+
+void ucp_tag_hist_str(const ucp_tag_hist_t *hist, ucs_string_buffer_t *strb);
+
 void ucp_tag_frag_list_process_queue(ucp_tag_match_t *tm, ucp_request_t *req,
                                      uint64_t msg_id
                                      UCS_STATS_ARG(int counter_idx));
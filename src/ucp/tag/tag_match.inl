@@ -18,6 +18,7 @@
 #include <ucs/debug/log.h>
 #include <ucs/datastruct/queue.h>
 #include <ucs/datastruct/mpool.inl>
+#include <ucs/time/time.h>
 #include <inttypes.h>
 
 
@@ -25,6 +26,58 @@
  * and small enough to fit L1 cache. */
 #define UCP_TAG_MATCH_HASH_SIZE     1021
 
+/* Resolution of timestamps used for histograms: time is kept as 32-bit value
+ * in units of 2^shift ticks of ucs_get_time() */
+#define UCP_TAG_MATCH_TIME_SHIFT    10
+
+
+static UCS_F_ALWAYS_INLINE int
+ucp_tag_match_hist_is_enabled(const ucp_tag_match_t *tm)
+{
+    return tm->hist.enabled;
+}
+
+static UCS_F_ALWAYS_INLINE uint32_t ucp_tag_match_timestamp()
+{
+    return ucs_get_time() >> UCP_TAG_MATCH_TIME_SHIFT;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_tag_match_hist_add(ucp_tag_match_t *tm, ucp_tag_hist_id_t id,
+                       uint64_t value)
+{
+    unsigned bin = (value == 0) ? 0 : (ucs_ilog2(value) + 1);
+
+    ++tm->hist.h[id].bins[ucs_min(bin, UCP_TAG_HIST_NUM_BINS - 1)];
+    UCS_STATS_UPDATE_COUNTER(tm->stats, (2 * id), 1);
+    UCS_STATS_UPDATE_COUNTER(tm->stats, (2 * id) + 1, value);
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_tag_match_hist_add_time(ucp_tag_match_t *tm, ucp_tag_hist_id_t id,
+                            uint32_t timestamp)
+{
+    uint32_t elapsed = ucp_tag_match_timestamp() - timestamp;
+
+    ucp_tag_match_hist_add(tm, id, ucs_time_to_nsec(
+            (ucs_time_t)elapsed << UCP_TAG_MATCH_TIME_SHIFT));
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_tag_exp_search_done(ucp_tag_match_t *tm, ucp_request_t *req,
+                        unsigned length)
+{
+    if (ucs_likely(!ucp_tag_match_hist_is_enabled(tm))) {
+        return;
+    }
+
+    ucp_tag_match_hist_add(tm, UCP_TAG_HIST_EXP_SEARCH_LEN, length);
+    if (req != NULL) {
+        ucp_tag_match_hist_add_time(tm, UCP_TAG_HIST_EXP_MATCH_TIME,
+                                    req->recv.tag.post_time);
+    }
+}
+
 
 static UCS_F_ALWAYS_INLINE
 int ucp_tag_is_specific_source(ucp_context_t *context, ucp_tag_t tag_mask)
@@ -77,6 +130,9 @@ ucp_tag_exp_push(ucp_tag_match_t *tm, ucp_request_queue_t *req_queue,
                  ucp_request_t *req)
 {
     req->recv.tag.sn = tm->expected.sn++;
+    if (ucs_unlikely(ucp_tag_match_hist_is_enabled(tm))) {
+        req->recv.tag.post_time = ucp_tag_match_timestamp();
+    }
     ucs_queue_push(&req_queue->queue, &req->recv.queue);
 }
 
@@ -100,6 +156,7 @@ ucp_tag_exp_search(ucp_tag_match_t *tm, ucp_tag_t tag)
     ucp_request_queue_t *req_queue;
     ucs_queue_iter_t iter;
     ucp_request_t *req;
+    unsigned length;
 
     if (ucs_unlikely(!ucs_queue_is_empty(&tm->expected.wildcard.queue))) {
         req_queue = ucp_tag_exp_get_queue_for_tag(tm, tag);
@@ -107,17 +164,22 @@ ucp_tag_exp_search(ucp_tag_match_t *tm, ucp_tag_t tag)
     }
 
     /* fast path - wildcard queue is empty, search only the specific queue */
+    length    = 0;
     req_queue = ucp_tag_exp_get_queue_for_tag(tm, tag);
     ucs_queue_for_each_safe(req, iter, &req_queue->queue, recv.queue) {
         req = ucs_container_of(*iter, ucp_request_t, recv.queue);
         ucs_trace_data("checking req %p tag %"PRIx64"/%"PRIx64" with tag %"PRIx64,
                        req, req->recv.tag.tag, req->recv.tag.tag_mask, tag);
+        ++length;
         if (ucp_tag_is_match(tag, req->recv.tag.tag, req->recv.tag.tag_mask)) {
             ucs_trace_req("matched received tag %"PRIx64" to req %p", tag, req);
             ucp_tag_exp_delete(req, tm, req_queue, iter);
+            ucp_tag_exp_search_done(tm, req, length);
             return req;
         }
     }
+
+    ucp_tag_exp_search_done(tm, NULL, length);
     return NULL;
 }
 
@@ -132,11 +194,24 @@ ucp_tag_unexp_get_list_for_tag(ucp_tag_match_t *tm, ucp_tag_t tag)
     return &tm->unexpected.hash[ucp_tag_match_calc_hash(tag)];
 }
 
+static UCS_F_ALWAYS_INLINE int
+ucp_tag_unexp_is_source_indexed(ucp_tag_match_t *tm)
+{
+    return tm->unexpected.source_mask != 0;
+}
+
 static UCS_F_ALWAYS_INLINE void
-ucp_tag_unexp_remove(ucp_recv_desc_t *rdesc)
+ucp_tag_unexp_remove(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc)
 {
     ucs_list_del(&rdesc->tag_list[UCP_RDESC_HASH_LIST]);
     ucs_list_del(&rdesc->tag_list[UCP_RDESC_ALL_LIST] );
+    if (ucs_unlikely(ucp_tag_unexp_is_source_indexed(tm))) {
+        ucp_tag_unexp_index_remove(tm, rdesc);
+    }
+    if (ucs_unlikely(ucp_tag_match_hist_is_enabled(tm))) {
+        ucs_assert(tm->hist.unexp_count > 0);
+        --tm->hist.unexp_count;
+    }
 }
 
 static UCS_F_ALWAYS_INLINE void
@@ -147,11 +222,34 @@ ucp_tag_unexp_recv(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc, ucp_tag_t tag)
     hash_list = ucp_tag_unexp_get_list_for_tag(tm, tag);
     ucs_list_add_tail(hash_list,           &rdesc->tag_list[UCP_RDESC_HASH_LIST]);
     ucs_list_add_tail(&tm->unexpected.all, &rdesc->tag_list[UCP_RDESC_ALL_LIST]);
+    if (ucs_unlikely(ucp_tag_unexp_is_source_indexed(tm))) {
+        ucp_tag_unexp_index_add(tm, rdesc, tag);
+    }
+    if (ucs_unlikely(ucp_tag_match_hist_is_enabled(tm))) {
+        rdesc->timestamp = ucp_tag_match_timestamp();
+        ucp_tag_match_hist_add(tm, UCP_TAG_HIST_UNEXP_DEPTH,
+                               tm->hist.unexp_count++);
+    }
 
     ucs_trace_req("unexp "UCP_RECV_DESC_FMT" tag %"PRIx64,
                   UCP_RECV_DESC_ARG(rdesc), tag);
 }
 
+static UCS_F_ALWAYS_INLINE void
+ucp_tag_unexp_search_done(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc,
+                          unsigned length)
+{
+    if (ucs_likely(!ucp_tag_match_hist_is_enabled(tm))) {
+        return;
+    }
+
+    ucp_tag_match_hist_add(tm, UCP_TAG_HIST_UNEXP_SEARCH_LEN, length);
+    if (rdesc != NULL) {
+        ucp_tag_match_hist_add_time(tm, UCP_TAG_HIST_UNEXP_MATCH_TIME,
+                                    rdesc->timestamp);
+    }
+}
+
 static UCS_F_ALWAYS_INLINE ucp_recv_desc_t*
 ucp_tag_unexp_list_next(ucp_recv_desc_t *rdesc, int i_list)
 {
@@ -159,6 +257,63 @@ ucp_tag_unexp_list_next(ucp_recv_desc_t *rdesc, int i_list)
                          tag_list[i_list]);
 }
 
+static UCS_F_ALWAYS_INLINE int
+ucp_tag_unexp_desc_is_match(ucp_recv_desc_t *rdesc, ucp_tag_t tag,
+                            uint64_t tag_mask)
+{
+    ucs_trace_req("searching for tag %"PRIx64"/%"PRIx64" "
+                  "checking "UCP_RECV_DESC_FMT" tag %"PRIx64,
+                  tag, tag_mask, UCP_RECV_DESC_ARG(rdesc),
+                  ucp_rdesc_get_tag(rdesc));
+    return ucp_tag_is_match(ucp_rdesc_get_tag(rdesc), tag, tag_mask);
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_tag_unexp_desc_matched(ucp_tag_match_t *tm, ucp_recv_desc_t *rdesc,
+                           ucp_tag_t tag, uint64_t tag_mask, unsigned length,
+                           int rem, const char *title)
+{
+    ucs_trace_req("matched unexp " UCP_RECV_DESC_FMT " to "
+                  "%s tag %"PRIx64"/%"PRIx64, UCP_RECV_DESC_ARG(rdesc),
+                  title, tag, tag_mask);
+    ucp_tag_unexp_search_done(tm, rem ? rdesc : NULL, length);
+    if (rem) {
+        ucp_tag_unexp_remove(tm, rdesc);
+    }
+}
+
+/* search one list of the unexpected queue for tag/mask, if found return the
+ * received desc, otherwise return NULL
+ */
+static UCS_F_ALWAYS_INLINE ucp_recv_desc_t*
+ucp_tag_unexp_list_search(ucp_tag_match_t *tm, ucs_list_link_t *list,
+                          int i_list, ucp_tag_t tag, uint64_t tag_mask,
+                          int rem, const char *title)
+{
+    unsigned length = 0;
+    ucp_recv_desc_t *rdesc;
+
+    if (ucs_list_is_empty(list)) {
+        ucp_tag_unexp_search_done(tm, NULL, 0);
+        return NULL;
+    }
+
+    rdesc = ucs_list_head(list, ucp_recv_desc_t, tag_list[i_list]);
+    do {
+        ++length;
+        if (ucp_tag_unexp_desc_is_match(rdesc, tag, tag_mask)) {
+            ucp_tag_unexp_desc_matched(tm, rdesc, tag, tag_mask, length, rem,
+                                       title);
+            return rdesc;
+        }
+
+        rdesc = ucp_tag_unexp_list_next(rdesc, i_list);
+    } while (&rdesc->tag_list[i_list] != list);
+
+    ucp_tag_unexp_search_done(tm, NULL, length);
+    return NULL;
+}
+
 /* search unexpected queue for tag/mask, if found return the received desc,
  * otherwise return NULL
  */
@@ -166,46 +321,27 @@ static UCS_F_ALWAYS_INLINE ucp_recv_desc_t*
 ucp_tag_unexp_search(ucp_tag_match_t *tm, ucp_tag_t tag, uint64_t tag_mask,
                      int rem, const char *title)
 {
-    ucp_recv_desc_t *rdesc;
     ucs_list_link_t *list;
     int i_list;
 
     /* fast check of global unexpected queue */
     if (ucs_list_is_empty(&tm->unexpected.all)) {
+        ucp_tag_unexp_search_done(tm, NULL, 0);
         return NULL;
     }
 
     if (tag_mask == UCP_TAG_MASK_FULL) {
-        list = ucp_tag_unexp_get_list_for_tag(tm, tag);
-        if (ucs_list_is_empty(list)) {
-            return NULL;
-        }
+        list   = ucp_tag_unexp_get_list_for_tag(tm, tag);
         i_list = UCP_RDESC_HASH_LIST;
+    } else if (ucs_unlikely(ucp_tag_unexp_is_source_indexed(tm))) {
+        return ucp_tag_unexp_index_search(tm, tag, tag_mask, rem, title);
     } else {
         list   = &tm->unexpected.all;
         i_list = UCP_RDESC_ALL_LIST;
     }
 
-    rdesc = ucs_list_head(list, ucp_recv_desc_t, tag_list[i_list]);
-    do {
-        ucs_trace_req("searching for tag %"PRIx64"/%"PRIx64" "
-                      "checking "UCP_RECV_DESC_FMT" tag %"PRIx64,
-                      tag, tag_mask, UCP_RECV_DESC_ARG(rdesc),
-                      ucp_rdesc_get_tag(rdesc));
-        if (ucp_tag_is_match(ucp_rdesc_get_tag(rdesc), tag, tag_mask)) {
-            ucs_trace_req("matched unexp " UCP_RECV_DESC_FMT " to "
-                          "%s tag %"PRIx64"/%"PRIx64, UCP_RECV_DESC_ARG(rdesc),
-                          title, tag, tag_mask);
-            if (rem) {
-                ucp_tag_unexp_remove(rdesc);
-            }
-            return rdesc;
-        }
-
-        rdesc = ucp_tag_unexp_list_next(rdesc, i_list);
-    } while (&rdesc->tag_list[i_list] != list);
-
-    return NULL;
+    return ucp_tag_unexp_list_search(tm, list, i_list, tag, tag_mask, rem,
+                                     title);
 }
 
 static UCS_F_ALWAYS_INLINE void
@@ -137,7 +137,9 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_rndv_rts_progress, (self),
     max_rts_size = sizeof(ucp_rndv_rts_hdr_t) + rpriv->packed_rkey_size;
 
     status = UCS_PROFILE_CALL(ucp_proto_rndv_rts_request_init, req);
-    if (status != UCS_OK) {
+    if (status == UCS_INPROGRESS) {
+        return UCS_OK; /* Resumed when the send buffer is registered */
+    } else if (status != UCS_OK) {
         ucp_proto_request_abort(req, status);
         return UCS_OK;
     }
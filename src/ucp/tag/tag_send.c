@@ -37,6 +37,7 @@ ucp_tag_get_rndv_threshold(const ucp_request_t *req, size_t count,
         /* Fall through */
     case UCP_DATATYPE_CONTIG:
         return ucs_min(rndv_rma_thresh, rndv_am_thresh);
+    case UCP_DATATYPE_STRIDED:
     case UCP_DATATYPE_GENERIC:
         return rndv_am_thresh;
     default:
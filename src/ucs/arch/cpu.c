@@ -13,6 +13,7 @@
 
 #include <ucs/arch/cpu.h>
 #include <ucs/arch/generic/cpu.h>
+#include <ucs/config/global_opts.h>
 #include <ucs/sys/sys.h>
 #include <ucs/sys/string.h>
 #include <ucs/sys/stubs.h>
@@ -158,6 +159,46 @@ size_t ucs_cpu_get_cache_size(ucs_cpu_cache_type_t type)
     return ucs_cpu_cache_size[type];
 }
 
+static size_t ucs_cpu_shm_nt_copy_thresh(size_t user_val, unsigned llc_div)
+{
+    size_t llc_size;
+
+    if (user_val != UCS_MEMUNITS_AUTO) {
+        return user_val;
+    }
+
+    llc_size = ucs_cpu_get_cache_size(UCS_CPU_CACHE_L3);
+    if (!UCS_ARCH_HAVE_MEMCPY_NT_STORE || (llc_size == 0)) {
+        return UCS_MEMUNITS_INF;
+    }
+
+    return llc_size / llc_div;
+}
+
+void ucs_cpu_shm_copy_init()
+{
+    ucs_global_opts.shm_nt_copy_local_thresh =
+            ucs_cpu_shm_nt_copy_thresh(ucs_global_opts.shm_nt_copy_local_thresh,
+                                       2);
+    ucs_global_opts.shm_nt_copy_remote_thresh =
+            ucs_cpu_shm_nt_copy_thresh(ucs_global_opts.shm_nt_copy_remote_thresh,
+                                       8);
+}
+
+void ucs_memcpy_shm(void *dst, const void *src, size_t len, size_t total_len,
+                    int remote_numa)
+{
+    size_t nt_thresh = remote_numa ?
+                       ucs_global_opts.shm_nt_copy_remote_thresh :
+                       ucs_global_opts.shm_nt_copy_local_thresh;
+
+    if (total_len >= nt_thresh) {
+        ucs_arch_memcpy_nt_store(dst, src, len);
+    } else {
+        ucs_memcpy_relaxed(dst, src, len, UCS_ARCH_MEMCPY_NT_DEST, total_len);
+    }
+}
+
 const char *ucs_cpu_vendor_name()
 {
     static const char *cpu_vendor_names[] = {
@@ -17,6 +17,7 @@
 
 #include <ucs/sys/compiler_def.h>
 #include <stddef.h>
+#include <string.h>
 
 BEGIN_C_DECLS
 
@@ -169,6 +170,42 @@ static inline int ucs_cpu_prefer_relaxed_order()
 }
 
 
+#ifndef UCS_ARCH_HAVE_MEMCPY_NT_STORE
+#define UCS_ARCH_HAVE_MEMCPY_NT_STORE 0
+
+static UCS_F_ALWAYS_INLINE void
+ucs_arch_memcpy_nt_store(void *dst, const void *src, size_t len)
+{
+    memcpy(dst, src, len);
+}
+#endif
+
+
+/**
+ * Resolve the message size thresholds of @ref ucs_memcpy_shm according to the
+ * last level cache size.
+ */
+void ucs_cpu_shm_copy_init();
+
+
+/**
+ * Copy data to a shared memory buffer which is consumed by another process.
+ * Large messages are written with non-temporal stores: the receiver reads them
+ * from memory anyway, and writing them through the cache of the sender would
+ * evict its working set. The size threshold is lower when the receiver runs on
+ * another NUMA node, since the cache of the sender is even less useful then.
+ * Smaller messages are copied with @ref UCS_ARCH_MEMCPY_NT_DEST hint.
+ *
+ * @param dst          Destination buffer in shared memory.
+ * @param src          Source buffer.
+ * @param len          Length of the data to copy.
+ * @param total_len    Total length of the message which the data belongs to.
+ * @param remote_numa  Whether the receiver runs on another NUMA node.
+ */
+void ucs_memcpy_shm(void *dst, const void *src, size_t len, size_t total_len,
+                    int remote_numa);
+
+
 #define UCS_CPU_VENDOR_LABEL "CPU vendor"
 #define UCS_CPU_MODEL_LABEL  "CPU model"
 
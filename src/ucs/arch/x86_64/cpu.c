@@ -19,6 +19,8 @@
 #include <ucs/sys/sys.h>
 #include <ucs/sys/string.h>
 
+#include <emmintrin.h>
+
 #define X86_CPUID_GENUINEINTEL    "GenuntelineI" /* GenuineIntel in magic notation */
 #define X86_CPUID_AUTHENTICAMD    "AuthcAMDenti" /* AuthenticAMD in magic notation */
 #define X86_CPUID_CENTAURHAULS    "CentaulsaurH" /* CentaurHauls in magic notation */
@@ -1224,4 +1226,58 @@ void ucs_x86_memcpy_sse_movntdqa(void *dst, const void *src, size_t len)
 #endif
 }
 
+void ucs_x86_memcpy_sse_movntdq(void *dst, const void *src, size_t len)
+{
+    size_t head = -(uintptr_t)dst & 15;
+    __m128i *D;
+
+    if (len < (head + 64)) {
+        memcpy(dst, src, len);
+        return;
+    }
+
+    /* Copy unaligned portion of dst */
+    memcpy(dst, src, head);
+    src  = UCS_PTR_BYTE_OFFSET(src, head);
+    dst  = UCS_PTR_BYTE_OFFSET(dst, head);
+    len -= head;
+
+    /* Copy 64 bytes at a time, bypassing the cache on the destination side */
+    while (len >= 64) {
+        const __m128i *S = (const __m128i*)src;
+        __m128i tmp[4];
+
+        D      = (__m128i*)dst;
+        tmp[0] = _mm_loadu_si128(S + 0);
+        tmp[1] = _mm_loadu_si128(S + 1);
+        tmp[2] = _mm_loadu_si128(S + 2);
+        tmp[3] = _mm_loadu_si128(S + 3);
+
+        _mm_stream_si128(D + 0, tmp[0]);
+        _mm_stream_si128(D + 1, tmp[1]);
+        _mm_stream_si128(D + 2, tmp[2]);
+        _mm_stream_si128(D + 3, tmp[3]);
+
+        src  = UCS_PTR_BYTE_OFFSET(src, 64);
+        dst  = UCS_PTR_BYTE_OFFSET(dst, 64);
+        len -= 64;
+    }
+
+    /* Copy 16 bytes at a time */
+    while (len >= 16) {
+        D = (__m128i*)dst;
+        _mm_stream_si128(D, _mm_loadu_si128((const __m128i*)src));
+
+        src  = UCS_PTR_BYTE_OFFSET(src, 16);
+        dst  = UCS_PTR_BYTE_OFFSET(dst, 16);
+        len -= 16;
+    }
+
+    memcpy(dst, src, len);
+
+    /* Non-temporal stores are weakly ordered, make them visible before any
+     * following store which may publish the data to another process */
+    _mm_sfence();
+}
+
 #endif
@@ -53,6 +53,7 @@ ucs_cpu_vendor_t ucs_arch_get_cpu_vendor();
 void ucs_cpu_init();
 ucs_status_t ucs_arch_get_cache_size(size_t *cache_sizes);
 void ucs_x86_memcpy_sse_movntdqa(void *dst, const void *src, size_t len);
+void ucs_x86_memcpy_sse_movntdq(void *dst, const void *src, size_t len);
 void ucs_x86_nt_buffer_transfer(void *dst, const void *src,
                                 size_t len, ucs_arch_memcpy_hint_t hint,
                                 size_t total_len);
@@ -132,6 +133,14 @@ ucs_memcpy_nontemporal(void *dst, const void *src, size_t len)
     ucs_x86_memcpy_sse_movntdqa(dst, src, len);
 }
 
+#define UCS_ARCH_HAVE_MEMCPY_NT_STORE 1
+
+static UCS_F_ALWAYS_INLINE void
+ucs_arch_memcpy_nt_store(void *dst, const void *src, size_t len)
+{
+    ucs_x86_memcpy_sse_movntdq(dst, src, len);
+}
+
 END_C_DECLS
 
 #endif
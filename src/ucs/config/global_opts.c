@@ -58,7 +58,9 @@ ucs_global_opts_t ucs_global_opts = {
     .modules               = { {NULL, 0}, UCS_CONFIG_ALLOW_LIST_ALLOW_ALL },
     .arch                  = UCS_ARCH_GLOBAL_OPTS_INITALIZER,
     .rcache_stat_min       = 0,
-    .rcache_stat_max       = 0
+    .rcache_stat_max       = 0,
+    .shm_nt_copy_local_thresh  = UCS_MEMUNITS_AUTO,
+    .shm_nt_copy_remote_thresh = UCS_MEMUNITS_AUTO
 };
 
 static const char *ucs_handle_error_modes[] = {
@@ -336,6 +338,20 @@ static ucs_config_field_t ucs_global_opts_read_only_table[] = {
   "bucket.\nRounded up to the next power-of-2 value.",
   ucs_offsetof(ucs_global_opts_t, rcache_stat_max), UCS_CONFIG_TYPE_MEMUNITS},
 
+ {"SHM_NT_COPY_LOCAL_THRESH", "auto",
+  "Minimal message size for copying data to shared memory with non-temporal\n"
+  "stores, which bypass the cache of the sender, when the receiver runs on the\n"
+  "same NUMA node. \"auto\" selects half of the last level cache size.",
+  ucs_offsetof(ucs_global_opts_t, shm_nt_copy_local_thresh),
+  UCS_CONFIG_TYPE_MEMUNITS},
+
+ {"SHM_NT_COPY_REMOTE_THRESH", "auto",
+  "Minimal message size for copying data to shared memory with non-temporal\n"
+  "stores, which bypass the cache of the sender, when the receiver runs on\n"
+  "another NUMA node. \"auto\" selects 1/8 of the last level cache size.",
+  ucs_offsetof(ucs_global_opts_t, shm_nt_copy_remote_thresh),
+  UCS_CONFIG_TYPE_MEMUNITS},
+
  {"", "", NULL,
   ucs_offsetof(ucs_global_opts_t, arch),
   UCS_CONFIG_TYPE_TABLE(ucs_arch_global_opts_table)},
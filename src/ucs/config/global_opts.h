@@ -152,6 +152,11 @@ typedef struct {
     size_t                     rcache_stat_min;
     size_t                     rcache_stat_max;
 
+    /* Minimal message size for copying to shared memory with non-temporal
+       stores, when the receiver runs on the same or on another NUMA node */
+    size_t                     shm_nt_copy_local_thresh;
+    size_t                     shm_nt_copy_remote_thresh;
+
     /* Estimated latency and bandwidth between devices according to distance
        within the sysfs device tree */
     struct {
@@ -16,6 +16,7 @@
 #include <ucs/datastruct/array.h>
 #include <ucs/datastruct/hlist.h>
 #include <ucs/datastruct/khash.h>
+#include <ucs/datastruct/string_buffer.h>
 #include <ucs/debug/assert.h>
 #include <ucs/debug/debug_int.h>
 #include <ucs/sys/sys.h>
@@ -26,14 +27,45 @@
 /* Reserve one slot for proxy callback */
 #define UCS_CALLBACKQ_FAST_MAX (UCS_CALLBACKQ_FAST_COUNT - 1)
 
+/* In statistics-enabled builds, count calls and events of all callbacks */
+#ifdef ENABLE_STATS
+#  define UCS_CALLBACKQ_ACCOUNT_ALL 1
+#  define UCS_CALLBACKQ_COUNTER_ADD(_account, _name, _value) \
+      (_account)->_name += (_value)
+#else
+#  define UCS_CALLBACKQ_ACCOUNT_ALL 0
+#  define UCS_CALLBACKQ_COUNTER_ADD(_account, _name, _value)
+#endif
+
 /*
  * Callback element in the spill array
  */
 typedef struct ucs_callbackq_spill_elem {
     ucs_callbackq_elem_t super;
     int                  id;
+    ucs_callbackq_prio_t prio;
 } ucs_callbackq_spill_elem_t;
 
+/*
+ * Accounting context of a callback, which is dispatched through
+ * ucs_callbackq_account_proxy()
+ */
+typedef struct ucs_callbackq_account {
+    ucs_callbackq_elem_t super;      /* User callback and argument */
+    ucs_list_link_t      list;       /* Entry in active or removed list */
+    ucs_callbackq_prio_t prio;       /* Callback priority */
+    unsigned             flags;      /* UCS_CALLBACKQ_ELEM_FLAG_xx */
+    unsigned             idle_count; /* Number of consecutive idle calls */
+    unsigned             backoff;    /* Number of rounds to skip after the
+                                        next idle call */
+    unsigned             skip_count; /* Remaining rounds to skip */
+#ifdef ENABLE_STATS
+    uint64_t             num_calls;  /* Total number of calls */
+    uint64_t             num_events; /* Sum of callback return values */
+    uint64_t             num_skips;  /* Total number of skipped rounds */
+#endif
+} ucs_callbackq_account_t;
+
 /*
  * One-shot element in the hash table
  */
@@ -56,6 +88,9 @@ struct ucs_callbackq_priv {
     /* IDs of fast-path callbacks */
     int                                               fast_ids[UCS_CALLBACKQ_FAST_COUNT];
 
+    /* Priorities of fast-path callbacks, in non-decreasing order */
+    ucs_callbackq_prio_t                              fast_prios[UCS_CALLBACKQ_FAST_COUNT];
+
     /* Number of fast-path elements */
     unsigned                                          num_fast_elems;
 
@@ -76,6 +111,20 @@ struct ucs_callbackq_priv {
 
     /* ID of oneshot-path proxy in fast-path array */
     int                                               proxy_cb_id;
+
+    /* Accounting contexts of callbacks in the queue */
+    ucs_list_link_t                                   accounts;
+
+    /* Accounting contexts of removed callbacks, released by the proxy since
+       they may still be in use by the dispatching thread */
+    ucs_list_link_t                                   removed_accounts;
+};
+
+
+static const char *ucs_callbackq_prio_names[] = {
+    [UCS_CALLBACKQ_PRIO_HIGH]   = "high",
+    [UCS_CALLBACKQ_PRIO_NORMAL] = "normal",
+    [UCS_CALLBACKQ_PRIO_LOW]    = "low"
 };
 
 
@@ -112,6 +161,102 @@ static void ucs_callbackq_elem_reset(ucs_callbackq_t *cbq, unsigned idx)
     ucs_callbackq_fast_elem_set(cbq, idx, NULL, cbq, UCS_CALLBACKQ_ID_NULL);
 }
 
+static unsigned ucs_callbackq_account_proxy(void *arg)
+{
+    ucs_callbackq_account_t *account = arg;
+    unsigned count;
+
+    if (account->skip_count > 0) {
+        --account->skip_count;
+        UCS_CALLBACKQ_COUNTER_ADD(account, num_skips, 1);
+        return 0;
+    }
+
+    count = account->super.cb(account->super.arg);
+    UCS_CALLBACKQ_COUNTER_ADD(account, num_calls, 1);
+
+    if (count > 0) {
+        UCS_CALLBACKQ_COUNTER_ADD(account, num_events, count);
+        account->idle_count = 0;
+        account->backoff    = 0;
+    } else if ((account->flags & UCS_CALLBACKQ_ELEM_FLAG_BACKOFF) &&
+               (++account->idle_count >= UCS_CALLBACKQ_BACKOFF_THRESH)) {
+        /* Double the number of skipped rounds on every idle call */
+        account->backoff    = ucs_min(ucs_max(account->backoff * 2, 1),
+                                      UCS_CALLBACKQ_BACKOFF_MAX);
+        account->skip_count = account->backoff;
+    }
+
+    return count;
+}
+
+/*
+ * Initialize a callback queue element, and wrap the user callback with an
+ * accounting context if needed. Lock must be held.
+ *
+ * @return UCS_ERR_NO_MEMORY if the context of a backoff callback could not be
+ *         allocated. A callback which is only counted for statistics is added
+ *         without a context in this case.
+ */
+static ucs_status_t
+ucs_callbackq_elem_init(ucs_callbackq_t *cbq, ucs_callbackq_elem_t *elem,
+                        ucs_callback_t cb, void *arg,
+                        ucs_callbackq_prio_t prio, unsigned flags)
+{
+    ucs_callbackq_account_t *account;
+
+    elem->cb  = cb;
+    elem->arg = arg;
+
+    if (!UCS_CALLBACKQ_ACCOUNT_ALL &&
+        !(flags & UCS_CALLBACKQ_ELEM_FLAG_BACKOFF)) {
+        return UCS_OK;
+    }
+
+    account = ucs_calloc(1, sizeof(*account), "ucs_callbackq_account");
+    if (account == NULL) {
+        if (flags & UCS_CALLBACKQ_ELEM_FLAG_BACKOFF) {
+            ucs_error("callbackq %p: failed to allocate backoff context", cbq);
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        ucs_debug("callbackq %p: failed to allocate accounting context", cbq);
+        return UCS_OK;
+    }
+
+    account->super = *elem;
+    account->prio  = prio;
+    account->flags = flags;
+    ucs_list_add_tail(&cbq->priv->accounts, &account->list);
+
+    elem->cb  = ucs_callbackq_account_proxy;
+    elem->arg = account;
+    return UCS_OK;
+}
+
+/*
+ * Release the accounting context of a removed element, if it has one.
+ * Lock must be held.
+ *
+ * @return The user-defined argument of the element.
+ */
+static void *ucs_callbackq_elem_release(ucs_callbackq_t *cbq,
+                                        const ucs_callbackq_elem_t *elem)
+{
+    ucs_callbackq_account_t *account;
+
+    if (elem->cb != ucs_callbackq_account_proxy) {
+        return elem->arg;
+    }
+
+    /* The element may be dispatched at this moment, so defer the release to
+       the proxy callback */
+    account = elem->arg;
+    ucs_list_del(&account->list);
+    ucs_list_add_tail(&cbq->priv->removed_accounts, &account->list);
+    return account->super.arg;
+}
+
 /*
  * @param [in]  id  ID to release in the lookup array.
  * @return index which this ID used to hold.
@@ -161,21 +306,55 @@ static int ucs_callbackq_get_id(ucs_callbackq_t *cbq, unsigned idx)
     return id;
 }
 
-static unsigned ucs_callbackq_get_fast_idx(ucs_callbackq_t *cbq)
+/*
+ * Make room for a fast-path element with priority 'prio' after all elements
+ * with the same or higher priority.
+ *
+ * @return index of the new element.
+ */
+static unsigned
+ucs_callbackq_get_fast_idx(ucs_callbackq_t *cbq, ucs_callbackq_prio_t prio)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
-    unsigned idx;
+    ucs_callbackq_elem_t *elem;
+    unsigned idx, pos;
+    int id;
 
-    ucs_trace_func("cbq=%p num_fast_elems=%u", cbq, priv->num_fast_elems);
+    ucs_trace_func("cbq=%p num_fast_elems=%u prio=%d", cbq,
+                   priv->num_fast_elems, prio);
 
-    idx = priv->num_fast_elems++;
-    ucs_assertv(idx < UCS_CALLBACKQ_FAST_COUNT, "idx=%u", idx);
+    ucs_assertv(priv->num_fast_elems < UCS_CALLBACKQ_FAST_COUNT,
+                "num_fast_elems=%u", priv->num_fast_elems);
 
-    return idx;
+    for (pos = 0; pos < priv->num_fast_elems; ++pos) {
+        if (priv->fast_prios[pos] > prio) {
+            break;
+        }
+    }
+
+    /* Shift lower-priority elements by one position. Elements which are
+     * pending removal have already released their IDs. */
+    for (idx = priv->num_fast_elems; idx > pos; --idx) {
+        elem = &cbq->fast_elems[idx - 1];
+        id   = priv->fast_ids[idx - 1];
+        ucs_callbackq_fast_elem_set(cbq, idx, elem->cb, elem->arg, id);
+        priv->fast_prios[idx] = priv->fast_prios[idx - 1];
+        if (!(priv->fast_remove_mask & UCS_BIT(idx - 1))) {
+            ucs_array_elem(&priv->idxs, id) = idx;
+        }
+    }
+
+    priv->fast_remove_mask = (priv->fast_remove_mask & UCS_MASK(pos)) |
+                             ((priv->fast_remove_mask & ~UCS_MASK(pos)) << 1);
+    priv->fast_prios[pos]  = prio;
+    ++priv->num_fast_elems;
+
+    return pos;
 }
 
 static int
-ucs_callbackq_fast_elem_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
+ucs_callbackq_fast_elem_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg,
+                            ucs_callbackq_prio_t prio)
 {
     unsigned idx;
     int id;
@@ -183,7 +362,7 @@ ucs_callbackq_fast_elem_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
     ucs_trace_func("cbq=%p cb=%s arg=%p", cbq, ucs_debug_get_symbol_name(cb),
                    arg);
 
-    idx = ucs_callbackq_get_fast_idx(cbq);
+    idx = ucs_callbackq_get_fast_idx(cbq, prio);
     id  = ucs_callbackq_get_id(cbq, idx);
     ucs_callbackq_fast_elem_set(cbq, idx, cb, arg, id);
     return id;
@@ -193,56 +372,56 @@ ucs_callbackq_fast_elem_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
 static void ucs_callbackq_fast_elems_purge(ucs_callbackq_t *cbq)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
-    ucs_callbackq_elem_t *replace_elem;
-    unsigned idx, replace_idx;
-    int replace_id;
+    ucs_callbackq_elem_t *src_elem;
+    unsigned src_idx, dst_idx;
+    int src_id;
 
     ucs_trace_func("cbq=%p fast_remove_mask=0x%" PRIx64, cbq,
                    priv->fast_remove_mask);
-    ucs_log_indent_level(UCS_LOG_LEVEL_TRACE_FUNC, 1);
 
     ucs_assertv(priv->num_fast_elems >= ucs_popcount(priv->fast_remove_mask),
                 "num_fast_elems=%u fast_remove_mask=0x%" PRIx64,
                 priv->num_fast_elems, priv->fast_remove_mask);
 
-    while (priv->fast_remove_mask) {
-        ucs_assert(priv->num_fast_elems > 0);
-
-        idx                     = ucs_ilog2(priv->fast_remove_mask);
-        replace_idx             = --priv->num_fast_elems;
-        priv->fast_remove_mask &= ~UCS_BIT(idx);
+    if (priv->fast_remove_mask == 0) {
+        return;
+    }
 
-        if (idx == replace_idx) {
-            /* Removing last element */
-            ucs_callbackq_elem_reset(cbq, replace_idx);
+    /*
+     * Compact the array in-place, keeping the order of remaining elements so
+     * that higher priority callbacks are still dispatched first.
+     */
+    dst_idx = 0;
+    for (src_idx = 0; src_idx < priv->num_fast_elems; ++src_idx) {
+        if (priv->fast_remove_mask & UCS_BIT(src_idx)) {
             continue;
         }
 
-        /*
-         * Since we iterate using ilog2 - from high bit to low - if we are not
-         * removing the last element, it means the last element is not part of
-         * the remove mask
-         */
-        ucs_assert(!(priv->fast_remove_mask & UCS_BIT(replace_idx)));
-
-        replace_id = priv->fast_ids[replace_idx];
-        ucs_assert(replace_id != UCS_CALLBACKQ_ID_NULL);
-        ucs_trace_func("cbq=%p replace fast idx=%u by idx=%u id=%d", cbq, idx,
-                       replace_idx, replace_id);
+        if (dst_idx != src_idx) {
+            src_elem = &cbq->fast_elems[src_idx];
+            src_id   = priv->fast_ids[src_idx];
+            ucs_assert(src_id != UCS_CALLBACKQ_ID_NULL);
+            ucs_trace_func("cbq=%p move fast idx=%u to idx=%u id=%d", cbq,
+                           src_idx, dst_idx, src_id);
+            ucs_callbackq_fast_elem_set(cbq, dst_idx, src_elem->cb,
+                                        src_elem->arg, src_id);
+            priv->fast_prios[dst_idx]           = priv->fast_prios[src_idx];
+            ucs_array_elem(&priv->idxs, src_id) = dst_idx;
+        }
+        ++dst_idx;
+    }
 
-        /* Replace removed element by last element */
-        replace_elem = &cbq->fast_elems[replace_idx];
-        ucs_callbackq_fast_elem_set(cbq, idx, replace_elem->cb,
-                                    replace_elem->arg, replace_id);
-        ucs_array_elem(&priv->idxs, replace_id) = idx;
-        ucs_callbackq_elem_reset(cbq, replace_idx);
+    for (src_idx = dst_idx; src_idx < priv->num_fast_elems; ++src_idx) {
+        ucs_callbackq_elem_reset(cbq, src_idx);
     }
 
-    ucs_log_indent_level(UCS_LOG_LEVEL_TRACE_FUNC, -1);
+    priv->num_fast_elems   = dst_idx;
+    priv->fast_remove_mask = 0;
 }
 
 static int
-ucs_callbackq_spill_elem_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
+ucs_callbackq_spill_elem_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg,
+                             ucs_callbackq_prio_t prio)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
     ucs_callbackq_spill_elem_t *elem;
@@ -261,22 +440,26 @@ ucs_callbackq_spill_elem_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
     elem->super.cb  = cb;
     elem->super.arg = arg;
     elem->id        = id;
+    elem->prio      = prio;
 
     ucs_callbackq_proxy_enable(cbq);
     return id;
 }
 
-static void *ucs_callbackq_spill_elem_remove(ucs_callbackq_t *cbq, unsigned idx)
+static void ucs_callbackq_spill_elem_clear(ucs_callbackq_t *cbq, unsigned idx)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
-    ucs_callbackq_spill_elem_t *elem;
 
     ucs_assertv(idx < ucs_array_length(&priv->spill_elems), "idx=%u length=%u",
                 idx, ucs_array_length(&priv->spill_elems));
-    elem     = &ucs_array_elem(&priv->spill_elems, idx);
-    elem->id = UCS_CALLBACKQ_ID_NULL;
+    ucs_array_elem(&priv->spill_elems, idx).id = UCS_CALLBACKQ_ID_NULL;
+}
 
-    return elem->super.arg;
+static void *ucs_callbackq_spill_elem_remove(ucs_callbackq_t *cbq, unsigned idx)
+{
+    ucs_callbackq_spill_elem_clear(cbq, idx);
+    return ucs_callbackq_elem_release(
+            cbq, &ucs_array_elem(&cbq->priv->spill_elems, idx).super);
 }
 
 /* Should be called from dispatch thread only */
@@ -312,6 +495,16 @@ static void ucs_callbackq_spill_elems_purge(ucs_callbackq_t *cbq)
     ucs_array_set_length(&priv->spill_elems, dst_idx);
 }
 
+static void ucs_callbackq_accounts_free(ucs_list_link_t *list)
+{
+    ucs_callbackq_account_t *account, *tmp;
+
+    ucs_list_for_each_safe(account, tmp, list, list) {
+        ucs_free(account);
+    }
+    ucs_list_head_init(list);
+}
+
 static void ucs_callbackq_oneshot_elems_free(ucs_callbackq_t *cbq)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
@@ -331,7 +524,8 @@ static int ucs_callback_is_proxy_needed(ucs_callbackq_t *cbq)
     ucs_callbackq_priv_t *priv = cbq->priv;
 
     return !ucs_array_is_empty(&priv->spill_elems) ||
-           (kh_size(&priv->oneshot_elems) > 0) || priv->fast_remove_mask;
+           (kh_size(&priv->oneshot_elems) > 0) || priv->fast_remove_mask ||
+           !ucs_list_is_empty(&priv->removed_accounts);
 }
 
 /* Promote a spill element to fast-path array */
@@ -343,11 +537,11 @@ static void ucs_callbackq_spill_elem_promote(ucs_callbackq_t *cbq, unsigned idx)
 
     ucs_trace_func("cbq=%p idx=%u elem->id=%d", cbq, idx, elem->id);
 
-    fast_idx = ucs_callbackq_get_fast_idx(cbq);
+    fast_idx = ucs_callbackq_get_fast_idx(cbq, elem->prio);
     ucs_callbackq_fast_elem_set(cbq, fast_idx, elem->super.cb, elem->super.arg,
                                 elem->id);
     ucs_array_elem(&priv->idxs, elem->id) = fast_idx;
-    ucs_callbackq_spill_elem_remove(cbq, idx);
+    ucs_callbackq_spill_elem_clear(cbq, idx);
 }
 
 /* Lock must be held */
@@ -479,6 +673,7 @@ static unsigned ucs_callbackq_proxy_callback(void *arg)
     /* Remove remaining callbacks */
     ucs_callbackq_fast_elems_purge(cbq);
     ucs_callbackq_spill_elems_purge(cbq);
+    ucs_callbackq_accounts_free(&cbq->priv->removed_accounts);
 
     /* Disable this proxy if no more work to do */
     if (!ucs_callback_is_proxy_needed(cbq)) {
@@ -503,9 +698,12 @@ static void ucs_callbackq_proxy_enable(ucs_callbackq_t *cbq)
         return;
     }
 
+    /* Keep the proxy after all other fast-path elements, so that removing it
+     * from the array during dispatch does not move any element which was not
+     * dispatched yet */
     ucs_log_indent_level(UCS_LOG_LEVEL_TRACE_FUNC, 1);
-    priv->proxy_cb_id =
-            ucs_callbackq_fast_elem_add(cbq, ucs_callbackq_proxy_callback, cbq);
+    priv->proxy_cb_id = ucs_callbackq_fast_elem_add(
+            cbq, ucs_callbackq_proxy_callback, cbq, UCS_CALLBACKQ_PRIO_LAST);
     ucs_log_indent_level(UCS_LOG_LEVEL_TRACE_FUNC, -1);
 }
 
@@ -534,6 +732,10 @@ static void ucs_callbackq_proxy_disable(ucs_callbackq_t *cbq)
 static void
 ucs_callbackq_elem_show(const char *title, const ucs_callbackq_elem_t *elem)
 {
+    if (elem->cb == ucs_callbackq_account_proxy) {
+        elem = &((ucs_callbackq_account_t*)elem->arg)->super;
+    }
+
     ucs_diag("%s: cb %s (%p) arg %p", title,
              ucs_debug_get_symbol_name(elem->cb), elem->cb, elem->arg);
 }
@@ -601,6 +803,8 @@ ucs_status_t ucs_callbackq_init(ucs_callbackq_t *cbq)
     priv->fast_remove_mask = 0;
     priv->free_idx_id      = UCS_CALLBACKQ_ID_NULL;
     priv->proxy_cb_id      = UCS_CALLBACKQ_ID_NULL;
+    ucs_list_head_init(&priv->accounts);
+    ucs_list_head_init(&priv->removed_accounts);
     cbq->priv              = priv;
 
     for (idx = 0; idx < UCS_CALLBACKQ_FAST_COUNT; ++idx) {
@@ -620,6 +824,8 @@ void ucs_callbackq_cleanup(ucs_callbackq_t *cbq)
     ucs_callbackq_proxy_disable(cbq);
     ucs_callbackq_show_remaining_elems(cbq);
 
+    ucs_callbackq_accounts_free(&priv->accounts);
+    ucs_callbackq_accounts_free(&priv->removed_accounts);
     ucs_callbackq_oneshot_elems_free(cbq);
     kh_destroy_inplace(ucs_callbackq_oneshot_elems, &priv->oneshot_elems);
     ucs_array_cleanup_dynamic(&priv->spill_elems);
@@ -628,26 +834,39 @@ void ucs_callbackq_cleanup(ucs_callbackq_t *cbq)
     ucs_free(priv);
 }
 
-int ucs_callbackq_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
+int ucs_callbackq_add_prio(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg,
+                           ucs_callbackq_prio_t prio, unsigned flags)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
+    ucs_callbackq_elem_t elem;
+    ucs_status_t status;
     int id;
 
-    ucs_trace_func("cbq=%p cb=%s arg=%p", cbq, ucs_debug_get_symbol_name(cb),
-                   arg);
+    ucs_trace_func("cbq=%p cb=%s arg=%p prio=%d flags=0x%x", cbq,
+                   ucs_debug_get_symbol_name(cb), arg, prio, flags);
+
+    ucs_assertv(prio < UCS_CALLBACKQ_PRIO_LAST, "prio=%d", prio);
 
     ucs_callbackq_enter(cbq);
 
-    if (ucs_likely(priv->num_fast_elems < UCS_CALLBACKQ_FAST_MAX)) {
-        id = ucs_callbackq_fast_elem_add(cbq, cb, arg);
+    status = ucs_callbackq_elem_init(cbq, &elem, cb, arg, prio, flags);
+    if (status != UCS_OK) {
+        id = UCS_CALLBACKQ_ID_NULL;
+    } else if (ucs_likely(priv->num_fast_elems < UCS_CALLBACKQ_FAST_MAX)) {
+        id = ucs_callbackq_fast_elem_add(cbq, elem.cb, elem.arg, prio);
     } else {
-        id = ucs_callbackq_spill_elem_add(cbq, cb, arg);
+        id = ucs_callbackq_spill_elem_add(cbq, elem.cb, elem.arg, prio);
     }
 
     ucs_callbackq_leave(cbq);
     return id;
 }
 
+int ucs_callbackq_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
+{
+    return ucs_callbackq_add_prio(cbq, cb, arg, UCS_CALLBACKQ_PRIO_NORMAL, 0);
+}
+
 void *ucs_callbackq_remove(ucs_callbackq_t *cbq, int id)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
@@ -662,7 +881,7 @@ void *ucs_callbackq_remove(ucs_callbackq_t *cbq, int id)
     if (idx < UCS_CALLBACKQ_FAST_COUNT) {
         ucs_assertv(idx < priv->num_fast_elems, "idx=%u num_fast_elems=%u", idx,
                     priv->num_fast_elems);
-        cb_arg                  = cbq->fast_elems[idx].arg;
+        cb_arg = ucs_callbackq_elem_release(cbq, &cbq->fast_elems[idx]);
         priv->fast_remove_mask |= UCS_BIT(idx);
         ucs_callbackq_fast_elems_purge(cbq);
     } else {
@@ -670,29 +889,50 @@ void *ucs_callbackq_remove(ucs_callbackq_t *cbq, int id)
                 cbq, idx - UCS_CALLBACKQ_FAST_COUNT);
     }
 
+    if (!ucs_list_is_empty(&priv->removed_accounts)) {
+        ucs_callbackq_proxy_enable(cbq);
+    }
+
     ucs_callbackq_leave(cbq);
 
     return cb_arg;
 }
 
-int ucs_callbackq_add_safe(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
+int ucs_callbackq_add_safe_prio(ucs_callbackq_t *cbq, ucs_callback_t cb,
+                                void *arg, ucs_callbackq_prio_t prio,
+                                unsigned flags)
 {
+    ucs_callbackq_elem_t elem;
+    ucs_status_t status;
     int id;
 
-    ucs_trace_func("cbq=%p cb=%s arg=%p", cbq, ucs_debug_get_symbol_name(cb),
-                   arg);
+    ucs_trace_func("cbq=%p cb=%s arg=%p prio=%d flags=0x%x", cbq,
+                   ucs_debug_get_symbol_name(cb), arg, prio, flags);
+
+    ucs_assertv(prio < UCS_CALLBACKQ_PRIO_LAST, "prio=%d", prio);
 
     ucs_callbackq_enter(cbq);
 
     /* Add callback to spill elems, and it may be upgraded to fast-path later by
      * the proxy callback. It's not safe to add to fast_elems directly.
      */
-    id = ucs_callbackq_spill_elem_add(cbq, cb, arg);
+    status = ucs_callbackq_elem_init(cbq, &elem, cb, arg, prio, flags);
+    if (status != UCS_OK) {
+        id = UCS_CALLBACKQ_ID_NULL;
+    } else {
+        id = ucs_callbackq_spill_elem_add(cbq, elem.cb, elem.arg, prio);
+    }
 
     ucs_callbackq_leave(cbq);
     return id;
 }
 
+int ucs_callbackq_add_safe(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg)
+{
+    return ucs_callbackq_add_safe_prio(cbq, cb, arg, UCS_CALLBACKQ_PRIO_NORMAL,
+                                       0);
+}
+
 void *ucs_callbackq_remove_safe(ucs_callbackq_t *cbq, int id)
 {
     ucs_callbackq_priv_t *priv = cbq->priv;
@@ -711,7 +951,7 @@ void *ucs_callbackq_remove_safe(ucs_callbackq_t *cbq, int id)
         /* Make sure user callback will not be called in case we try to dispatch
            the removed fast-path element before the proxy callback had a chance
            to clean it up. */
-        cb_arg                  = cbq->fast_elems[idx].arg;
+        cb_arg = ucs_callbackq_elem_release(cbq, &cbq->fast_elems[idx]);
         cbq->fast_elems[idx].cb = (ucs_callback_t)ucs_empty_function_return_zero;
         priv->fast_remove_mask |= UCS_BIT(idx);
         ucs_callbackq_proxy_enable(cbq);
@@ -799,3 +1039,27 @@ void ucs_callbackq_remove_oneshot(ucs_callbackq_t *cbq, ucs_callbackq_key_t key,
 out:
     ucs_callbackq_leave(cbq);
 }
+
+void ucs_callbackq_print_counters(ucs_callbackq_t *cbq,
+                                  ucs_string_buffer_t *strb)
+{
+    ucs_callbackq_account_t *account;
+
+    ucs_callbackq_enter(cbq);
+
+    ucs_list_for_each(account, &cbq->priv->accounts, list) {
+        ucs_string_buffer_appendf(strb, "%s(%p): prio %s backoff %u",
+                                  ucs_debug_get_symbol_name(account->super.cb),
+                                  account->super.arg,
+                                  ucs_callbackq_prio_names[account->prio],
+                                  account->backoff);
+#ifdef ENABLE_STATS
+        ucs_string_buffer_appendf(strb, " calls %" PRIu64 " events %" PRIu64
+                                  " skips %" PRIu64, account->num_calls,
+                                  account->num_events, account->num_skips);
+#endif
+        ucs_string_buffer_appendf(strb, "\n");
+    }
+
+    ucs_callbackq_leave(cbq);
+}
@@ -9,6 +9,7 @@
 #define UCS_CALLBACKQ_H
 
 #include <ucs/datastruct/list.h>
+#include <ucs/datastruct/string_buffer.h>
 #include <ucs/sys/compiler_def.h>
 #include <ucs/type/status.h>
 #include <stddef.h>
@@ -25,8 +26,10 @@ BEGIN_C_DECLS
  *  - add/remove operations are O(1)
  */
 
-#define UCS_CALLBACKQ_FAST_COUNT 7    /* Max. number of fast-path callbacks */
-#define UCS_CALLBACKQ_ID_NULL    (-1) /* Invalid callback identifier */
+#define UCS_CALLBACKQ_FAST_COUNT     7    /* Max. number of fast-path callbacks */
+#define UCS_CALLBACKQ_ID_NULL        (-1) /* Invalid callback identifier */
+#define UCS_CALLBACKQ_BACKOFF_THRESH 16   /* Idle calls before starting backoff */
+#define UCS_CALLBACKQ_BACKOFF_MAX    16   /* Max. number of rounds to skip */
 
 
 /*
@@ -38,6 +41,34 @@ typedef struct ucs_callbackq_priv  ucs_callbackq_priv_t;
 typedef void *                     ucs_callbackq_key_t;
 
 
+/**
+ * Callback priority. Fast-path callbacks with higher priority are dispatched
+ * before callbacks with lower priority, and callbacks with the same priority
+ * are dispatched in the order they were added.
+ */
+typedef enum {
+    UCS_CALLBACKQ_PRIO_HIGH,
+    UCS_CALLBACKQ_PRIO_NORMAL,
+    UCS_CALLBACKQ_PRIO_LOW,
+    UCS_CALLBACKQ_PRIO_LAST
+} ucs_callbackq_prio_t;
+
+
+/**
+ * Callback queue element flags.
+ */
+enum {
+    /**
+     * Poll the callback less often while it does not do any work. After
+     * @ref UCS_CALLBACKQ_BACKOFF_THRESH consecutive calls which returned 0, the
+     * callback is skipped for an exponentially growing number of dispatch
+     * rounds, up to @ref UCS_CALLBACKQ_BACKOFF_MAX. The backoff is reset as
+     * soon as the callback returns a nonzero value.
+     */
+    UCS_CALLBACKQ_ELEM_FLAG_BACKOFF = UCS_BIT(0)
+};
+
+
 /**
  * Callback which can be placed in a queue.
  *
@@ -120,6 +151,23 @@ void ucs_callbackq_cleanup(ucs_callbackq_t *cbq);
 int ucs_callbackq_add(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg);
 
 
+/**
+ * Add a callback with a given priority to the queue.
+ * Same as @ref ucs_callbackq_add, which uses @ref UCS_CALLBACKQ_PRIO_NORMAL.
+ *
+ * @param  [in] cbq      Callback queue to add the callback to.
+ * @param  [in] cb       Callback to add.
+ * @param  [in] arg      User-defined argument for the callback.
+ * @param  [in] prio     Callback priority.
+ * @param  [in] flags    Callback flags, see UCS_CALLBACKQ_ELEM_FLAG_xx.
+ *
+ * @return Unique identifier of the callback in the queue, or
+ *         @ref UCS_CALLBACKQ_ID_NULL if failed to allocate the backoff context.
+ */
+int ucs_callbackq_add_prio(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg,
+                           ucs_callbackq_prio_t prio, unsigned flags);
+
+
 /**
  * Remove a callback from the queue immediately.
  * This is *not* safe to call while another thread might be dispatching callbacks.
@@ -150,6 +198,24 @@ void *ucs_callbackq_remove(ucs_callbackq_t *cbq, int id);
 int ucs_callbackq_add_safe(ucs_callbackq_t *cbq, ucs_callback_t cb, void *arg);
 
 
+/**
+ * Add a callback with a given priority to the queue.
+ * Same as @ref ucs_callbackq_add_safe, which uses @ref UCS_CALLBACKQ_PRIO_NORMAL.
+ *
+ * @param  [in] cbq      Callback queue to add the callback to.
+ * @param  [in] cb       Callback to add.
+ * @param  [in] arg      User-defined argument for the callback.
+ * @param  [in] prio     Callback priority.
+ * @param  [in] flags    Callback flags, see UCS_CALLBACKQ_ELEM_FLAG_xx.
+ *
+ * @return Unique identifier of the callback in the queue, or
+ *         @ref UCS_CALLBACKQ_ID_NULL if failed to allocate the backoff context.
+ */
+int ucs_callbackq_add_safe_prio(ucs_callbackq_t *cbq, ucs_callback_t cb,
+                                void *arg, ucs_callbackq_prio_t prio,
+                                unsigned flags);
+
+
 /**
  * Remove a callback from the queue in a safe but lazy fashion. The callback will
  * be removed at some point in the near future.
@@ -196,6 +262,19 @@ void ucs_callbackq_remove_oneshot(ucs_callbackq_t *cbq, ucs_callbackq_key_t key,
                                   ucs_callbackq_predicate_t pred, void *arg);
 
 
+/**
+ * Print the priority and the current backoff of callbacks added with
+ * @ref UCS_CALLBACKQ_ELEM_FLAG_BACKOFF. When the library is built with
+ * statistics support, print also the number of calls, events and skipped
+ * dispatch rounds of every callback in the queue.
+ *
+ * @param  [in]  cbq      Callback queue.
+ * @param  [out] strb     String buffer to print to.
+ */
+void ucs_callbackq_print_counters(ucs_callbackq_t *cbq,
+                                  ucs_string_buffer_t *strb);
+
+
 /**
  * Dispatch callbacks from the callback queue.
  * Must be called from single thread only.
@@ -16,8 +16,11 @@
  */
 enum ucs_callbackq_flags {
     UCS_CALLBACKQ_FLAG_FAST    = UCS_BIT(0), /**< Fast-path (best effort) */
-    UCS_CALLBACKQ_FLAG_ONESHOT = UCS_BIT(1)  /**< Call the callback only once
+    UCS_CALLBACKQ_FLAG_ONESHOT = UCS_BIT(1), /**< Call the callback only once
                                                   (cannot be used with FAST) */
+    UCS_CALLBACKQ_FLAG_BACKOFF = UCS_BIT(2)  /**< Low priority, and poll less
+                                                  often while idle (cannot be
+                                                  used with ONESHOT) */
 };
 
 #endif
@@ -15,28 +15,63 @@
 #include <ucs/arch/bitops.h>
 #include <ucs/debug/assert.h>
 #include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/math.h>
 
 
-#define UCS_MPMC_INVALID_VALUE -1
+#define UCS_MPMC_INVALID_VALUE ((uint64_t)-1)
+
+/* Number of slots in the ring, must be a power of 2 */
+#define UCS_MPMC_QUEUE_LENGTH  256
+
 
 ucs_status_t ucs_mpmc_queue_init(ucs_mpmc_queue_t *mpmc)
 {
-    ucs_queue_head_init(&mpmc->queue);
-    return ucs_spinlock_init(&mpmc->lock, 0);
+    ucs_status_t status;
+    uint64_t pos;
+    int ret;
+
+    UCS_STATIC_ASSERT(ucs_is_pow2_or_zero(UCS_MPMC_QUEUE_LENGTH));
+
+    ret = ucs_posix_memalign((void**)&mpmc->slots, UCS_SYS_CACHE_LINE_SIZE,
+                             sizeof(*mpmc->slots) * UCS_MPMC_QUEUE_LENGTH,
+                             "mpmc slots");
+    if (ret != 0) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (pos = 0; pos < UCS_MPMC_QUEUE_LENGTH; ++pos) {
+        mpmc->slots[pos].seq   = pos;
+        mpmc->slots[pos].value = UCS_MPMC_INVALID_VALUE;
+    }
+
+    mpmc->enq_pos = 0;
+    mpmc->deq_pos = 0;
+    ucs_queue_head_init(&mpmc->overflow);
+
+    status = ucs_spinlock_init(&mpmc->lock, 0);
+    if (status != UCS_OK) {
+        ucs_free(mpmc->slots);
+    }
+
+    return status;
 }
 
 void ucs_mpmc_queue_cleanup(ucs_mpmc_queue_t *mpmc)
 {
     ucs_mpmc_elem_t *elem;
 
-    while (!ucs_queue_is_empty(&mpmc->queue)) {
-        elem = ucs_queue_pull_elem_non_empty(&mpmc->queue,
+    while (!ucs_queue_is_empty(&mpmc->overflow)) {
+        elem = ucs_queue_pull_elem_non_empty(&mpmc->overflow,
                                              ucs_mpmc_elem_t, super);
         ucs_free(elem);
     }
+
+    ucs_spinlock_destroy(&mpmc->lock);
+    ucs_free(mpmc->slots);
 }
 
-ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value)
+static ucs_status_t
+ucs_mpmc_queue_push_overflow(ucs_mpmc_queue_t *mpmc, uint64_t value)
 {
     ucs_mpmc_elem_t *elem;
 
@@ -48,24 +83,56 @@ ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value)
     elem->value = value;
 
     ucs_spin_lock(&mpmc->lock);
-    ucs_queue_push(&mpmc->queue, &elem->super);
+    ucs_queue_push(&mpmc->overflow, &elem->super);
     ucs_spin_unlock(&mpmc->lock);
 
     return UCS_OK;
 }
 
-ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p)
+ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value)
+{
+    uint64_t pos = mpmc->enq_pos;
+    ucs_mpmc_slot_t *slot;
+    int64_t diff;
+
+    ucs_assert(value != UCS_MPMC_INVALID_VALUE);
+
+    for (;;) {
+        slot = &mpmc->slots[pos & (UCS_MPMC_QUEUE_LENGTH - 1)];
+        diff = (int64_t)(slot->seq - pos);
+        ucs_memory_cpu_load_fence();
+        if (diff == 0) {
+            /* The slot is free, try to claim the position */
+            if (ucs_atomic_cswap64(&mpmc->enq_pos, pos, pos + 1) == pos) {
+                break;
+            }
+        } else if (diff < 0) {
+            /* The slot was not pulled yet since the previous round */
+            return ucs_mpmc_queue_push_overflow(mpmc, value);
+        }
+
+        pos = mpmc->enq_pos;
+    }
+
+    slot->value = value;
+    ucs_memory_cpu_store_fence();
+    slot->seq   = pos + 1;
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucs_mpmc_queue_pull_overflow(ucs_mpmc_queue_t *mpmc, uint64_t *value_p)
 {
     ucs_status_t status = UCS_ERR_NO_PROGRESS;
     ucs_mpmc_elem_t *elem;
 
-    if (ucs_mpmc_queue_is_empty(mpmc)) {
+    if (ucs_queue_is_empty_no_deref(&mpmc->overflow)) {
         return status;
     }
 
     ucs_spin_lock(&mpmc->lock);
-    while (!ucs_queue_is_empty(&mpmc->queue)) {
-        elem = ucs_queue_pull_elem_non_empty(&mpmc->queue, ucs_mpmc_elem_t,
+    while (!ucs_queue_is_empty(&mpmc->overflow)) {
+        elem = ucs_queue_pull_elem_non_empty(&mpmc->overflow, ucs_mpmc_elem_t,
                                              super);
         if (elem->value != UCS_MPMC_INVALID_VALUE) {
             *value_p = elem->value;
@@ -81,14 +148,61 @@ ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p)
     return status;
 }
 
+ucs_status_t ucs_mpmc_queue_pull(ucs_mpmc_queue_t *mpmc, uint64_t *value_p)
+{
+    ucs_mpmc_slot_t *slot;
+    uint64_t value, pos;
+    int64_t diff;
+
+    pos = mpmc->deq_pos;
+    for (;;) {
+        slot = &mpmc->slots[pos & (UCS_MPMC_QUEUE_LENGTH - 1)];
+        diff = (int64_t)(slot->seq - (pos + 1));
+        ucs_memory_cpu_load_fence();
+        if (diff == 0) {
+            /* The slot is full, try to claim the position */
+            if (ucs_atomic_cswap64(&mpmc->deq_pos, pos, pos + 1) == pos) {
+                /* Take the value atomically, since it could be removed by
+                 * ucs_mpmc_queue_remove_if() meanwhile */
+                value = ucs_atomic_swap64(&slot->value,
+                                          UCS_MPMC_INVALID_VALUE);
+                ucs_memory_cpu_store_fence();
+                slot->seq = pos + UCS_MPMC_QUEUE_LENGTH;
+                if (value != UCS_MPMC_INVALID_VALUE) {
+                    *value_p = value;
+                    return UCS_OK;
+                }
+            }
+        } else if (diff < 0) {
+            /* The ring is empty */
+            return ucs_mpmc_queue_pull_overflow(mpmc, value_p);
+        }
+
+        pos = mpmc->deq_pos;
+    }
+}
+
 void ucs_mpmc_queue_remove_if(ucs_mpmc_queue_t *mpmc,
                               ucs_mpmc_queue_predicate_t predicate, void *arg)
 {
     ucs_mpmc_elem_t *elem;
     ucs_queue_iter_t iter;
+    ucs_mpmc_slot_t *slot;
+    uint64_t value;
+
+    /* Pulled and free slots hold an invalid value, so it's enough to check the
+     * values of all slots. A value which is pulled concurrently is either
+     * returned by the pull or removed here, but not both. */
+    for (slot = mpmc->slots; slot < mpmc->slots + UCS_MPMC_QUEUE_LENGTH;
+         ++slot) {
+        value = slot->value;
+        if ((value != UCS_MPMC_INVALID_VALUE) && predicate(value, arg)) {
+            ucs_atomic_cswap64(&slot->value, value, UCS_MPMC_INVALID_VALUE);
+        }
+    }
 
     ucs_spin_lock(&mpmc->lock);
-    ucs_queue_for_each_safe(elem, iter, &mpmc->queue, super) {
+    ucs_queue_for_each_safe(elem, iter, &mpmc->overflow, super) {
         if (predicate(elem->value, arg)) {
             elem->value = UCS_MPMC_INVALID_VALUE;
         }
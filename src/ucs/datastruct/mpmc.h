@@ -9,21 +9,43 @@
 
 #include "queue.h"
 
+#include <ucs/arch/cpu.h>
+#include <ucs/sys/compiler.h>
 #include <ucs/type/status.h>
 #include <ucs/type/spinlock.h>
 
+
+/**
+ * MPMC queue ring slot.
+ */
+typedef struct ucs_mpmc_slot {
+    volatile uint64_t  seq;         /* Position the slot is ready for */
+    volatile uint64_t  value;       /* Value in the slot */
+    UCS_CACHELINE_PADDING(uint64_t, uint64_t);
+} ucs_mpmc_slot_t;
+
+
 /**
  * A Multi-producer-multi-consumer thread-safe queue.
- * Every push/pull is a single atomic operation in "good" scenario.
+ * The queue is a bounded lock-free ring, where every slot holds a sequence
+ * number which tells whether it is ready for the producer or for the consumer
+ * at the given position. Every push/pull is a single atomic operation in
+ * "good" scenario. If the ring is full, values are pushed to a spinlock
+ * protected overflow queue, which is pulled after the ring is drained.
  */
 typedef struct ucs_mpmc_queue {
-    ucs_spinlock_t     lock;        /* Protects 'queue' */
-    ucs_queue_head_t   queue;       /* Queue of data */
+    volatile uint64_t  enq_pos;     /* Next position to push to */
+    UCS_CACHELINE_PADDING(uint64_t);
+    volatile uint64_t  deq_pos;     /* Next position to pull from */
+    UCS_CACHELINE_PADDING(uint64_t);
+    ucs_mpmc_slot_t    *slots;      /* Ring of slots */
+    ucs_spinlock_t     lock;        /* Protects 'overflow' */
+    ucs_queue_head_t   overflow;    /* Values which did not fit the ring */
 } ucs_mpmc_queue_t;
 
 
 /**
- * MPMC queue element type.
+ * MPMC queue overflow element type.
  */
 typedef struct ucs_mpmc_elem {
     ucs_queue_elem_t super;
@@ -44,8 +66,6 @@ typedef int (*ucs_mpmc_queue_predicate_t)(uint64_t value, void *arg);
 
 /**
  * Initialize MPMC queue.
- *
- * @param length   Queue length.
  */
 ucs_status_t ucs_mpmc_queue_init(ucs_mpmc_queue_t *mpmc);
 
@@ -60,7 +80,8 @@ void ucs_mpmc_queue_cleanup(ucs_mpmc_queue_t *mpmc);
  * Atomically push a value to the queue.
  *
  * @param value Value to push.
- * @return UCS_ERR_NO_MEMORY if it fails to allocate the MPMC queue element.
+ * @return UCS_ERR_NO_MEMORY if the ring is full and it fails to allocate the
+ *         MPMC queue overflow element.
  */
 ucs_status_t ucs_mpmc_queue_push(ucs_mpmc_queue_t *mpmc, uint64_t value);
 
@@ -93,7 +114,13 @@ void ucs_mpmc_queue_remove_if(ucs_mpmc_queue_t *mpmc,
  */
 static inline int ucs_mpmc_queue_is_empty(ucs_mpmc_queue_t *mpmc)
 {
-    return ucs_queue_is_empty_no_deref(&mpmc->queue);
+    /* Read the consumer position first, since it never passes the producer
+     * position */
+    uint64_t deq_pos = mpmc->deq_pos;
+
+    ucs_memory_cpu_load_fence();
+    return (deq_pos == mpmc->enq_pos) &&
+           ucs_queue_is_empty_no_deref(&mpmc->overflow);
 }
 
 #endif
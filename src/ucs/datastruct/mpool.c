@@ -18,6 +18,8 @@
 #include <ucs/sys/sys.h>
 #include <ucs/arch/cpu.h>
 
+#include <string.h>
+
 
 static size_t ucs_mpool_elem_total_size(ucs_mpool_data_t *data)
 {
@@ -68,10 +70,73 @@ void ucs_mpool_params_reset(ucs_mpool_params_t *params)
     params->max_chunk_size  = 128 * UCS_MBYTE;
     params->max_elems       = UINT_MAX;
     params->grow_factor     = 1.0;
+    params->numa_node       = UCS_NUMA_NODE_UNDEFINED;
+    params->hugepages       = 0;
+    params->thread_cache_size = 0;
     params->ops             = NULL;
     params->name            = "";
 }
 
+/* Must be called with the pool lock held */
+static void ucs_mpool_thread_cache_flush(ucs_mpool_t *mp,
+                                         ucs_mpool_thread_cache_t *tc,
+                                         unsigned count)
+{
+    ucs_mpool_elem_t *elem;
+
+    while (tc->count > count) {
+        elem = tc->elems[--tc->count];
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        ucs_mpool_add_to_freelist(mp, elem);
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    }
+}
+
+/* Called when a thread which used the pool exits */
+static void ucs_mpool_thread_cache_destroy(void *arg)
+{
+    ucs_mpool_thread_cache_t *tc = arg;
+    ucs_mpool_data_t *data       = tc->mp->data;
+
+    ucs_spin_lock(&data->lock);
+    ucs_mpool_thread_cache_flush(tc->mp, tc, 0);
+    ucs_list_del(&tc->list);
+    ucs_spin_unlock(&data->lock);
+    ucs_free(tc);
+}
+
+static ucs_mpool_thread_cache_t *
+ucs_mpool_thread_cache_create(ucs_mpool_t *mp)
+{
+    ucs_mpool_data_t *data = mp->data;
+    ucs_mpool_thread_cache_t *tc;
+    int ret;
+
+    tc = ucs_malloc(sizeof(*tc) + (data->thread_cache_size * sizeof(*tc->elems)),
+                    "mpool_thread_cache");
+    if (tc == NULL) {
+        ucs_debug("mpool %s: failed to allocate thread cache",
+                  ucs_mpool_name(mp));
+        return NULL;
+    }
+
+    ret = pthread_setspecific(data->thread_cache_key, tc);
+    if (ret != 0) {
+        ucs_debug("mpool %s: pthread_setspecific() failed: %s",
+                  ucs_mpool_name(mp), strerror(ret));
+        ucs_free(tc);
+        return NULL;
+    }
+
+    tc->mp    = mp;
+    tc->count = 0;
+
+    ucs_spin_lock(&data->lock);
+    ucs_list_add_tail(&data->thread_caches, &tc->list);
+    ucs_spin_unlock(&data->lock);
+    return tc;
+}
+
 static size_t ucs_mpool_chunk_size(ucs_mpool_t *mp, unsigned num_elems)
 {
     return sizeof(ucs_mpool_chunk_t) + mp->data->alignment +
@@ -82,6 +147,7 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
 {
     size_t min_chunk_size;
     ucs_status_t status;
+    int ret;
 
     /* Check input values */
     if ((params->elem_size == 0) ||
@@ -111,11 +177,20 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
     mp->data->align_offset    = sizeof(ucs_mpool_elem_t) + params->align_offset;
     mp->data->elems_per_chunk = params->elems_per_chunk;
     mp->data->malloc_safe     = params->malloc_safe;
+    mp->data->hugepages       = params->hugepages;
+    /* Changing the memory policy costs system calls on every grow, and has no
+     * effect when there is only one node */
+    mp->data->numa_node       = (ucs_numa_num_configured_nodes() > 1) ?
+                                params->numa_node : UCS_NUMA_NODE_UNDEFINED;
     mp->data->quota           = params->max_elems;
     mp->data->tail            = NULL;
     mp->data->chunks          = NULL;
     mp->data->ops             = params->ops;
     mp->data->name            = ucs_strdup(params->name, "mpool_data_name");
+    /* Thread caches are allocated on first use */
+    mp->data->thread_cache_size = params->malloc_safe ? 0 :
+                                  params->thread_cache_size;
+    ucs_list_head_init(&mp->data->thread_caches);
 
     if (mp->data->name == NULL) {
         ucs_error("Failed to allocate memory pool data name");
@@ -131,6 +206,22 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
         goto err_free_name;
     }
 
+    status = ucs_spinlock_init(&mp->data->lock, 0);
+    if (status != UCS_OK) {
+        goto err_free_name;
+    }
+
+    if (mp->data->thread_cache_size > 0) {
+        ret = pthread_key_create(&mp->data->thread_cache_key,
+                                 ucs_mpool_thread_cache_destroy);
+        if (ret != 0) {
+            ucs_error("mpool %s: pthread_key_create() failed: %s",
+                      ucs_mpool_name(mp), strerror(ret));
+            status = UCS_ERR_NO_RESOURCE;
+            goto err_destroy_lock;
+        }
+    }
+
     VALGRIND_CREATE_MEMPOOL(mp, 0, 0);
 
     ucs_debug("mpool %s: align %zu, maxelems %u, elemsize %zu",
@@ -138,6 +229,8 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
               mp->data->elem_size);
     return UCS_OK;
 
+err_destroy_lock:
+    ucs_spinlock_destroy(&mp->data->lock);
 err_free_name:
     ucs_free(mp->data->name);
 err_strdup:
@@ -150,9 +243,21 @@ void ucs_mpool_cleanup(ucs_mpool_t *mp, int leak_check)
 {
     ucs_mpool_chunk_t *chunk, *next_chunk;
     ucs_mpool_elem_t *elem, *next_elem;
+    ucs_mpool_thread_cache_t *tc, *tmp_tc;
     ucs_mpool_data_t *data = mp->data;
     void *obj;
 
+    /* Return the objects cached by all threads to the freelist. After the key
+     * is deleted, the caches are not released anymore when threads exit.
+     */
+    if (data->thread_cache_size > 0) {
+        pthread_key_delete(data->thread_cache_key);
+        ucs_list_for_each_safe(tc, tmp_tc, &data->thread_caches, list) {
+            ucs_mpool_thread_cache_flush(mp, tc, 0);
+            ucs_free(tc);
+        }
+    }
+
     /* Cleanup all elements in the freelist and set their header to NULL to mark
      * them as released for the leak check.
      */
@@ -193,6 +298,7 @@ void ucs_mpool_cleanup(ucs_mpool_t *mp, int leak_check)
 
     ucs_debug("mpool %s destroyed", ucs_mpool_name(mp));
 
+    ucs_spinlock_destroy(&data->lock);
     ucs_free(data->name);
     ucs_free(data);
 }
@@ -222,6 +328,66 @@ void ucs_mpool_put(void *obj)
     ucs_mpool_put_inline(obj);
 }
 
+void *ucs_mpool_get_mt_refill(ucs_mpool_t *mp)
+{
+    ucs_mpool_data_t *data = mp->data;
+    ucs_mpool_thread_cache_t *tc;
+    ucs_mpool_elem_t *elem;
+    void *obj;
+
+    tc = ucs_mpool_thread_cache(mp);
+    if ((tc == NULL) && (data->thread_cache_size > 0)) {
+        tc = ucs_mpool_thread_cache_create(mp);
+    }
+
+    ucs_spin_lock(&data->lock);
+    if (tc != NULL) {
+        /* Move a batch of elements, leaving room for objects returned by the
+         * thread before the next flush */
+        while ((tc->count < ucs_max(data->thread_cache_size / 2, 1)) &&
+               (mp->freelist != NULL)) {
+            elem = mp->freelist;
+            VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+            mp->freelist = elem->next;
+            VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+            tc->elems[tc->count++] = elem;
+        }
+    }
+
+    if ((tc == NULL) || (tc->count == 0)) {
+        obj = ucs_mpool_get_inline(mp);
+    } else {
+        obj = ucs_mpool_thread_cache_pop(mp, tc);
+    }
+    ucs_spin_unlock(&data->lock);
+
+    return obj;
+}
+
+void ucs_mpool_put_mt_flush(ucs_mpool_t *mp, void *obj)
+{
+    ucs_mpool_data_t *data = mp->data;
+    ucs_mpool_elem_t *elem = ucs_mpool_obj_to_elem(obj);
+    ucs_mpool_thread_cache_t *tc;
+
+    tc = ucs_mpool_thread_cache(mp);
+    if ((tc == NULL) && (data->thread_cache_size > 0)) {
+        tc = ucs_mpool_thread_cache_create(mp);
+    }
+
+    ucs_spin_lock(&data->lock);
+    if (tc == NULL) {
+        ucs_mpool_add_to_freelist(mp, elem);
+    } else {
+        ucs_mpool_thread_cache_flush(mp, tc, data->thread_cache_size / 2);
+        tc->elems[tc->count++] = elem;
+    }
+    ucs_spin_unlock(&data->lock);
+
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    VALGRIND_MEMPOOL_FREE(mp, obj);
+}
+
 static void *ucs_mpool_chunk_elems(ucs_mpool_t *mp, ucs_mpool_chunk_t *chunk)
 {
     ucs_mpool_data_t *data = mp->data;
@@ -248,6 +414,8 @@ unsigned ucs_mpool_num_elems_per_chunk(ucs_mpool_t *mp,
 void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
 {
     ucs_mpool_data_t *data = mp->data;
+    ucs_status_t numa_status = UCS_ERR_UNSUPPORTED;
+    ucs_numa_policy_t prev_policy;
     size_t chunk_size;
     ucs_mpool_chunk_t *chunk;
     ucs_mpool_elem_t *elem;
@@ -260,6 +428,12 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
         return;
     }
 
+    /* Pages of the chunk are first touched while it is allocated and its
+     * elements are initialized, so they are placed on the preferred node */
+    if (data->numa_node != UCS_NUMA_NODE_UNDEFINED) {
+        numa_status = ucs_numa_policy_prefer(data->numa_node, &prev_policy);
+    }
+
     allocated_num_elems = ucs_min(data->quota, num_elems);
     chunk_size          = ucs_mpool_chunk_size(mp, allocated_num_elems);
     chunk_size          = ucs_min(chunk_size, data->max_chunk_size);
@@ -269,7 +443,7 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
             ucs_error("Failed to allocate memory pool (name=%s) chunk: %s",
                       ucs_mpool_name(mp), ucs_status_string(status));
         }
-        return;
+        goto out;
     }
 
     /* Calculate padding, and update element count according to allocated size */
@@ -302,6 +476,11 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
     }
 
     VALGRIND_MAKE_MEM_NOACCESS(chunk + 1, chunk_size - sizeof(*chunk));
+
+out:
+    if (numa_status == UCS_OK) {
+        ucs_numa_policy_restore(&prev_policy);
+    }
 }
 
 void *ucs_mpool_get_grow(ucs_mpool_t *mp)
@@ -342,13 +521,20 @@ typedef struct ucs_mmap_mpool_chunk_hdr {
 ucs_status_t ucs_mpool_chunk_mmap(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
 {
     ucs_mmap_mpool_chunk_hdr_t *chunk;
+    ucs_status_t status;
     size_t real_size;
 
-    real_size = ucs_align_up(*size_p + sizeof(*chunk), ucs_get_page_size());
-    chunk = ucs_mmap(NULL, real_size, PROT_READ|PROT_WRITE,
-                     MAP_PRIVATE|MAP_ANONYMOUS, -1, 0, ucs_mpool_name(mp));
-    if (chunk == MAP_FAILED) {
-        return UCS_ERR_NO_MEMORY;
+    chunk     = NULL;
+    real_size = *size_p + sizeof(*chunk);
+    if (mp->data->hugepages) {
+        status = ucs_mmap_alloc_hugepages(&real_size, (void**)&chunk,
+                                          ucs_mpool_name(mp));
+    } else {
+        status = ucs_mmap_alloc(&real_size, (void**)&chunk, 0,
+                                ucs_mpool_name(mp));
+    }
+    if (status != UCS_OK) {
+        return status;
     }
 
     chunk->size = real_size;
@@ -10,7 +10,12 @@
 #include <stddef.h>
 #include <ucs/type/status.h>
 #include <ucs/sys/compiler_def.h>
+#include <ucs/datastruct/list.h>
 #include <ucs/datastruct/string_buffer.h>
+#include <ucs/memory/numa.h>
+#include <ucs/type/spinlock.h>
+
+#include <pthread.h>
 
 
 BEGIN_C_DECLS
@@ -22,6 +27,7 @@ typedef union  ucs_mpool_elem    ucs_mpool_elem_t;
 typedef struct ucs_mpool         ucs_mpool_t;
 typedef struct ucs_mpool_data    ucs_mpool_data_t;
 typedef struct ucs_mpool_ops     ucs_mpool_ops_t;
+typedef struct ucs_mpool_thread_cache ucs_mpool_thread_cache_t;
 
 
 /**
@@ -82,10 +88,30 @@ struct ucs_mpool_data {
     unsigned               elems_per_chunk; /* Number of elements per chunk */
     unsigned               quota;           /* How many more elements can be allocated */
     int                    malloc_safe;     /* Avoid triggering malloc() during put/get */
+    int                    hugepages;       /* Back chunks by huge pages */
+    ucs_numa_node_t        numa_node;       /* NUMA node to allocate chunks on */
     ucs_mpool_elem_t       *tail;           /* Free list tail */
     ucs_mpool_chunk_t      *chunks;         /* List of allocated chunks */
     const ucs_mpool_ops_t  *ops;            /* Memory pool operations */
     char                   *name;           /* Name - used for debugging */
+    unsigned               thread_cache_size; /* Max. objects cached per thread */
+    pthread_key_t          thread_cache_key;  /* Per-thread object caches */
+    ucs_list_link_t        thread_caches;     /* List of per-thread caches */
+    ucs_spinlock_t         lock;              /* Protects the freelist when
+                                                 accessed by _mt functions */
+};
+
+
+/**
+ * Per-thread cache ("magazine") of free objects, used by the _mt get/put
+ * functions. It is refilled from and flushed to the pool freelist in batches
+ * of half its size, so most operations do not touch the shared freelist.
+ */
+struct ucs_mpool_thread_cache {
+    ucs_mpool_t            *mp;       /* Memory pool the cache belongs to */
+    ucs_list_link_t        list;      /* Entry in the pool list of caches */
+    unsigned               count;     /* Number of cached elements */
+    ucs_mpool_elem_t       *elems[0]; /* Cached elements */
 };
 
 
@@ -230,6 +256,26 @@ typedef struct ucs_mpool_params {
      */
     double                grow_factor;
 
+    /**
+     * NUMA node to allocate the memory of new chunks on, or
+     * UCS_NUMA_NODE_UNDEFINED to use the memory policy of the calling thread.
+     */
+    ucs_numa_node_t       numa_node;
+
+    /**
+     * Back the chunks by huge pages, if supported by the chunk allocator.
+     * @ref ucs_mpool_chunk_mmap uses MAP_HUGETLB, and falls back to
+     * transparent huge pages.
+     */
+    int                   hugepages;
+
+    /**
+     * Maximal number of free objects cached by each thread which uses
+     * @ref ucs_mpool_get_mt_inline and @ref ucs_mpool_put_mt_inline.
+     * 0 disables the per-thread cache.
+     */
+    unsigned              thread_cache_size;
+
     /**
      * Memory pool operations.
      */
@@ -335,6 +381,27 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems);
 void *ucs_mpool_get_grow(ucs_mpool_t *mp);
 
 
+/**
+ * Refill the cache of the calling thread from the memory pool and allocate an
+ * object from it. Used internally by ucs_mpool_get_mt_inline().
+ *
+ * @param mp               Memory pool structure.
+ *
+ * @return New allocated object, or NULL if cannot allocate.
+ */
+void *ucs_mpool_get_mt_refill(ucs_mpool_t *mp);
+
+
+/**
+ * Flush the cache of the calling thread to the memory pool and return the
+ * object to the cache. Used internally by ucs_mpool_put_mt_inline().
+ *
+ * @param mp               Memory pool the object belongs to.
+ * @param obj              Object to return.
+ */
+void ucs_mpool_put_mt_flush(ucs_mpool_t *mp, void *obj);
+
+
 /**
  * Return the number of elements in the chunk.
  * @param mp               Memory pool structure.
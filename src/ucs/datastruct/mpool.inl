@@ -81,4 +81,69 @@ static inline void ucs_mpool_put_inline(void *obj)
     VALGRIND_MEMPOOL_FREE(mp, obj);
 }
 
+static UCS_F_ALWAYS_INLINE ucs_mpool_thread_cache_t *
+ucs_mpool_thread_cache(ucs_mpool_t *mp)
+{
+    if (mp->data->thread_cache_size == 0) {
+        return NULL;
+    }
+
+    return (ucs_mpool_thread_cache_t*)pthread_getspecific(
+            mp->data->thread_cache_key);
+}
+
+static UCS_F_ALWAYS_INLINE void *
+ucs_mpool_thread_cache_pop(ucs_mpool_t *mp, ucs_mpool_thread_cache_t *tc)
+{
+    ucs_mpool_elem_t *elem;
+    void *obj;
+
+    elem = tc->elems[--tc->count];
+    VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+    elem->mpool = mp;
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+
+    obj = elem + 1;
+    VALGRIND_MEMPOOL_ALLOC(mp, obj, mp->data->elem_size - sizeof(ucs_mpool_elem_t));
+    return obj;
+}
+
+/*
+ * Get an object from the memory pool using the cache of the calling thread.
+ * May be called by several threads concurrently, as long as the pool is not
+ * accessed by the non-_mt functions at the same time.
+ */
+static inline void *ucs_mpool_get_mt_inline(ucs_mpool_t *mp)
+{
+    ucs_mpool_thread_cache_t *tc = ucs_mpool_thread_cache(mp);
+
+    if (ucs_unlikely((tc == NULL) || (tc->count == 0))) {
+        return ucs_mpool_get_mt_refill(mp);
+    }
+
+    return ucs_mpool_thread_cache_pop(mp, tc);
+}
+
+/*
+ * Return an object which was allocated by ucs_mpool_get_mt_inline() to the
+ * cache of the calling thread.
+ */
+static inline void ucs_mpool_put_mt_inline(void *obj)
+{
+    ucs_mpool_elem_t *elem = ucs_mpool_obj_to_elem(obj);
+    ucs_mpool_t *mp        = elem->mpool;
+    ucs_mpool_thread_cache_t *tc;
+
+    tc = ucs_mpool_thread_cache(mp);
+    if (ucs_unlikely((tc == NULL) ||
+                     (tc->count == mp->data->thread_cache_size))) {
+        ucs_mpool_put_mt_flush(mp, obj);
+        return;
+    }
+
+    tc->elems[tc->count++] = elem;
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    VALGRIND_MEMPOOL_FREE(mp, obj);
+}
+
 #endif
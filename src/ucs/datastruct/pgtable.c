@@ -65,6 +65,10 @@
         (ucs_pgt_dir_t*)ucs_pgt_entry_value(_pte); \
     })
 
+/* Maximal number of levels in the page table */
+#define UCS_PGT_MAX_LEVELS \
+    (((UCS_PGT_ADDR_ORDER - UCS_PGT_ADDR_SHIFT) / UCS_PGT_ENTRY_SHIFT) + 1)
+
 
 static inline ucs_pgt_dir_t* ucs_pgt_dir_alloc(ucs_pgtable_t *pgtable)
 {
@@ -77,6 +81,8 @@ static inline ucs_pgt_dir_t* ucs_pgt_dir_alloc(ucs_pgtable_t *pgtable)
 
     ucs_pgt_check_ptr(pgd);
     memset(pgd, 0, sizeof(*pgd));
+    /* Concurrent readers must not see stale entries after it is linked */
+    ucs_memory_cpu_store_fence();
     return pgd;
 }
 
@@ -85,6 +91,18 @@ static inline void ucs_pgt_dir_release(ucs_pgtable_t *pgtable, ucs_pgt_dir_t* pg
     pgtable->pgd_release_cb(pgtable, pgd);
 }
 
+static UCS_F_ALWAYS_INLINE void ucs_pgtable_write_begin(ucs_pgtable_t *pgtable)
+{
+    ++pgtable->seq;
+    ucs_memory_cpu_store_fence();
+}
+
+static UCS_F_ALWAYS_INLINE void ucs_pgtable_write_end(ucs_pgtable_t *pgtable)
+{
+    ucs_memory_cpu_store_fence();
+    ++pgtable->seq;
+}
+
 static inline void ucs_pgt_address_advance(ucs_pgt_addr_t *address_p,
                                            unsigned order)
 {
@@ -415,6 +433,7 @@ ucs_status_t ucs_pgtable_insert(ucs_pgtable_t *pgtable, ucs_pgt_region_t *region
     }
 
     ucs_assert(address != end);
+    ucs_pgtable_write_begin(pgtable);
     while (address < end) {
         order = ucs_pgtable_get_next_page_order(address, end);
         status = ucs_pgtable_insert_page(pgtable, address, order, region);
@@ -425,6 +444,7 @@ ucs_status_t ucs_pgtable_insert(ucs_pgtable_t *pgtable, ucs_pgt_region_t *region
         ucs_pgt_address_advance(&address, order);
     }
     ++pgtable->num_regions;
+    ucs_pgtable_write_end(pgtable);
 
     ucs_pgtable_trace(pgtable, "insert");
     return UCS_OK;
@@ -438,6 +458,7 @@ err:
         ucs_pgtable_remove_page(pgtable, address, order, region);
         ucs_pgt_address_advance(&address, order);
     }
+    ucs_pgtable_write_end(pgtable);
     return status;
 }
 
@@ -456,11 +477,13 @@ ucs_status_t ucs_pgtable_remove(ucs_pgtable_t *pgtable, ucs_pgt_region_t *region
         return UCS_ERR_NO_ELEM;
     }
 
+    ucs_pgtable_write_begin(pgtable);
     while (address < end) {
         order = ucs_pgtable_get_next_page_order(address, end);
         status = ucs_pgtable_remove_page(pgtable, address, order, region);
         if (status != UCS_OK) {
             ucs_assert(address == region->start); /* Cannot be partially removed */
+            ucs_pgtable_write_end(pgtable);
             return status;
         }
 
@@ -469,6 +492,7 @@ ucs_status_t ucs_pgtable_remove(ucs_pgtable_t *pgtable, ucs_pgt_region_t *region
 
     ucs_assert(pgtable->num_regions > 0);
     --pgtable->num_regions;
+    ucs_pgtable_write_end(pgtable);
 
     ucs_pgtable_trace(pgtable, "remove");
     return UCS_OK;
@@ -507,6 +531,40 @@ ucs_pgt_region_t *ucs_pgtable_lookup(const ucs_pgtable_t *pgtable,
     }
 }
 
+ucs_pgt_region_t *ucs_pgtable_lookup_concurrent(const ucs_pgtable_t *pgtable,
+                                                ucs_pgt_addr_t address)
+{
+    const ucs_pgt_dir_t *dir;
+    ucs_pgt_addr_t value;
+    unsigned shift, level;
+
+    /* Every field is read exactly once, and may be inconsistent with the
+     * others if the page table is being modified. Such a result is rejected
+     * by ucs_pgtable_read_validate(), so here it only must not crash. */
+    if ((address & pgtable->mask) != pgtable->base) {
+        return NULL;
+    }
+
+    value = *(volatile const ucs_pgt_addr_t*)&pgtable->root.value;
+    shift = pgtable->shift;
+    for (level = 0; level < UCS_PGT_MAX_LEVELS; ++level) {
+        if (value & UCS_PGT_ENTRY_FLAG_REGION) {
+            return (ucs_pgt_region_t*)(value & UCS_PGT_ENTRY_PTR_MASK);
+        } else if (!(value & UCS_PGT_ENTRY_FLAG_DIR) ||
+                   (shift < UCS_PGT_ENTRY_SHIFT)) {
+            break;
+        }
+
+        dir    = (const ucs_pgt_dir_t*)(value & UCS_PGT_ENTRY_PTR_MASK);
+        shift -= UCS_PGT_ENTRY_SHIFT;
+        value  = *(volatile const ucs_pgt_addr_t*)
+                         &dir->entries[(address >> shift) &
+                                       UCS_PGT_ENTRY_MASK].value;
+    }
+
+    return NULL;
+}
+
 static void ucs_pgtable_search_recurs(const ucs_pgtable_t *pgtable,
                                       ucs_pgt_addr_t address, unsigned order,
                                       const ucs_pgt_entry_t *pte, unsigned shift,
@@ -671,6 +729,7 @@ ucs_status_t ucs_pgtable_init(ucs_pgtable_t *pgtable,
     ucs_pgt_entry_clear(&pgtable->root);
     ucs_pgtable_reset(pgtable);
     pgtable->num_regions    = 0;
+    pgtable->seq            = 0;
     pgtable->pgd_alloc_cb   = alloc_cb;
     pgtable->pgd_release_cb = release_cb;
     return UCS_OK;
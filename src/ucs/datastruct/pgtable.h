@@ -7,6 +7,7 @@
 #ifndef UCS_PGTABLE_H_
 #define UCS_PGTABLE_H_
 
+#include <ucs/arch/cpu.h>
 #include <ucs/config/types.h>
 #include <ucs/sys/compiler_def.h>
 #include <ucs/type/status.h>
@@ -19,6 +20,11 @@
  * UCS_PGT_PTE_FLAG_REGION bit), or another entry (indicated by UCS_PGT_PTE_FLAG_DIR),
  * or be empty - if none of these bits is set.
  *
+ * Modifications of the page table must be serialized by the user. Lookups may
+ * run concurrently with modifications by using @ref ucs_pgtable_read_begin,
+ * @ref ucs_pgtable_lookup_concurrent and @ref ucs_pgtable_read_validate, as
+ * long as released directories and removed regions remain readable until all
+ * such lookups are done.
  */
 
 
@@ -140,6 +146,8 @@ struct ucs_pgtable {
     ucs_pgt_addr_t                 mask;        /**< mask for page table address range */
     unsigned                       shift;       /**< page table address span is 2**shift */
     unsigned                       num_regions; /**< total number of regions */
+    volatile unsigned long         seq;         /**< modification sequence number,
+                                                     odd while being modified */
     ucs_pgt_dir_alloc_callback_t   pgd_alloc_cb;
     ucs_pgt_dir_release_callback_t pgd_release_cb;
 };
@@ -209,6 +217,20 @@ ucs_pgt_region_t *ucs_pgtable_lookup(const ucs_pgtable_t *pgtable,
                                      ucs_pgt_addr_t address);
 
 
+/*
+ * Find a region which contains the given address, while the page table may be
+ * modified concurrently by another thread. The result is meaningful only if
+ * @ref ucs_pgtable_read_validate succeeds afterwards.
+ *
+ * @param [in]  pgtable     Page table to search the address in.
+ * @param [in]  address     Address to search.
+ *
+ * @return Region which contains 'address', or NULL if not found.
+ */
+ucs_pgt_region_t *ucs_pgtable_lookup_concurrent(const ucs_pgtable_t *pgtable,
+                                                ucs_pgt_addr_t address);
+
+
 /**
  * Search for all regions overlapping with a given address range.
  *
@@ -255,4 +277,38 @@ static inline unsigned ucs_pgtable_num_regions(const ucs_pgtable_t *pgtable)
 }
 
 
+/**
+ * Start a read section which may run concurrently with page table
+ * modifications.
+ *
+ * @param [in]  pgtable      Page table to read.
+ *
+ * @return Sequence number to pass to @ref ucs_pgtable_read_validate.
+ */
+static UCS_F_ALWAYS_INLINE unsigned long
+ucs_pgtable_read_begin(const ucs_pgtable_t *pgtable)
+{
+    unsigned long seq = pgtable->seq;
+
+    ucs_memory_cpu_load_fence();
+    return seq;
+}
+
+
+/**
+ * Check that the page table was not modified since the read section started.
+ *
+ * @param [in]  pgtable      Page table which was read.
+ * @param [in]  seq          Value returned by @ref ucs_pgtable_read_begin.
+ *
+ * @return Nonzero if everything read from the page table is consistent.
+ */
+static UCS_F_ALWAYS_INLINE int
+ucs_pgtable_read_validate(const ucs_pgtable_t *pgtable, unsigned long seq)
+{
+    ucs_memory_cpu_load_fence();
+    return !(seq & 1) && (seq == pgtable->seq);
+}
+
+
 #endif
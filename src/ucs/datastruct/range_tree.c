@@ -0,0 +1,389 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "range_tree.h"
+
+#include <ucs/debug/assert.h>
+#include <ucs/debug/log.h>
+#include <ucs/sys/math.h>
+
+
+static UCS_F_ALWAYS_INLINE int
+ucs_range_tree_node_height(const ucs_range_tree_node_t *node)
+{
+    return (node == NULL) ? 0 : node->height;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucs_range_tree_node_update(ucs_range_tree_node_t *node)
+{
+    node->height = ucs_max(ucs_range_tree_node_height(node->left),
+                           ucs_range_tree_node_height(node->right)) + 1;
+}
+
+static ucs_range_tree_node_t *
+ucs_range_tree_rotate_right(ucs_range_tree_node_t *node)
+{
+    ucs_range_tree_node_t *left = node->left;
+
+    node->left  = left->right;
+    left->right = node;
+    ucs_range_tree_node_update(node);
+    ucs_range_tree_node_update(left);
+    return left;
+}
+
+static ucs_range_tree_node_t *
+ucs_range_tree_rotate_left(ucs_range_tree_node_t *node)
+{
+    ucs_range_tree_node_t *right = node->right;
+
+    node->right = right->left;
+    right->left = node;
+    ucs_range_tree_node_update(node);
+    ucs_range_tree_node_update(right);
+    return right;
+}
+
+/**
+ * Restore the balance of a subtree whose children heights differ by at most 2.
+ *
+ * @return New root of the subtree.
+ */
+static ucs_range_tree_node_t *
+ucs_range_tree_balance(ucs_range_tree_node_t *node)
+{
+    int diff;
+
+    ucs_range_tree_node_update(node);
+    diff = ucs_range_tree_node_height(node->left) -
+           ucs_range_tree_node_height(node->right);
+
+    if (diff > 1) {
+        if (ucs_range_tree_node_height(node->left->left) <
+            ucs_range_tree_node_height(node->left->right)) {
+            node->left = ucs_range_tree_rotate_left(node->left);
+        }
+        return ucs_range_tree_rotate_right(node);
+    } else if (diff < -1) {
+        if (ucs_range_tree_node_height(node->right->right) <
+            ucs_range_tree_node_height(node->right->left)) {
+            node->right = ucs_range_tree_rotate_right(node->right);
+        }
+        return ucs_range_tree_rotate_left(node);
+    }
+
+    return node;
+}
+
+/**
+ * @return The node of the last region which starts at or before 'address', or
+ *         NULL if there is no such region.
+ */
+static ucs_range_tree_node_t *
+ucs_range_tree_floor(const ucs_range_tree_t *tree, ucs_pgt_addr_t address)
+{
+    ucs_range_tree_node_t *node = tree->root;
+    ucs_range_tree_node_t *result = NULL;
+
+    while (node != NULL) {
+        if (node->region->start <= address) {
+            result = node;
+            node   = node->right;
+        } else {
+            node   = node->left;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @return The first region which overlaps with [from..to], or NULL if there is
+ *         no such region.
+ */
+static ucs_pgt_region_t *
+ucs_range_tree_first_overlap(const ucs_range_tree_t *tree, ucs_pgt_addr_t from,
+                             ucs_pgt_addr_t to)
+{
+    ucs_range_tree_node_t *node = tree->root;
+    ucs_pgt_region_t *result    = NULL;
+
+    /* The regions do not overlap, so they are sorted by their end addresses as
+     * well. Find the first region which ends after 'from'. */
+    while (node != NULL) {
+        if (node->region->end > from) {
+            result = node->region;
+            node   = node->left;
+        } else {
+            node   = node->right;
+        }
+    }
+
+    return ((result != NULL) && (result->start <= to)) ? result : NULL;
+}
+
+static ucs_range_tree_node_t *
+ucs_range_tree_insert_recurs(ucs_range_tree_node_t *node,
+                             ucs_range_tree_node_t *new_node)
+{
+    if (node == NULL) {
+        return new_node;
+    }
+
+    if (new_node->region->start < node->region->start) {
+        node->left  = ucs_range_tree_insert_recurs(node->left, new_node);
+    } else {
+        node->right = ucs_range_tree_insert_recurs(node->right, new_node);
+    }
+
+    return ucs_range_tree_balance(node);
+}
+
+static ucs_range_tree_node_t *
+ucs_range_tree_remove_min(ucs_range_tree_node_t *node,
+                          ucs_range_tree_node_t **min_p)
+{
+    if (node->left == NULL) {
+        *min_p = node;
+        return node->right;
+    }
+
+    node->left = ucs_range_tree_remove_min(node->left, min_p);
+    return ucs_range_tree_balance(node);
+}
+
+/*
+ * `region' is only used to compare pointers
+ */
+static ucs_range_tree_node_t *
+ucs_range_tree_remove_recurs(ucs_range_tree_node_t *node,
+                             const ucs_pgt_region_t *region,
+                             ucs_range_tree_node_t **removed_p)
+{
+    ucs_range_tree_node_t *min;
+
+    if (node == NULL) {
+        return NULL;
+    }
+
+    if (region->start < node->region->start) {
+        node->left  = ucs_range_tree_remove_recurs(node->left, region,
+                                                   removed_p);
+    } else if (region->start > node->region->start) {
+        node->right = ucs_range_tree_remove_recurs(node->right, region,
+                                                   removed_p);
+    } else if (node->region != region) {
+        return node;
+    } else {
+        *removed_p = node;
+        if (node->right == NULL) {
+            return node->left;
+        }
+
+        /* Replace the node by its successor */
+        node->right = ucs_range_tree_remove_min(node->right, &min);
+        min->left   = node->left;
+        min->right  = node->right;
+        node        = min;
+    }
+
+    return ucs_range_tree_balance(node);
+}
+
+static void ucs_range_tree_search_recurs(const ucs_range_tree_t *tree,
+                                         ucs_range_tree_node_t *node,
+                                         ucs_pgt_addr_t from, ucs_pgt_addr_t to,
+                                         ucs_range_tree_search_callback_t cb,
+                                         void *arg)
+{
+    ucs_pgt_region_t *region;
+
+    if (node == NULL) {
+        return;
+    }
+
+    /* Regions in the left subtree end before this one starts, and regions in
+     * the right subtree start after this one ends */
+    region = node->region;
+    if (region->end > from) {
+        ucs_range_tree_search_recurs(tree, node->left, from, to, cb, arg);
+        if (region->start <= to) {
+            cb(tree, region, arg);
+        }
+    }
+
+    if (region->start <= to) {
+        ucs_range_tree_search_recurs(tree, node->right, from, to, cb, arg);
+    }
+}
+
+static void ucs_range_tree_purge_recurs(ucs_range_tree_t *tree,
+                                        ucs_range_tree_node_t *node,
+                                        ucs_range_tree_search_callback_t cb,
+                                        void *arg)
+{
+    ucs_pgt_region_t *region;
+
+    if (node == NULL) {
+        return;
+    }
+
+    ucs_range_tree_purge_recurs(tree, node->left, cb, arg);
+    ucs_range_tree_purge_recurs(tree, node->right, cb, arg);
+
+    region = node->region;
+    tree->node_release_cb(tree, node);
+    cb(tree, region, arg);
+}
+
+static void ucs_range_tree_dump_recurs(const ucs_range_tree_node_t *node,
+                                       unsigned indent,
+                                       ucs_log_level_t log_level)
+{
+    if (node == NULL) {
+        return;
+    }
+
+    ucs_range_tree_dump_recurs(node->left, indent + 2, log_level);
+    ucs_log(log_level, "%*sregion " UCS_PGT_REGION_FMT " height %d", indent,
+            "", UCS_PGT_REGION_ARG(node->region), node->height);
+    ucs_range_tree_dump_recurs(node->right, indent + 2, log_level);
+}
+
+void ucs_range_tree_dump(const ucs_range_tree_t *tree,
+                         ucs_log_level_t log_level)
+{
+    ucs_log(log_level, "range tree %p: count %u", tree, tree->num_regions);
+    ucs_range_tree_dump_recurs(tree->root, 0, log_level);
+}
+
+ucs_status_t ucs_range_tree_insert(ucs_range_tree_t *tree,
+                                   ucs_pgt_region_t *region)
+{
+    ucs_range_tree_node_t *node;
+
+    ucs_trace_func("add region " UCS_PGT_REGION_FMT,
+                   UCS_PGT_REGION_ARG(region));
+
+    if (region->start >= region->end) {
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    /* Only the last region which starts before the end of the new one may
+     * overlap with it */
+    node = ucs_range_tree_floor(tree, region->end - 1);
+    if ((node != NULL) && (node->region->end > region->start)) {
+        return UCS_ERR_ALREADY_EXISTS;
+    }
+
+    node = tree->node_alloc_cb(tree);
+    if (node == NULL) {
+        ucs_error("failed to allocate range tree node");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    node->region = region;
+    node->left   = NULL;
+    node->right  = NULL;
+    node->height = 1;
+
+    tree->root = ucs_range_tree_insert_recurs(tree->root, node);
+    ++tree->num_regions;
+    return UCS_OK;
+}
+
+ucs_status_t ucs_range_tree_remove(ucs_range_tree_t *tree,
+                                   ucs_pgt_region_t *region)
+{
+    ucs_range_tree_node_t *removed = NULL;
+
+    ucs_trace_func("remove region " UCS_PGT_REGION_FMT,
+                   UCS_PGT_REGION_ARG(region));
+
+    tree->root = ucs_range_tree_remove_recurs(tree->root, region, &removed);
+    if (removed == NULL) {
+        return UCS_ERR_NO_ELEM;
+    }
+
+    ucs_assert(tree->num_regions > 0);
+    --tree->num_regions;
+    tree->node_release_cb(tree, removed);
+    return UCS_OK;
+}
+
+ucs_pgt_region_t *ucs_range_tree_lookup(const ucs_range_tree_t *tree,
+                                        ucs_pgt_addr_t address)
+{
+    ucs_range_tree_node_t *node = ucs_range_tree_floor(tree, address);
+
+    ucs_trace_func("tree=%p address=0x%lx", tree, address);
+
+    if ((node == NULL) || (address >= node->region->end)) {
+        return NULL;
+    }
+
+    return node->region;
+}
+
+void ucs_range_tree_search_range(const ucs_range_tree_t *tree,
+                                 ucs_pgt_addr_t from, ucs_pgt_addr_t to,
+                                 ucs_range_tree_search_callback_t cb,
+                                 void *arg)
+{
+    ucs_range_tree_search_recurs(tree, tree->root, from, to, cb, arg);
+}
+
+unsigned ucs_range_tree_remove_range(ucs_range_tree_t *tree,
+                                     ucs_pgt_addr_t from, ucs_pgt_addr_t to,
+                                     ucs_range_tree_search_callback_t cb,
+                                     void *arg)
+{
+    unsigned count = 0;
+    ucs_pgt_region_t *region;
+    ucs_status_t status;
+
+    while ((region = ucs_range_tree_first_overlap(tree, from, to)) != NULL) {
+        status = ucs_range_tree_remove(tree, region);
+        ucs_assert_always(status == UCS_OK);
+        cb(tree, region, arg);
+        ++count;
+    }
+
+    return count;
+}
+
+void ucs_range_tree_purge(ucs_range_tree_t *tree,
+                          ucs_range_tree_search_callback_t cb, void *arg)
+{
+    ucs_range_tree_node_t *root = tree->root;
+
+    tree->root        = NULL;
+    tree->num_regions = 0;
+    ucs_range_tree_purge_recurs(tree, root, cb, arg);
+}
+
+ucs_status_t ucs_range_tree_init(ucs_range_tree_t *tree,
+                                 ucs_range_tree_node_alloc_callback_t alloc_cb,
+                                 ucs_range_tree_node_release_callback_t release_cb)
+{
+    tree->root            = NULL;
+    tree->num_regions     = 0;
+    tree->node_alloc_cb   = alloc_cb;
+    tree->node_release_cb = release_cb;
+    return UCS_OK;
+}
+
+void ucs_range_tree_cleanup(ucs_range_tree_t *tree)
+{
+    if (tree->num_regions != 0) {
+        ucs_warn("range tree not empty during cleanup");
+    }
+}
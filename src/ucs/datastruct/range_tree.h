@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCS_RANGE_TREE_H_
+#define UCS_RANGE_TREE_H_
+
+#include <ucs/datastruct/pgtable.h>
+#include <ucs/sys/compiler_def.h>
+#include <ucs/type/status.h>
+
+BEGIN_C_DECLS
+
+/*
+ * The Range Tree organizes non-overlapping regions of memory in a balanced
+ * (AVL) binary search tree, sorted by the region start address. Unlike the
+ * page table, every region occupies a single tree node regardless of its size
+ * and alignment, so all operations take O(log n) time, where n is the number
+ * of regions. It provides the same set of operations as the page table, and
+ * also removal of all regions overlapping with a given address range.
+ *
+ * Modifications and lookups of the range tree must be serialized by the user.
+ */
+
+
+/* Forward declarations */
+typedef struct ucs_range_tree      ucs_range_tree_t;
+typedef struct ucs_range_tree_node ucs_range_tree_node_t;
+
+
+/**
+ * Callback for allocating a range tree node.
+ *
+ * @param [in]  tree     Pointer to the range tree to allocate the node for.
+ *
+ * @return Pointer to newly allocated node, or NULL if failed.
+ */
+typedef ucs_range_tree_node_t*
+(*ucs_range_tree_node_alloc_callback_t)(const ucs_range_tree_t *tree);
+
+
+/**
+ * Callback for releasing a range tree node.
+ *
+ * @param [in]  tree     Pointer to the range tree in which the node was
+ *                       allocated.
+ * @param [in]  node     Range tree node to release.
+ */
+typedef void
+(*ucs_range_tree_node_release_callback_t)(const ucs_range_tree_t *tree,
+                                          ucs_range_tree_node_t *node);
+
+
+/**
+ * Callback for searching for regions in the range tree.
+ *
+ * @param [in]  tree     The range tree.
+ * @param [in]  region   Found region.
+ * @param [in]  arg      User-defined argument.
+ */
+typedef void (*ucs_range_tree_search_callback_t)(const ucs_range_tree_t *tree,
+                                                 ucs_pgt_region_t *region,
+                                                 void *arg);
+
+
+/**
+ * Range tree node.
+ */
+struct ucs_range_tree_node {
+    ucs_pgt_region_t      *region; /**< Region stored in the node */
+    ucs_range_tree_node_t *left;   /**< Subtree of the preceding regions */
+    ucs_range_tree_node_t *right;  /**< Subtree of the following regions */
+    int                   height;  /**< Height of the subtree */
+};
+
+
+/* Range tree structure */
+struct ucs_range_tree {
+    ucs_range_tree_node_t                  *root;        /**< Root node */
+    unsigned                               num_regions;  /**< Total number of
+                                                              regions */
+    ucs_range_tree_node_alloc_callback_t   node_alloc_cb;
+    ucs_range_tree_node_release_callback_t node_release_cb;
+};
+
+
+/**
+ * Initialize a range tree.
+ *
+ * @param [in]  tree        Range tree to initialize.
+ * @param [in]  alloc_cb    Callback that will be used to allocate tree nodes.
+ *                           This may allow the range tree functions to be safe
+ *                           to use from memory allocation context.
+ * @param [in]  release_cb  Callback to release memory which was allocated by
+ *                           alloc_cb.
+ */
+ucs_status_t ucs_range_tree_init(ucs_range_tree_t *tree,
+                                 ucs_range_tree_node_alloc_callback_t alloc_cb,
+                                 ucs_range_tree_node_release_callback_t release_cb);
+
+
+/**
+ * Cleanup the range tree.
+ *
+ * @param [in]  tree        Range tree to cleanup.
+ */
+void ucs_range_tree_cleanup(ucs_range_tree_t *tree);
+
+
+/**
+ * Add a memory region to the range tree.
+ *
+ * @param [in]  tree        Range tree to insert the region to.
+ * @param [in]  region      Memory region to insert. The region must remain valid
+ *                           and unchanged as long as it's in the range tree.
+ *
+ * @return UCS_OK - region was added.
+ *         UCS_ERR_INVALID_PARAM - memory region is empty.
+ *         UCS_ERR_ALREADY_EXISTS - the region overlaps with existing region.
+ *         UCS_ERR_NO_MEMORY - failed to allocate a tree node.
+ */
+ucs_status_t ucs_range_tree_insert(ucs_range_tree_t *tree,
+                                   ucs_pgt_region_t *region);
+
+
+/**
+ * Remove a memory region from the range tree.
+ *
+ * @param [in]  tree        Range tree to remove the region from.
+ * @param [in]  region      Memory region to remove. This must be the same
+ *                           pointer passed to @ref ucs_range_tree_insert.
+ *
+ * @return UCS_OK - region was removed.
+ *         UCS_ERR_NO_ELEM - the region was not found.
+ */
+ucs_status_t ucs_range_tree_remove(ucs_range_tree_t *tree,
+                                   ucs_pgt_region_t *region);
+
+
+/**
+ * Find a region which contains the given address.
+ *
+ * @param [in]  tree        Range tree to search the address in.
+ * @param [in]  address     Address to search.
+ *
+ * @return Region which contains 'address', or NULL if not found.
+ */
+ucs_pgt_region_t *ucs_range_tree_lookup(const ucs_range_tree_t *tree,
+                                        ucs_pgt_addr_t address);
+
+
+/**
+ * Search for all regions overlapping with a given address range.
+ *
+ * @param [in]  tree        Range tree to search the range in.
+ * @param [in]  from        Lower bound of the range.
+ * @param [in]  to          Upper bound of the range (inclusive).
+ * @param [in]  cb          Callback to be called for every region found, in
+ *                           ascending order of addresses.
+ *                           The callback must not modify the range tree.
+ * @param [in]  arg         User-defined argument to the callback.
+ */
+void ucs_range_tree_search_range(const ucs_range_tree_t *tree,
+                                 ucs_pgt_addr_t from, ucs_pgt_addr_t to,
+                                 ucs_range_tree_search_callback_t cb,
+                                 void *arg);
+
+
+/**
+ * Remove all regions overlapping with a given address range, and call the
+ * provided callback for each of them.
+ *
+ * @param [in]  tree        Range tree to remove the regions from.
+ * @param [in]  from        Lower bound of the range.
+ * @param [in]  to          Upper bound of the range (inclusive).
+ * @param [in]  cb          Callback to be called for every region, after it is
+ *                           removed, in ascending order of addresses.
+ *                           The callback must not modify the range tree.
+ * @param [in]  arg         User-defined argument to the callback.
+ *
+ * @return Number of removed regions.
+ */
+unsigned ucs_range_tree_remove_range(ucs_range_tree_t *tree,
+                                     ucs_pgt_addr_t from, ucs_pgt_addr_t to,
+                                     ucs_range_tree_search_callback_t cb,
+                                     void *arg);
+
+
+/**
+ * Remove all regions from the range tree and call the provided callback for
+ * each.
+ *
+ * @param [in]  tree        Range tree to clean up.
+ * @param [in]  cb          Callback to be called for every region, after it (and
+ *                           all others) are removed.
+ *                           The callback must not modify the range tree.
+ * @param [in]  arg         User-defined argument to the callback.
+ */
+void ucs_range_tree_purge(ucs_range_tree_t *tree,
+                          ucs_range_tree_search_callback_t cb, void *arg);
+
+
+/**
+ * Dump range tree to log.
+ *
+ * @param [in]  tree         Range tree to dump.
+ * @param [in]  log_level    Which log level to use.
+ */
+void ucs_range_tree_dump(const ucs_range_tree_t *tree,
+                         ucs_log_level_t log_level);
+
+
+/**
+ * @return Number of regions currently present in the range tree.
+ */
+static inline unsigned ucs_range_tree_num_regions(const ucs_range_tree_t *tree)
+{
+    return tree->num_regions;
+}
+
+END_C_DECLS
+
+#endif
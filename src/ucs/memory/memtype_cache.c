@@ -20,6 +20,7 @@
 #include <ucs/sys/sys.h>
 #include <ucs/sys/ptr_arith.h>
 #include <ucm/api/ucm.h>
+#include <string.h>
 
 
 static ucs_spinlock_t ucs_memtype_cache_global_instance_lock;
@@ -100,6 +101,64 @@ ucs_memory_info_set_unknown(ucs_memory_info_t *mem_info)
     mem_info->alloc_length = -1;
 }
 
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_memtype_cache_filter_index(ucs_pgt_addr_t granule)
+{
+    /* Fibonacci hashing, to spread adjacent granules across the filter */
+    return (granule * 0x9e3779b97f4a7c15ul) >>
+           (UCS_PGT_ADDR_ORDER - UCS_MEMTYPE_CACHE_FILTER_BITS);
+}
+
+/*
+ * Account a region which is added to or removed from the page table in the
+ * lookup filter. Lock must be held.
+ */
+static void ucs_memtype_cache_filter_update(ucs_memtype_cache_t *memtype_cache,
+                                            const ucs_pgt_region_t *region,
+                                            int delta)
+{
+    ucs_pgt_addr_t first = region->start >> UCS_MEMTYPE_CACHE_FILTER_SHIFT;
+    ucs_pgt_addr_t last  = (region->end - 1) >> UCS_MEMTYPE_CACHE_FILTER_SHIFT;
+    ucs_pgt_addr_t granule;
+
+    if ((last - first) >= UCS_BIT(UCS_MEMTYPE_CACHE_FILTER_BITS)) {
+        /* Region covers all buckets anyway */
+        memtype_cache->num_wide_regions += delta;
+        return;
+    }
+
+    for (granule = first; granule <= last; ++granule) {
+        memtype_cache->filter[ucs_memtype_cache_filter_index(granule)] += delta;
+    }
+}
+
+/*
+ * Check without taking the lock whether the address is definitely not a part
+ * of any region in the page table. Returns 0 if not sure, for example if the
+ * page table is being updated concurrently.
+ */
+static UCS_F_ALWAYS_INLINE int
+ucs_memtype_cache_is_host(const ucs_memtype_cache_t *memtype_cache,
+                          ucs_pgt_addr_t address)
+{
+    uint64_t version = memtype_cache->version;
+    unsigned index;
+    int is_host;
+
+    if (version & 1) {
+        return 0;
+    }
+
+    ucs_memory_cpu_load_fence();
+    index   = ucs_memtype_cache_filter_index(address >>
+                                             UCS_MEMTYPE_CACHE_FILTER_SHIFT);
+    is_host = (memtype_cache->num_wide_regions == 0) &&
+              (memtype_cache->filter[index] == 0);
+    ucs_memory_cpu_load_fence();
+
+    return is_host && (memtype_cache->version == version);
+}
+
 static ucs_pgt_dir_t *ucs_memtype_cache_pgt_dir_alloc(const ucs_pgtable_t *pgtable)
 {
     void *ptr;
@@ -158,6 +217,8 @@ static void ucs_memtype_cache_insert(ucs_memtype_cache_t *memtype_cache,
         return;
     }
 
+    ucs_memtype_cache_filter_update(memtype_cache, &region->super, 1);
+
     ucs_trace("memtype_cache: insert " UCS_MEMTYPE_CACHE_REGION_FMT,
               UCS_MEMTYPE_CACHE_REGION_ARG(region));
 }
@@ -202,6 +263,11 @@ UCS_PROFILE_FUNC_VOID(ucs_memtype_cache_update_internal,
 
     ucs_spin_lock(&memtype_cache->lock);
 
+    /* Readers of the lookup filter retry under the lock while the version is
+     * odd, since the regions are removed and inserted back non-atomically */
+    ++memtype_cache->version;
+    ucs_memory_cpu_store_fence();
+
     /* find and remove all regions which intersect with new one */
     ucs_pgtable_search_range(&memtype_cache->pgtable, search_start, search_end,
                              ucs_memtype_cache_region_collect_callback,
@@ -233,6 +299,8 @@ UCS_PROFILE_FUNC_VOID(ucs_memtype_cache_update_internal,
             goto out_unlock;
         }
 
+        ucs_memtype_cache_filter_update(memtype_cache, &region->super, -1);
+
         ucs_trace("memtype_cache: removed " UCS_MEMTYPE_CACHE_REGION_FMT,
                   UCS_MEMTYPE_CACHE_REGION_ARG(region));
     }
@@ -260,6 +328,8 @@ UCS_PROFILE_FUNC_VOID(ucs_memtype_cache_update_internal,
     }
 
 out_unlock:
+    ucs_memory_cpu_store_fence();
+    ++memtype_cache->version;
     ucs_spin_unlock(&memtype_cache->lock);
 }
 
@@ -335,6 +405,10 @@ UCS_PROFILE_FUNC(ucs_status_t, ucs_memtype_cache_lookup,
         return UCS_ERR_UNSUPPORTED;
     }
 
+    if (ucs_likely(ucs_memtype_cache_is_host(memtype_cache, start))) {
+        return UCS_ERR_NO_ELEM;
+    }
+
     ucs_spin_lock(&memtype_cache->lock);
 
     pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &memtype_cache->pgtable,
@@ -382,6 +456,10 @@ static UCS_CLASS_INIT_FUNC(ucs_memtype_cache_t)
         goto err;
     }
 
+    self->version          = 0;
+    self->num_wide_regions = 0;
+    memset(self->filter, 0, sizeof(self->filter));
+
     status = ucs_pgtable_init(&self->pgtable, ucs_memtype_cache_pgt_dir_alloc,
                               ucs_memtype_cache_pgt_dir_release);
     if (status != UCS_OK) {
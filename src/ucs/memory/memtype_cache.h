@@ -20,6 +20,13 @@
 
 BEGIN_C_DECLS
 
+
+/* Every bucket of the lookup filter counts the regions overlapping with
+ * 2^UCS_MEMTYPE_CACHE_FILTER_SHIFT bytes-sized address granules hashed to it */
+#define UCS_MEMTYPE_CACHE_FILTER_SHIFT 21
+#define UCS_MEMTYPE_CACHE_FILTER_BITS  12
+
+
 typedef struct ucs_memtype_cache         ucs_memtype_cache_t;
 typedef struct ucs_memtype_cache_region  ucs_memtype_cache_region_t;
 
@@ -40,6 +47,13 @@ typedef struct ucs_memory_info {
 struct ucs_memtype_cache {
     ucs_spinlock_t        lock;       /**< protests the page table */
     ucs_pgtable_t         pgtable;    /**< Page table to hold the regions */
+    volatile uint64_t     version;    /**< Odd while the page table is updated */
+    unsigned              num_wide_regions; /**< Regions which are too large
+                                                 to be counted in the filter */
+    uint32_t              filter[UCS_BIT(UCS_MEMTYPE_CACHE_FILTER_BITS)];
+                                      /**< Lock-free lookup filter, a bucket
+                                           is zero if none of the regions
+                                           overlaps with its granules */
 };
 
 
@@ -16,9 +16,13 @@
 #include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
 #include <ucs/type/spinlock.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
 #include <stdint.h>
 #include <sched.h>
 #include <dirent.h>
+#include <string.h>
+#include <unistd.h>
 
 #define UCS_NUMA_MIN_DISTANCE       10
 #define UCS_NUMA_NODE_MAX           INT16_MAX
@@ -151,6 +155,35 @@ ucs_numa_node_t ucs_numa_node_of_cpu(int cpu)
     return cpu_numa_node[cpu] - 1;
 }
 
+ucs_numa_node_t ucs_numa_node_of_thread(void)
+{
+    ucs_numa_node_t node = UCS_NUMA_NODE_UNDEFINED;
+    ucs_numa_node_t cpu_node;
+    ucs_sys_cpuset_t cpu_mask;
+    unsigned cpu, num_cpus;
+
+    if (ucs_sys_getaffinity(&cpu_mask) != 0) {
+        return UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    num_cpus = ucs_min(ucs_numa_num_configured_cpus(), __CPU_SETSIZE);
+    for (cpu = 0; cpu < num_cpus; ++cpu) {
+        if (!CPU_ISSET(cpu, &cpu_mask)) {
+            continue;
+        }
+
+        cpu_node = ucs_numa_node_of_cpu(cpu);
+        if (node == UCS_NUMA_NODE_UNDEFINED) {
+            node = cpu_node;
+        } else if (node != cpu_node) {
+            /* Thread may run on several nodes */
+            return UCS_NUMA_NODE_UNDEFINED;
+        }
+    }
+
+    return node;
+}
+
 ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path)
 {
     long parsed_node;
@@ -253,6 +286,49 @@ ucs_numa_distance(ucs_numa_node_t node1, ucs_numa_node_t node2)
     return distance;
 }
 
+ucs_status_t
+ucs_numa_policy_prefer(ucs_numa_node_t node, ucs_numa_policy_t *prev_policy)
+{
+#if defined(__NR_get_mempolicy) && defined(__NR_set_mempolicy)
+    ucs_numa_policy_t policy;
+
+    if ((node < 0) || (node >= UCS_NUMA_POLICY_MAX_NODES)) {
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (syscall(__NR_get_mempolicy, &prev_policy->mode, prev_policy->nodemask,
+                UCS_NUMA_POLICY_MAX_NODES, NULL, 0) != 0) {
+        ucs_debug("get_mempolicy() failed: %m");
+        return UCS_ERR_IO_ERROR;
+    }
+
+    memset(policy.nodemask, 0, sizeof(policy.nodemask));
+    policy.mode = MPOL_PREFERRED;
+    policy.nodemask[node / (8 * sizeof(unsigned long))] |=
+            UCS_BIT(node % (8 * sizeof(unsigned long)));
+
+    if (syscall(__NR_set_mempolicy, policy.mode, policy.nodemask,
+                UCS_NUMA_POLICY_MAX_NODES) != 0) {
+        ucs_debug("set_mempolicy(MPOL_PREFERRED, node=%d) failed: %m", node);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    return UCS_OK;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
+void ucs_numa_policy_restore(const ucs_numa_policy_t *policy)
+{
+#ifdef __NR_set_mempolicy
+    if (syscall(__NR_set_mempolicy, policy->mode, policy->nodemask,
+                UCS_NUMA_POLICY_MAX_NODES) != 0) {
+        ucs_warn("failed to restore memory policy %d: %m", policy->mode);
+    }
+#endif
+}
+
 void ucs_numa_init()
 {
     ucs_spinlock_init(&ucs_numa_global_ctx.lock, 0);
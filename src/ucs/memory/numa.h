@@ -8,6 +8,7 @@
 #define UCS_NUMA_H_
 
 #include <ucs/sys/compiler_def.h>
+#include <ucs/type/status.h>
 #include <stdint.h>
 
 BEGIN_C_DECLS
@@ -21,6 +22,20 @@ typedef int ucs_numa_distance_t;
 typedef int16_t ucs_numa_node_t;
 
 
+/* Maximal number of NUMA nodes which can be set in a memory policy */
+#define UCS_NUMA_POLICY_MAX_NODES 1024
+
+
+/**
+ * Memory allocation policy of a thread.
+ */
+typedef struct {
+    int           mode;
+    unsigned long nodemask[UCS_NUMA_POLICY_MAX_NODES /
+                           (8 * sizeof(unsigned long))];
+} ucs_numa_policy_t;
+
+
 extern const char *ucs_numa_policy_names[];
 
 
@@ -50,6 +65,13 @@ unsigned ucs_numa_num_configured_nodes(void);
 ucs_numa_node_t ucs_numa_node_of_cpu(int cpu);
 
 
+/**
+ * @return The NUMA node of the CPUs the calling thread is allowed to run on,
+ *         or UCS_NUMA_NODE_UNDEFINED if they belong to more than one node.
+ */
+ucs_numa_node_t ucs_numa_node_of_thread(void);
+
+
 /**
  * @param [in]  dev_path sysfs path of the device.
  *
@@ -69,6 +91,30 @@ ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path);
 ucs_numa_distance_t
 ucs_numa_distance(ucs_numa_node_t node1, ucs_numa_node_t node2);
 
+
+/**
+ * Prefer allocating new pages of the calling thread on the given NUMA node,
+ * until the previous memory policy is restored by
+ * @ref ucs_numa_policy_restore.
+ *
+ * @param [in]  node        NUMA node to allocate memory on.
+ * @param [out] prev_policy Filled with the previous memory policy of the
+ *                          thread.
+ *
+ * @return UCS_OK if the memory policy was changed, or error code otherwise.
+ */
+ucs_status_t
+ucs_numa_policy_prefer(ucs_numa_node_t node, ucs_numa_policy_t *prev_policy);
+
+
+/**
+ * Restore memory policy of the calling thread.
+ *
+ * @param [in]  policy      Memory policy returned by
+ *                          @ref ucs_numa_policy_prefer.
+ */
+void ucs_numa_policy_restore(const ucs_numa_policy_t *policy);
+
 END_C_DECLS
 
 #endif
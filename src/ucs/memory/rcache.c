@@ -21,6 +21,7 @@
 #include <ucs/sys/sys.h>
 #include <ucs/sys/string.h>
 #include <ucs/arch/cpu.h>
+#include <ucs/time/time.h>
 #include <ucs/type/spinlock.h>
 #include <ucs/vfs/base/vfs_obj.h>
 #include <ucm/api/ucm.h>
@@ -75,6 +76,27 @@ typedef struct {
 } ucs_rcache_region_validate_pfn_t;
 
 
+/* Per-thread front cache entry. It does not hold a reference to the region,
+ * and is valid only while the cache generation did not change. */
+typedef struct ucs_rcache_front_entry {
+    uint64_t                 rcache_id;
+    uint64_t                 gen;
+    ucs_pgt_addr_t           address;
+    size_t                   length;
+    ucs_rcache_region_t      *region;
+} ucs_rcache_front_entry_t;
+
+
+/* Memory registration which is waiting for the helper thread */
+typedef struct ucs_rcache_async_reg {
+    ucs_queue_elem_t         queue;
+    ucs_rcache_region_t      *region;
+    void                     *arg;   /* Argument for mem_reg, points after
+                                        the structure if it was copied */
+    uint16_t                 flags;  /* Memory registration flags */
+} ucs_rcache_async_reg_t;
+
+
 #ifdef ENABLE_STATS
 static ucs_stats_class_t ucs_rcache_stats_class = {
     .name          = "rcache",
@@ -91,6 +113,9 @@ static ucs_stats_class_t ucs_rcache_stats_class = {
         [UCS_RCACHE_PUTS]               = "puts",
         [UCS_RCACHE_REGS]               = "mem_regs",
         [UCS_RCACHE_DEREGS]             = "mem_deregs",
+        [UCS_RCACHE_ASYNC_REGS]         = "mem_regs_async",
+        [UCS_RCACHE_PREFETCHES]         = "prefetches",
+        [UCS_RCACHE_DEREGS_DEFERRED]    = "mem_deregs_deferred",
     }
 };
 #endif
@@ -121,6 +146,33 @@ ucs_config_field_t ucs_config_rcache_table[] = {
      "Purge registration cache upon fork",
      ucs_offsetof(ucs_rcache_config_t, purge_on_fork), UCS_CONFIG_TYPE_BOOL},
 
+    {"RCACHE_LOCKLESS_GET", "n",
+     "Look up cached regions without taking the page table lock. Memory of\n"
+     "removed regions is released only after all concurrent lookups are done.",
+     ucs_offsetof(ucs_rcache_config_t, lockless_get), UCS_CONFIG_TYPE_BOOL},
+
+    {"RCACHE_FRONT_CACHE", "n",
+     "Remember recently returned regions in a small per-thread cache, keyed by\n"
+     "address and length, to skip the page table lookup when the same buffer is\n"
+     "registered repeatedly. Requires RCACHE_LOCKLESS_GET.",
+     ucs_offsetof(ucs_rcache_config_t, front_cache), UCS_CONFIG_TYPE_BOOL},
+
+    {"RCACHE_PREFETCH_BUDGET", "0",
+     "When buffers of equal size are registered one after another at\n"
+     "consecutive addresses, register up to this amount of memory ahead of the\n"
+     "requested buffer, so that the following buffers are found in the cache.\n"
+     "0 disables the prefetch.",
+     ucs_offsetof(ucs_rcache_config_t, prefetch_budget),
+     UCS_CONFIG_TYPE_MEMUNITS},
+
+    {"RCACHE_INV_BUDGET", "inf",
+     "Maximal number of invalidated regions which are deregistered by a single\n"
+     "memory registration call. The remaining regions are removed from the cache\n"
+     "immediately, and deregistered later by the async thread. This bounds the\n"
+     "latency of a registration which follows the release of a large amount of\n"
+     "registered memory.",
+     ucs_offsetof(ucs_rcache_config_t, inv_budget), UCS_CONFIG_TYPE_ULUNITS},
+
     {NULL}
 };
 
@@ -146,6 +198,19 @@ static ucs_rcache_global_context_t ucs_rcache_global_context = {
     .pipe = UCS_ASYNC_PIPE_INITIALIZER
 };
 
+/* Lock-free readers counter slot of the current thread, or -1 if not set */
+static __thread int ucs_rcache_reader_slot_index = -1;
+
+/* Used to assign reader slots to threads in round-robin order */
+static volatile uint32_t ucs_rcache_reader_slot_next = 0;
+
+/* Recently returned regions of the current thread, of all caches */
+static __thread ucs_rcache_front_entry_t
+        ucs_rcache_front_cache[UCS_RCACHE_FRONT_CACHE_SIZE];
+
+/* Used to assign unique ids to caches, 0 is reserved for disabled */
+static volatile uint64_t ucs_rcache_front_next_id = 1;
+
 void ucs_rcache_region_log(const char *file, int line, const char *function,
                            ucs_log_level_t level, ucs_rcache_t *rcache,
                            ucs_rcache_region_t *region, const char *fmt, ...)
@@ -187,6 +252,8 @@ void ucs_rcache_set_default_params(ucs_rcache_params_t *rcache_params)
     rcache_params->max_regions        = UCS_MEMUNITS_INF;
     rcache_params->max_size           = UCS_MEMUNITS_INF;
     rcache_params->max_unreleased     = UCS_MEMUNITS_INF;
+    rcache_params->prefetch_budget    = 0;
+    rcache_params->inv_budget         = UCS_ULUNITS_INF;
 }
 
 void ucs_rcache_set_params(ucs_rcache_params_t *rcache_params,
@@ -198,8 +265,230 @@ void ucs_rcache_set_params(ucs_rcache_params_t *rcache_params,
     rcache_params->max_regions        = rcache_config->max_regions;
     rcache_params->max_size           = rcache_config->max_size;
     rcache_params->max_unreleased     = rcache_config->max_unreleased;
+    rcache_params->prefetch_budget    = rcache_config->prefetch_budget;
+    rcache_params->inv_budget         = rcache_config->inv_budget;
     rcache_params->flags              = !rcache_config->purge_on_fork ? 0 :
                                         UCS_RCACHE_FLAG_PURGE_ON_FORK;
+    if (rcache_config->lockless_get) {
+        rcache_params->flags |= UCS_RCACHE_FLAG_LOCKLESS_GET;
+    }
+    if (rcache_config->front_cache) {
+        rcache_params->flags |= UCS_RCACHE_FLAG_FRONT_CACHE;
+    }
+}
+
+static UCS_F_ALWAYS_INLINE ucs_rcache_reader_slot_t *
+ucs_rcache_reader_slot(ucs_rcache_t *rcache)
+{
+    if (ucs_unlikely(ucs_rcache_reader_slot_index < 0)) {
+        ucs_rcache_reader_slot_index =
+                ucs_atomic_fadd32(&ucs_rcache_reader_slot_next, 1) %
+                UCS_RCACHE_NUM_READER_SLOTS;
+    }
+
+    return &rcache->readers.slots[ucs_rcache_reader_slot_index];
+}
+
+/*
+ * Enter a lock-free read section: memory of regions and page table directories
+ * which are reachable from the page table is not released until the section
+ * is exited. Returns the parity of the entered epoch.
+ */
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_rcache_read_enter(ucs_rcache_t *rcache, ucs_rcache_reader_slot_t *slot)
+{
+    uint64_t epoch;
+
+    for (;;) {
+        epoch = rcache->readers.epoch;
+        ucs_atomic_add64(&slot->count[epoch & 1], 1);
+        ucs_memory_cpu_fence();
+        if (ucs_likely(rcache->readers.epoch == epoch)) {
+            return epoch & 1;
+        }
+
+        /* The epoch was advanced meanwhile, and the writer could have missed
+         * our counter - retry with the new epoch */
+        ucs_atomic_sub64(&slot->count[epoch & 1], 1);
+    }
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_read_exit(ucs_rcache_reader_slot_t *slot, unsigned parity)
+{
+    ucs_atomic_sub64(&slot->count[parity], 1);
+}
+
+/*
+ * Wait until all lock-free read sections which could have observed memory
+ * removed from the page table are done. Lock must be held in write mode.
+ */
+static void ucs_rcache_readers_sync(ucs_rcache_t *rcache)
+{
+    uint64_t epoch;
+    unsigned i;
+
+    if (rcache->readers.slots == NULL) {
+        return;
+    }
+
+    /* New readers would count themselves in the other half of the slots */
+    epoch = ucs_atomic_fadd64(&rcache->readers.epoch, 1);
+    ucs_memory_cpu_fence();
+
+    for (i = 0; i < UCS_RCACHE_NUM_READER_SLOTS; ++i) {
+        while (rcache->readers.slots[i].count[epoch & 1] != 0) {
+            sched_yield();
+        }
+    }
+
+    ucs_memory_cpu_fence();
+}
+
+/* Must be called before a region could stop being valid */
+static UCS_F_ALWAYS_INLINE void ucs_rcache_front_invalidate(ucs_rcache_t *rcache)
+{
+    ucs_atomic_add64(&rcache->front.gen, 1);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_rcache_front_entry_t *
+ucs_rcache_front_entry(ucs_pgt_addr_t start, size_t length)
+{
+    unsigned index = ((start >> UCS_PGT_ADDR_SHIFT) ^ (start >> 20) ^ length) &
+                     (UCS_RCACHE_FRONT_CACHE_SIZE - 1);
+
+    return &ucs_rcache_front_cache[index];
+}
+
+ucs_status_t ucs_rcache_region_status(ucs_rcache_t *rcache,
+                                      ucs_rcache_region_t *region)
+{
+    ucs_status_t status = *(volatile ucs_status_t*)&region->status;
+
+    /* Memory registration results are written before the status */
+    ucs_memory_cpu_load_fence();
+    return status;
+}
+
+static void *ucs_rcache_async_reg_thread_func(void *arg)
+{
+    ucs_rcache_t *rcache = arg;
+    ucs_rcache_async_reg_t *entry;
+    ucs_rcache_region_t *region;
+    ucs_status_t status;
+
+    pthread_mutex_lock(&rcache->async_reg.lock);
+    for (;;) {
+        while (ucs_queue_is_empty(&rcache->async_reg.queue) &&
+               !rcache->async_reg.stop) {
+            pthread_cond_wait(&rcache->async_reg.cond, &rcache->async_reg.lock);
+        }
+
+        if (rcache->async_reg.stop) {
+            break;
+        }
+
+        entry = ucs_queue_pull_elem_non_empty(&rcache->async_reg.queue,
+                                              ucs_rcache_async_reg_t, queue);
+        pthread_mutex_unlock(&rcache->async_reg.lock);
+
+        /* The region is not destroyed before its status is set */
+        region = entry->region;
+        status = UCS_PROFILE_NAMED_CALL_ALWAYS("mem_reg",
+                                               rcache->params.ops->mem_reg,
+                                               rcache->params.context, rcache,
+                                               entry->arg, region,
+                                               entry->flags);
+        ucs_free(entry);
+
+        ucs_rcache_region_trace(rcache, region, "async registration: %s",
+                                ucs_status_string(status));
+        ucs_memory_cpu_store_fence();
+        *(volatile ucs_status_t*)&region->status = status;
+
+        pthread_mutex_lock(&rcache->async_reg.lock);
+    }
+    pthread_mutex_unlock(&rcache->async_reg.lock);
+
+    return NULL;
+}
+
+/* Lock must be held in write mode */
+static ucs_status_t
+ucs_rcache_async_reg_submit(ucs_rcache_t *rcache, ucs_rcache_region_t *region,
+                            void *arg, size_t arg_size, uint16_t flags)
+{
+    ucs_rcache_async_reg_t *entry;
+
+    entry = ucs_malloc(sizeof(*entry) + arg_size, "rcache_async_reg");
+    if (entry == NULL) {
+        ucs_error("failed to allocate rcache async registration entry");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    entry->region = region;
+    entry->flags  = flags;
+    if (arg_size == 0) {
+        entry->arg = arg;
+    } else {
+        entry->arg = entry + 1;
+        memcpy(entry->arg, arg, arg_size);
+    }
+
+    region->flags |= UCS_RCACHE_REGION_FLAG_ASYNC_REG;
+
+    pthread_mutex_lock(&rcache->async_reg.lock);
+    ucs_queue_push(&rcache->async_reg.queue, &entry->queue);
+    pthread_cond_signal(&rcache->async_reg.cond);
+    pthread_mutex_unlock(&rcache->async_reg.lock);
+
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_ASYNC_REGS, 1);
+    return UCS_OK;
+}
+
+/* Remove the region from the helper thread queue, if it was not taken yet */
+static void ucs_rcache_async_reg_cancel(ucs_rcache_t *rcache,
+                                        ucs_rcache_region_t *region)
+{
+    ucs_rcache_async_reg_t *entry;
+    ucs_queue_iter_t iter;
+
+    pthread_mutex_lock(&rcache->async_reg.lock);
+    ucs_queue_for_each_safe(entry, iter, &rcache->async_reg.queue, queue) {
+        if (entry->region == region) {
+            ucs_queue_del_iter(&rcache->async_reg.queue, iter);
+            ucs_free(entry);
+            region->status = UCS_ERR_CANCELED;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&rcache->async_reg.lock);
+}
+
+/*
+ * Wait for the helper thread to register the region, and mark it as registered
+ * if succeeded. Lock must be held in write mode, unless the region is being
+ * destroyed.
+ */
+static void ucs_rcache_region_async_complete(ucs_rcache_t *rcache,
+                                             ucs_rcache_region_t *region)
+{
+    ucs_status_t status;
+
+    ucs_assert(region->flags & UCS_RCACHE_REGION_FLAG_ASYNC_REG);
+
+    while ((status = ucs_rcache_region_status(rcache, region)) ==
+           UCS_INPROGRESS) {
+        sched_yield();
+    }
+
+    region->flags &= ~UCS_RCACHE_REGION_FLAG_ASYNC_REG;
+    if (status == UCS_OK) {
+        /* Lock-free lookup takes the region only after it sees the registered
+         * flag, so the region must be fully initialized before */
+        ucs_memory_cpu_store_fence();
+        region->flags |= UCS_RCACHE_REGION_FLAG_REGISTERED;
+    }
 }
 
 static size_t ucs_rcache_stat_max_pow2()
@@ -229,6 +518,10 @@ static void ucs_rcache_pgt_dir_release(const ucs_pgtable_t *pgtable,
 {
     ucs_rcache_t *rcache = ucs_container_of(pgtable, ucs_rcache_t, pgtable);
 
+    /* The directory memory may be reused for an invalidation entry, so a
+     * lock-free reader must not be walking through it */
+    ucs_rcache_readers_sync(rcache);
+
     ucs_spin_lock(&rcache->lock);
     ucs_mpool_put(dir);
     ucs_spin_unlock(&rcache->lock);
@@ -405,6 +698,22 @@ ucs_rcache_distribution_get_bin(ucs_rcache_t *rcache, size_t region_size)
     return &rcache->distribution[bin];
 }
 
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_region_prefetch_hit(ucs_rcache_t *rcache,
+                               ucs_rcache_region_t *region)
+{
+    ucs_rcache_distribution_t *distribution_bin;
+
+    if (ucs_likely(!(region->flags & UCS_RCACHE_REGION_FLAG_PREFETCH))) {
+        return;
+    }
+
+    /* May be called by lock-free readers */
+    distribution_bin = ucs_rcache_distribution_get_bin(
+            rcache, region->super.end - region->super.start);
+    ucs_atomic_add64(&distribution_bin->prefetch_hits, 1);
+}
+
 /* Lock must be held in write mode */
 void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
                                      ucs_rcache_region_t *region,
@@ -416,6 +725,11 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
 
     ucs_rcache_region_trace(rcache, region, "destroy");
 
+    if (region->flags & UCS_RCACHE_REGION_FLAG_ASYNC_REG) {
+        ucs_rcache_async_reg_cancel(rcache, region);
+        ucs_rcache_region_async_complete(rcache, region);
+    }
+
     ucs_assertv(region->refcount == 0, "region %p 0x%lx..0x%lx of %s", region,
                 region->super.start, region->super.end, rcache->name);
     ucs_assert(!(region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE));
@@ -453,6 +767,9 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
     distribution_bin = ucs_rcache_distribution_get_bin(rcache, region_size);
     --distribution_bin->count;
     distribution_bin->total_size -= region_size;
+    if (region->flags & UCS_RCACHE_REGION_FLAG_PREFETCH) {
+        --distribution_bin->prefetch_count;
+    }
 
     while (!ucs_list_is_empty(&region->comp_list)) {
         comp = ucs_list_extract_head(&region->comp_list,
@@ -463,6 +780,8 @@ void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
         ucs_spin_unlock(&rcache->lock);
     }
 
+    /* Lock-free readers may still check the region fields */
+    ucs_rcache_readers_sync(rcache);
     ucs_free(region);
     /* coverity[missing_unlock] */
 }
@@ -475,7 +794,10 @@ static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
 
     ucs_assert(region->refcount > 0);
     if (ucs_likely(ucs_atomic_fsub32(&region->refcount, 1) != 1)) {
-        ucs_assert(!(flags & UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY));
+        /* A lock-free reader could take a reference meanwhile; it would
+         * destroy the region when it finds out the region was removed */
+        ucs_assert(!(flags & UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY) ||
+                   (rcache->readers.slots != NULL));
         return;
     }
 
@@ -517,6 +839,7 @@ static void ucs_rcache_region_invalidate_internal(ucs_rcache_t *rcache,
 
     /* Remove the memory region from page table, if it's there */
     if (region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE) {
+        ucs_rcache_front_invalidate(rcache);
         status = ucs_pgtable_remove(&rcache->pgtable, &region->super);
         if (status != UCS_OK) {
             ucs_rcache_region_warn(rcache, region, "failed to remove (%s)",
@@ -562,9 +885,10 @@ static void ucs_rcache_remove_from_unreleased(ucs_rcache_t *rcache,
 }
 
 /* Lock must be held in write mode */
-static void ucs_rcache_check_inv_queue(ucs_rcache_t *rcache, unsigned flags)
+static unsigned ucs_rcache_check_inv_queue(ucs_rcache_t *rcache, unsigned flags)
 {
     ucs_rcache_inv_entry_t *entry;
+    unsigned count = 0;
 
     ucs_trace_func("rcache=%s", rcache->name);
 
@@ -585,18 +909,32 @@ static void ucs_rcache_check_inv_queue(ucs_rcache_t *rcache, unsigned flags)
         ucs_spin_lock(&rcache->lock);
 
         ucs_mpool_put(entry); /* Must be done with the lock held */
+        ++count;
     }
     ucs_spin_unlock(&rcache->lock);
+
+    return count;
 }
 
-static void ucs_rcache_check_gc_list(ucs_rcache_t *rcache, int drop_lock)
+/* Destroy at most max_count regions of the GC list, and let the async thread
+ * destroy the rest */
+static unsigned ucs_rcache_check_gc_list(ucs_rcache_t *rcache, int drop_lock,
+                                         unsigned long max_count)
 {
     ucs_rcache_region_t *region;
+    unsigned count = 0;
 
     ucs_trace_func("rcache=%s", rcache->name);
 
     ucs_spin_lock(&rcache->lock);
     while (!ucs_list_is_empty(&rcache->gc_list)) {
+        if (count >= max_count) {
+            UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_DEREGS_DEFERRED,
+                                     1);
+            ucs_async_pipe_push(&ucs_rcache_global_context.pipe);
+            break;
+        }
+
         region = ucs_list_extract_head(&rcache->gc_list, ucs_rcache_region_t,
                                        tmp_list);
         ucs_rcache_remove_from_unreleased(rcache, region->super.start,
@@ -611,8 +949,42 @@ static void ucs_rcache_check_gc_list(ucs_rcache_t *rcache, int drop_lock)
         ucs_mem_region_destroy_internal(rcache, region, drop_lock);
 
         ucs_spin_lock(&rcache->lock);
+        ++count;
     }
     ucs_spin_unlock(&rcache->lock);
+
+    return count;
+}
+
+/* Lock must be held in write mode */
+static void ucs_rcache_check_invalidated(ucs_rcache_t *rcache)
+{
+    ucs_time_t start_time = ucs_get_time();
+    unsigned count;
+    double usec;
+    int bin;
+
+    if (rcache->params.inv_budget == UCS_ULUNITS_INF) {
+        count  = ucs_rcache_check_inv_queue(rcache, 0);
+        /* coverity[double_unlock] */
+        count += ucs_rcache_check_gc_list(rcache, 1, ULONG_MAX);
+    } else {
+        /* Remove all invalidated regions from the page table, but deregister
+         * only some of them */
+        count  = ucs_rcache_check_inv_queue(rcache,
+                                            UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
+        /* coverity[double_unlock] */
+        count += ucs_rcache_check_gc_list(rcache, 1,
+                                          rcache->params.inv_budget);
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    usec = ucs_time_to_usec(ucs_get_time() - start_time);
+    bin  = (usec < 1.0) ? 0 : (ucs_ilog2((uint64_t)usec) + 1);
+    ++rcache->inv_stalls[ucs_min(bin, UCS_RCACHE_INV_STALL_NUM_BINS - 1)];
 }
 
 static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
@@ -643,6 +1015,10 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
 
     ucs_trace_func("%s: event vm_unmapped 0x%lx..0x%lx", rcache->name, start, end);
 
+    /* Regions of the unmapped range must not be found in the front cache, even
+     * before they are invalidated */
+    ucs_rcache_front_invalidate(rcache);
+
     /*
      * Try to lock the page table and invalidate the region immediately.
      * This way we avoid queuing endless events on the invalidation queue when
@@ -686,6 +1062,7 @@ static void ucs_rcache_purge(ucs_rcache_t *rcache)
     ucs_trace_func("rcache=%s", rcache->name);
 
     ucs_list_head_init(&region_list);
+    ucs_rcache_front_invalidate(rcache);
     ucs_pgtable_purge(&rcache->pgtable, ucs_rcache_region_collect_callback,
                       &region_list);
     ucs_list_for_each_safe(region, tmp, &region_list, tmp_list) {
@@ -706,7 +1083,7 @@ static void ucs_rcache_clean(ucs_rcache_t *rcache)
     pthread_rwlock_wrlock(&rcache->pgt_lock);
     /* coverity[double_lock]*/
     ucs_rcache_check_inv_queue(rcache, 0);
-    ucs_rcache_check_gc_list(rcache, 1);
+    ucs_rcache_check_gc_list(rcache, 1, ULONG_MAX);
     pthread_rwlock_unlock(&rcache->pgt_lock);
 }
 
@@ -834,9 +1211,10 @@ ucs_rcache_check_overlap_one(ucs_rcache_t *rcache, ucs_pgt_addr_t *start,
 
 /* Lock must be held */
 static ucs_status_t
-ucs_rcache_check_overlap(ucs_rcache_t *rcache, void *arg, ucs_pgt_addr_t *start,
-                         ucs_pgt_addr_t *end, size_t *alignment, int *prot,
-                         int *merged, ucs_rcache_region_t **region_p)
+ucs_rcache_check_overlap(ucs_rcache_t *rcache, void *arg, int async,
+                         ucs_pgt_addr_t *start, ucs_pgt_addr_t *end,
+                         size_t *alignment, int *prot, int *merged,
+                         ucs_rcache_region_t **region_p)
 {
     ucs_rcache_region_t *region, *tmp;
     ucs_pgt_addr_t old_start, old_end;
@@ -846,13 +1224,31 @@ ucs_rcache_check_overlap(ucs_rcache_t *rcache, void *arg, ucs_pgt_addr_t *start,
     ucs_trace_func("rcache=%s, *start=0x%lx, *end=0x%lx", rcache->name, *start,
                    *end);
 
-    ucs_rcache_check_inv_queue(rcache, 0);
-    /* coverity[double_unlock] */
-    ucs_rcache_check_gc_list(rcache, 1);
+    ucs_rcache_check_invalidated(rcache);
 
     ucs_list_head_init(&region_list);
     ucs_rcache_find_regions(rcache, *start, *end - 1, &region_list);
 
+    /* A region which is being registered by the helper thread is shared with
+     * asynchronous callers; otherwise wait until it is registered */
+    ucs_list_for_each(region, &region_list, tmp_list) {
+        if (!(region->flags & UCS_RCACHE_REGION_FLAG_ASYNC_REG)) {
+            continue;
+        }
+
+        if (async && ucs_list_is_only(&region_list, &region->tmp_list) &&
+            (*start >= region->super.start) && (*end <= region->super.end) &&
+            ucs_test_all_flags(region->prot, *prot) &&
+            (region->alignment >= *alignment) &&
+            (ucs_rcache_region_status(rcache, region) == UCS_INPROGRESS)) {
+            ucs_rcache_region_hold(rcache, region);
+            *region_p = region;
+            return UCS_INPROGRESS;
+        }
+
+        ucs_rcache_region_async_complete(rcache, region);
+    }
+
     if (!ucs_list_is_empty(&region_list)) {
         region = ucs_list_next(&region_list, ucs_rcache_region_t, tmp_list);
         if (ucs_list_is_only(&region_list, &region->tmp_list) &&
@@ -926,15 +1322,69 @@ static ucs_status_t ucs_rcache_fill_pfn(ucs_rcache_region_t *region)
     return status;
 }
 
+/*
+ * Detect misses on buffers of equal size at consecutive addresses, and return
+ * the length of memory to register ahead of the requested buffer.
+ * Lock must be held in write mode.
+ */
+static size_t ucs_rcache_prefetch_length(ucs_rcache_t *rcache,
+                                         ucs_pgt_addr_t address, size_t length,
+                                         int prot)
+{
+    size_t prefetch_length;
+    int mem_prot;
+
+    if ((rcache->params.prefetch_budget == 0) || (length == 0)) {
+        return 0;
+    }
+
+    if ((address == rcache->prefetch.next) &&
+        (length == rcache->prefetch.length)) {
+        ++rcache->prefetch.seq;
+    } else {
+        rcache->prefetch.seq    = 1;
+        rcache->prefetch.length = length;
+    }
+    rcache->prefetch.next = address + length;
+
+    if (rcache->prefetch.seq < UCS_RCACHE_PREFETCH_MIN_SEQ) {
+        return 0;
+    }
+
+    /* Register whole buffers ahead, within the budget and the cache limit */
+    prefetch_length = ucs_align_down(rcache->params.prefetch_budget, length);
+    if ((prefetch_length == 0) ||
+        ((rcache->total_size + length + prefetch_length) >
+         rcache->params.max_size)) {
+        return 0;
+    }
+
+    /* Memory ahead must be mapped with the same permissions */
+    mem_prot = UCS_PROFILE_CALL_ALWAYS(ucs_get_mem_prot, address + length,
+                                       address + length + prefetch_length);
+    if (!ucs_test_all_flags(mem_prot, prot)) {
+        ucs_trace("rcache=%s, not prefetching 0x%lx..0x%lx " UCS_RCACHE_PROT_FMT,
+                  rcache->name, address + length,
+                  address + length + prefetch_length,
+                  UCS_RCACHE_PROT_ARG(mem_prot));
+        return 0;
+    }
+
+    /* The next miss is expected right after the prefetched memory */
+    rcache->prefetch.next += prefetch_length;
+    return prefetch_length;
+}
+
 ucs_status_t ucs_rcache_create_region(ucs_rcache_t *rcache, void *address,
                                       size_t length, size_t alignment, int prot,
-                                      void *arg, ucs_rcache_region_t **region_p)
+                                      void *arg, size_t arg_size, int async,
+                                      ucs_rcache_region_t **region_p)
 {
     ucs_rcache_region_t *region;
     ucs_pgt_addr_t start, end;
     ucs_status_t status;
     int error, merged;
-    size_t region_size;
+    size_t region_size, prefetch_length;
     ucs_rcache_distribution_t *distribution_bin;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
@@ -942,19 +1392,29 @@ ucs_status_t ucs_rcache_create_region(ucs_rcache_t *rcache, void *address,
 
     pthread_rwlock_wrlock(&rcache->pgt_lock);
 
+    prefetch_length = async ? 0 :
+                      ucs_rcache_prefetch_length(rcache, (uintptr_t)address,
+                                                 length, prot);
+
 retry:
     /* Align to page size */
     start  = ucs_align_down_pow2((uintptr_t)address, alignment);
-    end    = ucs_align_up_pow2  ((uintptr_t)address + length, alignment);
+    end    = ucs_align_up_pow2((uintptr_t)address + length + prefetch_length,
+                               alignment);
     region = NULL;
     merged = 0;
 
     /* Check overlap with existing regions */
     /* coverity[double_unlock] */
     /* coverity[double_lock] */
-    status = UCS_PROFILE_CALL(ucs_rcache_check_overlap, rcache, arg, &start,
-                              &end, &alignment, &prot, &merged, &region);
-    if (status == UCS_ERR_ALREADY_EXISTS) {
+    status = UCS_PROFILE_CALL(ucs_rcache_check_overlap, rcache, arg, async,
+                              &start, &end, &alignment, &prot, &merged,
+                              &region);
+    if (status == UCS_INPROGRESS) {
+        /* Found a matching region which is being registered */
+        UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_SLOW, 1);
+        goto out_set_region;
+    } else if (status == UCS_ERR_ALREADY_EXISTS) {
         /* Found a matching region (it could have been added after we released
          * the lock)
          */
@@ -1014,16 +1474,28 @@ retry:
     ++distribution_bin->count;
     distribution_bin->total_size += region_size;
 
-    region->status = status = UCS_PROFILE_NAMED_CALL_ALWAYS(
-            "mem_reg", rcache->params.ops->mem_reg, rcache->params.context,
-            rcache, arg, region, merged ? UCS_RCACHE_MEM_REG_HIDE_ERRORS : 0);
+    if (prefetch_length != 0) {
+        region->flags |= UCS_RCACHE_REGION_FLAG_PREFETCH;
+        ++distribution_bin->prefetch_count;
+    }
+
+    if (async) {
+        /* Registered by the helper thread after the region is initialized */
+        status = UCS_OK;
+    } else {
+        region->status = status = UCS_PROFILE_NAMED_CALL_ALWAYS(
+                "mem_reg", rcache->params.ops->mem_reg, rcache->params.context,
+                rcache, arg, region,
+                (merged || (prefetch_length != 0)) ?
+                        UCS_RCACHE_MEM_REG_HIDE_ERRORS : 0);
+    }
     if (status != UCS_OK) {
-        if (merged) {
+        if (merged || (prefetch_length != 0)) {
             /* failure may be due to merge, because memory of the merged
              * regions has different access permission.
              * Retry with original address: there will be no merge because
              * all merged regions have been invalidated and registration will
-             * succeed.
+             * succeed. Prefetched memory is not registered on retry.
              */
             ucs_debug("failed to register merged region " UCS_PGT_REGION_FMT ": %s, retrying",
                       UCS_PGT_REGION_ARG(&region->super), ucs_status_string(status));
@@ -1031,6 +1503,7 @@ retry:
                     rcache, region,
                     UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE |
                             UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY);
+            prefetch_length = 0;
             goto retry;
         } else {
             ucs_debug("failed to register region " UCS_PGT_REGION_FMT ": %s",
@@ -1039,9 +1512,6 @@ retry:
         }
     }
 
-    region->flags   |= UCS_RCACHE_REGION_FLAG_REGISTERED;
-    region->refcount = 2; /* Page-table + user */
-
     if (!(rcache->params.flags & UCS_RCACHE_FLAG_NO_PFN_CHECK)) {
         status = ucs_rcache_fill_pfn(region);
         if (status != UCS_OK) {
@@ -1049,11 +1519,37 @@ retry:
             ucs_free(region);
             goto out_unlock;
         }
+    }
+
+    if (async) {
+        status = ucs_rcache_async_reg_submit(
+                rcache, region, arg, arg_size,
+                merged ? UCS_RCACHE_MEM_REG_HIDE_ERRORS : 0);
+        if (status != UCS_OK) {
+            region->status = status;
+            goto out_unlock;
+        }
 
+        status = UCS_INPROGRESS;
+    }
+
+    region->refcount = 2; /* Page-table + user */
+
+    if (!async) {
+        /* Lock-free lookup takes the region only after it sees the registered
+         * flag, so the region must be fully initialized before */
+        ucs_memory_cpu_store_fence();
+        region->flags |= UCS_RCACHE_REGION_FLAG_REGISTERED;
+    }
+
+    if (!(rcache->params.flags & UCS_RCACHE_FLAG_NO_PFN_CHECK)) {
         ucs_rcache_lru_evict(rcache);
     }
 
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_MISSES, 1);
+    if (prefetch_length != 0) {
+        UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_PREFETCHES, 1);
+    }
 
     ucs_rcache_region_trace(rcache, region, "created");
 
@@ -1071,17 +1567,205 @@ void ucs_rcache_region_hold(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
     ucs_rcache_region_trace(rcache, region, "hold");
 }
 
-ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
-                            size_t alignment, int prot, void *arg,
-                            ucs_rcache_region_t **region_p)
+/*
+ * Take a reference to a region found by a lock-free reader, unless the region
+ * is being destroyed. Returns nonzero if the reference was taken.
+ */
+static UCS_F_ALWAYS_INLINE int
+ucs_rcache_region_try_hold(ucs_rcache_region_t *region)
+{
+    uint32_t refcount;
+
+    do {
+        refcount = region->refcount;
+        if (refcount == 0) {
+            return 0;
+        }
+    } while (ucs_atomic_cswap32(&region->refcount, refcount, refcount + 1) !=
+             refcount);
+
+    return 1;
+}
+
+/*
+ * Find a region which was recently returned to the current thread for the same
+ * address and length, and take a reference to it. Returns NULL if not found.
+ */
+static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
+ucs_rcache_front_get(ucs_rcache_t *rcache, ucs_pgt_addr_t start, size_t length,
+                     size_t alignment, int prot)
+{
+    ucs_rcache_front_entry_t *entry = ucs_rcache_front_entry(start, length);
+    ucs_rcache_reader_slot_t *slot  = ucs_rcache_reader_slot(rcache);
+    ucs_rcache_region_t *region;
+    unsigned parity;
+    uint64_t gen;
+
+    if ((entry->rcache_id != rcache->front.id) || (entry->address != start) ||
+        (entry->length != length)) {
+        goto out_miss;
+    }
+
+    parity = ucs_rcache_read_enter(rcache, slot);
+
+    /* Same generation means the region was not removed from the page table,
+     * and so it was not released, since the entry was filled */
+    gen    = rcache->front.gen;
+    region = entry->region;
+    if ((entry->gen != gen) ||
+        !ucs_rcache_region_test(region, prot, alignment) ||
+        !ucs_rcache_region_try_hold(region)) {
+        ucs_rcache_read_exit(slot, parity);
+        goto out_miss;
+    }
+
+    if (ucs_likely(rcache->front.gen == gen)) {
+        ucs_rcache_read_exit(slot, parity);
+        ++slot->front_hits;
+        return region;
+    }
+
+    ucs_rcache_read_exit(slot, parity);
+    ucs_rcache_region_put_internal(rcache, region,
+                                   UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK);
+out_miss:
+    ++slot->front_misses;
+    return NULL;
+}
+
+/*
+ * Remember the region returned to the current thread. The generation must be
+ * read before the region was looked up.
+ */
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_front_update(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                        size_t length, uint64_t gen,
+                        ucs_rcache_region_t *region)
+{
+    ucs_rcache_front_entry_t *entry = ucs_rcache_front_entry(start, length);
+
+    entry->rcache_id = rcache->front.id;
+    entry->gen       = gen;
+    entry->address   = start;
+    entry->length    = length;
+    entry->region    = region;
+}
+
+/*
+ * Find a cached region and take a reference to it, without taking the page
+ * table lock. Returns NULL if the slow path should be used.
+ */
+static UCS_F_ALWAYS_INLINE ucs_rcache_region_t *
+ucs_rcache_get_lockless(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                        size_t length, size_t alignment, int prot)
+{
+    ucs_rcache_reader_slot_t *slot = ucs_rcache_reader_slot(rcache);
+    ucs_rcache_region_t *region    = NULL;
+    ucs_pgt_region_t *pgt_region;
+    unsigned long seq;
+    unsigned parity;
+
+    parity = ucs_rcache_read_enter(rcache, slot);
+
+    seq        = ucs_pgtable_read_begin(&rcache->pgtable);
+    pgt_region = ucs_pgtable_lookup_concurrent(&rcache->pgtable, start);
+    if ((pgt_region == NULL) ||
+        !ucs_pgtable_read_validate(&rcache->pgtable, seq)) {
+        goto out;
+    }
+
+    region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
+    if (!(region->flags & UCS_RCACHE_REGION_FLAG_REGISTERED)) {
+        goto out_not_found;
+    }
+
+    /* Read the region fields only after it is known to be initialized */
+    ucs_memory_cpu_load_fence();
+    if (((start + length) > region->super.end) ||
+        !ucs_rcache_region_test(region, prot, alignment)) {
+        goto out_not_found;
+    }
+
+    if (!ucs_rcache_region_try_hold(region)) {
+        goto out_not_found;
+    }
+
+    if (ucs_likely(ucs_pgtable_read_validate(&rcache->pgtable, seq))) {
+        goto out;
+    }
+
+    /* The region could have been removed from the page table before we took
+     * the reference, so release it outside of the read section */
+    ucs_rcache_read_exit(slot, parity);
+    ucs_rcache_region_put_internal(rcache, region,
+                                   UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK);
+    return NULL;
+
+out_not_found:
+    region = NULL;
+out:
+    ucs_rcache_read_exit(slot, parity);
+    return region;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucs_rcache_get_common(ucs_rcache_t *rcache, void *address, size_t length,
+                      size_t alignment, int prot, void *arg, size_t arg_size,
+                      int async, ucs_rcache_region_t **region_p)
 {
     ucs_pgt_addr_t start = (uintptr_t)address;
+    uint64_t front_gen   = 0;
     ucs_pgt_region_t *pgt_region;
     ucs_rcache_region_t *region;
+    ucs_status_t status;
 
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
+    if ((rcache->readers.slots != NULL) &&
+        ucs_queue_is_empty(&rcache->inv_q)) {
+        UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
+        if (rcache->front.id != 0) {
+            front_gen = rcache->front.gen;
+            ucs_memory_cpu_load_fence();
+            region = ucs_rcache_front_get(rcache, start, length, alignment,
+                                          prot);
+            if (ucs_likely(region != NULL)) {
+                goto out_hit;
+            }
+        }
+
+        region = UCS_PROFILE_CALL(ucs_rcache_get_lockless, rcache, start,
+                                  length, alignment, prot);
+        if (ucs_likely(region != NULL)) {
+            if (rcache->front.id != 0) {
+                ucs_rcache_front_update(rcache, start, length, front_gen,
+                                        region);
+            }
+            goto out_hit;
+        }
+
+        status = UCS_PROFILE_CALL(ucs_rcache_create_region, rcache, address,
+                                  length, alignment, prot, arg, arg_size,
+                                  async, region_p);
+        if ((status == UCS_OK) && (rcache->front.id != 0)) {
+            ucs_rcache_front_update(rcache, start, length, front_gen,
+                                    *region_p);
+        }
+        return status;
+
+out_hit:
+        ucs_rcache_region_trace(rcache, region, "hold");
+        ucs_rcache_region_validate_pfn(rcache, region);
+        ucs_rcache_region_prefetch_hit(rcache, region);
+        if (region->lru_flags & UCS_RCACHE_LRU_FLAG_IN_LRU) {
+            ucs_rcache_region_lru_get(rcache, region);
+        }
+        *region_p = region;
+        UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
+        return UCS_OK;
+    }
+
     pthread_rwlock_rdlock(&rcache->pgt_lock);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
     if (ucs_queue_is_empty(&rcache->inv_q)) {
@@ -1093,6 +1777,7 @@ ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
                 ucs_rcache_region_test(region, prot, alignment)) {
                 ucs_rcache_region_hold(rcache, region);
                 ucs_rcache_region_validate_pfn(rcache, region);
+                ucs_rcache_region_prefetch_hit(rcache, region);
                 ucs_rcache_region_lru_get(rcache, region);
                 *region_p = region;
                 UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
@@ -1109,7 +1794,27 @@ ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
      * - found unregistered region
      */
     return UCS_PROFILE_CALL(ucs_rcache_create_region, rcache, address, length,
-                            alignment, prot, arg, region_p);
+                            alignment, prot, arg, arg_size, async, region_p);
+}
+
+ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
+                            size_t alignment, int prot, void *arg,
+                            ucs_rcache_region_t **region_p)
+{
+    return ucs_rcache_get_common(rcache, address, length, alignment, prot, arg,
+                                 0, 0, region_p);
+}
+
+ucs_status_t ucs_rcache_get_async(ucs_rcache_t *rcache, void *address,
+                                  size_t length, size_t alignment, int prot,
+                                  void *arg, size_t arg_size,
+                                  ucs_rcache_region_t **region_p)
+{
+    return ucs_rcache_get_common(rcache, address, length, alignment, prot, arg,
+                                 arg_size,
+                                 rcache->params.flags &
+                                 UCS_RCACHE_FLAG_ASYNC_REG,
+                                 region_p);
 }
 
 void ucs_rcache_region_put(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
@@ -1267,6 +1972,63 @@ size_t ucs_rcache_distribution_get_num_bins()
     return ucs_ilog2(ucs_rcache_stat_max_pow2() / UCS_RCACHE_STAT_MIN_POW2) + 2;
 }
 
+static ucs_status_t ucs_rcache_async_reg_init(ucs_rcache_t *rcache)
+{
+    ucs_status_t status;
+
+    if (!(rcache->params.flags & UCS_RCACHE_FLAG_ASYNC_REG)) {
+        return UCS_OK;
+    }
+
+    pthread_mutex_init(&rcache->async_reg.lock, NULL);
+    pthread_cond_init(&rcache->async_reg.cond, NULL);
+    ucs_queue_head_init(&rcache->async_reg.queue);
+    rcache->async_reg.stop = 0;
+
+    status = ucs_pthread_create(&rcache->async_reg.thread,
+                                ucs_rcache_async_reg_thread_func, rcache,
+                                "rcache_reg");
+    if (status != UCS_OK) {
+        pthread_cond_destroy(&rcache->async_reg.cond);
+        pthread_mutex_destroy(&rcache->async_reg.lock);
+    }
+
+    return status;
+}
+
+/* Stop the helper thread, and cancel the registrations it did not start */
+static void ucs_rcache_async_reg_stop(ucs_rcache_t *rcache)
+{
+    ucs_rcache_async_reg_t *entry;
+
+    if (!(rcache->params.flags & UCS_RCACHE_FLAG_ASYNC_REG)) {
+        return;
+    }
+
+    pthread_mutex_lock(&rcache->async_reg.lock);
+    rcache->async_reg.stop = 1;
+    pthread_cond_signal(&rcache->async_reg.cond);
+    pthread_mutex_unlock(&rcache->async_reg.lock);
+    pthread_join(rcache->async_reg.thread, NULL);
+
+    while (!ucs_queue_is_empty(&rcache->async_reg.queue)) {
+        entry = ucs_queue_pull_elem_non_empty(&rcache->async_reg.queue,
+                                              ucs_rcache_async_reg_t, queue);
+        entry->region->status = UCS_ERR_CANCELED;
+        ucs_free(entry);
+    }
+}
+
+static void ucs_rcache_async_reg_cleanup(ucs_rcache_t *rcache)
+{
+    if (!(rcache->params.flags & UCS_RCACHE_FLAG_ASYNC_REG)) {
+        return;
+    }
+
+    pthread_cond_destroy(&rcache->async_reg.cond);
+    pthread_mutex_destroy(&rcache->async_reg.lock);
+}
+
 static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
                            const char *name, ucs_stats_node_t *stats_parent)
 {
@@ -1312,6 +2074,34 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err_destroy_inv_q_lock;
     }
 
+    self->prefetch.next   = 0;
+    self->prefetch.length = 0;
+    self->prefetch.seq    = 0;
+
+    self->readers.epoch = 0;
+    self->readers.slots = NULL;
+    self->front.id      = 0;
+    self->front.gen     = 0;
+    if (params->flags & UCS_RCACHE_FLAG_LOCKLESS_GET) {
+        ret = ucs_posix_memalign((void**)&self->readers.slots,
+                                 UCS_SYS_CACHE_LINE_SIZE,
+                                 sizeof(*self->readers.slots) *
+                                 UCS_RCACHE_NUM_READER_SLOTS,
+                                 "rcache_readers");
+        if (ret != 0) {
+            ucs_error("failed to allocate rcache readers array: %m");
+            status = UCS_ERR_NO_MEMORY;
+            goto err_cleanup_pgtable;
+        }
+
+        memset(self->readers.slots, 0,
+               sizeof(*self->readers.slots) * UCS_RCACHE_NUM_READER_SLOTS);
+
+        if (params->flags & UCS_RCACHE_FLAG_FRONT_CACHE) {
+            self->front.id = ucs_atomic_fadd64(&ucs_rcache_front_next_id, 1);
+        }
+    }
+
     mp_obj_size = ucs_max(sizeof(ucs_pgt_dir_t), sizeof(ucs_rcache_inv_entry_t));
     mp_obj_size = ucs_max(mp_obj_size, sizeof(ucs_rcache_comp_entry_t));
 
@@ -1326,7 +2116,7 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
     mp_params.name            = "rcache_mp";
     status = ucs_mpool_init(&mp_params, &self->mp);
     if (status != UCS_OK) {
-        goto err_cleanup_pgtable;
+        goto err_free_readers;
     }
 
     ucs_queue_head_init(&self->inv_q);
@@ -1336,6 +2126,7 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
     ucs_list_head_init(&self->gc_list);
     self->num_regions = 0;
     self->total_size  = 0;
+    memset(self->inv_stalls, 0, sizeof(self->inv_stalls));
     ucs_list_head_init(&self->lru.list);
     ucs_spinlock_init(&self->lru.lock, 0);
 
@@ -1348,11 +2139,16 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err_destroy_mp;
     }
 
-    status = ucs_rcache_global_list_add(self);
+    status = ucs_rcache_async_reg_init(self);
     if (status != UCS_OK) {
         goto err_destroy_dist;
     }
 
+    status = ucs_rcache_global_list_add(self);
+    if (status != UCS_OK) {
+        goto err_stop_async_reg;
+    }
+
     ucs_rcache_vfs_init(self);
 
     status = ucm_set_event_handler(params->ucm_events, params->ucm_event_priority,
@@ -1368,10 +2164,15 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
 err_remove_vfs:
     ucs_vfs_obj_remove(self);
     ucs_rcache_global_list_remove(self);
+err_stop_async_reg:
+    ucs_rcache_async_reg_stop(self);
+    ucs_rcache_async_reg_cleanup(self);
 err_destroy_dist:
     ucs_free(self->distribution);
 err_destroy_mp:
     ucs_mpool_cleanup(&self->mp, 1);
+err_free_readers:
+    ucs_free(self->readers.slots);
 err_cleanup_pgtable:
     ucs_pgtable_cleanup(&self->pgtable);
 err_destroy_inv_q_lock:
@@ -1392,8 +2193,9 @@ static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
                             self);
     ucs_vfs_obj_remove(self);
     ucs_rcache_global_list_remove(self);
+    ucs_rcache_async_reg_stop(self);
     ucs_rcache_check_inv_queue(self, 0);
-    ucs_rcache_check_gc_list(self, 0);
+    ucs_rcache_check_gc_list(self, 0, ULONG_MAX);
     ucs_rcache_purge(self);
 
     if (!ucs_list_is_empty(&self->lru.list)) {
@@ -1406,7 +2208,9 @@ static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
     ucs_spinlock_destroy(&self->lru.lock);
 
     ucs_mpool_cleanup(&self->mp, 1);
+    ucs_free(self->readers.slots);
     ucs_pgtable_cleanup(&self->pgtable);
+    ucs_rcache_async_reg_cleanup(self);
     ucs_spinlock_destroy(&self->lock);
     pthread_rwlock_destroy(&self->pgt_lock);
     UCS_STATS_NODE_FREE(self->stats);
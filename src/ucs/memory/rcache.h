@@ -45,6 +45,11 @@ typedef struct ucs_rcache_config  ucs_rcache_config_t;
 enum {
     UCS_RCACHE_REGION_FLAG_REGISTERED = UCS_BIT(0), /**< Memory registered */
     UCS_RCACHE_REGION_FLAG_PGTABLE    = UCS_BIT(1), /**< In the page table */
+    UCS_RCACHE_REGION_FLAG_ASYNC_REG  = UCS_BIT(2), /**< Memory is registered by
+                                                         the helper thread */
+    UCS_RCACHE_REGION_FLAG_PREFETCH   = UCS_BIT(3), /**< Region was extended
+                                                         beyond the requested
+                                                         range by prefetch */
 };
 
 /*
@@ -61,6 +66,18 @@ enum {
     UCS_RCACHE_FLAG_NO_PFN_CHECK  = UCS_BIT(0), /**< PFN check not supported for this rcache */
     UCS_RCACHE_FLAG_PURGE_ON_FORK = UCS_BIT(1), /**< purge rcache on fork */
     UCS_RCACHE_FLAG_SYNC_EVENTS   = UCS_BIT(2), /**< Synchronize memory events handling */
+    UCS_RCACHE_FLAG_LOCKLESS_GET  = UCS_BIT(3), /**< Look up cached regions
+                                                     without taking the page
+                                                     table lock */
+    UCS_RCACHE_FLAG_FRONT_CACHE   = UCS_BIT(4), /**< Remember recently returned
+                                                     regions in a per-thread
+                                                     cache. Used only together
+                                                     with
+                                                     UCS_RCACHE_FLAG_LOCKLESS_GET */
+    UCS_RCACHE_FLAG_ASYNC_REG     = UCS_BIT(5), /**< Register memory of new
+                                                     regions by a helper thread,
+                                                     when requested by
+                                                     @ref ucs_rcache_get_async() */
 };
 
 /*
@@ -97,6 +114,9 @@ struct ucs_rcache_ops {
      * @note This function should be able to handle inaccessible memory addresses
      *       and return error status in this case, without any destructive consequences
      *       such as error messages or fatal failure.
+     *
+     * @note If the cache was created with @ref UCS_RCACHE_FLAG_ASYNC_REG, this
+     *       function may be called from a helper thread.
      */
     ucs_status_t           (*mem_reg)(void *context, ucs_rcache_t *rcache,
                                       void *arg, ucs_rcache_region_t *region,
@@ -154,6 +174,14 @@ struct ucs_rcache_params {
     unsigned long          max_regions;         /**< Maximal number of regions */
     size_t                 max_size;            /**< Maximal total size of regions */
     size_t                 max_unreleased;      /**< Threshold for triggering a cleanup */
+    size_t                 prefetch_budget;     /**< Maximal size of memory to
+                                                     register ahead of sequential
+                                                     misses, 0 disables prefetch */
+    unsigned long          inv_budget;          /**< Maximal number of invalidated
+                                                     regions deregistered by a
+                                                     single get operation, the
+                                                     rest are deregistered by the
+                                                     async thread */
 };
 
 
@@ -167,6 +195,12 @@ struct ucs_rcache_config {
     size_t        max_size;       /**< Maximal size of mapped memory */
     size_t        max_unreleased; /**< Threshold for triggering a cleanup */
     int           purge_on_fork;  /**< Enable/disable rcache purge on fork */
+    int           lockless_get;   /**< Enable/disable lock-free lookup */
+    int           front_cache;    /**< Enable/disable per-thread front cache */
+    size_t        prefetch_budget; /**< Size to register ahead of sequential
+                                        misses */
+    unsigned long inv_budget;     /**< Maximal number of deregistrations by
+                                       a get operation */
 };
 
 
@@ -237,6 +271,53 @@ ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
                             ucs_rcache_region_t **region_p);
 
 
+/**
+ * Resolve buffer in the registration cache, or start registering it if not
+ * found. If the cache was created with @ref UCS_RCACHE_FLAG_ASYNC_REG, memory
+ * of a new region is registered by a helper thread and the region is returned
+ * without waiting for the registration to complete. Otherwise, this function
+ * behaves as @ref ucs_rcache_get().
+ *
+ * @param [in]  rcache      Memory registration cache.
+ * @param [in]  address     Address to register or resolve.
+ * @param [in]  length      Length of buffer to register or resolve.
+ * @param [in]  alignment   Alignment for registration buffer.
+ * @param [in]  prot        Requested access flags, PROT_xx (same as passed to mmap).
+ * @param [in]  arg         Custom argument passed down to memory registration
+ *                          callback. The registration callback gets a copy of
+ *                          it, so it may be released after this call returns.
+ *                          If arg_size is 0, the argument itself is passed and
+ *                          must be valid until the registration is completed.
+ * @param [in]  arg_size    Size of the custom argument.
+ * @param [out] region_p    Filled with a pointer to the memory region, if the
+ *                          call returned UCS_OK or UCS_INPROGRESS.
+ *
+ * In both cases, the memory region reference count is incremented by 1.
+ *
+ * @return UCS_OK if the region is registered, UCS_INPROGRESS if it is being
+ *         registered - use @ref ucs_rcache_region_status() to check for
+ *         completion - or error code.
+ */
+ucs_status_t ucs_rcache_get_async(ucs_rcache_t *rcache, void *address,
+                                  size_t length, size_t alignment, int prot,
+                                  void *arg, size_t arg_size,
+                                  ucs_rcache_region_t **region_p);
+
+
+/**
+ * Check the memory registration status of a region returned by
+ * @ref ucs_rcache_get_async(). The region must be held by the caller.
+ *
+ * @param [in]  rcache      Memory registration cache.
+ * @param [in]  region      Memory region to check.
+ *
+ * @return UCS_INPROGRESS if the memory is being registered, UCS_OK if it was
+ *         registered, or the registration error code.
+ */
+ucs_status_t ucs_rcache_region_status(ucs_rcache_t *rcache,
+                                      ucs_rcache_region_t *region);
+
+
 /**
  * Increment memory region reference count.
  *
@@ -11,6 +11,7 @@
 
 #include <ucs/datastruct/list.h>
 #include <ucs/stats/stats.h>
+#include <ucs/sys/compiler.h>
 #include <ucs/sys/ptr_arith.h>
 #include <ucs/type/spinlock.h>
 
@@ -38,6 +39,24 @@
     ucs_roundup_pow2(ucs_global_opts.rcache_stat_min)
 
 
+/* Number of counters of lock-free readers; threads are spread among them */
+#define UCS_RCACHE_NUM_READER_SLOTS 64
+
+
+/* Number of entries in the per-thread front cache, must be a power of 2 */
+#define UCS_RCACHE_FRONT_CACHE_SIZE 64
+
+
+/* Number of consecutive sequential misses after which memory is registered
+   ahead of the requested buffer */
+#define UCS_RCACHE_PREFETCH_MIN_SEQ 2
+
+
+/* Number of bins in the histogram of invalidation stalls. Bin i counts stalls
+   shorter than 2^i microseconds, and the last bin counts all longer stalls */
+#define UCS_RCACHE_INV_STALL_NUM_BINS 18
+
+
 /* Names of rcache stats counters */
 enum {
     UCS_RCACHE_GETS,                /* number of get operations */
@@ -51,16 +70,37 @@ enum {
     UCS_RCACHE_PUTS,                /* number of put operations */
     UCS_RCACHE_REGS,                /* number of memory registrations */
     UCS_RCACHE_DEREGS,              /* number of memory deregistrations */
+    UCS_RCACHE_ASYNC_REGS,          /* number of memory registrations done
+                                       by the helper thread */
+    UCS_RCACHE_PREFETCHES,          /* number of regions extended by
+                                       prefetch */
+    UCS_RCACHE_DEREGS_DEFERRED,     /* number of times deregistrations were
+                                       left to the async thread */
     UCS_RCACHE_STAT_LAST
 };
 
 
+/* Number of lock-free readers of the page table, per epoch parity, and front
+   cache counters of the threads using the slot. Every slot is on a separate
+   cache line, to avoid false sharing between threads. */
+typedef struct ucs_rcache_reader_slot {
+    volatile uint64_t count[2];
+    uint64_t          front_hits;   /* Approximate if the slot is shared */
+    uint64_t          front_misses; /* Approximate if the slot is shared */
+    UCS_CACHELINE_PADDING(uint64_t, uint64_t, uint64_t, uint64_t);
+} ucs_rcache_reader_slot_t;
+
+
 /* The structure represents a group in registration cache regions distribution.
    Regions are distributed by their size.
  */
 typedef struct ucs_rcache_distribution {
     size_t count; /**< Number of regions in the group */
     size_t total_size; /**< Total size of regions in the group */
+    size_t prefetch_count; /**< Number of regions in the group which were
+                                extended by prefetch */
+    volatile uint64_t prefetch_hits; /**< Number of lookups served by
+                                          prefetched regions of the group */
 } ucs_rcache_distribution_t;
 
 struct ucs_rcache {
@@ -100,6 +140,50 @@ struct ucs_rcache {
                                               is the most recently used region. */
     } lru;
 
+    struct {
+        volatile uint64_t        epoch;  /**< Current readers epoch, advanced
+                                              before releasing memory which
+                                              lock-free readers may access */
+        ucs_rcache_reader_slot_t *slots; /**< Lock-free readers counters, or
+                                              NULL if lock-free lookup is
+                                              disabled */
+    } readers;
+
+    struct {
+        uint64_t                 id;     /**< Unique cache id which tags the
+                                              front cache entries, or 0 if
+                                              the front cache is disabled */
+        volatile uint64_t        gen;    /**< Advanced whenever a region may
+                                              stop being valid, to invalidate
+                                              all front cache entries */
+    } front;
+
+    struct {
+        pthread_t                thread; /**< Helper thread which registers
+                                              memory of new regions */
+        pthread_mutex_t          lock;   /**< Protects 'queue' and 'stop' */
+        pthread_cond_t           cond;   /**< Signaled when a registration
+                                              is queued or on stop */
+        ucs_queue_head_t         queue;  /**< Pending memory registrations */
+        int                      stop;   /**< Whether the thread should exit */
+    } async_reg;                         /**< Used only if the cache was
+                                              created with
+                                              UCS_RCACHE_FLAG_ASYNC_REG */
+
+    struct {
+        ucs_pgt_addr_t           next;   /**< Address expected by the next
+                                              sequential miss */
+        size_t                   length; /**< Length of the last miss */
+        unsigned                 seq;    /**< Number of sequential misses */
+    } prefetch;                          /**< Stride detector, protected by
+                                              'pgt_lock' */
+
+    unsigned long       inv_stalls[UCS_RCACHE_INV_STALL_NUM_BINS];
+                                         /**< Histogram of the time get
+                                              operations spent on invalidated
+                                              regions, protected by
+                                              'pgt_lock' */
+
     char                *name;           /**< Name of the cache, for debug purpose */
 
     UCS_STATS_NODE_DECLARE(stats)
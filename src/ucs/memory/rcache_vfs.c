@@ -49,6 +49,24 @@ static void ucs_rcache_vfs_read_gc_list_length(void *obj,
     ucs_string_buffer_appendf(strb, "%lu\n", rcache_gc_list_length);
 }
 
+static void ucs_rcache_vfs_read_front_cache_counter(void *obj,
+                                                    ucs_string_buffer_t *strb,
+                                                    void *arg_ptr,
+                                                    uint64_t arg_u64)
+{
+    ucs_rcache_t *rcache = obj;
+    size_t offset        = arg_u64;
+    unsigned long total  = 0;
+    unsigned i;
+
+    for (i = 0; i < UCS_RCACHE_NUM_READER_SLOTS; ++i) {
+        total += *(uint64_t*)UCS_PTR_BYTE_OFFSET(&rcache->readers.slots[i],
+                                                 offset);
+    }
+
+    ucs_string_buffer_appendf(strb, "%lu\n", total);
+}
+
 static void ucs_rcache_vfs_show_primitive(void *obj, ucs_string_buffer_t *strb,
                                           void *arg_ptr, uint64_t arg_u64)
 {
@@ -81,6 +99,36 @@ static void ucs_rcache_vfs_init_regions_distribution(ucs_rcache_t *rcache)
                                 &rcache->distribution[i].total_size,
                                 UCS_VFS_TYPE_SIZET,
                                 "regions_distribution/%s/total_size", bin_name);
+        ucs_vfs_obj_add_ro_file(rcache, ucs_vfs_show_primitive,
+                                &rcache->distribution[i].prefetch_count,
+                                UCS_VFS_TYPE_SIZET,
+                                "regions_distribution/%s/prefetch_count",
+                                bin_name);
+        ucs_vfs_obj_add_ro_file(rcache, ucs_vfs_show_primitive,
+                                (void*)&rcache->distribution[i].prefetch_hits,
+                                UCS_VFS_TYPE_ULONG,
+                                "regions_distribution/%s/prefetch_hits",
+                                bin_name);
+    }
+}
+
+static void ucs_rcache_vfs_init_inv_stalls(ucs_rcache_t *rcache)
+{
+    char bin_name[32];
+    size_t i;
+
+    for (i = 0; i < UCS_RCACHE_INV_STALL_NUM_BINS; ++i) {
+        if (i != (UCS_RCACHE_INV_STALL_NUM_BINS - 1)) {
+            ucs_snprintf_safe(bin_name, sizeof(bin_name), "%luus",
+                              UCS_BIT(i));
+        } else {
+            ucs_strncpy_safe(bin_name, UCS_RCACHE_VFS_MAX_STR,
+                             sizeof(bin_name));
+        }
+
+        ucs_vfs_obj_add_ro_file(rcache, ucs_rcache_vfs_show_primitive,
+                                &rcache->inv_stalls[i], UCS_VFS_TYPE_ULONG,
+                                "inv_stalls/%s", bin_name);
     }
 }
 
@@ -102,4 +150,18 @@ void ucs_rcache_vfs_init(ucs_rcache_t *rcache)
                             "gc_list/length");
 
     ucs_rcache_vfs_init_regions_distribution(rcache);
+    ucs_rcache_vfs_init_inv_stalls(rcache);
+
+    if (rcache->front.id != 0) {
+        ucs_vfs_obj_add_ro_file(rcache, ucs_rcache_vfs_read_front_cache_counter,
+                                NULL,
+                                ucs_offsetof(ucs_rcache_reader_slot_t,
+                                             front_hits),
+                                "front_cache/hits");
+        ucs_vfs_obj_add_ro_file(rcache, ucs_rcache_vfs_read_front_cache_counter,
+                                NULL,
+                                ucs_offsetof(ucs_rcache_reader_slot_t,
+                                             front_misses),
+                                "front_cache/misses");
+    }
 }
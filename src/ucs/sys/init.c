@@ -99,6 +99,7 @@ void UCS_F_CTOR ucs_init()
     ucs_init_ucm_opts();
     ucs_memtype_cache_global_init();
     ucs_cpu_init();
+    ucs_cpu_shm_copy_init();
     ucs_log_init();
 #ifdef ENABLE_STATS
     ucs_stats_init();
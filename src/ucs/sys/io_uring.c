@@ -0,0 +1,332 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "io_uring.h"
+
+#include <ucs/arch/cpu.h>
+#include <ucs/debug/assert.h>
+#include <ucs/debug/log.h>
+#include <ucs/sys/sys.h>
+
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define UCS_IO_URING_SUPPORTED 0
+#ifdef HAVE_LINUX_IO_URING_H
+#  include <linux/io_uring.h>
+#  if HAVE_DECL_IORING_OP_RECV && \
+      defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#    undef UCS_IO_URING_SUPPORTED
+#    define UCS_IO_URING_SUPPORTED 1
+#  endif
+#endif
+
+
+#if UCS_IO_URING_SUPPORTED
+
+static int ucs_io_uring_setup(unsigned entries, struct io_uring_params *params)
+{
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int ucs_io_uring_enter(int fd, unsigned to_submit,
+                              unsigned min_complete, unsigned flags)
+{
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                   NULL, 0);
+}
+
+int ucs_io_uring_is_supported(void)
+{
+    ucs_io_uring_t ring;
+
+    if (ucs_io_uring_init(&ring, 1) != UCS_OK) {
+        return 0;
+    }
+
+    ucs_io_uring_cleanup(&ring);
+    return 1;
+}
+
+static void *ucs_io_uring_mmap(int fd, size_t size, off_t offset,
+                               const char *name)
+{
+    void *ptr;
+
+    ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+               fd, offset);
+    if (ptr == MAP_FAILED) {
+        ucs_debug("failed to map io_uring %s (fd=%d size=%zu): %m", name, fd,
+                  size);
+        return NULL;
+    }
+
+    return ptr;
+}
+
+ucs_status_t ucs_io_uring_init(ucs_io_uring_t *ring, unsigned entries)
+{
+    struct io_uring_params params;
+    ucs_status_t status;
+
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+
+    ring->fd = ucs_io_uring_setup(entries, &params);
+    if (ring->fd < 0) {
+        ucs_debug("io_uring_setup(entries=%u) failed: %m", entries);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    ring->sq_ring_size = params.sq_off.array +
+                         (params.sq_entries * sizeof(unsigned));
+    ring->cq_ring_size = params.cq_off.cqes +
+                         (params.cq_entries * sizeof(struct io_uring_cqe));
+    ring->sqes_size    = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->sq_ring_size = ucs_max(ring->sq_ring_size, ring->cq_ring_size);
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    ring->sq_ring = ucs_io_uring_mmap(ring->fd, ring->sq_ring_size,
+                                      IORING_OFF_SQ_RING, "SQ ring");
+    if (ring->sq_ring == NULL) {
+        status = UCS_ERR_IO_ERROR;
+        goto err_close;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring = ring->sq_ring;
+    } else {
+        ring->cq_ring = ucs_io_uring_mmap(ring->fd, ring->cq_ring_size,
+                                          IORING_OFF_CQ_RING, "CQ ring");
+        if (ring->cq_ring == NULL) {
+            status = UCS_ERR_IO_ERROR;
+            goto err_unmap_sq_ring;
+        }
+    }
+
+    ring->sqes = ucs_io_uring_mmap(ring->fd, ring->sqes_size, IORING_OFF_SQES,
+                                   "SQEs");
+    if (ring->sqes == NULL) {
+        status = UCS_ERR_IO_ERROR;
+        goto err_unmap_cq_ring;
+    }
+
+    ring->sq_entries  = params.sq_entries;
+    ring->sq_prepared = 0;
+    ring->sq_head     = UCS_PTR_BYTE_OFFSET(ring->sq_ring, params.sq_off.head);
+    ring->sq_tail     = UCS_PTR_BYTE_OFFSET(ring->sq_ring, params.sq_off.tail);
+    ring->sq_mask     = UCS_PTR_BYTE_OFFSET(ring->sq_ring,
+                                            params.sq_off.ring_mask);
+    ring->sq_array    = UCS_PTR_BYTE_OFFSET(ring->sq_ring, params.sq_off.array);
+    ring->cq_head     = UCS_PTR_BYTE_OFFSET(ring->cq_ring, params.cq_off.head);
+    ring->cq_tail     = UCS_PTR_BYTE_OFFSET(ring->cq_ring, params.cq_off.tail);
+    ring->cq_mask     = UCS_PTR_BYTE_OFFSET(ring->cq_ring,
+                                            params.cq_off.ring_mask);
+    ring->cqes        = UCS_PTR_BYTE_OFFSET(ring->cq_ring, params.cq_off.cqes);
+
+    ucs_debug("created io_uring fd %d with %u SQ entries and %u CQ entries",
+              ring->fd, params.sq_entries, params.cq_entries);
+    return UCS_OK;
+
+err_unmap_cq_ring:
+    if (ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+err_unmap_sq_ring:
+    munmap(ring->sq_ring, ring->sq_ring_size);
+err_close:
+    close(ring->fd);
+    return status;
+}
+
+void ucs_io_uring_cleanup(ucs_io_uring_t *ring)
+{
+    ucs_assertv(ring->sq_prepared == 0, "ring=%p sq_prepared=%u", ring,
+                ring->sq_prepared);
+
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring) {
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    }
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+}
+
+static ucs_status_t
+ucs_io_uring_prep_rw(ucs_io_uring_t *ring, uint8_t opcode, int fd,
+                     const void *buffer, size_t length, uint64_t user_data)
+{
+    unsigned tail = *ring->sq_tail + ring->sq_prepared;
+    struct io_uring_sqe *sqe;
+    unsigned index;
+
+    if (ring->sq_prepared == ring->sq_entries) {
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    index = tail & *ring->sq_mask;
+    sqe   = (struct io_uring_sqe*)ring->sqes + index;
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode    = opcode;
+    sqe->fd        = fd;
+    sqe->addr      = (uintptr_t)buffer;
+    sqe->len       = length;
+    /* Never block on the socket, it was reported as ready by the event set */
+    sqe->msg_flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+    sqe->user_data = user_data;
+
+    ring->sq_array[index] = index;
+    ring->sq_prepared++;
+
+    return UCS_OK;
+}
+
+ucs_status_t ucs_io_uring_prep_recv(ucs_io_uring_t *ring, int fd, void *buffer,
+                                    size_t length, uint64_t user_data)
+{
+    return ucs_io_uring_prep_rw(ring, IORING_OP_RECV, fd, buffer, length,
+                                user_data);
+}
+
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_io_uring_num_completed(const ucs_io_uring_t *ring)
+{
+    unsigned tail = *(volatile unsigned*)ring->cq_tail;
+
+    ucs_memory_cpu_load_fence();
+    return tail - *ring->cq_head;
+}
+
+static unsigned ucs_io_uring_reap(ucs_io_uring_t *ring,
+                                  ucs_io_uring_cqe_cb_t cb, void *arg)
+{
+    unsigned head  = *ring->cq_head;
+    unsigned count = 0;
+    struct io_uring_cqe *cqe;
+    unsigned tail;
+
+    tail = *(volatile unsigned*)ring->cq_tail;
+    ucs_memory_cpu_load_fence();
+
+    for (; head != tail; ++head, ++count) {
+        cqe = (struct io_uring_cqe*)ring->cqes + (head & *ring->cq_mask);
+        cb(arg, cqe->user_data, cqe->res);
+    }
+
+    ucs_memory_cpu_store_fence();
+    *(volatile unsigned*)ring->cq_head = head;
+    return count;
+}
+
+static void ucs_io_uring_cancel(ucs_io_uring_t *ring, unsigned count,
+                                ucs_io_uring_cqe_cb_t cb, void *arg)
+{
+    unsigned tail = *ring->sq_tail;
+    struct io_uring_sqe *sqe;
+
+    /* The kernel did not consume the last 'count' entries, so take them back
+     * from the submission queue */
+    *(volatile unsigned*)ring->sq_tail = tail - count;
+    for (; count > 0; --count) {
+        sqe = (struct io_uring_sqe*)ring->sqes +
+              ((tail - count) & *ring->sq_mask);
+        cb(arg, sqe->user_data, -ECANCELED);
+    }
+}
+
+ucs_status_t ucs_io_uring_submit(ucs_io_uring_t *ring,
+                                 ucs_io_uring_cqe_cb_t cb, void *arg)
+{
+    unsigned total     = ring->sq_prepared;
+    unsigned to_submit = total;
+    ucs_status_t status;
+    int ret;
+
+    if (total == 0) {
+        return UCS_OK;
+    }
+
+    ucs_memory_cpu_store_fence();
+    *(volatile unsigned*)ring->sq_tail = *ring->sq_tail + total;
+    ring->sq_prepared                  = 0;
+
+    /* All operations are non-blocking, so waiting for their completions does
+     * not block on the sockets. Completions are reaped only after all of them
+     * are posted, since the callback may release buffers of other operations */
+    do {
+        ret = ucs_io_uring_enter(ring->fd, to_submit,
+                                 total - ucs_io_uring_num_completed(ring),
+                                 IORING_ENTER_GETEVENTS);
+        if (ret >= 0) {
+            if ((ret == 0) && (to_submit > 0)) {
+                /* The kernel refused to consume the remaining entries */
+                status = UCS_ERR_NO_RESOURCE;
+                goto err;
+            }
+
+            to_submit -= ret;
+        } else if ((errno == EAGAIN) || (errno == EBUSY)) {
+            status = UCS_ERR_NO_RESOURCE;
+            goto err;
+        } else if (errno != EINTR) {
+            ucs_debug("io_uring_enter(fd=%d, to_submit=%u) failed: %m",
+                      ring->fd, to_submit);
+            status = UCS_ERR_IO_ERROR;
+            goto err;
+        }
+    } while (ucs_io_uring_num_completed(ring) < total);
+
+    ucs_io_uring_reap(ring, cb, arg);
+    return UCS_OK;
+
+err:
+    /* Operations are non-blocking, so the ones which were consumed by the
+     * kernel were also completed by the same system call */
+    ucs_io_uring_cancel(ring, to_submit, cb, arg);
+    ucs_io_uring_reap(ring, cb, arg);
+    return status;
+}
+
+#else
+
+int ucs_io_uring_is_supported(void)
+{
+    return 0;
+}
+
+ucs_status_t ucs_io_uring_init(ucs_io_uring_t *ring, unsigned entries)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+void ucs_io_uring_cleanup(ucs_io_uring_t *ring)
+{
+}
+
+ucs_status_t ucs_io_uring_prep_recv(ucs_io_uring_t *ring, int fd, void *buffer,
+                                    size_t length, uint64_t user_data)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+ucs_status_t ucs_io_uring_submit(ucs_io_uring_t *ring,
+                                 ucs_io_uring_cqe_cb_t cb, void *arg)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+#endif
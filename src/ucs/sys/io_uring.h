@@ -0,0 +1,123 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifndef UCS_IO_URING_H
+#define UCS_IO_URING_H
+
+#include <ucs/type/status.h>
+#include <ucs/sys/compiler_def.h>
+
+#include <stdint.h>
+#include <stddef.h>
+
+BEGIN_C_DECLS
+
+
+/**
+ * Submission/completion rings shared with the kernel. The rings are used in
+ * a synchronous manner: operations are prepared, then submitted together by
+ * a single system call which also waits for their completions.
+ */
+typedef struct ucs_io_uring {
+    int          fd;           /* io_uring file descriptor */
+    unsigned     sq_entries;   /* Number of submission queue entries */
+    unsigned     sq_prepared;  /* Number of prepared and not submitted SQEs */
+    unsigned     *sq_head;     /* Submission queue head, updated by kernel */
+    unsigned     *sq_tail;     /* Submission queue tail */
+    unsigned     *sq_mask;     /* Submission queue ring mask */
+    unsigned     *sq_array;    /* Indexes of SQEs in the submission queue */
+    void         *sqes;        /* Submission queue entries */
+    unsigned     *cq_head;     /* Completion queue head */
+    unsigned     *cq_tail;     /* Completion queue tail, updated by kernel */
+    unsigned     *cq_mask;     /* Completion queue ring mask */
+    void         *cqes;        /* Completion queue entries */
+    void         *sq_ring;     /* Mapped submission queue ring */
+    size_t       sq_ring_size; /* Size of the mapped submission queue ring */
+    void         *cq_ring;     /* Mapped completion queue ring, can be the
+                                  same as the submission queue ring */
+    size_t       cq_ring_size; /* Size of the mapped completion queue ring */
+    size_t       sqes_size;    /* Size of the mapped submission queue
+                                  entries */
+} ucs_io_uring_t;
+
+
+/**
+ * Callback which is invoked for every completed operation.
+ *
+ * @param [in]  arg        User-defined argument.
+ * @param [in]  user_data  User data which was passed when the operation was
+ *                         prepared.
+ * @param [in]  res        Result of the operation: the number of bytes
+ *                         transferred, or negative errno value.
+ */
+typedef void (*ucs_io_uring_cqe_cb_t)(void *arg, uint64_t user_data, int res);
+
+
+/**
+ * Check whether io_uring is supported by the system.
+ *
+ * @return 1 if io_uring is supported, or 0 otherwise.
+ */
+int ucs_io_uring_is_supported(void);
+
+
+/**
+ * Create io_uring instance.
+ *
+ * @param [out] ring     io_uring instance to initialize.
+ * @param [in]  entries  Minimal number of submission queue entries.
+ *
+ * @return UCS_OK on success, UCS_ERR_UNSUPPORTED if io_uring is not supported
+ *         by the system, or other error code on failure.
+ */
+ucs_status_t ucs_io_uring_init(ucs_io_uring_t *ring, unsigned entries);
+
+
+/**
+ * Destroy io_uring instance.
+ *
+ * @param [in]  ring     io_uring instance to destroy.
+ */
+void ucs_io_uring_cleanup(ucs_io_uring_t *ring);
+
+
+/**
+ * Prepare non-blocking receive operation on the socket.
+ *
+ * @param [in]  ring       io_uring instance.
+ * @param [in]  fd         Socket file descriptor.
+ * @param [in]  buffer     Buffer to receive the data to.
+ * @param [in]  length     Length of the buffer.
+ * @param [in]  user_data  User data which is passed to the completion
+ *                         callback.
+ *
+ * @return UCS_OK on success, or UCS_ERR_NO_RESOURCE if the submission queue
+ *         is full.
+ */
+ucs_status_t ucs_io_uring_prep_recv(ucs_io_uring_t *ring, int fd, void *buffer,
+                                    size_t length, uint64_t user_data);
+
+
+/**
+ * Submit all prepared operations by a single system call, wait until they are
+ * completed and invoke the callback for each of them. If the operations could
+ * not be submitted, the callback is invoked with -ECANCELED result for every
+ * operation which was not passed to the kernel.
+ *
+ * @param [in]  ring     io_uring instance.
+ * @param [in]  cb       Completion callback.
+ * @param [in]  arg      User-defined argument for the callback.
+ *
+ * @return UCS_OK if all operations were submitted and completed,
+ *         UCS_ERR_NO_RESOURCE if the kernel was temporarily out of resources,
+ *         or UCS_ERR_IO_ERROR if the io_uring instance is not usable anymore.
+ */
+ucs_status_t ucs_io_uring_submit(ucs_io_uring_t *ring,
+                                 ucs_io_uring_cqe_cb_t cb, void *arg);
+
+END_C_DECLS
+
+#endif
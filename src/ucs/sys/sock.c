@@ -24,6 +24,12 @@
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
+#if defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+#  include <linux/errqueue.h>
+#  define UCS_SOCKET_HAVE_ZCOPY 1
+#else
+#  define UCS_SOCKET_HAVE_ZCOPY 0
+#endif
 
 
 #define UCS_NETIF_DIR                    "/sys/class/net"
@@ -594,6 +600,18 @@ ucs_socket_handle_io(int fd, const void *data, size_t count,
     return ucs_socket_handle_io_error(fd, name, io_retval, io_errno);
 }
 
+ucs_status_t ucs_socket_io_result(int fd, const char *name, int result,
+                                  size_t *length_p)
+{
+    if (ucs_likely(result > 0)) {
+        *length_p = result;
+        return UCS_OK;
+    }
+
+    *length_p = 0;
+    return ucs_socket_handle_io_error(fd, name, result, -result);
+}
+
 static inline ucs_status_t
 ucs_socket_do_io_nb(int fd, void *data, size_t *length_p,
                     ucs_socket_io_func_t io_func, const char *name, int flags)
@@ -671,6 +689,95 @@ ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p)
     return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, sendmsg, "sendv");
 }
 
+ucs_status_t ucs_socket_zcopy_enable(int fd)
+{
+#if UCS_SOCKET_HAVE_ZCOPY
+    int optval = 1;
+
+    if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval)) < 0) {
+        ucs_debug("failed to set SO_ZEROCOPY option on fd %d: %m", fd);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
+ucs_status_t ucs_socket_sendv_zcopy_nb(int fd, struct iovec *iov,
+                                       size_t iov_cnt, size_t *length_p)
+{
+#if UCS_SOCKET_HAVE_ZCOPY
+    struct msghdr msg = {
+        .msg_iov    = iov,
+        .msg_iovlen = iov_cnt
+    };
+    ssize_t ret;
+
+    ret = sendmsg(fd, &msg, MSG_NOSIGNAL | MSG_ZEROCOPY);
+    if ((ret < 0) && (errno == ENOBUFS)) {
+        /* The socket ran out of memory for zero-copy notifications, need to
+         * read completions from the error queue and try again */
+        *length_p = 0;
+        return UCS_ERR_NO_PROGRESS;
+    }
+
+    return ucs_socket_handle_io(fd, iov, iov_cnt, length_p, 1, ret, errno,
+                                "sendv_zcopy");
+#else
+    *length_p = 0;
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
+ucs_status_t ucs_socket_zcopy_progress(int fd, uint32_t *count_p)
+{
+#if UCS_SOCKET_HAVE_ZCOPY
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+    struct sock_extended_err *serr;
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    ssize_t ret;
+
+    *count_p = 0;
+
+    for (;;) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        ret = recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+        if (ret < 0) {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                break;
+            }
+
+            ucs_debug("recvmsg(%d, MSG_ERRQUEUE) failed: %m", fd);
+            return ucs_socket_check_errno(errno);
+        }
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+            if ((serr->ee_errno != 0) ||
+                (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)) {
+                continue;
+            }
+
+            /* The notification covers the inclusive range of send calls
+             * [ee_info, ee_data] */
+            *count_p += serr->ee_data - serr->ee_info + 1;
+        }
+    }
+
+    return (*count_p == 0) ? UCS_ERR_NO_PROGRESS : UCS_OK;
+#else
+    *count_p = 0;
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
 ucs_status_t ucs_sockaddr_sizeof(const struct sockaddr *addr, size_t *size_p)
 {
     switch (addr->sa_family) {
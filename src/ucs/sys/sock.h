@@ -290,6 +290,23 @@ ucs_status_t ucs_socket_send_nb(int fd, const void *data, size_t *length_p);
 ucs_status_t ucs_socket_recv_nb(int fd, void *data, int flags, size_t *length_p);
 
 
+/**
+ * Convert the result of a send/receive operation which was completed
+ * asynchronously (e.g. by io_uring) on the socket `fd` to a status code, in the
+ * same way as it is done by the non-blocking socket operations.
+ *
+ * @param [in]  fd        Socket fd.
+ * @param [in]  name      Name of the operation ("send" or "recv").
+ * @param [in]  result    Number of bytes transferred, or negative errno value.
+ * @param [out] length_p  The amount of data transferred is written to this
+ *                        argument.
+ *
+ * @return UCS_OK on success or an error code on failure.
+ */
+ucs_status_t ucs_socket_io_result(int fd, const char *name, int result,
+                                  size_t *length_p);
+
+
 /**
  * Blocking send operation sends data on the connected (or bound connectionless)
  * socket referred to by the file descriptor `fd`.
@@ -322,6 +339,54 @@ ucs_status_t ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt,
                                  size_t *length_p);
 
 
+/**
+ * Enable zero-copy transmission (SO_ZEROCOPY) on the socket referred to by
+ * the file descriptor `fd`, so that @ref ucs_socket_sendv_zcopy_nb can be
+ * used on it.
+ *
+ * @param [in]      fd              Socket fd.
+ *
+ * @return UCS_OK on success or UCS_ERR_UNSUPPORTED if the system does not
+ *         support zero-copy transmission.
+ */
+ucs_status_t ucs_socket_zcopy_enable(int fd);
+
+
+/**
+ * Non-blocking zero-copy send operation (MSG_ZEROCOPY) sends I/O vector on
+ * the connected socket referred to by the file descriptor `fd`. The user's
+ * buffers are pinned by the kernel and mustn't be modified until the send
+ * operation is reported as completed by @ref ucs_socket_zcopy_progress.
+ * Every call which returned UCS_OK consumes one zero-copy sequence number
+ * of the socket.
+ *
+ * @param [in]      fd              Socket fd.
+ * @param [in]      iov             A pointer to an array of iovec buffers.
+ * @param [in]      iov_cnt         The number of buffers pointed to by
+ *                                  the iov parameter.
+ * @param [out]     length_p        The amount of data transmitted is written to
+ *                                  this argument.
+ *
+ * @return UCS_OK on success or an error code on failure.
+ */
+ucs_status_t ucs_socket_sendv_zcopy_nb(int fd, struct iovec *iov,
+                                       size_t iov_cnt, size_t *length_p);
+
+
+/**
+ * Read zero-copy completion notifications from the error queue of the socket
+ * referred to by the file descriptor `fd`.
+ *
+ * @param [in]      fd              Socket fd.
+ * @param [out]     count_p         The number of zero-copy send operations
+ *                                  whose buffers were released by the kernel.
+ *
+ * @return UCS_OK if some completions were read, UCS_ERR_NO_PROGRESS if there
+ *         are no completions, or an error code on failure.
+ */
+ucs_status_t ucs_socket_zcopy_progress(int fd, uint32_t *count_p);
+
+
 /**
  * Blocking receive operation receives data from the connected (or bound
  * connectionless) socket referred to by the file descriptor `fd`.
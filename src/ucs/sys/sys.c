@@ -1005,6 +1005,51 @@ ucs_status_t ucs_mmap_alloc(size_t *size, void **address_p,
     return UCS_OK;
 }
 
+ucs_status_t ucs_mmap_alloc_hugepages(size_t *size, void **address_p,
+                                      const char *alloc_name)
+{
+    ssize_t huge_page_size = ucs_get_huge_page_size();
+    size_t alloc_length;
+    void *addr;
+
+    if (huge_page_size <= 0) {
+        return ucs_mmap_alloc(size, address_p, 0, alloc_name);
+    }
+
+    alloc_length = ucs_align_up(*size, huge_page_size);
+
+#ifdef MAP_HUGETLB
+    addr = ucs_mmap(NULL, alloc_length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANON | MAP_HUGETLB, -1, 0, alloc_name);
+    if (addr != MAP_FAILED) {
+        goto out;
+    }
+
+    ucs_debug("mmap(length=%zu, MAP_HUGETLB) for %s failed: %m, falling back "
+              "to transparent huge pages", alloc_length, alloc_name);
+#endif
+
+    addr = ucs_mmap(NULL, alloc_length, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANON, -1, 0, alloc_name);
+    if (addr == MAP_FAILED) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (madvise(addr, alloc_length, MADV_HUGEPAGE) != 0) {
+        ucs_debug("madvise(address=%p, length=%zu, HUGEPAGE) failed: %m", addr,
+                  alloc_length);
+    }
+#endif
+
+#ifdef MAP_HUGETLB
+out:
+#endif
+    *size      = alloc_length;
+    *address_p = addr;
+    return UCS_OK;
+}
+
 ucs_status_t ucs_mmap_free(void *address, size_t length)
 {
     int ret;
@@ -386,6 +386,21 @@ ucs_status_t ucs_sysv_free(void *address);
 ucs_status_t ucs_mmap_alloc(size_t *size, void **address_p,
                             int flags, const char *alloc_name);
 
+/**
+ * Allocate private memory backed by huge pages using mmap(MAP_HUGETLB). If
+ * huge pages are not available, fall back to regular pages and advise the
+ * kernel to use transparent huge pages for them.
+ *
+ * @param size      Pointer to memory size to allocate, updated with actual size
+ *                  (rounded up to huge page size).
+ * @param address_p Filled with allocated memory address.
+ * @param alloc_name Name of the allocation, for debugging.
+ *
+ * @note The memory should be released by @ref ucs_mmap_free.
+ */
+ucs_status_t ucs_mmap_alloc_hugepages(size_t *size, void **address_p,
+                                      const char *alloc_name);
+
 /**
  * Release memory allocated via mmap API.
  *
@@ -14,6 +14,18 @@
 #include <ucs/debug/log.h>
 #include <ucs/debug/memtrack_int.h>
 #include <ucs/sys/ptr_arith.h>
+#include <ucs/sys/string.h>
+#include <ucs/vfs/base/vfs_cb.h>
+#include <ucs/vfs/base/vfs_obj.h>
+
+#include <string.h>
+
+
+#define UCS_TWHEEL_SLOT_MASK  (UCS_TWHEEL_LEVEL_SLOTS - 1)
+
+/* Maximal timer delay in ticks */
+#define UCS_TWHEEL_MAX_TICKS   (UCS_BIT(UCS_TWHEEL_LEVEL_ORDER * \
+                                        UCS_TWHEEL_NUM_LEVELS) - 1)
 
 
 ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
@@ -21,21 +33,25 @@ ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
 {
     unsigned i;
 
-    twheel->res         = ucs_roundup_pow2(resolution);
-    twheel->res_order   = (unsigned) ucs_log2(twheel->res);
-    twheel->num_slots   = 1024;
-    twheel->current     = 0;
-    twheel->now         = current_time;
-    twheel->wheel       = ucs_malloc(sizeof(*twheel->wheel) * twheel->num_slots,
-                                     "twheel");
-    twheel->count       = 0;
+    twheel->res          = ucs_roundup_pow2(resolution);
+    twheel->res_order    = (unsigned) ucs_log2(twheel->res);
+    twheel->num_slots    = UCS_TWHEEL_LEVEL_SLOTS;
+    twheel->current      = 0;
+    twheel->now          = current_time;
+    twheel->start_time   = current_time;
+    twheel->num_cascades = 0;
+    twheel->wheel        = ucs_malloc(sizeof(*twheel->wheel) *
+                                      UCS_TWHEEL_LEVEL_SLOTS *
+                                      UCS_TWHEEL_NUM_LEVELS, "twheel");
+    twheel->count        = 0;
     if (twheel->wheel == NULL) {
         return UCS_ERR_NO_MEMORY;
     }
 
-    for (i = 0; i < twheel->num_slots; i++) {
+    for (i = 0; i < UCS_TWHEEL_LEVEL_SLOTS * UCS_TWHEEL_NUM_LEVELS; i++) {
         ucs_list_head_init(&twheel->wheel[i]);
     }
+    memset(twheel->nonempty, 0, sizeof(twheel->nonempty));
 
     ucs_debug("high res timer created log=%d resolution=%lf usec wanted: %lf usec",
               twheel->res_order, ucs_time_to_usec(twheel->res), ucs_time_to_usec(resolution));
@@ -54,52 +70,190 @@ ucs_status_t ucs_wtimer_init(ucs_wtimer_t *t, ucs_twheel_callback_t cb)
     return UCS_OK;
 }
 
+static UCS_F_ALWAYS_INLINE unsigned ucs_twheel_level_shift(unsigned level)
+{
+    return level * UCS_TWHEEL_LEVEL_ORDER;
+}
+
+/* Add the timer to the lowest level which covers its expiration tick */
+static void ucs_twheel_insert(ucs_twheel_t *t, ucs_wtimer_t *timer)
+{
+    uint64_t delta = timer->expires - t->current;
+    unsigned level, index;
+
+    for (level = 0; level < (UCS_TWHEEL_NUM_LEVELS - 1); ++level) {
+        if (delta < UCS_BIT(ucs_twheel_level_shift(level + 1))) {
+            break;
+        }
+    }
+
+    index       = (timer->expires >> ucs_twheel_level_shift(level)) &
+                  UCS_TWHEEL_SLOT_MASK;
+    timer->slot = (level << UCS_TWHEEL_LEVEL_ORDER) | index;
+    ucs_list_add_tail(&t->wheel[timer->slot], &timer->list);
+    t->nonempty[level][index / 64] |= UCS_BIT(index % 64);
+}
+
 void __ucs_wtimer_add(ucs_twheel_t *t, ucs_wtimer_t *timer, ucs_time_t delta)
 {
-    uint64_t slot;
+    uint64_t ticks;
 
     timer->is_active = 1;
-    slot = delta>>t->res_order;
-    if (ucs_unlikely(slot == 0)) {
+    ticks = delta>>t->res_order;
+    if (ucs_unlikely(ticks == 0)) {
         /* nothing really wrong with adding timer to the current slot. However
          * we want to guard against the case we spend to much time in hi res
          * timer processing */
         ucs_fatal("Timer resolution is too low. Min resolution %lf usec, wanted %lf usec",
                 ucs_time_to_usec(t->res), ucs_time_to_usec(delta));
     }
-    ucs_assert(slot > 0);
+    ucs_assert(ticks > 0);
 
-    if (ucs_unlikely(slot >= t->num_slots)) {
-        slot = t->num_slots - 1;
+    if (ucs_unlikely(ticks > UCS_TWHEEL_MAX_TICKS)) {
+        ticks = UCS_TWHEEL_MAX_TICKS;
     }
 
-    slot = (t->current + slot) % t->num_slots;
-    ucs_assert(slot != t->current);
-
-    ucs_list_add_tail(&t->wheel[slot], &timer->list);
+    timer->expires = t->current + ticks;
+    ucs_twheel_insert(t, timer);
     t->count++;
 }
 
+/* Find the first non-empty slot in the level, starting from the given index.
+ * Return UCS_TWHEEL_LEVEL_SLOTS if there is none. */
+static unsigned
+ucs_twheel_find_slot(const ucs_twheel_t *t, unsigned level, unsigned index)
+{
+    unsigned word;
+    uint64_t mask;
+
+    for (word = index / 64; word < UCS_TWHEEL_BITMAP_WORDS; ++word) {
+        mask = t->nonempty[level][word];
+        if (word == (index / 64)) {
+            mask &= ~UCS_MASK(index % 64);
+        }
+
+        if (mask != 0) {
+            return (word * 64) + ucs_ffs64(mask);
+        }
+    }
+
+    return UCS_TWHEEL_LEVEL_SLOTS;
+}
+
+/* Return the first tick after the current one, at which a slot of any level
+ * has to be processed */
+static uint64_t ucs_twheel_next_tick(const ucs_twheel_t *t)
+{
+    unsigned level, shift, index;
+    uint64_t pos;
+
+    for (level = 0; level < UCS_TWHEEL_NUM_LEVELS; ++level) {
+        shift = ucs_twheel_level_shift(level);
+        pos   = (t->current >> shift) + 1;
+        index = ucs_twheel_find_slot(t, level, pos & UCS_TWHEEL_SLOT_MASK);
+        if (index < UCS_TWHEEL_LEVEL_SLOTS) {
+            /* Non-empty slot until the end of the current round */
+            return ((pos & ~(uint64_t)UCS_TWHEEL_SLOT_MASK) + index) << shift;
+        }
+
+        if (ucs_twheel_find_slot(t, level, 0) < UCS_TWHEEL_LEVEL_SLOTS) {
+            /* Non-empty slot in the next round, which starts by cascading the
+             * next level */
+            return ((pos | UCS_TWHEEL_SLOT_MASK) + 1) << shift;
+        }
+    }
+
+    return UINT64_MAX;
+}
+
+/* Move the timers from the current slot of the level to lower levels */
+static void ucs_twheel_cascade(ucs_twheel_t *t, unsigned level)
+{
+    unsigned index = (t->current >> ucs_twheel_level_shift(level)) &
+                     UCS_TWHEEL_SLOT_MASK;
+    ucs_list_link_t *slot, timers;
+    ucs_wtimer_t *timer;
+
+    if (!(t->nonempty[level][index / 64] & UCS_BIT(index % 64))) {
+        return;
+    }
+
+    slot = &t->wheel[(level << UCS_TWHEEL_LEVEL_ORDER) | index];
+    ucs_list_head_init(&timers);
+    ucs_list_splice_tail(&timers, slot);
+    ucs_list_head_init(slot);
+    t->nonempty[level][index / 64] &= ~UCS_BIT(index % 64);
+
+    while (!ucs_list_is_empty(&timers)) {
+        timer = ucs_list_extract_head(&timers, ucs_wtimer_t, list);
+        ucs_assert(timer->expires >= t->current);
+        ucs_twheel_insert(t, timer);
+    }
+
+    ++t->num_cascades;
+}
+
 void __ucs_twheel_sweep(ucs_twheel_t *t, ucs_time_t current_time)
 {
+    uint64_t target, next;
     ucs_wtimer_t *timer;
-    uint64_t slot;
+    unsigned level, index;
+    ucs_list_link_t *slot;
 
-    slot   = (current_time - t->now) >> t->res_order;
+    target = t->current + ((current_time - t->now) >> t->res_order);
     t->now = current_time;
 
-    if (ucs_unlikely(slot >= t->num_slots)) {
-        slot = t->num_slots - 1;
-    }
+    for (;;) {
+        next = ucs_twheel_next_tick(t);
+        if (next > target) {
+            break;
+        }
+
+        t->current = next;
+
+        /* Cascade the upper levels whose slot starts at this tick, from the
+         * highest one, since it can move timers to the lower ones */
+        for (level = UCS_TWHEEL_NUM_LEVELS - 1; level > 0; --level) {
+            if ((next & UCS_MASK(ucs_twheel_level_shift(level))) == 0) {
+                ucs_twheel_cascade(t, level);
+            }
+        }
 
-    slot = (t->current + slot) % t->num_slots;
+        index = next & UCS_TWHEEL_SLOT_MASK;
+        slot  = &t->wheel[index];
+        while (!ucs_list_is_empty(slot)) {
+            timer = ucs_list_extract_head(slot, ucs_wtimer_t, list);
+            if (ucs_list_is_empty(slot)) {
+                t->nonempty[0][index / 64] &= ~UCS_BIT(index % 64);
+            }
 
-    for (; t->current != slot; t->current = (t->current+1) % t->num_slots) {
-        while (!ucs_list_is_empty(&t->wheel[t->current])) {
-            timer = ucs_list_extract_head(&t->wheel[t->current], ucs_wtimer_t, list);
+            ucs_assert(timer->expires == next);
             timer->is_active = 0;
-            timer->cb(timer);
             t->count--;
+            timer->cb(timer);
         }
     }
+
+    t->current = target;
+}
+
+static void ucs_twheel_vfs_show_cascade_rate(void *obj,
+                                             ucs_string_buffer_t *strb,
+                                             void *arg_ptr, uint64_t arg_u64)
+{
+    ucs_twheel_t *t = arg_ptr;
+    double elapsed  = ucs_time_to_sec(t->now - t->start_time);
+
+    ucs_string_buffer_appendf(strb, "%.3f\n",
+                              (elapsed > 0) ? (t->num_cascades / elapsed) : 0);
+}
+
+void ucs_twheel_vfs_init(ucs_twheel_t *t, void *obj, const char *dir)
+{
+    ucs_vfs_obj_add_ro_file(obj, ucs_vfs_show_primitive, &t->count,
+                            UCS_VFS_TYPE_U32, "%s/timers_pending", dir);
+    ucs_vfs_obj_add_ro_file(obj, ucs_vfs_show_primitive, &t->num_cascades,
+                            UCS_VFS_TYPE_ULONG, "%s/cascades", dir);
+    ucs_vfs_obj_add_ro_file(obj, ucs_twheel_vfs_show_cascade_rate, t, 0,
+                            "%s/cascades_per_sec", dir);
 }
@@ -12,6 +12,17 @@
 #include <ucs/debug/log.h>
 
 
+/* Number of slots in every level of the wheel */
+#define UCS_TWHEEL_LEVEL_ORDER  8
+#define UCS_TWHEEL_LEVEL_SLOTS  UCS_BIT(UCS_TWHEEL_LEVEL_ORDER)
+
+/* Number of levels: every level covers a range which is UCS_TWHEEL_LEVEL_SLOTS
+ * times larger than the previous one */
+#define UCS_TWHEEL_NUM_LEVELS   4
+
+#define UCS_TWHEEL_BITMAP_WORDS (UCS_TWHEEL_LEVEL_SLOTS / 64)
+
+
 /* Forward declarations */
 typedef struct ucs_wtimer       ucs_wtimer_t;
 typedef struct ucs_timer_wheel  ucs_twheel_t;
@@ -29,18 +40,30 @@ typedef void (*ucs_twheel_callback_t)(ucs_wtimer_t *self);
 struct ucs_wtimer {
     ucs_twheel_callback_t  cb;         /* User callback */
     ucs_list_link_t        list;       /* Link in the list of timers */
+    uint64_t               expires;    /* Expiration tick */
+    unsigned               slot;       /* Index of the slot in the wheel */
     int                    is_active;
 };
 
 
+/**
+ * Hierarchical timer wheel. Level 0 has a slot per tick, and each slot of
+ * level N covers all slots of level N-1. Timers are added to the lowest level
+ * which covers their expiration time, and moved (cascaded) one or more levels
+ * down when the wheel reaches the slot they are in.
+ */
 struct ucs_timer_wheel {
     ucs_time_t             res;
     ucs_time_t             now;        /* when wheel was last updated */
-    uint64_t               current;
-    ucs_list_link_t        *wheel;
+    uint64_t               current;    /* Current tick */
+    ucs_list_link_t        *wheel;     /* Slots of all levels */
+    /* Bitmaps of non-empty slots in every level */
+    uint64_t               nonempty[UCS_TWHEEL_NUM_LEVELS][UCS_TWHEEL_BITMAP_WORDS];
     unsigned               res_order;
-    unsigned               num_slots;
+    unsigned               num_slots;  /* Number of slots in every level */
     unsigned               count;
+    ucs_time_t             start_time; /* when the wheel was created */
+    unsigned long          num_cascades;
 };
 
 
@@ -48,7 +71,9 @@ struct ucs_timer_wheel {
  * Initialize the timer queue.
  *
  * @param twheel        Timer queue to initialize.
- * @param resolution    Timer resolution. Timer wheel range is from now to now + UCS_TWHEEL_NSLOTS * res
+ * @param resolution    Timer resolution. Timer wheel range is from now to
+ *                      now + res * UCS_TWHEEL_LEVEL_SLOTS^UCS_TWHEEL_NUM_LEVELS,
+ *                      later timers are clamped to the end of the range.
  * @param current_time  Current time to initialize the timer with.
  */
 ucs_status_t ucs_twheel_init(ucs_twheel_t *twheel, ucs_time_t resolution,
@@ -79,6 +104,8 @@ ucs_status_t ucs_wtimer_init(ucs_wtimer_t *t, ucs_twheel_callback_t cb);
  *
  * @note Timers which expired between calls to this function will also be dispatched.
  * @note There is no guarantee on the order of dispatching.
+ * @note The cost of the function depends on the number of expired timers and
+ *       non-empty slots, rather than on the time since the previous call.
  */
 void __ucs_twheel_sweep(ucs_twheel_t *t, ucs_time_t current_time);
 static inline void ucs_twheel_sweep(ucs_twheel_t *t, ucs_time_t current_time)
@@ -134,11 +161,29 @@ static inline ucs_status_t ucs_wtimer_add(ucs_twheel_t *t, ucs_wtimer_t *timer,
  */
 static inline void ucs_wtimer_remove(ucs_twheel_t *t, ucs_wtimer_t *timer)
 {
+    unsigned level, index;
+
     if (ucs_likely(timer->is_active)) {
         ucs_list_del(&timer->list);
+        if (ucs_list_is_empty(&t->wheel[timer->slot])) {
+            level = timer->slot >> UCS_TWHEEL_LEVEL_ORDER;
+            index = timer->slot & (UCS_TWHEEL_LEVEL_SLOTS - 1);
+            t->nonempty[level][index / 64] &= ~UCS_BIT(index % 64);
+        }
         timer->is_active = 0;
         t->count--;
     }
 }
 
+
+/**
+ * Expose the timer wheel statistics as VFS files in a sub-directory of a VFS
+ * object.
+ *
+ * @param twheel     Timer wheel to expose.
+ * @param obj        VFS object to add the files to.
+ * @param dir        Name of the sub-directory.
+ */
+void ucs_twheel_vfs_init(ucs_twheel_t *t, void *obj, const char *dir);
+
 #endif
@@ -1045,6 +1045,14 @@ void uct_iface_mpool_config_copy(ucs_mpool_params_t *mp_params,
       mp_params->elems_per_chunk = cfg->bufs_grow;
       mp_params->max_chunk_size  = cfg->max_chunk_size;
       mp_params->grow_factor     = cfg->grow_factor;
+
+      if (cfg->numa_node == UCS_ULUNITS_AUTO) {
+          mp_params->numa_node = ucs_numa_node_of_thread();
+      } else if (cfg->numa_node < UCS_NUMA_POLICY_MAX_NODES) {
+          mp_params->numa_node = cfg->numa_node;
+      } else {
+          mp_params->numa_node = UCS_NUMA_NODE_UNDEFINED;
+      }
 }
 
 void uct_tl_register(uct_component_t *component, uct_tl_t *tl)
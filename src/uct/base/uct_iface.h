@@ -554,6 +554,7 @@ typedef struct uct_iface_mpool_config {
     unsigned          bufs_grow; /* How many buffers (approx.) are allocated 1st time */
     size_t            max_chunk_size; /* Maximal chunk size */
     double            grow_factor; /* Increase each new allocated chunk by this factor */
+    unsigned long     numa_node; /* NUMA node to allocate chunks on */
 } uct_iface_mpool_config_t;
 
 
@@ -580,7 +581,13 @@ typedef struct uct_iface_mpool_config {
     {_prefix "GROW_FACTOR", UCS_PP_QUOTE(_dfl_grow_factor), \
      "Growth factor for new chunks in " _mp_name ". Each time a new chunk is allocated,\n" \
      "its size is the multiple of the previous chunk size by this number.",\
-     (_offset) + ucs_offsetof(uct_iface_mpool_config_t, grow_factor), UCS_CONFIG_TYPE_DOUBLE}
+     (_offset) + ucs_offsetof(uct_iface_mpool_config_t, grow_factor), UCS_CONFIG_TYPE_DOUBLE}, \
+    \
+    {_prefix "NUMA_NODE", "auto", \
+     "NUMA node to allocate " _mp_name " memory pool chunks on. \"auto\" selects the\n" \
+     "node of the CPUs the interface is created on, if they all belong to one node.\n" \
+     "\"inf\" keeps the memory policy of the process.", \
+     (_offset) + ucs_offsetof(uct_iface_mpool_config_t, numa_node), UCS_CONFIG_TYPE_ULUNITS}
 
 
 void uct_iface_mpool_config_copy(ucs_mpool_params_t *mp_params,
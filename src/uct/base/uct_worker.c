@@ -32,10 +32,20 @@ typedef struct {
     int             id;   /* Callback id for removing after dispatch */
 } uct_worker_oneshot_cb_ctx_t;
 
+static void uct_worker_vfs_show_progress(void *obj, ucs_string_buffer_t *strb,
+                                         void *arg_ptr, uint64_t arg_u64)
+{
+    uct_worker_t *worker = obj;
+
+    ucs_callbackq_print_counters(&worker->progress_q, strb);
+}
+
 static UCS_CLASS_INIT_FUNC(uct_worker_t)
 {
     ucs_callbackq_init(&self->progress_q);
     ucs_vfs_obj_add_dir(NULL, self, "uct/worker/%p", self);
+    ucs_vfs_obj_add_ro_file(self, uct_worker_vfs_show_progress, NULL, 0,
+                            "progress");
 
     return UCS_OK;
 }
@@ -167,6 +177,17 @@ void uct_worker_progress_register_safe(uct_worker_h tl_worker,
 
         id = ctx->id + UCT_WORKER_ONESHOT_ID_START;
         ucs_assertv(id >= UCT_WORKER_ONESHOT_ID_START, "id=%d", id);
+    } else if (flags & UCS_CALLBACKQ_FLAG_BACKOFF) {
+        /* Background callback, which is polled after all others and less
+         * often while idle */
+        id = ucs_callbackq_add_safe_prio(&worker->super.progress_q, func, arg,
+                                         UCS_CALLBACKQ_PRIO_LOW,
+                                         UCS_CALLBACKQ_ELEM_FLAG_BACKOFF);
+        if (id == UCS_CALLBACKQ_ID_NULL) {
+            /* Fall back to polling the callback on every progress */
+            id = ucs_callbackq_add_safe(&worker->super.progress_q, func, arg);
+        }
+        ucs_assertv(id < UCT_WORKER_ONESHOT_ID_START, "id=%d", id);
     } else {
         /* Normal callback */
         id = ucs_callbackq_add_safe(&worker->super.progress_q, func, arg);
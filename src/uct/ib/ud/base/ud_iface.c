@@ -1052,6 +1052,8 @@ void uct_ud_iface_vfs_refresh(uct_iface_h iface)
                             &ud_iface->config.tx_qp_len, UCS_VFS_TYPE_INT,
                             "tx_qp_len");
 
+    ucs_twheel_vfs_init(&ud_iface->tx.timer, ud_iface, "tx_timer");
+
     ucs_ptr_array_for_each(ep, i, &ud_iface->eps) {
         uct_ud_ep_vfs_populate(ep);
     }
@@ -146,6 +146,132 @@ static void uct_mm_ep_signal_remote(uct_mm_ep_t *ep)
     }
 }
 
+static void uct_mm_ep_spsc_ring_attach(uct_mm_ep_t *ep,
+                                       const uct_mm_spsc_rings_t *rings,
+                                       unsigned index)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                           uct_mm_iface_t);
+
+    ep->spsc.index      = index;
+    ep->spsc.ctl        = &rings->ctl[index];
+    ep->spsc.elems      = uct_mm_iface_spsc_ring_elems(iface, rings, index);
+    ep->spsc.ready      = &rings->ready[index];
+    ep->spsc.alloc_word = &rings->alloc_map[index / 64];
+    ep->spsc.head       = ep->spsc.ctl->head;
+    ucs_memory_cpu_load_fence();
+    ep->cached_tail     = ep->spsc.ctl->tail;
+    ucs_debug("mm_ep %p: using per-sender ring %u head %" PRIu64, ep,
+              ep->spsc.index, ep->spsc.head);
+}
+
+/* A ring stays owned if its owner process exits without destroying the ep, so
+ * take it over once the receiver consumed everything the owner wrote */
+static int uct_mm_ep_spsc_ring_reclaim(uct_mm_ep_t *ep,
+                                       const uct_mm_spsc_rings_t *rings,
+                                       unsigned index)
+{
+    uct_mm_iface_t *iface  = ucs_derived_of(ep->super.super.iface,
+                                            uct_mm_iface_t);
+    uct_mm_spsc_ctl_t *ctl = &rings->ctl[index];
+    uint32_t owner_pid     = ctl->owner_pid;
+    uct_mm_fifo_element_t *elem;
+    uint64_t tail;
+
+    /* owner_pid is 0 while the ring is being claimed */
+    if ((owner_pid == 0) || (ucs_sys_get_proc_create_time(owner_pid) != 0)) {
+        return 0;
+    }
+
+    tail = ctl->tail;
+    elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface,
+                                      uct_mm_iface_spsc_ring_elems(iface,
+                                                                   rings,
+                                                                   index),
+                                      tail & (iface->config.spsc_ring_size -
+                                              1));
+    if (!(elem->flags & UCT_MM_FIFO_ELEM_FLAG_OWNER) ==
+        !(tail & iface->config.spsc_ring_size)) {
+        /* the element at the tail is ready and was not consumed yet */
+        return 0;
+    }
+
+    if (ucs_atomic_cswap32(&ctl->owner_pid, owner_pid, getpid()) !=
+        owner_pid) {
+        /* race with another sender */
+        return 0;
+    }
+
+    ucs_debug("mm_ep %p: reclaimed per-sender ring %u of exited pid %u", ep,
+              index, owner_pid);
+    ctl->head = tail;
+    return 1;
+}
+
+static void uct_mm_ep_spsc_ring_claim(uct_mm_ep_t *ep)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                           uct_mm_iface_t);
+    unsigned num_rings    = iface->config.spsc_num_rings;
+    uct_mm_spsc_rings_t rings;
+    volatile uint64_t *word_p;
+    uint64_t free_mask, prev;
+    unsigned word_index, bit, index;
+
+    ep->spsc.ctl = NULL;
+
+    /* the ring layout is defined by the configuration, which must be the
+     * same on both sides */
+    if ((num_rings == 0) || (ep->fifo_ctl->spsc_num_rings != num_rings) ||
+        (ep->fifo_ctl->spsc_ring_size != iface->config.spsc_ring_size)) {
+        return;
+    }
+
+    uct_mm_iface_set_spsc_ptrs(iface, ep->fifo_elems, &rings);
+
+    for (word_index = 0; word_index < ucs_div_round_up(num_rings, 64);
+         ++word_index) {
+        word_p    = &rings.alloc_map[word_index];
+        free_mask = (num_rings - (word_index * 64) >= 64) ?
+                    UINT64_MAX : UCS_MASK(num_rings - (word_index * 64));
+        while ((free_mask & ~(*word_p)) != 0) {
+            bit  = ucs_ffs64(free_mask & ~(*word_p));
+            prev = ucs_atomic_for64(word_p, UCS_BIT(bit));
+            if (prev & UCS_BIT(bit)) {
+                /* race with another sender, try the next free ring */
+                continue;
+            }
+
+            index                      = (word_index * 64) + bit;
+            rings.ctl[index].owner_pid = getpid();
+            uct_mm_ep_spsc_ring_attach(ep, &rings, index);
+            return;
+        }
+    }
+
+    for (index = 0; index < num_rings; ++index) {
+        if (uct_mm_ep_spsc_ring_reclaim(ep, &rings, index)) {
+            uct_mm_ep_spsc_ring_attach(ep, &rings, index);
+            return;
+        }
+    }
+
+    ucs_debug("mm_ep %p: no free per-sender ring, using shared FIFO", ep);
+}
+
+static void uct_mm_ep_spsc_ring_release(uct_mm_ep_t *ep)
+{
+    if (ep->spsc.ctl == NULL) {
+        return;
+    }
+
+    /* let the next owner of the ring continue from the current head */
+    ep->spsc.ctl->head      = ep->spsc.head;
+    ep->spsc.ctl->owner_pid = 0;
+    ucs_memory_cpu_store_fence();
+    ucs_atomic_and64(ep->spsc.alloc_word, ~UCS_BIT(ep->spsc.index % 64));
+}
+
 void uct_mm_ep_cleanup_remote_segs(uct_mm_ep_t *ep)
 {
     uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -199,6 +325,7 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
     uct_mm_iface_set_fifo_ptrs(fifo_ptr, &self->fifo_ctl, &self->fifo_elems);
     self->cached_tail = self->fifo_ctl->tail;
     ucs_arbiter_elem_init(&self->arb_elem);
+    uct_mm_ep_spsc_ring_claim(self);
 
     status = uct_ep_keepalive_init(&self->keepalive, self->fifo_ctl->pid);
     if (status != UCS_OK) {
@@ -211,6 +338,7 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
     return UCS_OK;
 
 err_free_segs:
+    uct_mm_ep_spsc_ring_release(self);
     uct_mm_ep_cleanup_remote_segs(self);
 err_free_md_addr:
     ucs_free(self->remote_iface_addr);
@@ -221,6 +349,7 @@ err:
 static UCS_CLASS_CLEANUP_FUNC(uct_mm_ep_t)
 {
     uct_mm_ep_pending_purge(&self->super.super, NULL, NULL);
+    uct_mm_ep_spsc_ring_release(self);
     uct_mm_ep_cleanup_remote_segs(self);
     ucs_free(self->remote_iface_addr);
 }
@@ -255,7 +384,29 @@ uct_mm_ep_get_remote_elem(uct_mm_ep_t *ep, uint64_t head,
 static inline void uct_mm_ep_update_cached_tail(uct_mm_ep_t *ep)
 {
     ucs_memory_cpu_load_fence();
-    ep->cached_tail = ep->fifo_ctl->tail;
+    ep->cached_tail = (ep->spsc.ctl != NULL) ? ep->spsc.ctl->tail :
+                                               ep->fifo_ctl->tail;
+}
+
+/* Notify the receiver about a new element in the per-sender ring */
+static UCS_F_ALWAYS_INLINE void uct_mm_ep_spsc_notify(uct_mm_ep_t *ep)
+{
+    uint64_t head;
+
+    /* the receiver clears the flag before polling the ring, so the flag must
+     * be raised after every written element */
+    *ep->spsc.ready = 1;
+
+    /* order raising the flag before checking the armed bit, the receiver
+     * checks the flags after setting the armed bit */
+    ucs_memory_cpu_fence();
+    head = ep->fifo_ctl->head;
+    if (ucs_unlikely(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) &&
+        (ucs_atomic_cswap64(ucs_unaligned_ptr(&ep->fifo_ctl->head), head,
+                            head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) ==
+         head)) {
+        uct_mm_ep_signal_remote(ep);
+    }
 }
 
 static UCS_F_ALWAYS_INLINE void uct_mm_ep_peer_check(uct_mm_ep_t *ep,
@@ -291,13 +442,21 @@ static UCS_F_ALWAYS_INLINE ssize_t uct_mm_ep_am_common_send(
     uint64_t head;
     ucs_iov_iter_t iov_iter;
     void *desc_data;
+    unsigned fifo_size;
 
     UCT_CHECK_AM_ID(am_id);
 
 retry:
-    head = ep->fifo_ctl->head;
+    if (ep->spsc.ctl != NULL) {
+        head      = ep->spsc.head;
+        fifo_size = iface->config.spsc_ring_size;
+    } else {
+        head      = ep->fifo_ctl->head;
+        fifo_size = iface->config.fifo_size;
+    }
+
     /* check if there is room in the remote process's receive FIFO to write */
-    if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail, iface->config.fifo_size)) {
+    if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail, fifo_size)) {
         if (!ucs_arbiter_group_is_empty(&ep->arb_group)) {
             /* pending isn't empty. don't send now to prevent out-of-order sending */
             return uct_mm_ep_no_resources_handle(ep, flags);
@@ -305,7 +464,7 @@ retry:
             /* pending is empty. update the local copy of the tail to its
              * actual value on the remote peer */
             uct_mm_ep_update_cached_tail(ep);
-            if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail, iface->config.fifo_size)) {
+            if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail, fifo_size)) {
                 ucs_arbiter_group_push_head_elem_always(&ep->arb_group,
                                                         &ep->arb_elem);
                 ucs_arbiter_group_schedule_nonempty(&iface->arbiter,
@@ -315,11 +474,19 @@ retry:
         }
     }
 
-    status = uct_mm_ep_get_remote_elem(ep, head, &elem);
-    if (status != UCS_OK) {
-        ucs_assert(status == UCS_ERR_NO_RESOURCE);
-        ucs_trace_poll("couldn't get an available FIFO element. retrying");
-        goto retry;
+    if (ep->spsc.ctl != NULL) {
+        /* the ring is owned by this ep, no need to synchronize with other
+         * senders */
+        elem          = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->spsc.elems,
+                                                   head & (fifo_size - 1));
+        ep->spsc.head = head + 1;
+    } else {
+        status = uct_mm_ep_get_remote_elem(ep, head, &elem);
+        if (status != UCS_OK) {
+            ucs_assert(status == UCS_ERR_NO_RESOURCE);
+            ucs_trace_poll("couldn't get an available FIFO element. retrying");
+            goto retry;
+        }
     }
 
     switch (send_op) {
@@ -376,12 +543,14 @@ retry:
 
     /* set the owner bit to indicate that the writing is complete.
      * the owner bit flips after every FIFO wraparound */
-    if (head & iface->config.fifo_size) {
+    if (head & fifo_size) {
         elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
     }
     elem->flags = elem_flags;
 
-    if (ucs_unlikely(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
+    if (ep->spsc.ctl != NULL) {
+        uct_mm_ep_spsc_notify(ep);
+    } else if (ucs_unlikely(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
         uct_mm_ep_signal_remote(ep);
     }
 
@@ -443,6 +612,12 @@ ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_
 static inline int uct_mm_ep_has_tx_resources(uct_mm_ep_t *ep)
 {
     uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface, uct_mm_iface_t);
+
+    if (ep->spsc.ctl != NULL) {
+        return UCT_MM_EP_IS_ABLE_TO_SEND(ep->spsc.head, ep->cached_tail,
+                                         iface->config.spsc_ring_size);
+    }
+
     return UCT_MM_EP_IS_ABLE_TO_SEND(ep->fifo_ctl->head, ep->cached_tail,
                                      iface->config.fifo_size);
 }
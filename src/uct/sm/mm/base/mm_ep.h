@@ -30,10 +30,24 @@ typedef struct uct_mm_ep {
     /* fifo elements (destination's receive fifo) */
     void                       *fifo_elems;
 
-    /* the sender's own copy of the remote FIFO's tail.
+    /* the sender's own copy of the remote FIFO's tail, or the tail of the
+       per-sender ring if the ep owns one.
        it is not always updated with the actual remote tail value */
     uint64_t                   cached_tail;
 
+    /* per-sender ring in the destination's receive FIFO */
+    struct {
+        uct_mm_spsc_ctl_t      *ctl;          /* NULL if the ep does not own
+                                                 a ring and uses the shared
+                                                 FIFO */
+        void                   *elems;        /* ring elements */
+        volatile uint8_t       *ready;        /* ready flag of the ring */
+        volatile uint64_t      *alloc_word;   /* word of the ring allocation
+                                                 bitmap */
+        uint64_t               head;          /* where to write next */
+        unsigned               index;         /* index of the ring */
+    } spsc;
+
     /* mapped remote memory chunks to which remote descriptors belong to.
      * (after attaching to them) */
     khash_t(uct_mm_remote_seg) remote_segs;
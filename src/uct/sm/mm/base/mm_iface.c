@@ -64,6 +64,25 @@ ucs_config_field_t uct_mm_iface_config_table[] = {
      "Maximal number of receive completions to pick during RX poll",
      ucs_offsetof(uct_mm_iface_config_t, fifo_max_poll), UCS_CONFIG_TYPE_ULUNITS},
 
+    {"FIFO_BATCH_RECV", "n",
+     "Validate a run of consecutive FIFO elements written by the senders before\n"
+     "processing them, and release the processed elements to the senders once\n"
+     "per run instead of once per element.",
+     ucs_offsetof(uct_mm_iface_config_t, fifo_batch_recv), UCS_CONFIG_TYPE_BOOL},
+
+    {"SPSC_RINGS", "0",
+     "Number of per-sender receive rings in the receive FIFO segment. An\n"
+     "endpoint which owns a ring writes to it without updating the shared FIFO\n"
+     "head atomically, which removes the contention between the senders. An\n"
+     "endpoint which could not get a ring uses the shared FIFO. 0 disables the\n"
+     "per-sender rings.",
+     ucs_offsetof(uct_mm_iface_config_t, spsc_num_rings), UCS_CONFIG_TYPE_UINT},
+
+    {"SPSC_RING_SIZE", "64",
+     "Number of elements in every per-sender receive ring (must be a power of\n"
+     "two and bigger than 1).",
+     ucs_offsetof(uct_mm_iface_config_t, spsc_ring_size), UCS_CONFIG_TYPE_UINT},
+
     {"ERROR_HANDLING", "n", "Expose error handling support capability",
      ucs_offsetof(uct_mm_iface_config_t, error_handling), UCS_CONFIG_TYPE_BOOL},
 
@@ -295,17 +314,17 @@ uct_mm_assign_desc_to_fifo_elem(uct_mm_iface_t *iface,
     return UCS_OK;
 }
 
-static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
+static UCS_F_ALWAYS_INLINE void
+uct_mm_iface_process_recv(uct_mm_iface_t *iface, uct_mm_fifo_element_t *elem,
+                          uint64_t elem_index)
 {
-    uct_mm_fifo_element_t *elem = iface->read_index_elem;
     ucs_status_t status;
     void *data;
 
     if (ucs_likely(elem->flags & UCT_MM_FIFO_ELEM_FLAG_INLINE)) {
         /* read short (inline) messages from the FIFO elements */
         uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_RECV, elem->flags,
-                              elem->am_id, elem + 1, elem->length,
-                              iface->read_index);
+                              elem->am_id, elem + 1, elem->length, elem_index);
         uct_mm_iface_invoke_am(iface, elem->am_id, elem + 1, elem->length, 0);
         return;
     }
@@ -320,7 +339,7 @@ static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
     data = elem->desc_data;
     VALGRIND_MAKE_MEM_DEFINED(data, elem->length);
     uct_mm_iface_trace_am(iface, UCT_AM_TRACE_TYPE_RECV, elem->flags,
-                          elem->am_id, data, elem->length, iface->read_index);
+                          elem->am_id, data, elem->length, elem_index);
 
     status = uct_mm_iface_invoke_am(iface, elem->am_id, data, elem->length,
                                     UCT_CB_PARAM_FLAG_DESC);
@@ -333,13 +352,23 @@ static UCS_F_ALWAYS_INLINE void uct_mm_iface_process_recv(uct_mm_iface_t *iface)
     }
 }
 
+static UCS_F_ALWAYS_INLINE int
+uct_mm_iface_fifo_elem_is_ready(const uct_mm_fifo_element_t *elem,
+                                uint64_t elem_index, uint8_t fifo_shift)
+{
+    /* check the owner bit of the element, which is flipped by the sender every
+     * FIFO cycle */
+    return (((elem_index >> fifo_shift) & 1) ==
+            (elem->flags & UCT_MM_FIFO_ELEM_FLAG_OWNER));
+}
+
 static UCS_F_ALWAYS_INLINE int
 uct_mm_iface_fifo_has_new_data(uct_mm_iface_t *iface)
 {
-    /* check the read_index to see if there is a new item to read
-     * (checking the owner bit) */
-    return (((iface->read_index >> iface->fifo_shift) & 1) ==
-            (iface->read_index_elem->flags & 1));
+    /* check the read_index to see if there is a new item to read */
+    return uct_mm_iface_fifo_elem_is_ready(iface->read_index_elem,
+                                           iface->read_index,
+                                           iface->fifo_shift);
 }
 
 static UCS_F_ALWAYS_INLINE unsigned
@@ -354,7 +383,7 @@ uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
     ucs_assert(iface->read_index <=
                (iface->recv_fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
 
-    uct_mm_iface_process_recv(iface);
+    uct_mm_iface_process_recv(iface, iface->read_index_elem, iface->read_index);
 
     /* raise the read_index */
     iface->read_index++;
@@ -369,6 +398,166 @@ uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
     return 1;
 }
 
+static UCS_F_ALWAYS_INLINE uct_mm_fifo_element_t *
+uct_mm_iface_fifo_next_elem(uct_mm_iface_t *iface, uint64_t elem_index)
+{
+    return UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems,
+                                      elem_index & iface->fifo_mask);
+}
+
+static UCS_F_ALWAYS_INLINE unsigned
+uct_mm_iface_poll_fifo_batch(uct_mm_iface_t *iface, unsigned max_count)
+{
+    uint64_t read_index         = iface->read_index;
+    uct_mm_fifo_element_t *elem = iface->read_index_elem;
+    unsigned count, i;
+
+    /* find the run of consecutive elements which were written by the senders,
+     * and prefetch the next element header while checking the current one */
+    for (count = 0; count < max_count; ++count) {
+        if (!uct_mm_iface_fifo_elem_is_ready(elem, read_index + count,
+                                             iface->fifo_shift)) {
+            break;
+        }
+
+        elem = uct_mm_iface_fifo_next_elem(iface, read_index + count + 1);
+        ucs_read_prefetch(elem);
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    /* a single barrier orders reading the data of all validated elements after
+     * reading their owner bits */
+    ucs_memory_cpu_load_fence();
+    ucs_assert((read_index + count) <=
+               (iface->recv_fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
+
+    elem = iface->read_index_elem;
+    for (i = 0; i < count; ++i) {
+        uct_mm_iface_process_recv(iface, elem, read_index + i);
+        elem = uct_mm_iface_fifo_next_elem(iface, read_index + i + 1);
+    }
+
+    iface->read_index      = read_index + count;
+    iface->read_index_elem = elem;
+
+    /* release the processed elements to the senders once per batch, if the
+     * batch crossed the release boundary */
+    if ((read_index | iface->fifo_release_factor_mask) <
+        (iface->read_index | iface->fifo_release_factor_mask)) {
+        ucs_memory_cpu_store_fence();
+        iface->recv_fifo_ctl->tail = iface->read_index;
+    }
+
+    return count;
+}
+
+static UCS_F_ALWAYS_INLINE unsigned
+uct_mm_iface_poll_spsc_ring(uct_mm_iface_t *iface, unsigned ring_index,
+                            unsigned max_count)
+{
+    uint64_t read_index = iface->spsc.read_index[ring_index];
+    void *ring_elems    = uct_mm_iface_spsc_ring_elems(iface,
+                                                       &iface->spsc.rings,
+                                                       ring_index);
+    uct_mm_fifo_element_t *elem;
+    unsigned count, i;
+
+    for (count = 0; count < max_count; ++count) {
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ring_elems,
+                                          (read_index + count) &
+                                          iface->spsc.ring_mask);
+        if (!uct_mm_iface_fifo_elem_is_ready(elem, read_index + count,
+                                             iface->spsc.ring_shift)) {
+            break;
+        }
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    ucs_memory_cpu_load_fence();
+
+    for (i = 0; i < count; ++i) {
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ring_elems,
+                                          (read_index + i) &
+                                          iface->spsc.ring_mask);
+        uct_mm_iface_process_recv(iface, elem, read_index + i);
+    }
+
+    /* the ring tail is polled only by the ring owner, so release the
+     * processed elements immediately */
+    iface->spsc.read_index[ring_index] = read_index + count;
+    ucs_memory_cpu_store_fence();
+    iface->spsc.rings.ctl[ring_index].tail = read_index + count;
+
+    return count;
+}
+
+static unsigned uct_mm_iface_poll_spsc(uct_mm_iface_t *iface,
+                                       unsigned max_count)
+{
+    volatile uint8_t *ready = iface->spsc.rings.ready;
+    unsigned num_words      = ucs_div_round_up(iface->config.spsc_num_rings,
+                                               sizeof(uint64_t));
+    unsigned total_count    = 0;
+    unsigned i, word_index, ring_index;
+
+    /* start scanning from a different word every time to be fair between
+     * the senders when the polling window is exhausted */
+    word_index          = iface->spsc.next_word;
+    iface->spsc.next_word = (word_index + 1) % num_words;
+
+    for (i = 0; (i < num_words) && (total_count < max_count); ++i) {
+        if (((volatile uint64_t*)ready)[word_index] != 0) {
+            for (ring_index = word_index * sizeof(uint64_t);
+                 (ring_index < ((word_index + 1) * sizeof(uint64_t))) &&
+                 (total_count < max_count);
+                 ++ring_index) {
+                if (ready[ring_index] == 0) {
+                    continue;
+                }
+
+                /* clear the flag before polling the ring, so an element
+                 * written after the polling raises the flag again */
+                ready[ring_index] = 0;
+                ucs_memory_cpu_fence();
+
+                total_count += uct_mm_iface_poll_spsc_ring(
+                                       iface, ring_index,
+                                       max_count - total_count);
+                if (total_count == max_count) {
+                    /* the ring may still have elements to read */
+                    ready[ring_index] = 1;
+                }
+            }
+        }
+
+        word_index = (word_index + 1) % num_words;
+    }
+
+    return total_count;
+}
+
+static int uct_mm_iface_spsc_has_ready(uct_mm_iface_t *iface)
+{
+    const volatile uint64_t *ready = (const volatile uint64_t*)
+                                             iface->spsc.rings.ready;
+    unsigned i;
+
+    for (i = 0; i < ucs_div_round_up(iface->config.spsc_num_rings,
+                                     sizeof(uint64_t)); ++i) {
+        if (ready[i] != 0) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 static UCS_F_ALWAYS_INLINE void
 uct_mm_iface_fifo_window_adjust(uct_mm_iface_t *iface,
                                 unsigned fifo_poll_count)
@@ -405,13 +594,34 @@ static unsigned uct_mm_iface_progress(uct_iface_h tl_iface)
 
     ucs_assert(iface->fifo_poll_count >= UCT_MM_IFACE_FIFO_MIN_POLL);
 
-    /* progress receive */
-    do {
-        count = uct_mm_iface_poll_fifo(iface);
-        ucs_assert(count < 2);
-        total_count += count;
-        ucs_assert(total_count < UINT_MAX);
-    } while ((count != 0) && (total_count < iface->fifo_poll_count));
+    /* progress receive from the per-sender rings */
+    if (iface->config.spsc_num_rings > 0) {
+        total_count = uct_mm_iface_poll_spsc(iface, iface->fifo_poll_count);
+    }
+
+    /* progress receive from the shared FIFO */
+    if (iface->config.fifo_batch_recv) {
+        while (total_count < iface->fifo_poll_count) {
+            count = uct_mm_iface_poll_fifo_batch(
+                    iface, iface->fifo_poll_count - total_count);
+            if (count == 0) {
+                break;
+            }
+
+            total_count += count;
+        }
+    } else {
+        while (total_count < iface->fifo_poll_count) {
+            count = uct_mm_iface_poll_fifo(iface);
+            if (count == 0) {
+                break;
+            }
+
+            ucs_assert(count == 1);
+            total_count += count;
+            ucs_assert(total_count < UINT_MAX);
+        }
+    }
 
     uct_mm_iface_fifo_window_adjust(iface, total_count);
 
@@ -474,6 +684,17 @@ uct_mm_iface_event_fd_arm(uct_iface_h tl_iface, unsigned events)
         }
     }
 
+    /* Senders to the per-sender rings check the armed bit after raising the
+     * ready flag of the ring, so check the ready flags after setting it */
+    if (iface->config.spsc_num_rings > 0) {
+        ucs_memory_cpu_fence();
+        if (uct_mm_iface_spsc_has_ready(iface)) {
+            ucs_trace("iface %p: cannot arm, per-sender ring has new data",
+                      iface);
+            return UCS_ERR_BUSY;
+        }
+    }
+
     /* check for pending events */
     ret = recvfrom(iface->signal_fd, &dummy, sizeof(dummy), 0, NULL, 0);
     if (ret > 0) {
@@ -635,14 +856,15 @@ static void uct_mm_iface_recv_desc_init(uct_iface_h tl_iface, void *obj,
     desc->info.offset   = offset;
 }
 
-static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface, unsigned num_elems)
+static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface, void *elems,
+                                       unsigned num_elems)
 {
     uct_mm_fifo_element_t *elem;
     uct_mm_recv_desc_t *desc;
     unsigned i;
 
     for (i = 0; i < num_elems; i++) {
-        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems, i);
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, elems, i);
         desc = (uct_mm_recv_desc_t*)UCS_PTR_BYTE_OFFSET(elem->desc_data,
                                                         -iface->rx_headroom) - 1;
         ucs_mpool_put(desc);
@@ -673,6 +895,93 @@ void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
     *fifo_elems_p = UCS_PTR_BYTE_OFFSET(fifo_ctl, UCT_MM_FIFO_CTL_SIZE);
 }
 
+void uct_mm_iface_set_spsc_ptrs(uct_mm_iface_t *iface, void *fifo_elems,
+                                uct_mm_spsc_rings_t *rings)
+{
+    unsigned num_rings = iface->config.spsc_num_rings;
+    void *ptr;
+
+    ptr = (void*)ucs_align_up_pow2((uintptr_t)UCT_MM_IFACE_GET_FIFO_ELEM(
+                                           iface, fifo_elems,
+                                           iface->config.fifo_size),
+                                   UCS_SYS_CACHE_LINE_SIZE);
+
+    rings->alloc_map = ptr;
+    ptr              = UCS_PTR_BYTE_OFFSET(ptr,
+                                           UCT_MM_SPSC_ALLOC_MAP_SIZE(num_rings));
+    rings->ready     = ptr;
+    ptr              = UCS_PTR_BYTE_OFFSET(ptr,
+                                           UCT_MM_SPSC_READY_SIZE(num_rings));
+    rings->ctl       = ptr;
+    rings->elems     = rings->ctl + num_rings;
+}
+
+static ucs_status_t uct_mm_iface_spsc_init(uct_mm_iface_t *iface)
+{
+    unsigned num_rings = iface->config.spsc_num_rings;
+    uct_mm_fifo_element_t *elem;
+    ucs_status_t status;
+    unsigned i;
+
+    iface->recv_fifo_ctl->spsc_num_rings = num_rings;
+    iface->recv_fifo_ctl->spsc_ring_size = iface->config.spsc_ring_size;
+    iface->spsc.read_index               = NULL;
+    iface->spsc.next_word                = 0;
+    iface->spsc.ring_mask                = iface->config.spsc_ring_size - 1;
+    iface->spsc.ring_shift               = ucs_count_trailing_zero_bits(
+                                                iface->config.spsc_ring_size);
+    if (num_rings == 0) {
+        return UCS_OK;
+    }
+
+    iface->spsc.read_index = ucs_calloc(num_rings,
+                                        sizeof(*iface->spsc.read_index),
+                                        "mm_spsc_read_index");
+    if (iface->spsc.read_index == NULL) {
+        ucs_error("failed to allocate read index of %u per-sender rings",
+                  num_rings);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    uct_mm_iface_set_spsc_ptrs(iface, iface->recv_fifo_elems,
+                               &iface->spsc.rings);
+    memset((void*)iface->spsc.rings.alloc_map, 0,
+           UCT_MM_SPSC_ALLOC_MAP_SIZE(num_rings));
+    memset((void*)iface->spsc.rings.ready, 0,
+           UCT_MM_SPSC_READY_SIZE(num_rings));
+    memset(iface->spsc.rings.ctl, 0, num_rings * sizeof(uct_mm_spsc_ctl_t));
+
+    /* initiate the owner bit and assign a receive descriptor to all the
+     * elements of all the rings */
+    for (i = 0; i < (num_rings * iface->config.spsc_ring_size); i++) {
+        elem        = UCT_MM_IFACE_GET_FIFO_ELEM(iface,
+                                                 iface->spsc.rings.elems, i);
+        elem->flags = UCT_MM_FIFO_ELEM_FLAG_OWNER;
+
+        status = uct_mm_assign_desc_to_fifo_elem(iface, elem, 1);
+        if (status != UCS_OK) {
+            ucs_error("failed to allocate a descriptor for MM per-sender ring");
+            uct_mm_iface_free_rx_descs(iface, iface->spsc.rings.elems, i);
+            ucs_free(iface->spsc.read_index);
+            return status;
+        }
+    }
+
+    return UCS_OK;
+}
+
+static void uct_mm_iface_spsc_cleanup(uct_mm_iface_t *iface)
+{
+    if (iface->config.spsc_num_rings == 0) {
+        return;
+    }
+
+    uct_mm_iface_free_rx_descs(iface, iface->spsc.rings.elems,
+                               iface->config.spsc_num_rings *
+                               iface->config.spsc_ring_size);
+    ucs_free(iface->spsc.read_index);
+}
+
 static ucs_status_t uct_mm_iface_create_signal_fd(uct_mm_iface_t *iface)
 {
     ucs_status_t status;
@@ -764,6 +1073,15 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto err;
     }
 
+    if ((mm_config->spsc_num_rings > 0) &&
+        ((mm_config->spsc_ring_size <= 1) ||
+         !ucs_is_pow2(mm_config->spsc_ring_size))) {
+        ucs_error("The MM per-sender ring size must be a power of two and "
+                  "bigger than 1.");
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     /* check the value defining the FIFO batch release */
     if ((mm_config->release_fifo_factor < 0) || (mm_config->release_fifo_factor >= 1)) {
         ucs_error("The MM release FIFO factor must be: (0 =< factor < 1).");
@@ -788,6 +1106,9 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
                                       UCT_MM_IFACE_FIFO_MAX_POLL :
                                       /* trim by the maximum unsigned integer value */
                                       ucs_min(mm_config->fifo_max_poll, UINT_MAX));
+    self->config.fifo_batch_recv   = mm_config->fifo_batch_recv;
+    self->config.spsc_num_rings    = mm_config->spsc_num_rings;
+    self->config.spsc_ring_size    = mm_config->spsc_ring_size;
 
     self->config.extra_cap_flags   = (mm_config->error_handling == UCS_YES) ?
                                      UCT_IFACE_FLAG_ERRHANDLE_PEER_FAILURE :
@@ -872,13 +1193,18 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         }
     }
 
+    status = uct_mm_iface_spsc_init(self);
+    if (status != UCS_OK) {
+        goto destroy_descs;
+    }
+
     ucs_arbiter_init(&self->arbiter);
     uct_mm_iface_log_created(self);
 
     return UCS_OK;
 
 destroy_descs:
-    uct_mm_iface_free_rx_descs(self, i);
+    uct_mm_iface_free_rx_descs(self, self->recv_fifo_elems, i);
     ucs_mpool_put(self->last_recv_desc);
 destroy_recv_mpool:
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
@@ -897,7 +1223,9 @@ static UCS_CLASS_CLEANUP_FUNC(uct_mm_iface_t)
 
     /* return all the descriptors that are now 'assigned' to the FIFO,
      * to their mpool */
-    uct_mm_iface_free_rx_descs(self, self->config.fifo_size);
+    uct_mm_iface_free_rx_descs(self, self->recv_fifo_elems,
+                               self->config.fifo_size);
+    uct_mm_iface_spsc_cleanup(self);
 
     ucs_mpool_put(self->last_recv_desc);
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
@@ -36,9 +36,29 @@ enum {
     ucs_align_up(sizeof(uct_mm_fifo_ctl_t), UCS_SYS_CACHE_LINE_SIZE)
 
 
+#define UCT_MM_SPSC_ALLOC_MAP_SIZE(_num_rings) \
+    ucs_align_up(ucs_div_round_up(_num_rings, 64) * sizeof(uint64_t), \
+                 UCS_SYS_CACHE_LINE_SIZE)
+
+
+#define UCT_MM_SPSC_READY_SIZE(_num_rings) \
+    ucs_align_up(_num_rings, UCS_SYS_CACHE_LINE_SIZE)
+
+
+#define UCT_MM_GET_SPSC_SIZE(_iface) \
+    (((_iface)->config.spsc_num_rings == 0) ? 0 : \
+     (UCT_MM_SPSC_ALLOC_MAP_SIZE((_iface)->config.spsc_num_rings) + \
+      UCT_MM_SPSC_READY_SIZE((_iface)->config.spsc_num_rings) + \
+      ((_iface)->config.spsc_num_rings * sizeof(uct_mm_spsc_ctl_t)) + \
+      ((size_t)(_iface)->config.spsc_num_rings * \
+       (_iface)->config.spsc_ring_size * (_iface)->config.fifo_elem_size) + \
+      (UCS_SYS_CACHE_LINE_SIZE - 1)))
+
+
 #define UCT_MM_GET_FIFO_SIZE(_iface) \
     (UCT_MM_FIFO_CTL_SIZE + \
      ((_iface)->config.fifo_size * (_iface)->config.fifo_elem_size) + \
+     UCT_MM_GET_SPSC_SIZE(_iface) + \
       (UCS_SYS_CACHE_LINE_SIZE - 1))
 
 
@@ -114,6 +134,9 @@ typedef struct uct_mm_iface_config {
     ucs_ternary_auto_value_t hugetlb_mode;        /* Enable using huge pages for
                                                    * shared memory buffers */
     unsigned                 fifo_elem_size;      /* Size of the FIFO element size */
+    int                      fifo_batch_recv;     /* Drain FIFO elements in batches */
+    unsigned                 spsc_num_rings;      /* Number of per-sender rings */
+    unsigned                 spsc_ring_size;      /* Size of per-sender ring */
     int                      error_handling; /* Exposing of error handling cap */
     uct_iface_mpool_config_t mp;
     uct_mm_iface_overhead_t  overhead;
@@ -144,9 +167,39 @@ typedef struct uct_mm_fifo_ctl {
     /* 2nd cacheline */
     volatile uint64_t         tail;           /* How much was consumed */
     pid_t                     pid;            /* Process owner pid */
+    uint32_t                  spsc_num_rings; /* Number of per-sender rings */
+    uint32_t                  spsc_ring_size; /* Size of per-sender ring */
 } UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) uct_mm_fifo_ctl_t;
 
 
+/**
+ * MM per-sender receive ring control segment
+ */
+typedef struct uct_mm_spsc_ctl {
+    volatile uint64_t         tail;           /* How much was consumed */
+    uint64_t                  head;           /* Where the previous owner of
+                                                 the ring stopped writing */
+    volatile uint32_t         owner_pid;      /* Process which owns the ring,
+                                                 0 if the ring is free */
+    UCS_CACHELINE_PADDING(uint64_t, uint64_t, uint32_t);
+} UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) uct_mm_spsc_ctl_t;
+
+
+/**
+ * Per-sender receive rings, which follow the shared receive FIFO. Each ring is
+ * owned by a single sender, so the sender does not have to update the shared
+ * FIFO head atomically. The sender raises the ready flag of its ring after
+ * writing an element, and the receiver polls only the rings with raised flags.
+ */
+typedef struct uct_mm_spsc_rings {
+    volatile uint64_t         *alloc_map;     /* Bitmap of rings owned by
+                                                 senders */
+    volatile uint8_t          *ready;         /* Per-ring flags of new data */
+    uct_mm_spsc_ctl_t         *ctl;           /* Per-ring control segments */
+    void                      *elems;         /* Elements of all rings */
+} uct_mm_spsc_rings_t;
+
+
 /**
  * MM receive descriptor info in the shared FIFO
  */
@@ -214,6 +267,15 @@ typedef struct uct_mm_iface {
     unsigned                fifo_mask;        /* = 2^fifo_shift - 1 */
     uint64_t                fifo_release_factor_mask;
 
+    struct {
+        uct_mm_spsc_rings_t rings;            /* Per-sender receive rings */
+        uint64_t            *read_index;      /* Reading location per ring */
+        unsigned            next_word;        /* Ready flags word to start
+                                                 scanning from */
+        uint8_t             ring_shift;       /* = log2(ring_size) */
+        unsigned            ring_mask;        /* = 2^ring_shift - 1 */
+    } spsc;
+
     unsigned                fifo_poll_count;     /* How much RX operations can be polled
                                                   * during an iface progress call */
     int                     fifo_prev_wnd_cons;  /* Was FIFO window size fully consumed by
@@ -234,6 +296,9 @@ typedef struct uct_mm_iface {
         /* size of the receive descriptor (for payload) */
         unsigned                seg_size;
         unsigned                fifo_max_poll;
+        int                     fifo_batch_recv;
+        unsigned                spsc_num_rings;
+        unsigned                spsc_ring_size;
         uint64_t                extra_cap_flags;
         uct_mm_iface_overhead_t overhead;
     } config;
@@ -268,6 +333,18 @@ uct_mm_iface_query_tl_devices(uct_md_h md,
 extern ucs_config_field_t uct_mm_iface_config_table[];
 
 
+static UCS_F_ALWAYS_INLINE void *
+uct_mm_iface_spsc_ring_elems(uct_mm_iface_t *iface,
+                             const uct_mm_spsc_rings_t *rings,
+                             unsigned ring_index)
+{
+    return UCS_PTR_BYTE_OFFSET(rings->elems,
+                               (size_t)ring_index *
+                               iface->config.spsc_ring_size *
+                               iface->config.fifo_elem_size);
+}
+
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 uct_mm_iface_invoke_am(uct_mm_iface_t *iface, uint8_t am_id, void *data,
                        unsigned length, unsigned flags)
@@ -299,6 +376,17 @@ void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
                                 void **fifo_elems_p);
 
 
+/**
+ * Set pointers of the per-sender receive rings, which follow the FIFO elements.
+ *
+ * @param [in]  iface        Interface whose configuration defines the layout.
+ * @param [in]  fifo_elems   Pointer to the array of FIFO elements.
+ * @param [out] rings        Filled with pointers to the rings.
+ */
+void uct_mm_iface_set_spsc_ptrs(uct_mm_iface_t *iface, void *fifo_elems,
+                                uct_mm_spsc_rings_t *rings);
+
+
 UCS_CLASS_DECLARE_NEW_FUNC(uct_mm_iface_t, uct_iface_t, uct_md_h, uct_worker_h,
                            const uct_iface_params_t*, const uct_iface_config_t*);
 
@@ -256,6 +256,9 @@ uct_xpmem_rmem_add(xpmem_segid_t xsegid, uct_xpmem_remote_mem_t **rmem_p)
     rcache_params.flags              = UCS_RCACHE_FLAG_NO_PFN_CHECK;
     rcache_params.max_regions        = ULONG_MAX;
     rcache_params.max_size           = SIZE_MAX;
+    rcache_params.max_unreleased     = SIZE_MAX;
+    rcache_params.prefetch_budget    = 0;
+    rcache_params.inv_budget         = ULONG_MAX;
 
     status = ucs_rcache_create(&rcache_params, "xpmem_remote_mem",
                                ucs_stats_get_root(), &rmem->rcache);
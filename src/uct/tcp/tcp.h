@@ -17,6 +17,7 @@
 #include <ucs/datastruct/ptr_map.inl>
 #include <ucs/algorithm/crc.h>
 #include <ucs/sys/event_set.h>
+#include <ucs/sys/io_uring.h>
 #include <ucs/sys/iovec.h>
 
 #include <net/if.h>
@@ -47,6 +48,9 @@
  * operation */
 #define UCT_TCP_EP_PUT_ZCOPY_MAX              SIZE_MAX
 
+/* Maximal number of TCP connections used by an endpoint */
+#define UCT_TCP_EP_MAX_CONN_PER_EP            64
+
 /* Length of a data that is used by PUT protocol */
 #define UCT_TCP_EP_PUT_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
                                               sizeof(uct_tcp_ep_put_req_hdr_t))
@@ -114,7 +118,19 @@ enum {
     /* EP is on EP PTR map. */
     UCT_TCP_EP_FLAG_ON_PTR_MAP         = UCS_BIT(9),
     /* EP has some operations done without flush */
-    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10)
+    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10),
+    /* Zcopy TX operation in progress is sent using MSG_ZEROCOPY. */
+    UCT_TCP_EP_FLAG_ZCOPY_MSG_ZEROCOPY = UCS_BIT(11),
+    /* EP is waiting for the kernel to release user's buffers of Zcopy
+     * operations sent using MSG_ZEROCOPY. */
+    UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY  = UCS_BIT(12),
+    /* EP is an additional connection of another EP, which is used to send
+     * (or receive) parts of large PUT Zcopy operations. Such EP is hidden
+     * from a user and it doesn't take part in connection matching. */
+    UCT_TCP_EP_FLAG_STRIPE             = UCS_BIT(13),
+    /* SO_ZEROCOPY is enabled on the socket of a given EP, so Zcopy
+     * operations are allowed to be sent using MSG_ZEROCOPY. */
+    UCT_TCP_EP_FLAG_MSG_ZEROCOPY_ON    = UCS_BIT(14)
 };
 
 
@@ -189,7 +205,10 @@ typedef enum uct_tcp_cm_conn_event {
 enum {
     /* Indicates whether both EPs of the connection has to use CONNECT_TO_EP
      * CONNECT_TO_EP of connection establishment */
-    UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP = UCS_BIT(0)
+    UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP = UCS_BIT(0),
+    /* Indicates that the connection is an additional stripe connection of
+     * the peer's EP, which carries only PUT Zcopy data */
+    UCT_TCP_CM_CONN_REQ_PKT_FLAG_STRIPE        = UCS_BIT(1)
 };
 
 
@@ -261,6 +280,31 @@ typedef struct uct_tcp_ep_put_completion {
 } uct_tcp_ep_put_completion_t;
 
 
+/**
+ * TCP MSG_ZEROCOPY completion
+ */
+typedef struct uct_tcp_ep_zcopy_completion {
+    uct_completion_t              *comp;           /* User's completion of Zcopy
+                                                    * operation or flush */
+    uint32_t                      wait_sn;         /* Sequence number of the last
+                                                    * MSG_ZEROCOPY send which has
+                                                    * to be released by the kernel */
+    ucs_queue_elem_t              elem;            /* Element to insert completion into
+                                                    * TCP EP MSG_ZEROCOPY completion
+                                                    * queue */
+} uct_tcp_ep_zcopy_completion_t;
+
+
+/**
+ * Completion of an operation which is split between stripe connections
+ */
+typedef struct uct_tcp_ep_stripe_completion {
+    uct_completion_t              super;           /* Completion of every part
+                                                    * of the operation */
+    uct_completion_t              *comp;           /* User's completion */
+} uct_tcp_ep_stripe_completion_t;
+
+
 /**
  * TCP endpoint communication context
  */
@@ -283,6 +327,8 @@ typedef struct uct_tcp_ep_zcopy_tx {
     uct_completion_t              *comp;     /* Local UCT completion object */
     size_t                        iov_index; /* Current IOV index */
     size_t                        iov_cnt;   /* Number of IOVs that should be sent */
+    size_t                        hdr_iov_cnt; /* Number of IOVs that contain TCP
+                                                * protocol and user's headers */
     struct iovec                  iov[0];    /* IOVs that should be sent */
 } uct_tcp_ep_zcopy_tx_t;
 
@@ -349,6 +395,22 @@ struct uct_tcp_ep {
     ucs_queue_head_t              pending_q;    /* Pending operations */
     ucs_queue_head_t              put_comp_q;   /* Flush completions waiting for
                                                  * outstanding PUTs acknowledgment */
+    struct {
+        uint32_t                  sn;           /* Sequence number of the next
+                                                 * MSG_ZEROCOPY send */
+        uint32_t                  comp_sn;      /* Sequence number of the first
+                                                 * MSG_ZEROCOPY send which wasn't
+                                                 * released by the kernel yet */
+        ucs_queue_head_t          comp_q;       /* Completions waiting for the
+                                                 * kernel to release buffers */
+    } zcopy;
+    struct {
+        uct_tcp_ep_t              *parent;      /* EP which owns this stripe
+                                                 * connection */
+        uct_tcp_ep_t              **eps;        /* Additional connections used
+                                                 * to stripe large PUT Zcopy
+                                                 * operations */
+    } stripe;
     union {
         ucs_list_link_t           list;         /* List element to insert into TCP EP list */
         ucs_conn_match_elem_t     elem;         /* Connection matching element, used by EPs
@@ -361,6 +423,17 @@ struct uct_tcp_ep {
 UCS_PTR_MAP_DEFINE(tcp_ep, 0);
 
 
+/**
+ * Receive operation which is posted to io_uring
+ */
+typedef struct uct_tcp_iface_io_uring_op {
+    uct_tcp_ep_t                  *ep;               /* Endpoint which receives the data,
+                                                      * or NULL if it was destroyed */
+    void                          *buf;              /* EP RX buffer at the time the
+                                                      * operation was posted */
+} uct_tcp_iface_io_uring_op_t;
+
+
 /**
  * TCP interface
  */
@@ -384,6 +457,14 @@ typedef struct uct_tcp_iface {
                                                       * (0/1 for each EP) */
     ucs_range_spec_t              port_range;        /** Range of ports to use for bind() */
 
+    struct {
+        ucs_io_uring_t            ring;              /* Ring used to receive the data from
+                                                      * all readable EPs by a single syscall */
+        uct_tcp_iface_io_uring_op_t *ops;            /* Receive operations of the current
+                                                      * batch, NULL if io_uring is disabled */
+        unsigned                  count;             /* Number of EPs in the current batch */
+    } io_uring;
+
     struct {
         size_t                    tx_seg_size;       /* TX AM buffer size */
         size_t                    rx_seg_size;       /* RX AM buffer size */
@@ -392,10 +473,16 @@ typedef struct uct_tcp_iface {
         size_t                    max_iov;           /* Maximum supported IOVs limited by
                                                       * user configuration and service buffers
                                                       * (TCP protocol and user's AM headers) */
+        unsigned                  conn_per_ep;       /* Number of connections per EP */
+        size_t                    stripe_thresh;     /* Minimum size of PUT Zcopy payload from
+                                                      * which it is striped between all
+                                                      * connections of the EP */
         struct {
             size_t                max_hdr;           /* Maximum supported AM Zcopy header */
             size_t                hdr_offset;        /* Offset in TX buffer to empty space that
                                                       * can be used for AM Zcopy header */
+            size_t                msg_zcopy_thresh;  /* Minimum size of user's payload from
+                                                      * which MSG_ZEROCOPY send is used */
         } zcopy;
         struct sockaddr_storage   ifaddr;            /* Network address */
         struct sockaddr_storage   netmask;           /* Network address mask */
@@ -441,6 +528,10 @@ typedef struct uct_tcp_iface_config {
     size_t                         rx_seg_size;
     size_t                         max_iov;
     size_t                         sendv_thresh;
+    size_t                         zcopy_thresh;
+    int                            io_uring;
+    unsigned                       conn_per_ep;
+    size_t                         stripe_thresh;
     int                            prefer_default;
     int                            put_enable;
     int                            conn_nb;
@@ -526,11 +617,21 @@ void uct_tcp_iface_add_ep(uct_tcp_ep_t *ep);
 
 void uct_tcp_iface_remove_ep(uct_tcp_ep_t *ep);
 
+void uct_tcp_iface_io_uring_remove_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep);
+
 int uct_tcp_cm_ep_accept_conn(uct_tcp_ep_t *ep);
 
 int uct_tcp_iface_is_self_addr(uct_tcp_iface_t *iface,
                                const struct sockaddr *peer_addr);
 
+unsigned uct_tcp_ep_progress_zcopy_notify(uct_tcp_ep_t *ep);
+
+ucs_status_t uct_tcp_ep_io_uring_prep_recv(uct_tcp_ep_t *ep,
+                                           ucs_io_uring_t *ring,
+                                           uint64_t user_data);
+
+unsigned uct_tcp_ep_io_uring_recv_done(uct_tcp_ep_t *ep, void *buf, int res);
+
 ucs_status_t uct_tcp_ep_handle_io_err(uct_tcp_ep_t *ep, const char *op_str,
                                       ucs_status_t io_status);
 
@@ -661,6 +762,16 @@ static UCS_F_ALWAYS_INLINE int uct_tcp_ep_ctx_buf_empty(uct_tcp_ep_ctx_t *ctx)
     return ctx->length == 0;
 }
 
+/* SO_ZEROCOPY is a property of the socket, so it follows the socket fd when
+ * the fd is moved to another EP */
+static inline void
+uct_tcp_ep_move_msg_zcopy_flag(uct_tcp_ep_t *to_ep, uct_tcp_ep_t *from_ep)
+{
+    to_ep->flags   = (to_ep->flags & ~UCT_TCP_EP_FLAG_MSG_ZEROCOPY_ON) |
+                     (from_ep->flags & UCT_TCP_EP_FLAG_MSG_ZEROCOPY_ON);
+    from_ep->flags &= ~UCT_TCP_EP_FLAG_MSG_ZEROCOPY_ON;
+}
+
 static inline void uct_tcp_iface_outstanding_inc(uct_tcp_iface_t *iface)
 {
     iface->outstanding++;
@@ -230,8 +230,13 @@ ucs_status_t uct_tcp_cm_send_event(uct_tcp_ep_t *ep,
 
         conn_pkt        = (uct_tcp_cm_conn_req_pkt_t*)(pkt_hdr + 1);
         conn_pkt->event = UCT_TCP_CM_CONN_REQ;
-        conn_pkt->flags = (ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP) ?
-                          UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP : 0;
+        conn_pkt->flags = 0;
+        if (ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP) {
+            conn_pkt->flags |= UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP;
+        }
+        if (ep->flags & UCT_TCP_EP_FLAG_STRIPE) {
+            conn_pkt->flags |= UCT_TCP_CM_CONN_REQ_PKT_FLAG_STRIPE;
+        }
         conn_pkt->cm_id = ep->cm_id;
         memcpy(conn_pkt + 1, &iface->config.ifaddr, iface->config.sockaddr_len);
     } else {
@@ -474,6 +479,7 @@ uct_tcp_cm_simult_conn_accept_remote_conn(uct_tcp_ep_t *accept_ep,
 
     ucs_close_fd(&connect_ep->fd);
     connect_ep->fd = accept_ep->fd;
+    uct_tcp_ep_move_msg_zcopy_flag(connect_ep, accept_ep);
 
     /* 2. Migrate RX from the EP allocated during accepting connection to
      *    the found EP */
@@ -597,6 +603,14 @@ uct_tcp_cm_handle_conn_req(uct_tcp_ep_t **ep_p,
         goto send_ack;
     }
 
+    if (cm_req_pkt->flags & UCT_TCP_CM_CONN_REQ_PKT_FLAG_STRIPE) {
+        /* Stripe connection only receives PUT Zcopy data and sends ACKs for
+         * it, so it is not matched with any local EP and not acknowledged */
+        ep->flags |= UCT_TCP_EP_FLAG_STRIPE;
+        uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CONNECTED);
+        return 1;
+    }
+
     ucs_assertv(!(ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX),
                 "ep %p mustn't have TX cap", ep);
 
@@ -738,7 +752,7 @@ static void uct_tcp_cm_conn_complete(uct_tcp_ep_t *ep)
         return;
     }
 
-    if (ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP) {
+    if (ep->flags & (UCT_TCP_EP_FLAG_CONNECT_TO_EP | UCT_TCP_EP_FLAG_STRIPE)) {
         uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CONNECTED);
     } else {
         uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_WAITING_ACK);
@@ -222,6 +222,26 @@ uct_tcp_ep_t *uct_tcp_ep_ptr_map_retrieve(uct_tcp_iface_t *iface,
     return NULL;
 }
 
+static void uct_tcp_ep_msg_zcopy_enable(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    ucs_status_t status;
+
+    if (iface->config.zcopy.msg_zcopy_thresh == UCS_MEMUNITS_INF) {
+        return;
+    }
+
+    status = ucs_socket_zcopy_enable(ep->fd);
+    if (status != UCS_OK) {
+        ucs_diag("tcp_ep %p: MSG_ZEROCOPY is not supported on fd %d, fall "
+                 "back to copying Zcopy payload to socket buffer", ep, ep->fd);
+        return;
+    }
+
+    ep->flags |= UCT_TCP_EP_FLAG_MSG_ZEROCOPY_ON;
+}
+
 static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface, int fd,
                            const struct sockaddr *dest_addr)
 {
@@ -241,6 +261,11 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface, int fd,
     ucs_list_head_init(&self->list);
     ucs_queue_head_init(&self->pending_q);
     ucs_queue_head_init(&self->put_comp_q);
+    ucs_queue_head_init(&self->zcopy.comp_q);
+    self->zcopy.sn      = 0;
+    self->zcopy.comp_sn = 0;
+    self->stripe.parent = NULL;
+    self->stripe.eps    = NULL;
 
     if (dest_addr != NULL) {
         memcpy(&self->peer_addr[0], dest_addr, iface->config.sockaddr_len);
@@ -248,6 +273,7 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface, int fd,
 
     if (self->fd != -1) /* EP is created during accepting a connection */ {
         self->conn_retries++;
+        uct_tcp_ep_msg_zcopy_enable(self);
     } else if (dest_addr == NULL) {
         /* Since no socket FD and no destination address were specified for
          * new EP, it means that EP is created with CONNECT_TO_EP method */
@@ -341,16 +367,144 @@ uct_tcp_ep_tx_completed(uct_tcp_ep_t *ep, size_t sent_length)
     ep->tx.offset      += sent_length;
 }
 
+static ucs_status_t
+uct_tcp_ep_zcopy_comp_add(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_completion_t *zcopy_comp;
+
+    ucs_assert(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY);
+
+    if (comp == NULL) {
+        return UCS_OK;
+    }
+
+    zcopy_comp = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(zcopy_comp == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate MSG_ZEROCOPY completion "
+                  "from mpool", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    zcopy_comp->wait_sn = ep->zcopy.sn - 1;
+    zcopy_comp->comp    = comp;
+    ucs_queue_push(&ep->zcopy.comp_q, &zcopy_comp->elem);
+
+    return UCS_OK;
+}
+
+/* Invoke the completion of the operation which was acknowledged, or postpone
+ * it until the kernel releases the buffers of MSG_ZEROCOPY sends */
+static void uct_tcp_ep_comp_invoke(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    ucs_status_t status = UCS_OK;
+
+    if (ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY) {
+        status = uct_tcp_ep_zcopy_comp_add(ep, comp);
+        if (ucs_likely(status == UCS_OK)) {
+            return;
+        }
+    }
+
+    uct_invoke_completion(comp, status);
+}
+
 static UCS_F_ALWAYS_INLINE void
 uct_tcp_ep_zcopy_completed(uct_tcp_ep_t *ep, uct_completion_t *comp,
                            ucs_status_t status)
 {
-    ep->flags &= ~UCT_TCP_EP_FLAG_ZCOPY_TX;
-    if (comp != NULL) {
+    uint16_t flags = ep->flags;
+
+    ep->flags &= ~(UCT_TCP_EP_FLAG_ZCOPY_TX |
+                   UCT_TCP_EP_FLAG_ZCOPY_MSG_ZEROCOPY);
+    if (comp == NULL) {
+        return;
+    }
+
+    if ((status == UCS_OK) && (flags & UCT_TCP_EP_FLAG_ZCOPY_MSG_ZEROCOPY)) {
+        uct_tcp_ep_comp_invoke(ep, comp);
+    } else {
         uct_invoke_completion(comp, status);
     }
 }
 
+static void uct_tcp_ep_zcopy_notify_start(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    ep->zcopy.sn++;
+    if (ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY) {
+        return;
+    }
+
+    /* Zero-copy completions are reported through the socket error queue,
+     * keep the socket in the event set until all of them are read */
+    ep->flags |= UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY;
+    uct_tcp_iface_outstanding_inc(iface);
+    uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVERR, 0);
+}
+
+static void uct_tcp_ep_zcopy_notify_done(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    ucs_assert(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY);
+    ucs_assert(ucs_queue_is_empty(&ep->zcopy.comp_q));
+
+    ep->flags        &= ~UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY;
+    ep->zcopy.comp_sn = ep->zcopy.sn;
+    uct_tcp_iface_outstanding_dec(iface);
+    uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVERR);
+}
+
+static void uct_tcp_ep_zcopy_purge(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    uct_tcp_ep_zcopy_completion_t *zcopy_comp;
+
+    ucs_queue_for_each_extract(zcopy_comp, &ep->zcopy.comp_q, elem, 1) {
+        uct_invoke_completion(zcopy_comp->comp, status);
+        ucs_mpool_put_inline(zcopy_comp);
+    }
+}
+
+unsigned uct_tcp_ep_progress_zcopy_notify(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_zcopy_completion_t *zcopy_comp;
+    ucs_status_t status;
+    uint32_t count;
+
+    if (!(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY)) {
+        return 0;
+    }
+
+    status = ucs_socket_zcopy_progress(ep->fd, &count);
+    if (status != UCS_OK) {
+        /* Socket errors are handled by send/receive operations */
+        return 0;
+    }
+
+    /* TCP releases the buffers in the order the data was sent */
+    ep->zcopy.comp_sn += count;
+    ucs_trace_data("tcp_ep %p: MSG_ZEROCOPY sends released up to sn %u/%u",
+                   ep, ep->zcopy.comp_sn, ep->zcopy.sn);
+
+    ucs_queue_for_each_extract(zcopy_comp, &ep->zcopy.comp_q, elem,
+                               UCS_CIRCULAR_COMPARE32(zcopy_comp->wait_sn, <,
+                                                      ep->zcopy.comp_sn)) {
+        uct_invoke_completion(zcopy_comp->comp, UCS_OK);
+        ucs_mpool_put_inline(zcopy_comp);
+    }
+
+    if (!UCS_CIRCULAR_COMPARE32(ep->zcopy.comp_sn, <, ep->zcopy.sn)) {
+        uct_tcp_ep_zcopy_notify_done(ep);
+    }
+
+    return 1;
+}
+
 static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
 {
     uct_tcp_ep_put_completion_t *put_comp;
@@ -369,6 +523,24 @@ static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
         uct_invoke_completion(put_comp->comp, status);
         ucs_mpool_put_inline(put_comp);
     }
+
+    uct_tcp_ep_zcopy_purge(ep, status);
+}
+
+static void uct_tcp_ep_stripes_destroy(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    unsigned i;
+
+    for (i = 0; i < (iface->config.conn_per_ep - 1); ++i) {
+        if (ep->stripe.eps[i] != NULL) {
+            uct_tcp_ep_destroy_internal(&ep->stripe.eps[i]->super.super);
+        }
+    }
+
+    ucs_free(ep->stripe.eps);
+    ep->stripe.eps = NULL;
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
@@ -376,6 +548,10 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
     uct_tcp_iface_t *iface = ucs_derived_of(self->super.super.iface,
                                             uct_tcp_iface_t);
 
+    if (self->stripe.eps != NULL) {
+        uct_tcp_ep_stripes_destroy(self);
+    }
+
     uct_ep_pending_purge(
             &self->super.super,
             (uct_pending_purge_callback_t)ucs_empty_function_do_assert_void,
@@ -393,6 +569,11 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
 
     uct_tcp_ep_remove_ctx_cap(self, UCT_TCP_EP_CTX_CAPS);
     uct_tcp_ep_purge(self, UCS_ERR_CANCELED);
+    uct_tcp_iface_io_uring_remove_ep(iface, self);
+
+    if (self->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY) {
+        uct_tcp_ep_zcopy_notify_done(self);
+    }
 
     if (self->flags & UCT_TCP_EP_FLAG_FAILED) {
         /* a failed EP callback can be still scheduled on the UCT worker,
@@ -503,7 +684,14 @@ void uct_tcp_ep_set_failed(uct_tcp_ep_t *ep, ucs_status_t status)
 
     uct_tcp_ep_mod_events(ep, 0, ep->events);
 
-    if (ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX) {
+    if (ep->stripe.parent != NULL) {
+        /* Stripe connection is not exposed to a user, so its failure is
+         * reported as a failure of the EP which owns it */
+        ucs_debug("tcp_ep %p: stripe of tcp_ep %p failed", ep,
+                  ep->stripe.parent);
+        uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CLOSED);
+        uct_tcp_ep_set_failed(ep->stripe.parent, status);
+    } else if (ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX) {
         ucs_debug("tcp_ep %p: calling error handler (flags: %x)", ep,
                   ep->flags);
         uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CLOSED);
@@ -694,6 +882,8 @@ static ucs_status_t uct_tcp_ep_create_socket_and_connect(uct_tcp_ep_t *ep)
         goto err;
     }
 
+    uct_tcp_ep_msg_zcopy_enable(ep);
+
     status = uct_tcp_ep_keepalive_enable(ep);
     if (status != UCS_OK) {
         goto err;
@@ -726,6 +916,7 @@ void uct_tcp_ep_replace_ep(uct_tcp_ep_t *to_ep, uct_tcp_ep_t *from_ep)
     uct_tcp_ep_mod_events(from_ep, 0, from_ep->events);
     to_ep->fd   = from_ep->fd;
     from_ep->fd = -1;
+    uct_tcp_ep_move_msg_zcopy_flag(to_ep, from_ep);
     uct_tcp_ep_mod_events(to_ep, events, 0);
 
     to_ep->conn_retries++;
@@ -1028,7 +1219,7 @@ static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep,
     ucs_queue_for_each_extract(put_comp, &ep->put_comp_q, elem,
                                (UCS_CIRCULAR_COMPARE32(put_comp->wait_put_sn,
                                                        <=, put_ack->sn))) {
-        uct_invoke_completion(put_comp->comp, UCS_OK);
+        uct_tcp_ep_comp_invoke(ep, put_comp->comp);
         ucs_mpool_put_inline(put_comp);
     }
 }
@@ -1067,6 +1258,12 @@ static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep, ucs_status_t status
             ep->flags &= ~UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK;
         }
 
+        if (ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY) {
+            /* the kernel doesn't report completions for the closed
+             * connection anymore */
+            uct_tcp_ep_zcopy_notify_done(ep);
+        }
+
         uct_tcp_ep_tx_completed(ep, ep->tx.length - ep->tx.offset);
     }
 
@@ -1126,6 +1323,44 @@ static inline ssize_t uct_tcp_ep_send(uct_tcp_ep_t *ep)
     return sent_length;
 }
 
+static ucs_status_t
+uct_tcp_ep_sendv_nb(uct_tcp_ep_t *ep, struct iovec *iov, size_t iov_cnt,
+                    size_t hdr_iov_cnt, size_t *sent_length_p)
+{
+    size_t hdr_length   = 0;
+    size_t zcopy_length = 0;
+    ucs_status_t status;
+
+    if (ucs_likely(!(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_MSG_ZEROCOPY))) {
+        return ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, sent_length_p);
+    }
+
+    /* TCP protocol and user's headers are located in the EP TX buffer or
+     * in the caller's memory which can be reused as soon as the operation
+     * returns, so send them by copying to the socket buffer */
+    if (hdr_iov_cnt > 0) {
+        status = ucs_socket_sendv_nb(ep->fd, iov, hdr_iov_cnt, &hdr_length);
+        if ((status != UCS_OK) ||
+            (hdr_length < ucs_iovec_total_length(iov, hdr_iov_cnt))) {
+            *sent_length_p = hdr_length;
+            return status;
+        }
+    }
+
+    status = ucs_socket_sendv_zcopy_nb(ep->fd, iov + hdr_iov_cnt,
+                                       iov_cnt - hdr_iov_cnt, &zcopy_length);
+    if (status == UCS_OK) {
+        if (zcopy_length > 0) {
+            uct_tcp_ep_zcopy_notify_start(ep);
+        }
+    } else if ((status == UCS_ERR_NO_PROGRESS) && (hdr_length > 0)) {
+        status = UCS_OK;
+    }
+
+    *sent_length_p = hdr_length + zcopy_length;
+    return status;
+}
+
 static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
 {
     uct_tcp_ep_zcopy_tx_t *ctx = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
@@ -1135,8 +1370,11 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
     ucs_assertv((ep->tx.offset < ep->tx.length) &&
                 (ctx->iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, &ctx->iov[ctx->iov_index],
-                                 ctx->iov_cnt - ctx->iov_index, &sent_length);
+    status = uct_tcp_ep_sendv_nb(ep, &ctx->iov[ctx->iov_index],
+                                 ctx->iov_cnt - ctx->iov_index,
+                                 (ctx->iov_index < ctx->hdr_iov_cnt) ?
+                                 (ctx->hdr_iov_cnt - ctx->iov_index) : 0,
+                                 &sent_length);
     if (ucs_unlikely(status != UCS_OK)) {
         if (status == UCS_ERR_NO_PROGRESS) {
             ucs_assert(sent_length == 0);
@@ -1431,45 +1669,49 @@ static inline void uct_tcp_ep_handle_put_req(uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_PUT_RX;
 }
 
-static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
+static ucs_status_t
+uct_tcp_ep_am_rx_prepare(uct_tcp_ep_t *ep, size_t *recv_length_p)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
-    unsigned handled       = 0;
     uct_tcp_am_hdr_t *hdr;
-    size_t recv_length;
     size_t recvd_length;
-    size_t remaining;
-
-    ucs_trace_func("ep=%p", ep);
+    ucs_status_t status;
 
     if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
-        if (ucs_unlikely(uct_tcp_ep_ctx_buf_alloc(
-                                ep, &ep->rx, &iface->rx_mpool) != UCS_OK)) {
-            return 0;
+        status = uct_tcp_ep_ctx_buf_alloc(ep, &ep->rx, &iface->rx_mpool);
+        if (ucs_unlikely(status != UCS_OK)) {
+            return status;
         }
 
         /* post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size;
+        *recv_length_p = iface->config.rx_seg_size;
     } else if (ep->rx.length < sizeof(*hdr)) {
         ucs_assert((ep->rx.buf != NULL) && (ep->rx.offset == 0));
 
         /* do partial receive of the remaining part of the hdr
          * and post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size - ep->rx.length;
+        *recv_length_p = iface->config.rx_seg_size - ep->rx.length;
     } else {
         ucs_assert((ep->rx.buf != NULL) &&
                    ((ep->rx.length - ep->rx.offset) >= sizeof(*hdr)));
 
         /* do partial receive of the remaining user data */
-        hdr          = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
-        recvd_length = ep->rx.length - ep->rx.offset - sizeof(*hdr);
-        recv_length  = ucs_max(0, (ssize_t)(hdr->length - recvd_length));
+        hdr            = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
+        recvd_length   = ep->rx.length - ep->rx.offset - sizeof(*hdr);
+        *recv_length_p = ucs_max(0, (ssize_t)(hdr->length - recvd_length));
     }
 
-    if (!uct_tcp_ep_recv(ep, recv_length)) {
-        goto out;
-    }
+    return UCS_OK;
+}
+
+static unsigned uct_tcp_ep_am_rx_parse(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    unsigned handled       = 0;
+    uct_tcp_am_hdr_t *hdr;
+    size_t remaining;
 
     /* Parse received active messages */
     while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
@@ -1547,6 +1789,74 @@ out:
     return handled;
 }
 
+static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
+{
+    size_t recv_length;
+
+    ucs_trace_func("ep=%p", ep);
+
+    if ((uct_tcp_ep_am_rx_prepare(ep, &recv_length) != UCS_OK) ||
+        !uct_tcp_ep_recv(ep, recv_length)) {
+        return 0;
+    }
+
+    return uct_tcp_ep_am_rx_parse(ep);
+}
+
+ucs_status_t uct_tcp_ep_io_uring_prep_recv(uct_tcp_ep_t *ep,
+                                           ucs_io_uring_t *ring,
+                                           uint64_t user_data)
+{
+    size_t recv_length;
+    ucs_status_t status;
+
+    if ((ep->conn_state != UCT_TCP_EP_CONN_STATE_CONNECTED) ||
+        (ep->flags & UCT_TCP_EP_FLAG_PUT_RX)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    status = uct_tcp_ep_am_rx_prepare(ep, &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    if (ucs_unlikely(recv_length == 0)) {
+        return UCS_ERR_NO_PROGRESS;
+    }
+
+    return ucs_io_uring_prep_recv(ring, ep->fd,
+                                  UCS_PTR_BYTE_OFFSET(ep->rx.buf,
+                                                      ep->rx.length),
+                                  recv_length, user_data);
+}
+
+unsigned uct_tcp_ep_io_uring_recv_done(uct_tcp_ep_t *ep, void *buf, int res)
+{
+    uct_tcp_iface_t UCS_V_UNUSED *iface = ucs_derived_of(ep->super.super.iface,
+                                                         uct_tcp_iface_t);
+    size_t recv_length;
+    ucs_status_t status;
+
+    if (ucs_unlikely(ep->rx.buf != buf)) {
+        /* RX context was released while the operation was in progress */
+        ucs_debug("tcp_ep %p: drop %d bytes received to released buffer %p",
+                  ep, res, buf);
+        return 0;
+    }
+
+    status = ucs_socket_io_result(ep->fd, "recv", res, &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        uct_tcp_ep_handle_recv_err(ep, status);
+        return 0;
+    }
+
+    ep->rx.length += recv_length;
+    ucs_trace_data("tcp_ep %p: recvd %zu bytes", ep, recv_length);
+    ucs_assert(ep->rx.length <= (iface->config.rx_seg_size * 2));
+
+    return uct_tcp_ep_am_rx_parse(ep);
+}
+
 static inline ucs_status_t
 uct_tcp_ep_am_prepare(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
                       uint8_t am_id, uct_tcp_am_hdr_t **hdr)
@@ -1734,7 +2044,7 @@ uct_tcp_ep_am_sendv_get_trace_payload(uct_tcp_am_hdr_t *hdr,
 static inline ucs_status_t
 uct_tcp_ep_am_sendv(uct_tcp_ep_t *ep, int short_sendv, uct_tcp_am_hdr_t *hdr,
                     size_t send_limit, const void *header,
-                    struct iovec *iov, size_t iov_cnt)
+                    struct iovec *iov, size_t iov_cnt, size_t hdr_iov_cnt)
 {
     uct_tcp_iface_t UCS_V_UNUSED *iface = ucs_derived_of(ep->super.super.iface,
                                                          uct_tcp_iface_t);
@@ -1746,8 +2056,9 @@ uct_tcp_ep_am_sendv(uct_tcp_ep_t *ep, int short_sendv, uct_tcp_am_hdr_t *hdr,
     ucs_assertv((ep->tx.length <= send_limit) &&
                 (iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, &sent_length);
+    status = uct_tcp_ep_sendv_nb(ep, iov, iov_cnt, hdr_iov_cnt, &sent_length);
     if (ucs_unlikely((status != UCS_OK) && (status != UCS_ERR_NO_PROGRESS))) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_ZCOPY_MSG_ZEROCOPY;
         return uct_tcp_ep_handle_send_err(ep, status);
     }
 
@@ -1821,7 +2132,7 @@ uct_tcp_ep_am_short_sendv(uct_tcp_ep_t *ep, uct_tcp_iface_t *iface,
     size_t offset;
 
     status = uct_tcp_ep_am_sendv(ep, 1, hdr, iface->config.tx_seg_size, &header, iov,
-                                 iov_cnt);
+                                 iov_cnt, iov_cnt);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
@@ -1966,6 +2277,40 @@ ssize_t uct_tcp_ep_am_bcopy(uct_ep_h uct_ep, uint8_t am_id,
     return payload_length;
 }
 
+static UCS_F_ALWAYS_INLINE void
+uct_tcp_ep_zcopy_set_msg_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                               size_t payload_length)
+{
+    if ((ep->flags & UCT_TCP_EP_FLAG_MSG_ZEROCOPY_ON) &&
+        (payload_length >= iface->config.zcopy.msg_zcopy_thresh)) {
+        ep->flags |= UCT_TCP_EP_FLAG_ZCOPY_MSG_ZEROCOPY;
+    }
+}
+
+/* Complete Zcopy operation which was entirely sent by the first send call */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_tcp_ep_zcopy_sent(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    ucs_status_t status;
+
+    if (ucs_likely(!(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_MSG_ZEROCOPY))) {
+        return UCS_OK;
+    }
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_ZCOPY_MSG_ZEROCOPY;
+    if (!(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY)) {
+        return UCS_OK;
+    }
+
+    /* User's buffers can't be reused until the kernel releases them */
+    status = uct_tcp_ep_zcopy_comp_add(ep, comp);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    return UCS_INPROGRESS;
+}
+
 static inline ucs_status_t
 uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id,
                          const void *header, unsigned header_length,
@@ -2004,6 +2349,8 @@ uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id
         ctx->iov_cnt++;
     }
 
+    ctx->hdr_iov_cnt = ctx->iov_cnt;
+
     /* User-defined payload */
     ucs_iov_iter_init(&uct_iov_iter);
     io_vec_cnt       = iovcnt;
@@ -2039,9 +2386,11 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     }
 
     ctx->super.length = payload_length + header_length;
+    uct_tcp_ep_zcopy_set_msg_zcopy(iface, ep, payload_length);
 
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, iface->config.rx_seg_size,
-                                 header, ctx->iov, ctx->iov_cnt);
+                                 header, ctx->iov, ctx->iov_cnt,
+                                 ctx->hdr_iov_cnt);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
@@ -2054,7 +2403,7 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
         return UCS_INPROGRESS;
     }
 
-    return UCS_OK;
+    return uct_tcp_ep_zcopy_sent(ep, comp);
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
@@ -2082,21 +2431,17 @@ uct_tcp_ep_put_comp_add(uct_tcp_ep_t *ep, uct_completion_t *comp, int wait_sn)
     return UCS_OK;
 }
 
-ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
-                                  size_t iovcnt, uint64_t remote_addr,
-                                  uct_rkey_t rkey, uct_completion_t *comp)
+static ucs_status_t
+uct_tcp_ep_put_zcopy_single(uct_tcp_ep_t *ep, const uct_iov_t *iov,
+                            size_t iovcnt, uint64_t remote_addr,
+                            uct_completion_t *comp)
 {
-    uct_tcp_ep_t *ep                 = ucs_derived_of(uct_ep, uct_tcp_ep_t);
-    uct_tcp_iface_t *iface           = ucs_derived_of(uct_ep->iface,
+    uct_tcp_iface_t *iface           = ucs_derived_of(ep->super.super.iface,
                                                       uct_tcp_iface_t);
     uct_tcp_ep_zcopy_tx_t *ctx       = NULL;
     uct_tcp_ep_put_req_hdr_t put_req = {0}; /* Suppress Cppcheck false-positive */
     ucs_status_t status;
 
-    UCT_CHECK_LENGTH(sizeof(put_req) + uct_iov_total_length(iov, iovcnt), 0,
-                     UCT_TCP_EP_PUT_ZCOPY_MAX - sizeof(uct_tcp_am_hdr_t),
-                     "put_zcopy");
-
     status = uct_tcp_ep_prepare_zcopy(iface, ep, UCT_TCP_EP_PUT_REQ_AM_ID,
                                       &put_req, sizeof(put_req),
                                       iov, iovcnt, "put_zcopy",
@@ -2112,9 +2457,11 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     put_req.addr      = remote_addr;
     put_req.length    = ep->tx.length;
     put_req.sn        = ep->tx.put_sn + 1;
+    uct_tcp_ep_zcopy_set_msg_zcopy(iface, ep, put_req.length);
 
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_PUT_ZCOPY_MAX,
-                                 &put_req, ctx->iov, ctx->iov_cnt);
+                                 &put_req, ctx->iov, ctx->iov_cnt,
+                                 ctx->hdr_iov_cnt);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
@@ -2141,11 +2488,232 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
         uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, &put_req,
                                          sizeof(put_req), NULL);
+    } else {
+        /* PUT completion is reported upon receiving PUT ACK */
+        uct_tcp_ep_zcopy_sent(ep, NULL);
     }
 
     return UCS_INPROGRESS;
 }
 
+static void uct_tcp_ep_stripe_comp_cb(uct_completion_t *self)
+{
+    uct_tcp_ep_stripe_completion_t *stripe_comp =
+            ucs_derived_of(self, uct_tcp_ep_stripe_completion_t);
+
+    uct_invoke_completion(stripe_comp->comp, self->status);
+    ucs_mpool_put_inline(stripe_comp);
+}
+
+static uct_tcp_ep_stripe_completion_t *
+uct_tcp_ep_stripe_comp_get(uct_tcp_ep_t *ep, uct_completion_t *comp, int count)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_stripe_completion_t *stripe_comp;
+
+    stripe_comp = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(stripe_comp == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate stripe completion from mpool",
+                  ep);
+        return NULL;
+    }
+
+    stripe_comp->super.func   = uct_tcp_ep_stripe_comp_cb;
+    stripe_comp->super.count  = count;
+    stripe_comp->super.status = UCS_OK;
+    stripe_comp->comp         = comp;
+    return stripe_comp;
+}
+
+static ucs_status_t uct_tcp_ep_stripes_create(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_t *stripe_ep;
+    ucs_status_t status;
+    unsigned i;
+
+    ep->stripe.eps = ucs_calloc(iface->config.conn_per_ep - 1,
+                                sizeof(*ep->stripe.eps), "tcp_ep_stripes");
+    if (ep->stripe.eps == NULL) {
+        ucs_error("tcp_ep %p: failed to allocate stripe EPs array", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (i = 0; i < (iface->config.conn_per_ep - 1); ++i) {
+        status = uct_tcp_ep_init(iface, -1, (struct sockaddr*)ep->peer_addr,
+                                 &stripe_ep);
+        if (status != UCS_OK) {
+            goto err;
+        }
+
+        /* Stripe EP is destroyed together with the EP which owns it, so it
+         * must not be destroyed from the iface's EP list */
+        uct_tcp_iface_remove_ep(stripe_ep);
+        ucs_list_head_init(&stripe_ep->list);
+
+        stripe_ep->flags        |= UCT_TCP_EP_FLAG_STRIPE;
+        stripe_ep->stripe.parent = ep;
+        ep->stripe.eps[i]        = stripe_ep;
+        uct_tcp_ep_add_ctx_cap(stripe_ep, UCT_TCP_EP_FLAG_CTX_TYPE_TX);
+
+        status = uct_tcp_ep_create_socket_and_connect(stripe_ep);
+        if (status != UCS_OK) {
+            goto err;
+        }
+    }
+
+    ucs_debug("tcp_ep %p: created %u stripe connections", ep,
+              iface->config.conn_per_ep - 1);
+    return UCS_OK;
+
+err:
+    uct_tcp_ep_stripes_destroy(ep);
+    return status;
+}
+
+/* Fill `slice` by IOVs which describe `length` bytes of `iov` starting from
+ * the current position of `iov_iter`, and advance the iterator */
+static size_t uct_tcp_ep_iov_slice(const uct_iov_t *iov, size_t iovcnt,
+                                   ucs_iov_iter_t *iov_iter, size_t length,
+                                   uct_iov_t *slice)
+{
+    size_t slice_cnt = 0;
+    size_t slice_length;
+
+    while ((length > 0) && (iov_iter->iov_index < iovcnt)) {
+        slice_length = ucs_min(iov[iov_iter->iov_index].length -
+                               iov_iter->buffer_offset, length);
+
+        slice[slice_cnt]        = iov[iov_iter->iov_index];
+        slice[slice_cnt].buffer =
+                UCS_PTR_BYTE_OFFSET(iov[iov_iter->iov_index].buffer,
+                                    iov_iter->buffer_offset);
+        slice[slice_cnt].length = slice_length;
+        ++slice_cnt;
+
+        length                  -= slice_length;
+        iov_iter->buffer_offset += slice_length;
+        if (iov_iter->buffer_offset == iov[iov_iter->iov_index].length) {
+            iov_iter->buffer_offset = 0;
+            ++iov_iter->iov_index;
+        }
+    }
+
+    return slice_cnt;
+}
+
+static ucs_status_t
+uct_tcp_ep_put_zcopy_striped(uct_tcp_ep_t *ep, const uct_iov_t *iov,
+                             size_t iovcnt, size_t length,
+                             uint64_t remote_addr, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface                      = ucs_derived_of(
+                                                    ep->super.super.iface,
+                                                    uct_tcp_iface_t);
+    uct_tcp_ep_stripe_completion_t *stripe_comp = NULL;
+    uct_completion_t *part_comp                 = NULL;
+    size_t offset                               = 0;
+    uct_tcp_ep_t *stripe_eps[UCT_TCP_EP_MAX_CONN_PER_EP];
+    size_t part_length, slice_cnt, i;
+    ucs_iov_iter_t iov_iter;
+    ucs_status_t status;
+    uct_iov_t *slice;
+    unsigned count;
+
+    for (i = 0; i < iovcnt; ++i) {
+        if (iov[i].count != 1) {
+            return uct_tcp_ep_put_zcopy_single(ep, iov, iovcnt, remote_addr,
+                                               comp);
+        }
+    }
+
+    if (ucs_unlikely(ep->stripe.eps == NULL)) {
+        if ((uct_tcp_ep_check_tx_res(ep) != UCS_OK) ||
+            (uct_tcp_ep_stripes_create(ep) != UCS_OK)) {
+            return uct_tcp_ep_put_zcopy_single(ep, iov, iovcnt, remote_addr,
+                                               comp);
+        }
+    }
+
+    /* Use the main connection and the stripes which are ready to send */
+    stripe_eps[0] = ep;
+    count         = 1;
+    for (i = 0; i < (iface->config.conn_per_ep - 1); ++i) {
+        if (uct_tcp_ep_check_tx_res(ep->stripe.eps[i]) == UCS_OK) {
+            stripe_eps[count++] = ep->stripe.eps[i];
+        }
+    }
+
+    if ((count == 1) || (uct_tcp_ep_check_tx_res(ep) != UCS_OK)) {
+        return uct_tcp_ep_put_zcopy_single(ep, iov, iovcnt, remote_addr, comp);
+    }
+
+    if (comp != NULL) {
+        stripe_comp = uct_tcp_ep_stripe_comp_get(ep, comp, count);
+        if (ucs_unlikely(stripe_comp == NULL)) {
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        part_comp = &stripe_comp->super;
+    }
+
+    slice = ucs_alloca(iovcnt * sizeof(*slice));
+    ucs_iov_iter_init(&iov_iter);
+    for (i = 0; i < count; ++i) {
+        part_length = ucs_min(ucs_div_round_up(length, count), length - offset);
+        slice_cnt   = uct_tcp_ep_iov_slice(iov, iovcnt, &iov_iter, part_length,
+                                           slice);
+        status      = uct_tcp_ep_put_zcopy_single(stripe_eps[i], slice,
+                                                  slice_cnt,
+                                                  remote_addr + offset,
+                                                  part_comp);
+        if (ucs_unlikely(UCS_STATUS_IS_ERR(status))) {
+            if (i == 0) {
+                /* Nothing was sent yet, fail the whole operation */
+                if (stripe_comp != NULL) {
+                    ucs_mpool_put_inline(stripe_comp);
+                }
+                return status;
+            }
+
+            ucs_debug("tcp_ep %p: failed to send part %zu of PUT Zcopy on "
+                      "tcp_ep %p: %s", ep, i, stripe_eps[i],
+                      ucs_status_string(status));
+            if (part_comp != NULL) {
+                uct_invoke_completion(part_comp, status);
+            }
+        }
+
+        offset += part_length;
+    }
+
+    ucs_assert(offset == length);
+    return UCS_INPROGRESS;
+}
+
+ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    size_t length          = uct_iov_total_length(iov, iovcnt);
+
+    UCT_CHECK_LENGTH(sizeof(uct_tcp_ep_put_req_hdr_t) + length, 0,
+                     UCT_TCP_EP_PUT_ZCOPY_MAX - sizeof(uct_tcp_am_hdr_t),
+                     "put_zcopy");
+
+    if ((iface->config.conn_per_ep > 1) &&
+        (length >= iface->config.stripe_thresh)) {
+        return uct_tcp_ep_put_zcopy_striped(ep, iov, iovcnt, length,
+                                            remote_addr, comp);
+    }
+
+    return uct_tcp_ep_put_zcopy_single(ep, iov, iovcnt, remote_addr, comp);
+}
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags)
 {
@@ -2187,25 +2755,18 @@ void uct_tcp_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
                             uct_tcp_ep_pending_purge_cb, &purge_arg);
 }
 
-ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
-                              uct_completion_t *comp)
+static ucs_status_t
+uct_tcp_ep_flush_self(uct_tcp_ep_t *ep, uct_completion_t *comp)
 {
-    uct_tcp_ep_t *ep = ucs_derived_of(tl_ep, uct_tcp_ep_t);
     ucs_status_t status;
 
-    if (ucs_unlikely(flags & UCT_FLUSH_FLAG_CANCEL)) {
-        uct_tcp_ep_purge(ep, UCS_ERR_CANCELED);
-        return UCS_OK;
-    }
-
     status = uct_tcp_ep_check_tx_res(ep);
     if (ucs_unlikely(status != UCS_OK)) {
         return status;
     }
 
     if (ep->flags & UCT_TCP_EP_FLAG_NEED_FLUSH) {
-        status = uct_tcp_ep_put_zcopy(&ep->super.super, NULL, 0, 0, 0,
-                                      NULL);
+        status = uct_tcp_ep_put_zcopy_single(ep, NULL, 0, 0, NULL);
         ucs_assert(status != UCS_ERR_NO_RESOURCE);
         if (ucs_unlikely(UCS_STATUS_IS_ERR(status))) {
             return status;
@@ -2225,10 +2786,133 @@ ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
         return UCS_INPROGRESS;
     }
 
+    if (ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY) {
+        status = uct_tcp_ep_zcopy_comp_add(ep, comp);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+        return UCS_INPROGRESS;
+    }
+
     UCT_TL_EP_STAT_FLUSH(&ep->super);
     return UCS_OK;
 }
 
+static ucs_status_t
+uct_tcp_ep_stripe_flush(uct_tcp_ep_t *stripe_ep, uct_completion_t *comp)
+{
+    ucs_status_t status;
+
+    /* Stripe EP sends only PUT Zcopy operations, which are completed upon
+     * receiving PUT ACK, so a partially sent operation doesn't prevent from
+     * adding the flush completion */
+    if (stripe_ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) {
+        status = uct_tcp_ep_put_comp_add(stripe_ep, comp,
+                                         stripe_ep->tx.put_sn);
+    } else if (stripe_ep->flags & UCT_TCP_EP_FLAG_ZCOPY_WAIT_NOTIFY) {
+        status = uct_tcp_ep_zcopy_comp_add(stripe_ep, comp);
+    } else {
+        return UCS_OK;
+    }
+
+    return (status == UCS_OK) ? UCS_INPROGRESS : status;
+}
+
+/* Release the count held by a connection of a striped flush unless the flush
+ * of the connection is in progress */
+static UCS_F_ALWAYS_INLINE unsigned
+uct_tcp_ep_flush_striped_check(uct_completion_t *flush_comp,
+                               ucs_status_t status)
+{
+    if (status == UCS_INPROGRESS) {
+        return 1;
+    }
+
+    if (flush_comp != NULL) {
+        uct_invoke_completion(flush_comp, status);
+    }
+
+    return 0;
+}
+
+static ucs_status_t
+uct_tcp_ep_flush_striped(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface                      = ucs_derived_of(
+                                                    ep->super.super.iface,
+                                                    uct_tcp_iface_t);
+    uct_tcp_ep_stripe_completion_t *stripe_comp = NULL;
+    uct_completion_t *flush_comp                = NULL;
+    unsigned num_inprogress;
+    ucs_status_t status;
+    unsigned i;
+
+    if (comp != NULL) {
+        /* Every connection holds a count until it is flushed, and the extra
+         * count is held until all the connections are checked */
+        stripe_comp = uct_tcp_ep_stripe_comp_get(ep, comp,
+                                                 iface->config.conn_per_ep + 1);
+        if (ucs_unlikely(stripe_comp == NULL)) {
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        flush_comp = &stripe_comp->super;
+    }
+
+    status = uct_tcp_ep_flush_self(ep, flush_comp);
+    if (UCS_STATUS_IS_ERR(status)) {
+        if (stripe_comp != NULL) {
+            ucs_mpool_put_inline(stripe_comp);
+        }
+        return status;
+    }
+
+    num_inprogress = uct_tcp_ep_flush_striped_check(flush_comp, status);
+    for (i = 0; i < (iface->config.conn_per_ep - 1); ++i) {
+        status          = uct_tcp_ep_stripe_flush(ep->stripe.eps[i],
+                                                  flush_comp);
+        num_inprogress += uct_tcp_ep_flush_striped_check(flush_comp, status);
+    }
+
+    if (num_inprogress > 0) {
+        uct_tcp_ep_flush_striped_check(flush_comp, UCS_OK);
+        return UCS_INPROGRESS;
+    }
+
+    if (stripe_comp == NULL) {
+        return UCS_OK;
+    }
+
+    status = stripe_comp->super.status;
+    ucs_mpool_put_inline(stripe_comp);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
+                              uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_tcp_iface_t);
+    unsigned i;
+
+    if (ucs_unlikely(flags & UCT_FLUSH_FLAG_CANCEL)) {
+        uct_tcp_ep_purge(ep, UCS_ERR_CANCELED);
+        for (i = 0; (ep->stripe.eps != NULL) &&
+                    (i < (iface->config.conn_per_ep - 1)); ++i) {
+            uct_tcp_ep_purge(ep->stripe.eps[i], UCS_ERR_CANCELED);
+        }
+        return UCS_OK;
+    }
+
+    if (ucs_likely(ep->stripe.eps == NULL)) {
+        return uct_tcp_ep_flush_self(ep, comp);
+    }
+
+    return uct_tcp_ep_flush_striped(ep, comp);
+}
+
 ucs_status_t
 uct_tcp_ep_check(uct_ep_h tl_ep, unsigned flags, uct_completion_t *comp)
 {
@@ -45,6 +45,31 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Threshold for switching from send() to sendmsg() for short active messages",
    ucs_offsetof(uct_tcp_iface_config_t, sendv_thresh), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"ZCOPY_THRESH", "inf",
+   "Minimal size of user's payload of AM/PUT Zcopy operation from which\n"
+   "MSG_ZEROCOPY send is used, so the kernel does not copy the payload to\n"
+   "the socket buffer. The operation is completed only after the kernel\n"
+   "releases the user's buffer. \"inf\" disables MSG_ZEROCOPY send.",
+   ucs_offsetof(uct_tcp_iface_config_t, zcopy_thresh), UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"CONN_PER_EP", "1",
+   "Number of TCP connections used by an endpoint. Large PUT Zcopy operations\n"
+   "are split between all connections of the endpoint to utilize several\n"
+   "congestion windows and CPU cores, while other operations use the main\n"
+   "connection only.",
+   ucs_offsetof(uct_tcp_iface_config_t, conn_per_ep), UCS_CONFIG_TYPE_UINT},
+
+  {"STRIPE_THRESH", "64kb",
+   "Minimal size of PUT Zcopy payload which is split between the connections\n"
+   "of the endpoint, when CONN_PER_EP is greater than 1.",
+   ucs_offsetof(uct_tcp_iface_config_t, stripe_thresh), UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"IO_URING", "n",
+   "Use io_uring to receive the data from all endpoints which are ready for\n"
+   "reading by a single system call per progress iteration. If set to \"try\",\n"
+   "fall back to epoll-based progress when io_uring is not supported.",
+   ucs_offsetof(uct_tcp_iface_config_t, io_uring), UCS_CONFIG_TYPE_TERNARY},
+
   {"PREFER_DEFAULT", "y",
    "Give higher priority to the default network interface on the host",
    ucs_offsetof(uct_tcp_iface_config_t, prefer_default), UCS_CONFIG_TYPE_BOOL},
@@ -272,6 +297,33 @@ out:
     return sysfs_path;
 }
 
+static ucs_status_t
+uct_tcp_iface_get_link_caps(uct_tcp_iface_t *iface, double *latency_p,
+                            double *bandwidth_p)
+{
+    double pci_bw, network_bw;
+    char *path_buffer;
+    const char *sysfs_path;
+    ucs_status_t status;
+
+    status = uct_tcp_netif_caps(iface->if_name, latency_p, &network_bw);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucs_string_alloc_path_buffer(&path_buffer, "path_buffer");
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    sysfs_path   = uct_tcp_iface_get_sysfs_path(iface->if_name, path_buffer);
+    pci_bw       = ucs_topo_get_pci_bw(iface->if_name, sysfs_path);
+    *bandwidth_p = ucs_min(pci_bw, network_bw);
+
+    ucs_free(path_buffer);
+    return UCS_OK;
+}
+
 static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
                                         uct_iface_attr_t *attr)
 {
@@ -280,28 +332,17 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
                              sizeof(uct_tcp_am_hdr_t);
     ucs_status_t status;
     int is_default;
-    double pci_bw, network_bw, calculated_bw;
-    char *path_buffer;
-    const char *sysfs_path;
+    double link_bw;
 
     uct_base_iface_query(&iface->super, attr);
 
-    status = uct_tcp_netif_caps(iface->if_name, &attr->latency.c, &network_bw);
+    status = uct_tcp_iface_get_link_caps(iface, &attr->latency.c, &link_bw);
     if (status != UCS_OK) {
-        goto out;
-    }
-
-    status = ucs_string_alloc_path_buffer(&path_buffer, "path_buffer");
-    if (status != UCS_OK) {
-        goto out;
+        return status;
     }
 
-    sysfs_path             = uct_tcp_iface_get_sysfs_path(iface->if_name, path_buffer);
-    pci_bw                 = ucs_topo_get_pci_bw(iface->if_name, sysfs_path);
-    calculated_bw          = ucs_min(pci_bw, network_bw);
-
     /* Bandwidth is bounded by TCP stack computation time */
-    attr->bandwidth.shared = ucs_min(calculated_bw, iface->config.max_bw);
+    attr->bandwidth.shared = ucs_min(link_bw, iface->config.max_bw);
 
     attr->ep_addr_len      = sizeof(uct_tcp_ep_addr_t);
     attr->iface_addr_len   = sizeof(uct_tcp_iface_addr_t);
@@ -354,7 +395,7 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
     if (iface->config.prefer_default) {
         status = uct_tcp_netif_is_default(iface->if_name, &is_default);
         if (status != UCS_OK) {
-            goto out_free_path_buffer;
+            return status;
         }
 
         attr->priority    = is_default ? 0 : 1;
@@ -362,10 +403,45 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
         attr->priority    = 0;
     }
 
-out_free_path_buffer:
-    ucs_free(path_buffer);
-out:
-    return status;
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_tcp_iface_estimate_perf(uct_iface_h tl_iface, uct_perf_attr_t *perf_attr)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
+    double latency, link_bw, bw;
+    ucs_status_t status;
+
+    status = uct_base_iface_estimate_perf(tl_iface, perf_attr);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if ((iface->config.conn_per_ep == 1) ||
+        !uct_perf_attr_has_bandwidth(perf_attr->field_mask) ||
+        !(perf_attr->field_mask & UCT_PERF_ATTR_FIELD_OPERATION) ||
+        (perf_attr->operation != UCT_EP_OP_PUT_ZCOPY)) {
+        return UCS_OK;
+    }
+
+    /* Large PUT Zcopy is striped across all connections of an EP, so TCP
+     * stack computation time bounds the bandwidth of every connection */
+    status = uct_tcp_iface_get_link_caps(iface, &latency, &link_bw);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    bw = ucs_min(link_bw, iface->config.max_bw * iface->config.conn_per_ep);
+    if (perf_attr->field_mask & UCT_PERF_ATTR_FIELD_BANDWIDTH) {
+        perf_attr->bandwidth.shared = bw;
+    }
+
+    if (perf_attr->field_mask & UCT_PERF_ATTR_FIELD_PATH_BANDWIDTH) {
+        perf_attr->path_bandwidth.shared = bw;
+    }
+
+    return UCS_OK;
 }
 
 static ucs_status_t uct_tcp_iface_event_fd_get(uct_iface_h tl_iface, int *fd_p)
@@ -381,17 +457,104 @@ static void uct_tcp_iface_handle_events(void *callback_data,
 {
     unsigned *count  = (unsigned*)arg;
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)callback_data;
+    uct_tcp_iface_t *iface;
 
     ucs_assertv(ep->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED, "ep=%p", ep);
 
+    if (events & UCS_EVENT_SET_EVERR) {
+        *count += uct_tcp_ep_progress_zcopy_notify(ep);
+    }
     if (events & UCS_EVENT_SET_EVREAD) {
-        *count += uct_tcp_ep_cm_state[ep->conn_state].rx_progress(ep);
+        iface = ucs_derived_of(ep->super.super.iface, uct_tcp_iface_t);
+        if (iface->io_uring.ops != NULL) {
+            /* Data is received after all events are handled */
+            iface->io_uring.ops[iface->io_uring.count++].ep = ep;
+        } else {
+            *count += uct_tcp_ep_cm_state[ep->conn_state].rx_progress(ep);
+        }
     }
     if (events & UCS_EVENT_SET_EVWRITE) {
         *count += uct_tcp_ep_cm_state[ep->conn_state].tx_progress(ep);
     }
 }
 
+static void uct_tcp_iface_io_uring_cleanup(uct_tcp_iface_t *iface)
+{
+    if (iface->io_uring.ops == NULL) {
+        return;
+    }
+
+    ucs_free(iface->io_uring.ops);
+    ucs_io_uring_cleanup(&iface->io_uring.ring);
+    iface->io_uring.ops = NULL;
+}
+
+static void
+uct_tcp_iface_io_uring_recv_cb(void *arg, uint64_t user_data, int res)
+{
+    unsigned *count                 = (unsigned*)arg;
+    uct_tcp_iface_io_uring_op_t *op = (uct_tcp_iface_io_uring_op_t*)user_data;
+
+    if (ucs_unlikely(res == -ECANCELED)) {
+        /* The operation was not submitted, receive the data without
+         * io_uring */
+        op->buf = NULL;
+    } else if (op->ep != NULL) {
+        *count += uct_tcp_ep_io_uring_recv_done(op->ep, op->buf, res);
+    }
+}
+
+static unsigned uct_tcp_iface_io_uring_progress(uct_tcp_iface_t *iface)
+{
+    ucs_status_t status = UCS_OK;
+    unsigned count      = 0;
+    unsigned prepared   = 0;
+    uct_tcp_iface_io_uring_op_t *op;
+    uct_tcp_ep_t *ep;
+    unsigned i;
+
+    /* Post receive operations for all EPs which are ready for reading. Nothing
+     * else is invoked until they are completed, so the EPs and their RX
+     * buffers remain valid */
+    for (i = 0; i < iface->io_uring.count; ++i) {
+        op = &iface->io_uring.ops[i];
+        if (uct_tcp_ep_io_uring_prep_recv(op->ep, &iface->io_uring.ring,
+                                          (uintptr_t)op) == UCS_OK) {
+            op->buf = op->ep->rx.buf;
+            ++prepared;
+        } else {
+            op->buf = NULL;
+        }
+    }
+
+    if (prepared > 0) {
+        /* Operations which were not submitted are reported as canceled and
+         * progressed below */
+        status = ucs_io_uring_submit(&iface->io_uring.ring,
+                                     uct_tcp_iface_io_uring_recv_cb, &count);
+    }
+
+    /* Progress EPs which are not able to receive the data by io_uring, they
+     * could be destroyed while handling received messages of other EPs */
+    for (i = 0; i < iface->io_uring.count; ++i) {
+        op = &iface->io_uring.ops[i];
+        ep = op->ep;
+        if ((ep != NULL) && (op->buf == NULL)) {
+            count += uct_tcp_ep_cm_state[ep->conn_state].rx_progress(ep);
+        }
+    }
+
+    iface->io_uring.count = 0;
+
+    if (ucs_unlikely(status == UCS_ERR_IO_ERROR)) {
+        ucs_diag("tcp_iface %p: io_uring failed, using epoll based progress",
+                 iface);
+        uct_tcp_iface_io_uring_cleanup(iface);
+    }
+
+    return count;
+}
+
 unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
@@ -405,6 +568,10 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
         status = ucs_event_set_wait(iface->event_set, &read_events,
                                     0, uct_tcp_iface_handle_events,
                                     (void *)&count);
+        if (iface->io_uring.count > 0) {
+            count += uct_tcp_iface_io_uring_progress(iface);
+        }
+
         max_events -= read_events;
         ucs_trace_poll("iface=%p ucs_event_set_wait() returned %d: "
                        "read events=%u, total=%u",
@@ -632,7 +799,7 @@ static ucs_mpool_ops_t uct_tcp_mpool_ops = {
 };
 
 static uct_iface_internal_ops_t uct_tcp_iface_internal_ops = {
-    .iface_estimate_perf   = uct_base_iface_estimate_perf,
+    .iface_estimate_perf   = uct_tcp_iface_estimate_perf,
     .iface_vfs_refresh     = (uct_iface_vfs_refresh_func_t)ucs_empty_function,
     .ep_query              = (uct_ep_query_func_t)ucs_empty_function_return_unsupported,
     .ep_invalidate         = (uct_ep_invalidate_func_t)ucs_empty_function_return_unsupported,
@@ -641,6 +808,45 @@ static uct_iface_internal_ops_t uct_tcp_iface_internal_ops = {
     .ep_is_connected       = uct_tcp_ep_is_connected
 };
 
+static ucs_status_t
+uct_tcp_iface_io_uring_init(uct_tcp_iface_t *iface, int io_uring_mode)
+{
+    unsigned max_count = ucs_min(ucs_sys_event_set_max_wait_events,
+                                 iface->config.max_poll);
+    ucs_status_t status;
+
+    iface->io_uring.ops   = NULL;
+    iface->io_uring.count = 0;
+
+    if ((io_uring_mode == UCS_NO) || (max_count == 0)) {
+        return UCS_OK;
+    }
+
+    status = ucs_io_uring_init(&iface->io_uring.ring, max_count);
+    if (status != UCS_OK) {
+        if (io_uring_mode == UCS_TRY) {
+            ucs_diag("tcp_iface %p: io_uring is not supported, using epoll "
+                     "based progress", iface);
+            return UCS_OK;
+        }
+
+        ucs_error("tcp_iface %p: failed to initialize io_uring: %s", iface,
+                  ucs_status_string(status));
+        return status;
+    }
+
+    iface->io_uring.ops = ucs_calloc(max_count, sizeof(*iface->io_uring.ops),
+                                     "tcp_io_uring_ops");
+    if (iface->io_uring.ops == NULL) {
+        ucs_error("tcp_iface %p: failed to allocate io_uring operations",
+                  iface);
+        ucs_io_uring_cleanup(&iface->io_uring.ring);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    return UCS_OK;
+}
+
 static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                            const uct_iface_params_t *params,
                            const uct_iface_config_t *tl_config)
@@ -705,6 +911,14 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         return UCS_ERR_INVALID_PARAM;
     }
 
+    if ((config->conn_per_ep == 0) ||
+        (config->conn_per_ep > UCT_TCP_EP_MAX_CONN_PER_EP)) {
+        ucs_error("unsupported value was specified (%u) for the number of "
+                  "connections per endpoint, expected 1..%u",
+                  config->conn_per_ep, UCT_TCP_EP_MAX_CONN_PER_EP);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
     if (config->max_conn_retries > UINT8_MAX) {
         ucs_error("unsupported value was specified (%u) for the maximal "
                   "connection retries, expected lower than %u",
@@ -714,10 +928,13 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
 
     self->config.zcopy.max_hdr     = self->config.tx_seg_size -
                                      self->config.zcopy.hdr_offset;
+    self->config.zcopy.msg_zcopy_thresh = config->zcopy_thresh;
     self->config.prefer_default    = config->prefer_default;
     self->config.put_enable        = config->put_enable;
     self->config.conn_nb           = config->conn_nb;
     self->config.max_poll          = config->max_poll;
+    self->config.conn_per_ep       = config->conn_per_ep;
+    self->config.stripe_thresh     = config->stripe_thresh;
     self->config.max_conn_retries  = config->max_conn_retries;
     self->config.syn_cnt           = config->syn_cnt;
     self->sockopt.nodelay          = config->sockopt_nodelay;
@@ -808,13 +1025,20 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         goto err_cleanup_rx_mpool;
     }
 
-    status = uct_tcp_iface_listener_init(self);
+    status = uct_tcp_iface_io_uring_init(self, config->io_uring);
     if (status != UCS_OK) {
         goto err_cleanup_event_set;
     }
 
+    status = uct_tcp_iface_listener_init(self);
+    if (status != UCS_OK) {
+        goto err_cleanup_io_uring;
+    }
+
     return UCS_OK;
 
+err_cleanup_io_uring:
+    uct_tcp_iface_io_uring_cleanup(self);
 err_cleanup_event_set:
     ucs_event_set_cleanup(self->event_set);
 err_cleanup_rx_mpool:
@@ -834,6 +1058,17 @@ static void uct_tcp_iface_ep_list_cleanup(uct_tcp_iface_t *iface)
     }
 }
 
+void uct_tcp_iface_io_uring_remove_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
+{
+    unsigned i;
+
+    for (i = 0; i < iface->io_uring.count; ++i) {
+        if (iface->io_uring.ops[i].ep == ep) {
+            iface->io_uring.ops[i].ep = NULL;
+        }
+    }
+}
+
 void uct_tcp_iface_add_ep(uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -890,6 +1125,7 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_iface_t)
     ucs_mpool_cleanup(&self->tx_mpool, 1);
 
     ucs_close_fd(&self->listen_fd);
+    uct_tcp_iface_io_uring_cleanup(self);
     ucs_event_set_cleanup(self->event_set);
 }
 
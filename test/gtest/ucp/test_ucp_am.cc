@@ -1030,6 +1030,248 @@ UCS_TEST_P(test_ucp_am_nbx_reply_always, short_slow_path)
 UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_reply_always)
 
 
+class test_ucp_am_nbx_coalesce : public test_ucp_am_nbx {
+public:
+    test_ucp_am_nbx_coalesce() : m_check_order(true)
+    {
+    }
+
+protected:
+    virtual ucp_ep_params_t get_ep_params()
+    {
+        ucp_ep_params_t ep_params = test_ucp_am_nbx::get_ep_params();
+        ep_params.field_mask     |= UCP_EP_PARAM_FIELD_FLAGS;
+        ep_params.flags          |= UCP_EP_PARAMS_FLAGS_AM_COALESCE;
+        return ep_params;
+    }
+
+    static ucs_status_t am_seq_cb(void *arg, const void *header,
+                                  size_t header_length, void *data,
+                                  size_t length,
+                                  const ucp_am_recv_param_t *param)
+    {
+        test_ucp_am_nbx_coalesce *self =
+                reinterpret_cast<test_ucp_am_nbx_coalesce*>(arg);
+        uint32_t seq;
+
+        EXPECT_EQ(sizeof(seq), header_length);
+        memcpy(&seq, header, sizeof(seq));
+        if (self->m_check_order) {
+            EXPECT_EQ(self->m_recv_counter, seq);
+        }
+        mem_buffer::pattern_check(data, length, seq);
+
+        EXPECT_TRUE(self->m_rx_seqs.insert(seq).second) << "seq " << seq;
+        ++self->m_recv_counter;
+        return UCS_OK;
+    }
+
+    void send_seq(size_t length, std::vector<void*> &reqs)
+    {
+        uint32_t seq = m_send_counter;
+        std::string &buf = *m_tx_bufs.emplace(m_tx_bufs.end(), length, '\0');
+        ucp_request_param_t param;
+
+        mem_buffer::pattern_fill(&buf[0], length, seq);
+        param.op_attr_mask = UCP_OP_ATTR_FIELD_FLAGS;
+        param.flags        = UCP_AM_SEND_FLAG_COPY_HEADER;
+        reqs.push_back(update_counter_and_send_am(&seq, sizeof(seq), &buf[0],
+                                                  length, TEST_AM_NBX_ID,
+                                                  &param));
+    }
+
+    void test_seq(const std::vector<size_t> &lengths, bool explicit_flush)
+    {
+        std::vector<void*> reqs;
+
+        set_am_data_handler(receiver(), TEST_AM_NBX_ID, am_seq_cb, this);
+        for (size_t length : lengths) {
+            send_seq(length, reqs);
+        }
+
+        if (explicit_flush) {
+            flush_ep(sender());
+        }
+
+        wait_receives();
+        requests_wait(reqs);
+        EXPECT_EQ(m_send_counter, m_recv_counter);
+        m_tx_bufs.clear();
+    }
+
+    /* Messages which are not coalesced are not ordered with respect to the
+     * batches, so the order is checked only if all messages are small */
+    bool                   m_check_order;
+    std::set<uint32_t>     m_rx_seqs;
+    std::list<std::string> m_tx_bufs;
+};
+
+UCS_TEST_P(test_ucp_am_nbx_coalesce, small_msgs)
+{
+    test_seq(std::vector<size_t>(1000, 16), false);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_coalesce, mixed_sizes, "RNDV_THRESH=inf")
+{
+    std::vector<size_t> lengths;
+
+    for (unsigned i = 0; i < 200; ++i) {
+        lengths.push_back((i % 10 == 9) ? 64 * UCS_KBYTE : (8 + i));
+    }
+
+    m_check_order = false;
+    test_seq(lengths, false);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_coalesce, explicit_flush, "AM_COALESCE_TIMEOUT=10s")
+{
+    test_seq(std::vector<size_t>(100, 32), true);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_coalesce, small_budget, "AM_COALESCE_MAX_SIZE=64")
+{
+    test_seq(std::vector<size_t>(100, 24), false);
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_coalesce)
+
+
+class test_ucp_am_nbx_batch_recv : public test_ucp_am_nbx {
+public:
+    test_ucp_am_nbx_batch_recv() : m_num_batches(0), m_max_batch_size(0)
+    {
+    }
+
+protected:
+    static void am_batch_cb(void *arg, const ucp_am_recv_msg_t *msgs,
+                            size_t count)
+    {
+        test_ucp_am_nbx_batch_recv *self =
+                reinterpret_cast<test_ucp_am_nbx_batch_recv*>(arg);
+
+        EXPECT_GT(count, 0ul);
+        self->m_rx_msgs.insert(self->m_rx_msgs.end(), msgs, msgs + count);
+        self->m_recv_counter  += count;
+        self->m_max_batch_size = std::max(self->m_max_batch_size, count);
+        ++self->m_num_batches;
+    }
+
+    void set_am_batch_handler(entity &e)
+    {
+        ucp_am_handler_param_t param;
+
+        param.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID |
+                           UCP_AM_HANDLER_PARAM_FIELD_BATCH_CB |
+                           UCP_AM_HANDLER_PARAM_FIELD_ARG;
+        param.id         = TEST_AM_NBX_ID;
+        param.batch_cb   = am_batch_cb;
+        param.arg        = this;
+        ASSERT_UCS_OK(ucp_worker_set_am_recv_handler(e.worker(), &param));
+    }
+
+    void check_msg(const ucp_am_recv_msg_t &msg, std::vector<void*> &data)
+    {
+        uint32_t seq;
+
+        /* The header persists as long as the data */
+        ASSERT_EQ(sizeof(seq), msg.header_length);
+        memcpy(&seq, msg.header, sizeof(seq));
+        EXPECT_EQ(m_tx_bufs[seq].size(), msg.length);
+
+        if (!(msg.param.recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV)) {
+            EXPECT_TRUE(msg.param.recv_attr & UCP_AM_RECV_ATTR_FLAG_DATA);
+            mem_buffer::pattern_check(msg.data, msg.length, seq);
+            data.push_back(msg.data);
+            return;
+        }
+
+        std::string rx_buf(msg.length, '\0');
+        ucp_request_param_t param;
+        param.op_attr_mask = 0;
+        ucs_status_ptr_t sptr = ucp_am_recv_data_nbx(receiver().worker(),
+                                                     msg.data, &rx_buf[0],
+                                                     rx_buf.size(), &param);
+        ASSERT_UCS_OK(request_wait(sptr));
+        mem_buffer::pattern_check(&rx_buf[0], rx_buf.size(), seq);
+    }
+
+    void test_batch_recv(const std::vector<size_t> &lengths)
+    {
+        std::vector<void*> reqs, data;
+
+        set_am_batch_handler(receiver());
+
+        /* Avoid moving the send buffers */
+        m_tx_bufs.reserve(lengths.size());
+        for (size_t length : lengths) {
+            uint32_t seq     = m_send_counter;
+            std::string &buf = *m_tx_bufs.emplace(m_tx_bufs.end(), length,
+                                                  '\0');
+            ucp_request_param_t param;
+
+            mem_buffer::pattern_fill(&buf[0], length, seq);
+            param.op_attr_mask = UCP_OP_ATTR_FIELD_FLAGS;
+            param.flags        = UCP_AM_SEND_FLAG_COPY_HEADER;
+            reqs.push_back(update_counter_and_send_am(&seq, sizeof(seq),
+                                                      &buf[0], length,
+                                                      TEST_AM_NBX_ID, &param));
+        }
+
+        wait_receives();
+        EXPECT_EQ(m_send_counter, m_rx_msgs.size());
+        EXPECT_LE(m_num_batches, m_rx_msgs.size());
+
+        for (const ucp_am_recv_msg_t &msg : m_rx_msgs) {
+            check_msg(msg, data);
+        }
+
+        ucp_am_data_release_batch(receiver().worker(), data.data(),
+                                  data.size());
+        requests_wait(reqs);
+    }
+
+    size_t                         m_num_batches;
+    size_t                         m_max_batch_size;
+    std::vector<ucp_am_recv_msg_t> m_rx_msgs;
+    std::vector<std::string>       m_tx_bufs;
+};
+
+UCS_TEST_P(test_ucp_am_nbx_batch_recv, small_msgs)
+{
+    test_batch_recv(std::vector<size_t>(500, 24));
+
+    /* The messages were sent before the receiver progressed, so some of them
+     * must have been delivered together */
+    EXPECT_GT(m_max_batch_size, 1ul);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_batch_recv, mixed_sizes)
+{
+    static const size_t sizes[] = {8, 4 * UCS_KBYTE, 100 * UCS_KBYTE,
+                                   UCS_MBYTE};
+    std::vector<size_t> lengths;
+
+    for (unsigned i = 0; i < 40; ++i) {
+        lengths.push_back(sizes[i % ucs_static_array_size(sizes)]);
+    }
+
+    test_batch_recv(lengths);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_batch_recv, mixed_sizes_eager, "RNDV_THRESH=inf")
+{
+    std::vector<size_t> lengths;
+
+    for (unsigned i = 0; i < 40; ++i) {
+        lengths.push_back((i % 4 == 3) ? 100 * UCS_KBYTE : (1 + i));
+    }
+
+    test_batch_recv(lengths);
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_batch_recv)
+
+
 class test_ucp_am_nbx_send_copy_header : public test_ucp_am_nbx {
 public:
     static void get_test_variants_reply(std::vector<ucp_test_variant> &variants)
@@ -1772,6 +2014,37 @@ UCS_TEST_P(test_ucp_am_nbx_rndv, rndv_put, "RNDV_SCHEME=put_zcopy")
     test_am_send_recv(64 * UCS_KBYTE);
 }
 
+UCS_TEST_P(test_ucp_am_nbx_rndv, rndv_async_reg, "RNDV_ASYNC_REG_THRESH=0")
+{
+    test_am_send_recv(64 * UCS_KBYTE);
+    test_am_send_recv(UCS_MBYTE);
+}
+
+UCS_TEST_P(test_ucp_am_nbx_rndv, rndv_async_reg_ep_close,
+           "RNDV_ASYNC_REG_THRESH=0")
+{
+    test_am_send_recv(64 * UCS_KBYTE); // warmup wireup
+
+    mem_buffer sbuf(64 * UCS_MBYTE, tx_memtype());
+    ucp::data_type_desc_t sdt_desc(m_dt, sbuf.ptr(), sbuf.size());
+
+    set_am_data_handler(receiver(), TEST_AM_NBX_ID, am_rx_check_cb, this);
+    ucs_status_ptr_t sptr = send_am(sdt_desc, get_send_flag());
+
+    /* Close the endpoint while the send buffer may still be registered */
+    void *close_req     = sender().disconnect_nb();
+    ucs_time_t deadline = ucs::get_deadline();
+    while (!is_request_completed(close_req) && (ucs_get_time() < deadline)) {
+        progress();
+    }
+
+    sender().close_ep_req_free(close_req);
+
+    /* The send request may complete with any status */
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    request_wait(sptr);
+}
+
 UCS_TEST_P(test_ucp_am_nbx_rndv, rndv_flag_zero_send, "RNDV_THRESH=inf")
 {
     test_am_send_recv(0, 0, UCP_AM_SEND_FLAG_RNDV);
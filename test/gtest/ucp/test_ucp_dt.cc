@@ -280,3 +280,270 @@ INSTANTIATE_TEST_SUITE_P(iov, test_ucp_dt_iter,
 
 INSTANTIATE_TEST_SUITE_P(generic, test_ucp_dt_iter,
                         testing::ValuesIn(test_ucp_dt_iter::enum_dt_generic_params()));
+
+class test_ucp_dt_strided : public ucs::test {
+protected:
+    struct layout {
+        size_t                            elem_size;
+        std::vector<ucp_dt_strided_dim_t> dims;
+        size_t                            count;
+    };
+
+    virtual void init() {
+        ucp_params_t ctx_params;
+        ctx_params.field_mask = UCP_PARAM_FIELD_FEATURES;
+        ctx_params.features   = UCP_FEATURE_TAG;
+        UCS_TEST_CREATE_HANDLE(ucp_context_h, m_ucph, ucp_cleanup, ucp_init,
+                               &ctx_params, NULL);
+    }
+
+    virtual void cleanup() {
+        m_ucph.reset();
+    }
+
+    static ucp_datatype_t create_dt(const layout &l) {
+        ucp_dt_strided_params_t params;
+        ucp_datatype_t datatype;
+
+        params.field_mask = UCP_DT_STRIDED_PARAM_FIELD_ELEM_SIZE |
+                            UCP_DT_STRIDED_PARAM_FIELD_DIMS;
+        params.elem_size  = l.elem_size;
+        params.num_dims   = l.dims.size();
+        params.dims       = &l.dims[0];
+        ucs_status_t status = ucp_dt_create_strided(&params, &datatype);
+        EXPECT_UCS_OK(status);
+        return datatype;
+    }
+
+    /* Offsets of all elements, in packing order */
+    static void elem_offsets(const layout &l, size_t dim, size_t base,
+                             std::vector<size_t> &offsets) {
+        if (dim == 0) {
+            offsets.push_back(base);
+            return;
+        }
+
+        for (size_t i = 0; i < l.dims[dim - 1].count; ++i) {
+            elem_offsets(l, dim - 1, base + (i * l.dims[dim - 1].stride),
+                         offsets);
+        }
+    }
+
+    static std::vector<size_t> elem_offsets(const layout &l) {
+        const ucp_dt_strided_dim_t &outer = l.dims.back();
+        std::vector<size_t> offsets;
+
+        for (size_t i = 0; i < l.count; ++i) {
+            elem_offsets(l, l.dims.size(), i * outer.count * outer.stride,
+                         offsets);
+        }
+        return offsets;
+    }
+
+    static std::vector<layout> layouts() {
+        std::vector<layout> result;
+        layout l;
+
+        /* Matrix column */
+        l.elem_size = 8;
+        l.dims      = {{100, 64}};
+        l.count     = 1;
+        result.push_back(l);
+
+        /* Several columns of odd-sized elements */
+        l.elem_size = 3;
+        l.dims      = {{17, 10}};
+        l.count     = 5;
+        result.push_back(l);
+
+        /* Face of a 3D array */
+        l.elem_size = 16;
+        l.dims      = {{10, 16 * 12}, {7, 16 * 12 * 11}};
+        l.count     = 2;
+        result.push_back(l);
+
+        /* Contiguous inner dimension, which is merged to the element */
+        l.elem_size = 4;
+        l.dims      = {{8, 4}, {5, 50}, {3, 300}};
+        l.count     = 3;
+        result.push_back(l);
+
+        /* Fully contiguous */
+        l.elem_size = 1;
+        l.dims      = {{1000, 1}};
+        l.count     = 4;
+        result.push_back(l);
+
+        return result;
+    }
+
+    void test_layout(const layout &l) {
+        ucp_datatype_t datatype         = create_dt(l);
+        const ucp_dt_strided_t *strided = ucp_dt_to_strided(datatype);
+        std::vector<size_t> offsets     = elem_offsets(l);
+        size_t span                     = ucp_dt_strided_span(strided,
+                                                              l.count);
+        size_t length                   = offsets.size() * l.elem_size;
+        std::string buffer(span, 0), expected_buffer(span, 0);
+        std::string packed(length, 0), expected_packed;
+
+        ucs::fill_random(buffer);
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            expected_packed.append(buffer, offsets[i], l.elem_size);
+            expected_buffer.replace(offsets[i], l.elem_size, buffer,
+                                    offsets[i], l.elem_size);
+        }
+
+        ASSERT_EQ(length, ucp_dt_strided_length(strided, l.count));
+        ASSERT_EQ(offsets.back() + l.elem_size, span);
+
+        /* Pack by random segments */
+        for (size_t offset = 0, seg_size; offset < length; offset += seg_size) {
+            seg_size = ucs_min((ucs::rand() % 100) + 1, length - offset);
+            ucp_dt_strided_pack(strided, l.count, &buffer[0], offset,
+                                &packed[offset], seg_size);
+        }
+        EXPECT_EQ(expected_packed, packed);
+
+        /* Unpack by random segments to a clean buffer */
+        std::string unpacked(span, 0);
+        for (size_t offset = 0, seg_size; offset < length; offset += seg_size) {
+            seg_size = ucs_min((ucs::rand() % 100) + 1, length - offset);
+            ucp_dt_strided_unpack(strided, l.count, &unpacked[0], offset,
+                                  &expected_packed[offset], seg_size);
+        }
+        EXPECT_EQ(expected_buffer, unpacked);
+
+        /* Convert to iov by random segments */
+        std::string gathered;
+        for (size_t offset = 0, seg_size; offset < length; offset += seg_size) {
+            uct_iov_t iov[UCP_MAX_IOV];
+            size_t max_iov = (ucs::rand() % UCP_MAX_IOV) + 1;
+            size_t iov_count;
+
+            iov_count = ucp_dt_strided_to_iov(strided, l.count, &buffer[0],
+                                              offset,
+                                              ucs_min(ucs::rand() % 200 + 1,
+                                                      length - offset),
+                                              UCT_MEM_HANDLE_NULL, iov,
+                                              max_iov, &seg_size);
+            ASSERT_LE(iov_count, max_iov);
+            ASSERT_GT(seg_size, 0);
+            for (size_t i = 0; i < iov_count; ++i) {
+                gathered.append((const char*)iov[i].buffer, iov[i].length);
+            }
+        }
+        EXPECT_EQ(expected_packed, gathered);
+
+        ucp_dt_destroy(datatype);
+    }
+
+    ucs::handle<ucp_context_h> m_ucph;
+};
+
+UCS_TEST_F(test_ucp_dt_strided, pack_unpack) {
+    std::vector<layout> ls = layouts();
+
+    for (size_t i = 0; i < ls.size(); ++i) {
+        UCS_TEST_MESSAGE << "elem_size " << ls[i].elem_size << " num_dims "
+                         << ls[i].dims.size() << " count " << ls[i].count;
+        test_layout(ls[i]);
+    }
+}
+
+UCS_TEST_F(test_ucp_dt_strided, iter) {
+    layout l                = layouts()[2];
+    ucp_datatype_t datatype = create_dt(l);
+    size_t num_elems        = elem_offsets(l).size();
+    std::string buffer(ucp_dt_strided_span(ucp_dt_to_strided(datatype),
+                                           l.count), 0);
+    ucp_datatype_attr_t attr;
+    ucp_datatype_iter_t dt_iter, next_iter;
+    ucp_request_param_t param;
+    uct_iov_t iov[UCP_MAX_IOV];
+    uint8_t sg_count;
+
+    attr.field_mask = UCP_DATATYPE_ATTR_FIELD_PACKED_SIZE |
+                      UCP_DATATYPE_ATTR_FIELD_COUNT;
+    attr.count      = l.count;
+    ASSERT_UCS_OK(ucp_dt_query(datatype, &attr));
+    EXPECT_EQ(num_elems * l.elem_size, attr.packed_size);
+
+    param.op_attr_mask = 0;
+    ASSERT_UCS_OK(ucp_datatype_iter_init(m_ucph, &buffer[0], l.count, datatype,
+                                         0, 1, &dt_iter, &sg_count, &param));
+    EXPECT_EQ(UCP_DATATYPE_STRIDED, dt_iter.dt_class);
+    EXPECT_EQ(num_elems * l.elem_size, dt_iter.length);
+    /* The elements are too small to be selected for zero-copy */
+    EXPECT_EQ(0u, sg_count);
+
+    ucp_md_map_t md_map = m_ucph->reg_md_map[UCS_MEMORY_TYPE_HOST] &
+                          m_ucph->cache_md_map[UCS_MEMORY_TYPE_HOST];
+    ASSERT_UCS_OK(ucp_datatype_iter_mem_reg(m_ucph, &dt_iter, md_map, 0,
+                                            UCP_DT_MASK_ZCOPY));
+
+    /* Every iov entry is an element */
+    size_t num_iov = 0;
+    while (!ucp_datatype_iter_is_end(&dt_iter)) {
+        size_t iov_count = ucp_datatype_iter_next_iov(&dt_iter, SIZE_MAX,
+                                                      UCP_NULL_RESOURCE,
+                                                      UCP_DT_MASK_ZCOPY,
+                                                      &next_iter, iov,
+                                                      UCP_MAX_IOV);
+        ASSERT_EQ(ucs_min(UCP_MAX_IOV, num_elems - num_iov), iov_count);
+        for (size_t i = 0; i < iov_count; ++i) {
+            EXPECT_EQ(l.elem_size, iov[i].length);
+        }
+
+        num_iov += iov_count;
+        ucp_datatype_iter_copy_position(&dt_iter, &next_iter,
+                                        UCP_DT_MASK_ZCOPY);
+    }
+    EXPECT_EQ(num_elems, num_iov);
+
+    ucp_datatype_iter_cleanup(&dt_iter, 1, UCP_DT_MASK_ZCOPY);
+    ucp_dt_destroy(datatype);
+}
+
+UCS_TEST_F(test_ucp_dt_strided, zcopy_iov_count) {
+    layout l;
+
+    l.dims  = {{10, 4096}, {3, 65536}};
+    l.count = 2;
+
+    l.elem_size = UCP_DT_STRIDED_ZCOPY_MIN_BLOCK - 1;
+    ucp_datatype_t datatype = create_dt(l);
+    EXPECT_EQ(0ul, ucp_dt_strided_zcopy_iov_count(ucp_dt_to_strided(datatype),
+                                                  l.count));
+    ucp_dt_destroy(datatype);
+
+    l.elem_size = UCP_DT_STRIDED_ZCOPY_MIN_BLOCK;
+    datatype    = create_dt(l);
+    EXPECT_EQ(10ul * 3 * 2,
+              ucp_dt_strided_zcopy_iov_count(ucp_dt_to_strided(datatype),
+                                             l.count));
+    ucp_dt_destroy(datatype);
+}
+
+UCS_TEST_F(test_ucp_dt_strided, invalid_params) {
+    ucp_dt_strided_dim_t dims[UCP_DT_STRIDED_MAX_DIMS + 1] = {};
+    ucp_dt_strided_params_t params;
+    ucp_datatype_t datatype;
+
+    params.field_mask = UCP_DT_STRIDED_PARAM_FIELD_ELEM_SIZE |
+                        UCP_DT_STRIDED_PARAM_FIELD_DIMS;
+    params.elem_size  = 8;
+    params.num_dims   = UCP_DT_STRIDED_MAX_DIMS + 1;
+    params.dims       = dims;
+
+    scoped_log_handler wrap_err(wrap_errors_logger);
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, ucp_dt_create_strided(&params, &datatype));
+
+    /* Zero count */
+    params.num_dims = 1;
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, ucp_dt_create_strided(&params, &datatype));
+
+    params.field_mask = UCP_DT_STRIDED_PARAM_FIELD_ELEM_SIZE;
+    dims[0].count     = 1;
+    EXPECT_EQ(UCS_ERR_INVALID_PARAM, ucp_dt_create_strided(&params, &datatype));
+}
@@ -10,6 +10,8 @@
 #include <common/mem_buffer.h>
 #include <unordered_map>
 #include <memory>
+#include <dirent.h>
+#include <unistd.h>
 
 extern "C" {
 #include <ucp/core/ucp_rkey.h>
@@ -212,6 +214,252 @@ UCP_INSTANTIATE_TEST_CASE(test_ucp_proto)
 UCP_INSTANTIATE_TEST_CASE_TLS_GPU_AWARE(test_ucp_proto, shm_ipc,
                                         "shm,cuda_ipc,rocm_ipc")
 
+class test_ucp_proto_tune : public test_ucp_proto {
+protected:
+    static const unsigned MIN_SAMPLES = 4;
+    static const ucp_tag_t TAG        = 0x1337;
+
+    virtual void init() {
+        modify_config("PROTO_TUNE", "y");
+        modify_config("PROTO_TUNE_SAMPLE_RATE", "1");
+        modify_config("PROTO_TUNE_MIN_SAMPLES",
+                      ucs::to_string(MIN_SAMPLES).c_str());
+        test_ucp_proto::init();
+    }
+
+    ucp_proto_select_elem_t *tag_send_select_elem() {
+        ucp_worker_cfg_index_t ep_cfg_index = sender().ep()->cfg_index;
+        ucp_proto_select_param_t select_param;
+        ucp_memory_info_t mem_info;
+
+        ucp_memory_info_set_host(&mem_info);
+        ucp_proto_select_param_init(&select_param, UCP_OP_ID_TAG_SEND, 0, 0,
+                                    UCP_DATATYPE_CONTIG, &mem_info, 1);
+        return ucp_proto_select_lookup_slow(
+                worker(),
+                &ucs_array_elem(&worker()->ep_config, ep_cfg_index)
+                         .proto_select,
+                0, ep_cfg_index, UCP_WORKER_CFG_INDEX_NULL, &select_param);
+    }
+
+    static ucp_proto_threshold_elem_t *
+    thresholds(ucp_proto_select_elem_t *select_elem) {
+        return const_cast<ucp_proto_threshold_elem_t*>(select_elem->thresholds);
+    }
+
+    static std::vector<size_t>
+    thresholds_snapshot(ucp_proto_select_elem_t *select_elem) {
+        std::vector<size_t> result;
+        ucp_proto_threshold_elem_t *elem = thresholds(select_elem);
+
+        do {
+            result.push_back(elem->max_msg_length);
+        } while ((elem++)->max_msg_length != SIZE_MAX);
+
+        return result;
+    }
+
+    void send_recv(size_t size) {
+        std::string sbuf(size, 'a' + (size % 26)), rbuf(size, 0);
+        ucp_request_param_t param;
+
+        param.op_attr_mask = 0;
+        void *rreq = ucp_tag_recv_nbx(receiver().worker(), &rbuf[0], size, TAG,
+                                      (ucp_tag_t)-1, &param);
+        void *sreq = ucp_tag_send_nbx(sender().ep(), sbuf.data(), size, TAG,
+                                      &param);
+        ASSERT_UCS_OK(request_wait(sreq));
+        ASSERT_UCS_OK(request_wait(rreq));
+        EXPECT_EQ(sbuf, rbuf);
+    }
+
+    void print_thresholds(ucp_proto_select_elem_t *select_elem) {
+        ucs_string_buffer_t strb = UCS_STRING_BUFFER_INITIALIZER;
+        char *line;
+
+        ucp_proto_select_elem_info(worker(), sender().ep()->cfg_index,
+                                   UCP_WORKER_CFG_INDEX_NULL,
+                                   &thresholds(select_elem)->proto_config
+                                            .select_param,
+                                   select_elem, 1, &strb);
+        ucs_string_buffer_for_each_token(line, &strb, "\n") {
+            UCS_TEST_MESSAGE << line;
+        }
+        ucs_string_buffer_cleanup(&strb);
+    }
+};
+
+UCS_TEST_P(test_ucp_proto_tune, random_sizes)
+{
+    ucp_proto_select_elem_t *select_elem = tag_send_select_elem();
+    ASSERT_NE(nullptr, select_elem);
+
+    std::vector<size_t> initial = thresholds_snapshot(select_elem);
+    for (unsigned i = 0; i < 1000 / ucs::test_time_multiplier(); ++i) {
+        send_recv(ucs::rand() % (1 << (ucs::rand() % 20)));
+    }
+
+    /* Thresholds remain ordered, and only tunable boundaries may move */
+    ucp_proto_threshold_elem_t *elem = thresholds(select_elem);
+    size_t prev_max                  = 0;
+    for (size_t i = 0; i < initial.size(); ++i, ++elem) {
+        if (i > 0) {
+            EXPECT_GT(elem->max_msg_length, prev_max);
+        }
+        if (!(elem->tune.flags & UCP_PROTO_TUNE_FLAG_NEXT)) {
+            EXPECT_EQ(initial[i], elem->max_msg_length) << "i=" << i;
+        }
+        prev_max = elem->max_msg_length;
+    }
+    EXPECT_EQ(SIZE_MAX, prev_max);
+
+    print_thresholds(select_elem);
+}
+
+UCS_TEST_P(test_ucp_proto_tune, move_threshold)
+{
+    ucp_proto_select_elem_t *select_elem = tag_send_select_elem();
+    ASSERT_NE(nullptr, select_elem);
+
+    ucp_proto_threshold_elem_t *elem = thresholds(select_elem);
+    while (!(elem->tune.flags & UCP_PROTO_TUNE_FLAG_NEXT)) {
+        if (elem->max_msg_length == SIZE_MAX) {
+            UCS_TEST_SKIP_R("no tunable protocol threshold");
+        }
+        ++elem;
+    }
+
+    /* Pretend the current protocol was measured much slower than estimated,
+     * and let the next message complete the samples of the next protocol */
+    size_t thresh          = elem->max_msg_length;
+    elem[0].tune.count     = MIN_SAMPLES;
+    elem[0].tune.ratio_sum = MIN_SAMPLES * 1e9;
+    elem[1].tune.count     = MIN_SAMPLES - 1;
+    elem[1].tune.ratio_sum = MIN_SAMPLES - 1;
+    send_recv(thresh + 1);
+
+    EXPECT_LT(elem->max_msg_length, thresh);
+    EXPECT_TRUE(elem[0].tune.flags & UCP_PROTO_TUNE_FLAG_TUNED);
+    EXPECT_TRUE(elem[1].tune.flags & UCP_PROTO_TUNE_FLAG_TUNED);
+    EXPECT_EQ(0u, elem[0].tune.count);
+    EXPECT_EQ(0u, elem[1].tune.count);
+
+    ucp_proto_query_attr_t proto_attr;
+    ucp_proto_select_elem_query(worker(), select_elem, elem->max_msg_length,
+                                &proto_attr);
+    EXPECT_TRUE(proto_attr.is_tuned);
+    EXPECT_LE(proto_attr.max_msg_length, elem->max_msg_length);
+
+    /* New messages use the new threshold */
+    send_recv(thresh);
+    print_thresholds(select_elem);
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_proto_tune)
+
+class test_ucp_proto_cache : public test_ucp_proto_tune {
+protected:
+    virtual void init() {
+        char dir[] = "/tmp/ucp_proto_cache_XXXXXX";
+
+        ASSERT_NE(nullptr, mkdtemp(dir));
+        m_cache_dir = dir;
+        modify_config("PROTO_CACHE_DIR", m_cache_dir.c_str());
+        test_ucp_proto_tune::init();
+    }
+
+    virtual void cleanup() {
+        /* Workers save the cache when destroyed */
+        test_ucp_proto_tune::cleanup();
+        for (const std::string &file : cache_files()) {
+            unlink(file.c_str());
+        }
+        rmdir(m_cache_dir.c_str());
+    }
+
+    std::vector<std::string> cache_files() const {
+        std::vector<std::string> result;
+        struct dirent *entry;
+
+        DIR *dir = opendir(m_cache_dir.c_str());
+        if (dir == NULL) {
+            return result;
+        }
+
+        while ((entry = readdir(dir)) != NULL) {
+            if (entry->d_name[0] != '.') {
+                result.push_back(m_cache_dir + "/" + entry->d_name);
+            }
+        }
+
+        closedir(dir);
+        return result;
+    }
+
+    /* Create a new sender, whose worker loads the cache */
+    void add_sender() {
+        entity *e = create_entity(true);
+        e->connect(&receiver(), get_ep_params());
+    }
+
+    std::string m_cache_dir;
+};
+
+UCS_TEST_P(test_ucp_proto_cache, save_load)
+{
+    ucp_proto_select_elem_t *select_elem = tag_send_select_elem();
+    ASSERT_NE(nullptr, select_elem);
+
+    /* Mark the thresholds as tuned, which a worker that selects the protocols
+     * again would not do */
+    std::vector<size_t> expected     = thresholds_snapshot(select_elem);
+    ucp_proto_threshold_elem_t *elem = thresholds(select_elem);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        elem[i].tune.flags |= UCP_PROTO_TUNE_FLAG_TUNED;
+    }
+    worker()->proto_cache.dirty = 1;
+
+    ucp_proto_cache_save(worker());
+    EXPECT_EQ(0, worker()->proto_cache.dirty);
+    EXPECT_EQ(1u, cache_files().size());
+
+    add_sender();
+    EXPECT_NE(0u, kh_size(&worker()->proto_cache.hash));
+
+    select_elem = tag_send_select_elem();
+    ASSERT_NE(nullptr, select_elem);
+    EXPECT_EQ(expected, thresholds_snapshot(select_elem));
+    elem = thresholds(select_elem);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_TRUE(elem[i].tune.flags & UCP_PROTO_TUNE_FLAG_TUNED)
+                << "i=" << i;
+    }
+
+    /* The cached protocols are initialized, so the selection is usable */
+    for (size_t max_msg_length : expected) {
+        send_recv(ucs_min(max_msg_length, 1 * UCS_MBYTE));
+    }
+    print_thresholds(select_elem);
+}
+
+UCS_TEST_P(test_ucp_proto_cache, config_change)
+{
+    ASSERT_NE(nullptr, tag_send_select_elem());
+    ucp_proto_cache_save(worker());
+    EXPECT_EQ(1u, cache_files().size());
+
+    uint32_t config_crc = worker()->proto_cache.config_crc;
+    {
+        ucs::scoped_setenv env("UCX_PROTO_CACHE_TEST_VAR", "1");
+        add_sender();
+    }
+
+    EXPECT_NE(config_crc, worker()->proto_cache.config_crc);
+    EXPECT_EQ(0u, kh_size(&worker()->proto_cache.hash));
+}
+
+UCP_INSTANTIATE_TEST_CASE(test_ucp_proto_cache)
+
 class test_perf_node : public test_ucp_proto {
 };
 
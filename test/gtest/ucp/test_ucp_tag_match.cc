@@ -32,6 +32,16 @@ public:
         }
     }
 
+    static uint64_t hist_count(const ucp_tag_match_t *tm, ucp_tag_hist_id_t id)
+    {
+        uint64_t count = 0;
+
+        for (unsigned bin = 0; bin < UCP_TAG_HIST_NUM_BINS; ++bin) {
+            count += tm->hist.h[id].bins[bin];
+        }
+        return count;
+    }
+
     virtual void init()
     {
         modify_config("TM_THRESH", "1");
@@ -564,6 +574,82 @@ UCS_TEST_P(test_ucp_tag_match, sync_send_unexp) {
     request_free(my_send_req);
 }
 
+UCS_TEST_P(test_ucp_tag_match, recv_unexp_source_index,
+           "TM_SOURCE_MASK=mpich", "RNDV_THRESH=inf")
+{
+    /* MPICH layout: 16-bit context id, 16-bit source, 32-bit tag */
+    const ucp_tag_t source_mask = 0x0000ffff00000000ul;
+    const ucp_tag_t tag_masks[] = {
+        UCP_TAG_MASK_FULL,  /* Specific source and tag */
+        ~0xfffffffful,      /* Any tag */
+        ~source_mask,       /* Any source */
+        ~(source_mask | 0xfffffffful) /* Any source and tag */
+    };
+    const unsigned num_sends    = 300 / ucs::test_time_multiplier();
+    std::vector<std::pair<ucp_tag_t, uint64_t> > unexp;
+    ucp_tag_recv_info_t info;
+    ucp_tag_t tag, tag_mask;
+    uint64_t recv_data;
+    ucs_status_t status;
+    size_t expected;
+
+    for (uint64_t i = 0; i < num_sends; ++i) {
+        tag = (1ul << 48) | ((ucs::rand() % 4ul) << 32) | (ucs::rand() % 3);
+        send_b(&i, sizeof(i), DATATYPE, tag);
+        unexp.push_back(std::make_pair(tag, i));
+    }
+
+    short_progress_loop(); /* Receive messages as unexpected */
+
+    while (!unexp.empty()) {
+        /* Take tag bits of a random pending message, so a match exists */
+        tag      = unexp[ucs::rand() % unexp.size()].first;
+        tag_mask = tag_masks[ucs::rand() % ucs_static_array_size(tag_masks)];
+
+        /* MPI ordering: the earliest matching message is received */
+        for (expected = 0;
+             ((unexp[expected].first ^ tag) & tag_mask) != 0; ++expected) {
+        }
+
+        status = recv_b(&recv_data, sizeof(recv_data), DATATYPE, tag, tag_mask,
+                        &info);
+        ASSERT_UCS_OK(status);
+        EXPECT_EQ(unexp[expected].first, info.sender_tag);
+        EXPECT_EQ(unexp[expected].second, recv_data);
+        unexp.erase(unexp.begin() + expected);
+    }
+}
+
+UCS_TEST_P(test_ucp_tag_match, histograms, "TM_HISTOGRAM=y",
+           "RNDV_THRESH=inf")
+{
+    const unsigned num_sends = 20;
+    const ucp_tag_match_t *tm = &receiver().worker()->tm;
+    ucp_tag_recv_info_t info;
+    uint64_t send_data, recv_data;
+    ucs_status_t status;
+
+    for (send_data = 0; send_data < num_sends; ++send_data) {
+        send_b(&send_data, sizeof(send_data), DATATYPE, 0x111337);
+    }
+
+    short_progress_loop(); /* Receive messages as unexpected */
+
+    for (unsigned i = 0; i < num_sends; ++i) {
+        status = recv_b(&recv_data, sizeof(recv_data), DATATYPE, 0x1337,
+                        0xffff, &info);
+        ASSERT_UCS_OK(status);
+        EXPECT_EQ(i, recv_data);
+    }
+
+    /* Every unexpected message was matched by a receive */
+    EXPECT_EQ(hist_count(tm, UCP_TAG_HIST_UNEXP_DEPTH),
+              hist_count(tm, UCP_TAG_HIST_UNEXP_MATCH_TIME));
+    EXPECT_GE(hist_count(tm, UCP_TAG_HIST_UNEXP_SEARCH_LEN),
+              hist_count(tm, UCP_TAG_HIST_UNEXP_MATCH_TIME));
+    EXPECT_EQ(0u, tm->hist.unexp_count);
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_tag_match)
 
 class test_ucp_tag_match_rndv : public test_ucp_tag_match {
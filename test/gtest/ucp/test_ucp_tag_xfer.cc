@@ -127,6 +127,8 @@ public:
     void test_xfer_contig(size_t size, bool expected, bool sync, bool truncated);
     void test_xfer_generic(size_t size, bool expected, bool sync, bool truncated);
     void test_xfer_iov(size_t size, bool expected, bool sync, bool truncated);
+    void test_xfer_strided(size_t size, bool expected, bool sync,
+                           bool truncated);
     void test_xfer_generic_err(size_t size, bool expected, bool sync, bool truncated);
 
 protected:
@@ -446,6 +448,52 @@ void test_ucp_tag_xfer::test_xfer_iov(size_t size, bool expected, bool sync,
                                "IOV"));
 }
 
+void test_ucp_tag_xfer::test_xfer_strided(size_t size, bool expected,
+                                          bool sync, bool truncated)
+{
+    /* Every item is 8 rows of a single 8-byte column, and the sender and the
+     * receiver use different row lengths */
+    static const size_t elem_size   = sizeof(uint64_t);
+    static const size_t num_rows    = 8;
+    static const size_t send_stride = 3 * elem_size;
+    static const size_t recv_stride = 2 * elem_size;
+    size_t count                    = ucs_div_round_up(size,
+                                                       num_rows * elem_size);
+    size_t num_elems                = count * num_rows;
+    std::vector<uint64_t> sendbuf(num_elems * send_stride / elem_size);
+    std::vector<uint64_t> recvbuf(num_elems * recv_stride / elem_size, 0);
+    ucp_dt_strided_params_t params;
+    ucp_dt_strided_dim_t dim;
+    ucp_datatype_t send_dt, recv_dt;
+
+    ucs::fill_random(sendbuf);
+
+    params.field_mask = UCP_DT_STRIDED_PARAM_FIELD_ELEM_SIZE |
+                        UCP_DT_STRIDED_PARAM_FIELD_DIMS;
+    params.elem_size  = elem_size;
+    params.num_dims   = 1;
+    params.dims       = &dim;
+
+    dim.count  = num_rows;
+    dim.stride = send_stride;
+    ASSERT_UCS_OK(ucp_dt_create_strided(&params, &send_dt));
+    dim.stride = recv_stride;
+    ASSERT_UCS_OK(ucp_dt_create_strided(&params, &recv_dt));
+
+    size_t recvd = do_xfer(sendbuf.data(), recvbuf.data(), count, send_dt,
+                           recv_dt, expected, sync, truncated);
+    if (!truncated) {
+        EXPECT_EQ(num_elems * elem_size, recvd);
+        for (size_t i = 0; i < num_elems; ++i) {
+            ASSERT_EQ(sendbuf[i * send_stride / elem_size],
+                      recvbuf[i * recv_stride / elem_size]) << "element " << i;
+        }
+    }
+
+    ucp_dt_destroy(recv_dt);
+    ucp_dt_destroy(send_dt);
+}
+
 void test_ucp_tag_xfer::test_xfer_generic_err(size_t size, bool expected,
                                               bool sync, bool truncated)
 {
@@ -644,6 +692,18 @@ UCS_TEST_P(test_ucp_tag_xfer, iov_unexp) {
     test_xfer(&test_ucp_tag_xfer::test_xfer_iov, false, false, false);
 }
 
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, false, false);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_exp_truncated) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, true, false, true);
+}
+
+UCS_TEST_P(test_ucp_tag_xfer, strided_unexp) {
+    test_xfer(&test_ucp_tag_xfer::test_xfer_strided, false, false, false);
+}
+
 UCS_TEST_P(test_ucp_tag_xfer, generic_err_exp, "PROTO_INDIRECT_ID=y") {
     test_xfer(&test_ucp_tag_xfer::test_xfer_generic_err, true, false, false);
 }
@@ -707,6 +767,11 @@ UCS_TEST_P(test_ucp_tag_xfer, send_contig_recv_contig_exp, "RNDV_THRESH=1248576"
     test_run_xfer(true, true, true, false, false);
 }
 
+UCS_TEST_P(test_ucp_tag_xfer, send_contig_recv_contig_exp_nt_copy,
+           "RNDV_THRESH=1248576", "SHM_NT_COPY_LOCAL_THRESH=0") {
+    test_run_xfer(true, true, true, false, false);
+}
+
 /* send_generic_recv_generic */
 
 UCS_TEST_P(test_ucp_tag_xfer, send_generic_recv_generic_exp, "RNDV_THRESH=1248576") {
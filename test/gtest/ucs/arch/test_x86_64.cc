@@ -189,6 +189,65 @@ UCS_TEST_F(test_arch, nt_buffer_transfer_nt_dst) {
     nt_buffer_transfer_test(UCS_ARCH_MEMCPY_NT_DEST);
 }
 
+UCS_TEST_F(test_arch, memcpy_nt_store) {
+    const size_t align     = 64;
+    const size_t max_len   = 4096;
+    const size_t hole_size = align;
+    std::vector<char> src(max_len + align);
+    std::vector<char> dst(max_len + align + (2 * hole_size));
+    std::vector<char> expected;
+    size_t len, i, j;
+
+    for (i = 0; i < src.size(); ++i) {
+        src[i] = (char)ucs::rand();
+    }
+
+    for (len = 0; len <= max_len; len += (len < 256) ? 1 : 61) {
+        for (i = 0; i < align; i += 3) {
+            for (j = 0; j < align; j += 5) {
+                std::fill(dst.begin(), dst.end(), 0);
+                expected = dst;
+                std::copy(src.begin() + j, src.begin() + j + len,
+                          expected.begin() + hole_size + i);
+
+                ucs_arch_memcpy_nt_store(&dst[hole_size + i], &src[j], len);
+                ASSERT_TRUE(dst == expected) << "len=" << len
+                                             << " dst_align=" << i
+                                             << " src_align=" << j;
+            }
+        }
+    }
+}
+
+UCS_TEST_F(test_arch, memcpy_shm) {
+    size_t local_thresh  = ucs_global_opts.shm_nt_copy_local_thresh;
+    size_t remote_thresh = ucs_global_opts.shm_nt_copy_remote_thresh;
+    std::vector<char> src(UCS_MBYTE), dst(UCS_MBYTE);
+    int remote_numa;
+
+    for (size_t i = 0; i < src.size(); ++i) {
+        src[i] = (char)i;
+    }
+
+    /* Use temporal copy for same NUMA node and non-temporal copy for another
+     * NUMA node */
+    ucs_global_opts.shm_nt_copy_local_thresh  = UCS_MEMUNITS_INF;
+    ucs_global_opts.shm_nt_copy_remote_thresh = 0;
+
+    for (remote_numa = 0; remote_numa <= 1; ++remote_numa) {
+        for (size_t len = 1; len <= src.size(); len *= 4) {
+            std::fill(dst.begin(), dst.end(), 0);
+            ucs_memcpy_shm(&dst[0], &src[0], len, len, remote_numa);
+            ASSERT_TRUE(std::equal(src.begin(), src.begin() + len,
+                                   dst.begin()))
+                    << "len=" << len << " remote_numa=" << remote_numa;
+        }
+    }
+
+    ucs_global_opts.shm_nt_copy_local_thresh  = local_thresh;
+    ucs_global_opts.shm_nt_copy_remote_thresh = remote_thresh;
+}
+
 UCS_TEST_F(test_arch, nt_buffer_transfer_nt_src_dst) {
     /* Make nt_dest_threshold zero to test the combination of hints */
     ucs_global_opts.arch.nt_dest_threshold = 0;
@@ -23,6 +23,7 @@ protected:
         COMMAND_ADD_ANOTHER,
         COMMAND_ADD_ANOTHER_ONESHOT,
         COMMAND_REMOVE_ANOTHER_ONESHOT,
+        COMMAND_IDLE,
         COMMAND_NONE
     };
 
@@ -83,6 +84,8 @@ protected:
         case COMMAND_ENQUEUE_USER_ID:
             m_user_id_queue.push_back(ctx->user_id);
             break;
+        case COMMAND_IDLE:
+            return 0;
         case COMMAND_NONE:
         default:
             break;
@@ -108,6 +111,14 @@ protected:
                                              reinterpret_cast<void*>(ctx));
     }
 
+    void add_prio(callback_ctx *ctx, ucs_callbackq_prio_t prio,
+                  unsigned flags = 0)
+    {
+        ctx->callback_id = ucs_callbackq_add_prio(&m_cbq, callback_proxy,
+                                                  reinterpret_cast<void*>(ctx),
+                                                  prio, flags);
+    }
+
     void *remove(int callback_id)
     {
         return ucs_callbackq_remove(&m_cbq, callback_id);
@@ -266,6 +277,94 @@ UCS_TEST_F(test_callbackq, add_another) {
     EXPECT_EQ(count + 1, ctx2.count);
 }
 
+UCS_TEST_F(test_callbackq, prio_order) {
+    static const ucs_callbackq_prio_t prios[] = {
+        UCS_CALLBACKQ_PRIO_LOW, UCS_CALLBACKQ_PRIO_NORMAL,
+        UCS_CALLBACKQ_PRIO_HIGH, UCS_CALLBACKQ_PRIO_NORMAL
+    };
+    callback_ctx ctx[ucs_static_array_size(prios)];
+
+    for (unsigned i = 0; i < ucs_static_array_size(prios); ++i) {
+        init_ctx(&ctx[i], nullptr, i);
+        ctx[i].command = COMMAND_ENQUEUE_USER_ID;
+        add_prio(&ctx[i], prios[i]);
+    }
+
+    dispatch();
+    EXPECT_EQ(std::vector<int>({2, 1, 3, 0}), m_user_id_queue);
+
+    /* Removing a callback keeps the order of the others */
+    remove(&ctx[1]);
+    m_user_id_queue.clear();
+    dispatch();
+    EXPECT_EQ(std::vector<int>({2, 3, 0}), m_user_id_queue);
+
+    for (unsigned i = 0; i < ucs_static_array_size(prios); ++i) {
+        if (i != 1) {
+            remove(&ctx[i]);
+        }
+    }
+}
+
+UCS_TEST_F(test_callbackq, backoff) {
+    static const unsigned idle_rounds = 1000;
+    callback_ctx ctx;
+
+    init_ctx(&ctx);
+    ctx.command = COMMAND_IDLE;
+    add_prio(&ctx, UCS_CALLBACKQ_PRIO_LOW, UCS_CALLBACKQ_ELEM_FLAG_BACKOFF);
+
+    dispatch(UCS_CALLBACKQ_BACKOFF_THRESH);
+    EXPECT_EQ(UCS_CALLBACKQ_BACKOFF_THRESH, ctx.count);
+
+    /* Idle callback is skipped most of the time */
+    dispatch(idle_rounds);
+    unsigned idle_count = ctx.count - UCS_CALLBACKQ_BACKOFF_THRESH;
+    EXPECT_GT(idle_count, 0u);
+    EXPECT_LE(idle_count, idle_rounds / UCS_CALLBACKQ_BACKOFF_MAX + 5);
+
+    /* Backoff is reset once the callback does some work */
+    ctx.command = COMMAND_NONE;
+    dispatch(UCS_CALLBACKQ_BACKOFF_MAX + 1);
+    unsigned count = ctx.count;
+    EXPECT_EQ(10u, dispatch(10));
+    EXPECT_EQ(count + 10, ctx.count);
+
+    ucs_string_buffer_t strb;
+    ucs_string_buffer_init(&strb);
+    ucs_callbackq_print_counters(&m_cbq, &strb);
+    std::string counters(ucs_string_buffer_cstr(&strb));
+    ucs_string_buffer_cleanup(&strb);
+    UCS_TEST_MESSAGE << counters;
+    EXPECT_NE(std::string::npos, counters.find("prio low backoff 0"));
+#ifdef ENABLE_STATS
+    EXPECT_NE(std::string::npos,
+              counters.find("calls " + std::to_string(ctx.count)));
+#else
+    EXPECT_EQ(std::string::npos, counters.find("calls"));
+#endif
+
+    remove(&ctx);
+    dispatch();
+    EXPECT_EQ(count + 10, ctx.count);
+}
+
+UCS_TEST_F(test_callbackq, backoff_remove_self) {
+    callback_ctx ctx1, ctx2;
+
+    init_ctx(&ctx1);
+    ctx1.command = COMMAND_REMOVE_SELF;
+    add_prio(&ctx1, UCS_CALLBACKQ_PRIO_NORMAL, UCS_CALLBACKQ_ELEM_FLAG_BACKOFF);
+
+    init_ctx(&ctx2);
+    ctx2.command = COMMAND_REMOVE_SELF_SAFE;
+    add_prio(&ctx2, UCS_CALLBACKQ_PRIO_HIGH, UCS_CALLBACKQ_ELEM_FLAG_BACKOFF);
+
+    dispatch(100);
+    EXPECT_EQ(1u, ctx1.count);
+    EXPECT_EQ(1u, ctx2.count);
+}
+
 UCS_MT_TEST_F(test_callbackq, threads, 10) {
     static unsigned COUNT = 2000;
     if (barrier()) {
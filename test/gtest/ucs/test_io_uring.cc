@@ -0,0 +1,134 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#include <common/test.h>
+extern "C" {
+#include <ucs/sys/io_uring.h>
+}
+
+#include <sys/socket.h>
+#include <errno.h>
+#include <map>
+
+
+class test_io_uring : public ucs::test {
+protected:
+    static const unsigned ENTRIES  = 4;
+    static const size_t   BUF_SIZE = 64;
+
+    typedef std::map<uint64_t, int> results_t;
+
+    void init()
+    {
+        if (!ucs_io_uring_is_supported()) {
+            UCS_TEST_SKIP_R("io_uring is not supported");
+        }
+
+        ucs::test::init();
+
+        ASSERT_UCS_OK(ucs_io_uring_init(&m_ring, ENTRIES));
+        for (unsigned i = 0; i < ENTRIES; ++i) {
+            int fds[2];
+            ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+            m_fds.push_back(std::make_pair(fds[0], fds[1]));
+        }
+    }
+
+    void cleanup()
+    {
+        for (size_t i = 0; i < m_fds.size(); ++i) {
+            close(m_fds[i].first);
+            close(m_fds[i].second);
+        }
+
+        ucs_io_uring_cleanup(&m_ring);
+        ucs::test::cleanup();
+    }
+
+    static void cqe_cb(void *arg, uint64_t user_data, int res)
+    {
+        results_t *results = (results_t*)arg;
+
+        EXPECT_EQ(0ul, results->count(user_data));
+        (*results)[user_data] = res;
+    }
+
+    void send(unsigned index, const std::string &data)
+    {
+        ASSERT_EQ((ssize_t)data.size(),
+                  ::send(m_fds[index].second, data.c_str(), data.size(), 0));
+    }
+
+    ucs_status_t prep_recv(unsigned index, uint64_t user_data)
+    {
+        return ucs_io_uring_prep_recv(&m_ring, m_fds[index].first,
+                                      m_bufs[index], BUF_SIZE, user_data);
+    }
+
+    ucs_io_uring_t                   m_ring;
+    std::vector<std::pair<int, int>> m_fds;
+    char                             m_bufs[ENTRIES][BUF_SIZE];
+};
+
+UCS_TEST_F(test_io_uring, submit_empty) {
+    results_t results;
+
+    ASSERT_UCS_OK(ucs_io_uring_submit(&m_ring, cqe_cb, &results));
+    EXPECT_TRUE(results.empty());
+}
+
+UCS_TEST_F(test_io_uring, recv) {
+    results_t results;
+
+    for (unsigned i = 0; i < ENTRIES; ++i) {
+        send(i, "data" + ucs::to_string(i));
+        ASSERT_UCS_OK(prep_recv(i, i));
+    }
+
+    ASSERT_UCS_OK(ucs_io_uring_submit(&m_ring, cqe_cb, &results));
+    ASSERT_EQ((size_t)ENTRIES, results.size());
+
+    for (unsigned i = 0; i < ENTRIES; ++i) {
+        std::string expected = "data" + ucs::to_string(i);
+        ASSERT_EQ((int)expected.size(), results[i]);
+        EXPECT_EQ(expected, std::string(m_bufs[i], results[i]));
+    }
+}
+
+UCS_TEST_F(test_io_uring, recv_no_data) {
+    results_t results;
+
+    /* Receive operation must not block when there is no data */
+    send(0, "data");
+    ASSERT_UCS_OK(prep_recv(0, 0));
+    ASSERT_UCS_OK(prep_recv(1, 1));
+
+    ASSERT_UCS_OK(ucs_io_uring_submit(&m_ring, cqe_cb, &results));
+    ASSERT_EQ(2ul, results.size());
+    EXPECT_EQ(4, results[0]);
+    EXPECT_EQ(-EAGAIN, results[1]);
+}
+
+UCS_TEST_F(test_io_uring, queue_full) {
+    results_t results;
+
+    for (unsigned i = 0; i < m_ring.sq_entries; ++i) {
+        ASSERT_UCS_OK(prep_recv(i % ENTRIES, i));
+    }
+
+    EXPECT_EQ(UCS_ERR_NO_RESOURCE, prep_recv(0, m_ring.sq_entries));
+
+    ASSERT_UCS_OK(ucs_io_uring_submit(&m_ring, cqe_cb, &results));
+    EXPECT_EQ(m_ring.sq_entries, results.size());
+
+    /* The queue can be reused after submit */
+    results.clear();
+    send(0, "x");
+    ASSERT_UCS_OK(prep_recv(0, 0));
+    ASSERT_UCS_OK(ucs_io_uring_submit(&m_ring, cqe_cb, &results));
+    ASSERT_EQ(1ul, results.size());
+    EXPECT_EQ(1, results[0]);
+}
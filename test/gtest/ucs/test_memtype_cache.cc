@@ -11,6 +11,8 @@
 #include <ucs/memory/memtype_cache.h>
 #include <ucm/api/ucm.h>
 
+#include <atomic>
+
 extern "C" {
 #include <ucm/event/event.h>
 }
@@ -430,6 +432,93 @@ UCS_TEST_P(test_memtype_cache, diff_mem_types_diff_bufs_keep_mem) {
     test_memtype_cache_alloc_diff_mem_types(true, false);
 }
 
+UCS_TEST_SKIP_COND_P(test_memtype_cache, wide_region,
+                     GetParam() != UCS_MEMORY_TYPE_HOST) {
+    /* The region covers more granules than there are filter buckets */
+    const size_t size = UCS_BIT(UCS_MEMTYPE_CACHE_FILTER_SHIFT +
+                                UCS_MEMTYPE_CACHE_FILTER_BITS + 1);
+    void *ptr         = reinterpret_cast<void*>(0x7e0000000000ul);
+
+    memtype_cache_update(ptr, size, UCS_MEMORY_TYPE_CUDA);
+    test_ptr_found(ptr, size, UCS_MEMORY_TYPE_CUDA);
+    test_lookup_found(UCS_PTR_BYTE_OFFSET(ptr, size / 2), 1,
+                      UCS_MEMORY_TYPE_CUDA);
+
+    memtype_cache_remove(ptr, size);
+    test_ptr_released(ptr, size);
+    test_ptr_released(UCS_PTR_BYTE_OFFSET(ptr, size / 2), 1);
+    test_ptr_not_found(ptr, size);
+}
+
+class test_memtype_cache_mt_lookup {
+public:
+    test_memtype_cache_mt_lookup(const void *ptr) :
+        m_ptr(ptr), m_stop(false), m_num_lookups(0), m_num_errors(0)
+    {
+    }
+
+    static void *thread_func(void *arg)
+    {
+        test_memtype_cache_mt_lookup *self =
+                reinterpret_cast<test_memtype_cache_mt_lookup*>(arg);
+        ucs_memory_info_t mem_info;
+        ucs_status_t status;
+
+        while (!self->m_stop) {
+            status = ucs_memtype_cache_lookup(self->m_ptr, 1, &mem_info);
+            if ((status != UCS_OK) ||
+                (mem_info.type != UCS_MEMORY_TYPE_CUDA)) {
+                ++self->m_num_errors;
+            }
+            ++self->m_num_lookups;
+        }
+
+        return NULL;
+    }
+
+    const void            *m_ptr;
+    std::atomic<bool>     m_stop;
+    std::atomic<unsigned> m_num_lookups;
+    std::atomic<unsigned> m_num_errors;
+};
+
+UCS_TEST_SKIP_COND_P(test_memtype_cache, mt_update_lookup,
+                     GetParam() != UCS_MEMORY_TYPE_HOST) {
+    const size_t size          = UCS_BIT(UCS_MEMTYPE_CACHE_FILTER_SHIFT + 1);
+    const unsigned num_threads = 4;
+    void *ptr                  = reinterpret_cast<void*>(0x7e0000000000ul);
+    test_memtype_cache_mt_lookup lookup(UCS_PTR_BYTE_OFFSET(ptr, size - 1));
+    pthread_t threads[num_threads];
+
+    memtype_cache_update(ptr, size, UCS_MEMORY_TYPE_CUDA);
+
+    for (unsigned i = 0; i < num_threads; ++i) {
+        pthread_create(&threads[i], NULL,
+                       test_memtype_cache_mt_lookup::thread_func, &lookup);
+    }
+
+    /* Changing the memory type of the first half splits the region, and
+     * changing it back with an overlap merges the halves, so the region which
+     * contains the looked up address is removed and inserted back every time */
+    const unsigned count = 10000 / ucs::test_time_multiplier();
+    for (unsigned i = 0; (i < count) || (lookup.m_num_lookups < count); ++i) {
+        memtype_cache_update(ptr, size / 2, UCS_MEMORY_TYPE_ROCM);
+        memtype_cache_update(ptr, size / 2 + UCS_PGT_ADDR_ALIGN,
+                             UCS_MEMORY_TYPE_CUDA);
+    }
+
+    lookup.m_stop = true;
+    for (unsigned i = 0; i < num_threads; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    memtype_cache_remove(ptr, size);
+    test_ptr_released(ptr, size);
+
+    UCS_TEST_MESSAGE << lookup.m_num_lookups << " lookups";
+    EXPECT_EQ(0u, lookup.m_num_errors);
+}
+
 INSTANTIATE_TEST_SUITE_P(mem_type, test_memtype_cache,
                         ::testing::ValuesIn(mem_buffer::supported_mem_types()));
 
@@ -8,8 +8,10 @@
 
 extern "C" {
 #include <ucs/datastruct/mpmc.h>
+#include <ucs/time/time.h>
 }
 #include <pthread.h>
+#include <set>
 
 
 class test_mpmc : public ucs::test {
@@ -128,3 +130,101 @@ UCS_TEST_F(test_mpmc, multi_threaded) {
     EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
     ucs_mpmc_queue_cleanup(&mpmc);
 }
+
+static int test_mpmc_is_odd(uint64_t value, void *arg)
+{
+    return value & 1;
+}
+
+UCS_TEST_F(test_mpmc, remove_if) {
+    /* Exceed the ring length, to remove values from the overflow queue too */
+    static const uint64_t count = 1000;
+    ucs_mpmc_queue_t mpmc;
+    ucs_status_t status;
+    uint64_t i, value;
+
+    status = ucs_mpmc_queue_init(&mpmc);
+    ASSERT_UCS_OK(status);
+
+    for (i = 0; i < count; ++i) {
+        status = ucs_mpmc_queue_push(&mpmc, i);
+        ASSERT_UCS_OK(status);
+    }
+
+    ucs_mpmc_queue_remove_if(&mpmc, test_mpmc_is_odd, NULL);
+
+    std::set<uint64_t> values;
+    while (ucs_mpmc_queue_pull(&mpmc, &value) == UCS_OK) {
+        EXPECT_FALSE(test_mpmc_is_odd(value, NULL)) << "value=" << value;
+        values.insert(value);
+    }
+
+    EXPECT_EQ(count / 2, values.size());
+    EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
+    ucs_mpmc_queue_cleanup(&mpmc);
+}
+
+
+class test_mpmc_perf : public ucs::test {
+protected:
+    struct thread_args {
+        ucs_mpmc_queue_t *mpmc;
+        unsigned         count;
+    };
+
+    static void *push_pull_thread_func(void *arg)
+    {
+        const thread_args *args = reinterpret_cast<thread_args*>(arg);
+        ucs_status_t status;
+        uint64_t value;
+
+        for (unsigned i = 0; i < args->count; ++i) {
+            status = ucs_mpmc_queue_push(args->mpmc, i);
+            ASSERT_UCS_OK(status);
+            do {
+                status = ucs_mpmc_queue_pull(args->mpmc, &value);
+            } while (status == UCS_ERR_NO_PROGRESS);
+        }
+
+        return NULL;
+    }
+
+    double measure(unsigned num_threads, unsigned count)
+    {
+        std::vector<pthread_t> threads(num_threads);
+        thread_args args;
+        ucs_mpmc_queue_t mpmc;
+        ucs_time_t start_time;
+        double elapsed;
+
+        ASSERT_UCS_OK(ucs_mpmc_queue_init(&mpmc));
+
+        args.mpmc  = &mpmc;
+        args.count = count;
+
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < num_threads; ++i) {
+            pthread_create(&threads[i], NULL, push_pull_thread_func, &args);
+        }
+        for (unsigned i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+        elapsed = ucs_time_to_sec(ucs_get_time() - start_time);
+
+        EXPECT_TRUE(ucs_mpmc_queue_is_empty(&mpmc));
+        ucs_mpmc_queue_cleanup(&mpmc);
+
+        return (2.0 * num_threads * count) / elapsed;
+    }
+};
+
+UCS_TEST_SKIP_COND_F(test_mpmc_perf, push_pull,
+                     RUNNING_ON_VALGRIND || !ucs::perf_retry_count) {
+    const unsigned total_count = 1000000 / ucs::test_time_multiplier();
+
+    for (unsigned num_threads = 1; num_threads <= 64; num_threads *= 2) {
+        double rate = measure(num_threads, total_count / num_threads);
+        UCS_TEST_MESSAGE << num_threads << " threads: " << (rate / 1e6)
+                         << " Mops/sec";
+    }
+}
@@ -7,9 +7,15 @@
 #include <common/test.h>
 extern "C" {
 #include <ucs/datastruct/mpool.h>
+#include <ucs/datastruct/mpool.inl>
+#include <ucs/sys/sys.h>
 }
 
 #include <limits.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <fstream>
+#include <sstream>
 #include <vector>
 #include <queue>
 
@@ -24,6 +30,38 @@ protected:
         free(chunk);
     }
 
+    /* Return the NUMA node the page of the given address was allocated on */
+    static int numa_node_of_addr(void *addr) {
+        int node;
+
+        if (syscall(__NR_get_mempolicy, &node, NULL, 0, addr,
+                    MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+            return -1;
+        }
+
+        return node;
+    }
+
+    /* Return the VmFlags of the mapping which contains the given address */
+    static std::string vma_flags_of_addr(void *addr) {
+        std::ifstream smaps("/proc/self/smaps");
+        std::string line, flags;
+        unsigned long start, end;
+        bool found = false;
+        char dash;
+
+        while (std::getline(smaps, line)) {
+            std::istringstream iss(line);
+            if ((iss >> std::hex >> start >> dash >> end) && (dash == '-')) {
+                found = (start <= (uintptr_t)addr) && ((uintptr_t)addr < end);
+            } else if (found && (line.compare(0, 8, "VmFlags:") == 0)) {
+                return line.substr(8);
+            }
+        }
+
+        return "";
+    }
+
     static void obj_str(ucs_mpool_t *mp, void *obj, ucs_string_buffer_t *strb)
     {
         ucs_string_buffer_appendf(strb, "test-obj-%p", obj);
@@ -291,6 +329,83 @@ UCS_TEST_F(test_mpool, grow) {
     ucs_mpool_cleanup(&mp, 1);
 }
 
+UCS_TEST_F(test_mpool, numa_hugepages) {
+    ucs_numa_policy_t policy_before, policy_after;
+    ucs_status_t status;
+    ucs_mpool_t mp;
+
+    ucs_mpool_ops_t ops = {
+       ucs_mpool_chunk_mmap,
+       ucs_mpool_chunk_munmap,
+       NULL,
+       NULL,
+       NULL
+    };
+    ucs_mpool_params_t mp_params;
+
+    ASSERT_EQ(0, syscall(__NR_get_mempolicy, &policy_before.mode,
+                         policy_before.nodemask, UCS_NUMA_POLICY_MAX_NODES,
+                         NULL, 0));
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size       = header_size + data_size;
+    mp_params.align_offset    = header_size;
+    mp_params.alignment       = align;
+    mp_params.elems_per_chunk = 1000;
+    mp_params.max_elems       = 2000;
+    mp_params.numa_node       = ucs_numa_node_of_cpu(ucs_get_first_cpu());
+    mp_params.hugepages       = 1;
+    mp_params.ops             = &ops;
+    mp_params.name            = "tests";
+    status = ucs_mpool_init(&mp_params, &mp);
+    ASSERT_UCS_OK(status);
+
+    std::vector<void*> objs;
+    for (unsigned i = 0; i < 2000; ++i) {
+        void *obj = ucs_mpool_get(&mp);
+        ASSERT_TRUE(obj != NULL);
+        memset(obj, 0, data_size);
+        objs.push_back(obj);
+    }
+
+    EXPECT_TRUE(ucs_mpool_get(&mp) == NULL);
+
+    /* The pages were allocated on the requested node */
+    for (std::vector<void*>::iterator iter = objs.begin(); iter != objs.end();
+         ++iter) {
+        EXPECT_EQ((int)mp_params.numa_node, numa_node_of_addr(*iter))
+                << "obj=" << *iter;
+    }
+
+    /* The chunk is backed by hugetlb pages (ht) or advised to use transparent
+     * huge pages (hg) */
+    if (ucs_get_huge_page_size() <= 0) {
+        UCS_TEST_MESSAGE << "huge pages are not supported";
+    } else {
+        std::string flags = vma_flags_of_addr(objs.front());
+        bool huge         = (flags.find(" ht") != std::string::npos) ||
+                            (flags.find(" hg") != std::string::npos);
+        if (ucs_is_thp_enabled()) {
+            EXPECT_TRUE(huge) << "obj=" << objs.front() << " VmFlags:" << flags;
+        } else if (!huge) {
+            UCS_TEST_MESSAGE << "transparent huge pages are disabled";
+        }
+    }
+
+    for (std::vector<void*>::iterator iter = objs.begin(); iter != objs.end();
+         ++iter) {
+        ucs_mpool_put(*iter);
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+
+    /* The memory policy of the thread is restored after the pool grows */
+    ASSERT_EQ(0, syscall(__NR_get_mempolicy, &policy_after.mode,
+                         policy_after.nodemask, UCS_NUMA_POLICY_MAX_NODES,
+                         NULL, 0));
+    EXPECT_EQ(policy_before.mode, policy_after.mode);
+}
+
 UCS_TEST_F(test_mpool, infinite) {
     const unsigned NUM_ELEMS = 1000000 / ucs::test_time_multiplier();
     ucs_status_t status;
@@ -495,3 +610,116 @@ UCS_TEST_SKIP_COND_F(test_mpool_fifo, alloc_release, !ENABLE_DEBUG_DATA)
 
     ucs_mpool_cleanup(&mp, 0); // skip individual put as obj could be corrupted
 }
+
+class test_mpool_thread_cache : public test_mpool {
+protected:
+    static const unsigned num_threads = 4;
+    static const unsigned num_objs    = 100;
+    static const unsigned cache_size  = 16;
+
+    void init_mpool(ucs_mpool_t *mp, unsigned max_elems = UINT_MAX)
+    {
+        static ucs_mpool_ops_t ops = {ucs_mpool_chunk_malloc,
+                                      ucs_mpool_chunk_free,
+                                      NULL, NULL, NULL};
+        ucs_mpool_params_t mp_params;
+
+        ucs_mpool_params_reset(&mp_params);
+        mp_params.elem_size         = header_size + data_size;
+        mp_params.align_offset      = header_size;
+        mp_params.alignment         = align;
+        mp_params.elems_per_chunk   = 64;
+        mp_params.max_elems         = max_elems;
+        mp_params.thread_cache_size = cache_size;
+        mp_params.ops               = &ops;
+        mp_params.name              = "test";
+        ASSERT_UCS_OK(ucs_mpool_init(&mp_params, mp));
+    }
+
+    static void get_put(ucs_mpool_t *mp, unsigned count)
+    {
+        std::vector<void*> objs;
+
+        for (unsigned i = 0; i < count; ++i) {
+            void *obj = ucs_mpool_get_mt_inline(mp);
+            ASSERT_TRUE(obj != NULL);
+            memset(obj, 0, data_size);
+            objs.push_back(obj);
+        }
+
+        for (std::vector<void*>::iterator iter = objs.begin();
+             iter != objs.end(); ++iter) {
+            ucs_mpool_put_mt_inline(*iter);
+        }
+    }
+
+    static void *get_put_thread_func(void *arg)
+    {
+        ucs_mpool_t *mp   = (ucs_mpool_t*)arg;
+        unsigned num_iter = 1000 / ucs::test_time_multiplier();
+
+        for (unsigned i = 0; i < num_iter; ++i) {
+            get_put(mp, (i % num_objs) + 1);
+        }
+
+        /* Exit while some objects are still in the thread cache */
+        return NULL;
+    }
+};
+
+UCS_TEST_F(test_mpool_thread_cache, multi_thread) {
+    pthread_t threads[num_threads];
+    ucs_mpool_t mp;
+
+    init_mpool(&mp);
+
+    for (unsigned i = 0; i < num_threads; ++i) {
+        pthread_create(&threads[i], NULL, get_put_thread_func, &mp);
+    }
+    for (unsigned i = 0; i < num_threads; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* Objects cached by the exited threads were returned to the pool */
+    EXPECT_TRUE(ucs_list_is_empty(&mp.data->thread_caches));
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_thread_cache, cleanup_cached) {
+    ucs_mpool_t mp;
+
+    init_mpool(&mp);
+
+    /* Leave objects in the cache of the current thread, they should not be
+     * reported as leaked */
+    get_put(&mp, num_objs);
+    EXPECT_EQ(1ul, ucs_list_length(&mp.data->thread_caches));
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool_thread_cache, max_elems) {
+    const unsigned max_elems = 64;
+    std::vector<void*> objs;
+    ucs_mpool_t mp;
+
+    init_mpool(&mp, max_elems);
+
+    /* Objects in the thread cache are available for allocation */
+    get_put(&mp, max_elems);
+    for (unsigned i = 0; i < max_elems; ++i) {
+        void *obj = ucs_mpool_get_mt_inline(&mp);
+        ASSERT_TRUE(obj != NULL);
+        objs.push_back(obj);
+    }
+
+    EXPECT_TRUE(ucs_mpool_get_mt_inline(&mp) == NULL);
+
+    for (std::vector<void*>::iterator iter = objs.begin(); iter != objs.end();
+         ++iter) {
+        ucs_mpool_put_mt_inline(*iter);
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+}
@@ -0,0 +1,400 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#include <common/test.h>
+extern "C" {
+#include <ucs/datastruct/range_tree.h>
+#include <ucs/datastruct/pgtable.h>
+#include <ucs/time/time.h>
+}
+#include <cmath>
+#include <map>
+#include <vector>
+
+class test_range_tree : public ucs::test {
+protected:
+    typedef std::vector<ucs_pgt_region_t*> search_result_t;
+
+    virtual void init() {
+        ucs::test::init();
+        m_num_nodes = 0;
+        ucs_status_t status = ucs_range_tree_init(&m_tree, node_alloc,
+                                                  node_free);
+        ASSERT_UCS_OK(status);
+    }
+
+    virtual void cleanup() {
+        ucs_range_tree_cleanup(&m_tree);
+        EXPECT_EQ(0u, m_num_nodes);
+        ucs::test::cleanup();
+    }
+
+    void insert(ucs_pgt_region_t *region, ucs_status_t exp_status = UCS_OK)
+    {
+        ucs_status_t status = ucs_range_tree_insert(&m_tree, region);
+        if (exp_status == UCS_OK) {
+            ASSERT_UCS_OK(status, << " inserting 0x" << std::hex <<
+                                     region->start << "..0x" << region->end);
+        } else {
+            EXPECT_EQ(exp_status, status);
+        }
+    }
+
+    void remove(ucs_pgt_region_t *region, ucs_status_t exp_status = UCS_OK)
+    {
+        ucs_status_t status = ucs_range_tree_remove(&m_tree, region);
+        EXPECT_EQ(exp_status, status);
+    }
+
+    ucs_pgt_region_t *lookup(ucs_pgt_addr_t address) {
+        return ucs_range_tree_lookup(&m_tree, address);
+    }
+
+    unsigned num_regions() {
+        return ucs_range_tree_num_regions(&m_tree);
+    }
+
+    search_result_t search(ucs_pgt_addr_t from, ucs_pgt_addr_t to) {
+        search_result_t result;
+        ucs_range_tree_search_range(&m_tree, from, to, collect_cb, &result);
+        return result;
+    }
+
+    search_result_t remove_range(ucs_pgt_addr_t from, ucs_pgt_addr_t to) {
+        search_result_t result;
+        unsigned count = ucs_range_tree_remove_range(&m_tree, from, to,
+                                                     collect_cb, &result);
+        EXPECT_EQ(result.size(), count);
+        return result;
+    }
+
+    void purge() {
+        search_result_t result;
+        ucs_range_tree_purge(&m_tree, collect_cb, &result);
+    }
+
+    void check_balanced() {
+        int height = (m_tree.root == NULL) ? 0 : m_tree.root->height;
+        EXPECT_LE(height, 1.45 * std::log2(num_regions() + 2))
+                << "num_regions=" << num_regions();
+    }
+
+    static ucs_range_tree_node_t *node_alloc(const ucs_range_tree_t *tree) {
+        ++m_num_nodes;
+        return new ucs_range_tree_node_t;
+    }
+
+    static void node_free(const ucs_range_tree_t *tree,
+                          ucs_range_tree_node_t *node) {
+        --m_num_nodes;
+        delete node;
+    }
+
+    static void collect_cb(const ucs_range_tree_t *tree,
+                           ucs_pgt_region_t *region, void *arg) {
+        reinterpret_cast<search_result_t*>(arg)->push_back(region);
+    }
+
+    static unsigned  m_num_nodes;
+    ucs_range_tree_t m_tree;
+};
+
+unsigned test_range_tree::m_num_nodes = 0;
+
+
+UCS_TEST_F(test_range_tree, basic) {
+    ucs_pgt_region_t region = {0x400801, 0x403403};
+
+    insert(&region);
+    ucs_range_tree_dump(&m_tree, UCS_LOG_LEVEL_DEBUG);
+
+    EXPECT_EQ(&region, lookup(0x400801));
+    EXPECT_EQ(&region, lookup(0x402020));
+    EXPECT_EQ(&region, lookup(0x403402));
+    EXPECT_TRUE(NULL == lookup(0x400800));
+    EXPECT_TRUE(NULL == lookup(0x403403));
+    EXPECT_TRUE(NULL == lookup(0x0));
+    EXPECT_TRUE(NULL == lookup(std::numeric_limits<ucs_pgt_addr_t>::max()));
+    EXPECT_EQ(1u, num_regions());
+
+    remove(&region);
+    EXPECT_TRUE(NULL == lookup(0x402020));
+    EXPECT_EQ(0u, num_regions());
+
+    insert(&region);
+    purge();
+    EXPECT_EQ(0u, num_regions());
+}
+
+UCS_TEST_F(test_range_tree, invalid_param) {
+    ucs_pgt_region_t region1 = {0x4000, 0x4000};
+    insert(&region1, UCS_ERR_INVALID_PARAM);
+
+    ucs_pgt_region_t region2 = {0x5000, 0x4000};
+    insert(&region2, UCS_ERR_INVALID_PARAM);
+}
+
+UCS_TEST_F(test_range_tree, overlap_insert) {
+    ucs_pgt_region_t region1 = {0x4000, 0x6000};
+    insert(&region1);
+
+    ucs_pgt_region_t region2 = {0x5fff, 0x7000};
+    insert(&region2, UCS_ERR_ALREADY_EXISTS);
+
+    ucs_pgt_region_t region3 = {0x3000, 0x4001};
+    insert(&region3, UCS_ERR_ALREADY_EXISTS);
+
+    ucs_pgt_region_t region4 = {0x4100, 0x4200};
+    insert(&region4, UCS_ERR_ALREADY_EXISTS);
+
+    ucs_pgt_region_t region5 = {0x3000, 0x7000};
+    insert(&region5, UCS_ERR_ALREADY_EXISTS);
+
+    /* Adjacent regions do not overlap */
+    ucs_pgt_region_t region6 = {0x6000, 0x7000};
+    insert(&region6);
+    ucs_pgt_region_t region7 = {0x3000, 0x4000};
+    insert(&region7);
+
+    EXPECT_EQ(&region7, lookup(0x3fff));
+    EXPECT_EQ(&region1, lookup(0x4000));
+    EXPECT_EQ(&region6, lookup(0x6000));
+
+    remove(&region1);
+    remove(&region6);
+    remove(&region7);
+}
+
+UCS_TEST_F(test_range_tree, nonexist_remove) {
+    ucs_pgt_region_t region1 = {0x4000, 0x6000};
+    remove(&region1, UCS_ERR_NO_ELEM);
+
+    ucs_pgt_region_t region2 = {0x5000, 0x7000};
+    insert(&region2);
+
+    remove(&region1, UCS_ERR_NO_ELEM);
+
+    region1 = region2;
+    remove(&region1, UCS_ERR_NO_ELEM); /* Fail - should be pointer-equal */
+
+    remove(&region2);
+}
+
+UCS_TEST_F(test_range_tree, search_and_remove_range) {
+    const unsigned num_regions = 100;
+    ucs_pgt_region_t regions[num_regions];
+    search_result_t result;
+
+    /* Every region is 0x100 bytes followed by a gap of 0x100 bytes */
+    for (unsigned i = 0; i < num_regions; ++i) {
+        regions[i].start = 0x10000 + (i * 0x200);
+        regions[i].end   = regions[i].start + 0x100;
+        insert(&regions[i]);
+    }
+
+    result = search(regions[10].end, regions[11].start - 1);
+    EXPECT_TRUE(result.empty());
+
+    result = search(regions[10].end - 1, regions[20].start);
+    ASSERT_EQ(11u, result.size());
+    for (unsigned i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(&regions[10 + i], result[i]);
+    }
+
+    result = search(0, std::numeric_limits<ucs_pgt_addr_t>::max());
+    EXPECT_EQ(num_regions, result.size());
+
+    /* Remove regions 10..20 */
+    result = remove_range(regions[10].end - 1, regions[20].start);
+    ASSERT_EQ(11u, result.size());
+    for (unsigned i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(&regions[10 + i], result[i]);
+    }
+
+    EXPECT_EQ(num_regions - 11, this->num_regions());
+    EXPECT_EQ(&regions[9], lookup(regions[9].start));
+    EXPECT_TRUE(NULL == lookup(regions[10].start));
+    EXPECT_TRUE(NULL == lookup(regions[20].start));
+    EXPECT_EQ(&regions[21], lookup(regions[21].start));
+    check_balanced();
+
+    result = remove_range(regions[10].start, regions[20].end);
+    EXPECT_TRUE(result.empty());
+
+    result = remove_range(0, std::numeric_limits<ucs_pgt_addr_t>::max());
+    EXPECT_EQ(num_regions - 11, result.size());
+    EXPECT_EQ(0u, this->num_regions());
+}
+
+UCS_TEST_F(test_range_tree, random_ops) {
+    typedef std::map<ucs_pgt_addr_t, ucs_pgt_region_t*> ref_map_t;
+    const ucs_pgt_addr_t max_addr = UCS_BIT(24);
+    ucs::ptr_vector<ucs_pgt_region_t> regions;
+    ref_map_t ref;
+
+    for (unsigned i = 0; i < 20000 / ucs::test_time_multiplier(); ++i) {
+        ucs_pgt_addr_t address = ucs::rand() % max_addr;
+        ucs_pgt_region_t *region;
+        ref_map_t::iterator iter;
+
+        /* Find the region containing the address in the reference map */
+        region = NULL;
+        iter   = ref.upper_bound(address);
+        if (iter != ref.begin()) {
+            --iter;
+            if (address < iter->second->end) {
+                region = iter->second;
+            }
+        }
+
+        ASSERT_EQ(region, lookup(address)) << std::hex << address;
+
+        if (region != NULL) {
+            remove(region);
+            ref.erase(region->start);
+        } else {
+            region        = new ucs_pgt_region_t;
+            region->start = address;
+            region->end   = address + 1 + (ucs::rand() % 4096);
+            regions.push_back(region);
+
+            iter = ref.lower_bound(address);
+            if ((iter == ref.end()) || (iter->first >= region->end)) {
+                insert(region);
+                ref[address] = region;
+            } else {
+                insert(region, UCS_ERR_ALREADY_EXISTS);
+            }
+        }
+
+        ASSERT_EQ(ref.size(), num_regions());
+    }
+
+    check_balanced();
+    purge();
+}
+
+
+class test_range_tree_perf : public test_range_tree {
+protected:
+    typedef std::pair<double, double> result_t;
+
+    void measure(size_t region_size, unsigned count)
+    {
+        ucs::ptr_vector<ucs_pgt_region_t> regions;
+        std::vector<ucs_pgt_addr_t> lookups;
+        ucs_pgtable_t pgtable;
+        result_t insert_ns, lookup_ns, remove_ns;
+        ucs_pgt_addr_t address;
+        unsigned num_pgdirs;
+        size_t num_hits;
+
+        /* Regions are unaligned, separated by random gaps */
+        address = UCS_BIT(40);
+        for (unsigned i = 0; i < count; ++i) {
+            address += UCS_PGT_ADDR_ALIGN * (1 + (ucs::rand() % 64));
+            ucs_pgt_region_t *region = new ucs_pgt_region_t;
+            region->start = address;
+            region->end   = address + region_size;
+            regions.push_back(region);
+            address = region->end;
+        }
+
+        for (unsigned i = 0; i < count * 4; ++i) {
+            const ucs_pgt_region_t *region = &regions.at(ucs::rand() % count);
+            lookups.push_back(region->start +
+                              (ucs::rand() % (region->end - region->start)));
+        }
+
+        ASSERT_UCS_OK(ucs_pgtable_init(&pgtable, pgd_alloc, pgd_free));
+        m_num_pgdirs = 0;
+
+        insert_ns.first = time_ns(count, [&]() {
+            for (auto &region : regions) {
+                ucs_pgtable_insert(&pgtable, region);
+            }
+        });
+        insert_ns.second = time_ns(count, [&]() {
+            for (auto &region : regions) {
+                ucs_range_tree_insert(&m_tree, region);
+            }
+        });
+        num_pgdirs = m_num_pgdirs;
+
+        num_hits        = 0;
+        lookup_ns.first = time_ns(lookups.size(), [&]() {
+            for (auto address : lookups) {
+                num_hits += (ucs_pgtable_lookup(&pgtable, address) != NULL);
+            }
+        });
+        lookup_ns.second = time_ns(lookups.size(), [&]() {
+            for (auto address : lookups) {
+                num_hits += (ucs_range_tree_lookup(&m_tree, address) != NULL);
+            }
+        });
+        EXPECT_EQ(2 * lookups.size(), num_hits);
+
+        remove_ns.first = time_ns(count, [&]() {
+            for (auto &region : regions) {
+                ucs_pgtable_remove(&pgtable, region);
+            }
+        });
+        remove_ns.second = time_ns(count, [&]() {
+            ucs_range_tree_remove_range(&m_tree, 0, UCS_PGT_ADDR_MAX,
+                                        remove_cb, NULL);
+        });
+
+        EXPECT_EQ(0u, ucs_pgtable_num_regions(&pgtable));
+        EXPECT_EQ(0u, num_regions());
+        ucs_pgtable_cleanup(&pgtable);
+
+        UCS_TEST_MESSAGE << count << " regions of " << region_size
+                         << " bytes, pgtable/range_tree: insert "
+                         << insert_ns.first << "/" << insert_ns.second
+                         << " ns, lookup " << lookup_ns.first << "/"
+                         << lookup_ns.second << " ns, remove "
+                         << remove_ns.first << "/" << remove_ns.second
+                         << " ns, " << num_pgdirs << " directories/"
+                         << count << " nodes";
+    }
+
+private:
+    template<typename Func>
+    static double time_ns(size_t count, Func func)
+    {
+        ucs_time_t start_time = ucs_get_time();
+        func();
+        return ucs_time_to_nsec(ucs_get_time() - start_time) / count;
+    }
+
+    static ucs_pgt_dir_t *pgd_alloc(const ucs_pgtable_t *pgtable) {
+        ++m_num_pgdirs;
+        return new ucs_pgt_dir_t;
+    }
+
+    static void pgd_free(const ucs_pgtable_t *pgtable, ucs_pgt_dir_t *pgdir) {
+        delete pgdir;
+    }
+
+    static void remove_cb(const ucs_range_tree_t *tree,
+                          ucs_pgt_region_t *region, void *arg) {
+    }
+
+    static unsigned m_num_pgdirs;
+};
+
+unsigned test_range_tree_perf::m_num_pgdirs = 0;
+
+
+/*
+ * Compare the costs to the page table
+ */
+UCS_TEST_SKIP_COND_F(test_range_tree_perf, compare_pgtable,
+                     (ucs::test_time_multiplier() != 1)) {
+    measure(4 * UCS_KBYTE + UCS_PGT_ADDR_ALIGN, 100000);
+    measure(UCS_MBYTE + UCS_PGT_ADDR_ALIGN, 10000);
+    measure(UCS_GBYTE + UCS_PGT_ADDR_ALIGN, 1000);
+}
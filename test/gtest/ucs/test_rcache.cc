@@ -15,6 +15,7 @@ extern "C" {
 #include <ucm/api/ucm.h>
 }
 #include <set>
+#include <vector>
 
 static ucs_rcache_params_t
 get_default_rcache_params(void *context, const ucs_rcache_ops_t *ops)
@@ -28,6 +29,7 @@ get_default_rcache_params(void *context, const ucs_rcache_ops_t *ops)
                                   ULONG_MAX,
                                   SIZE_MAX};
 
+    params.inv_budget = ULONG_MAX;
     return params;
 }
 
@@ -678,6 +680,489 @@ UCS_MT_TEST_F(test_rcache, shared_region, 6) {
     shared_free(mem);
 }
 
+class test_rcache_lockless : public test_rcache {
+protected:
+    struct thread_args {
+        ucs_rcache_t *rcache;
+        void         *ptr;
+        size_t       size;
+        unsigned     count;
+    };
+
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache::rcache_params();
+        params.flags              |= UCS_RCACHE_FLAG_LOCKLESS_GET;
+        return params;
+    }
+
+    static void *get_put_thread_func(void *arg)
+    {
+        thread_args *args = (thread_args*)arg;
+        ucs_rcache_region_t *r;
+        ucs_status_t status;
+
+        for (unsigned i = 0; i < args->count; ++i) {
+            status = ucs_rcache_get(args->rcache, args->ptr, args->size,
+                                    UCS_PGT_ADDR_ALIGN, PROT_READ | PROT_WRITE,
+                                    NULL, &r);
+            EXPECT_UCS_OK(status);
+            ucs_rcache_region_put(args->rcache, r);
+        }
+
+        return NULL;
+    }
+
+    /* Returns the rate of get/put operations on a cached region */
+    double measure(int flags, unsigned num_threads, unsigned count)
+    {
+        static const size_t size    = 64 * UCS_KBYTE;
+        ucs_rcache_params_t params  = test_rcache::rcache_params();
+        std::vector<pthread_t> threads(num_threads);
+        ucs_rcache_region_t *r;
+        ucs_rcache_t *rcache;
+        ucs_time_t start_time;
+        thread_args args;
+        double elapsed;
+        void *ptr;
+
+        params.flags |= flags;
+        ASSERT_UCS_OK(ucs_rcache_create(&params, "perf", NULL, &rcache));
+
+        ptr = alloc_pages(size, PROT_READ | PROT_WRITE);
+        ASSERT_UCS_OK(ucs_rcache_get(rcache, ptr, size, UCS_PGT_ADDR_ALIGN,
+                                     PROT_READ | PROT_WRITE, NULL, &r));
+
+        args.rcache = rcache;
+        args.ptr    = ptr;
+        args.size   = size;
+        args.count  = count;
+
+        start_time = ucs_get_time();
+        for (unsigned i = 0; i < num_threads; ++i) {
+            pthread_create(&threads[i], NULL, get_put_thread_func, &args);
+        }
+        for (unsigned i = 0; i < num_threads; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+        elapsed = ucs_time_to_sec(ucs_get_time() - start_time);
+
+        ucs_rcache_region_put(rcache, r);
+        ucs_rcache_destroy(rcache);
+        munmap(ptr, size);
+
+        return (num_threads * count) / elapsed;
+    }
+
+    void test_get_put_unmap()
+    {
+        static const size_t size = 16 * UCS_KBYTE;
+        const unsigned count     = 1000 / ucs::test_time_multiplier();
+        region *region1, *region2;
+        void *ptr;
+
+        /* Regions are created and removed by other threads while we look up */
+        for (unsigned i = 0; i < count; ++i) {
+            ptr     = alloc_pages(size, PROT_READ | PROT_WRITE);
+            region1 = get(ptr, size);
+            put(region1);
+            region2 = get(ptr, size);
+            EXPECT_EQ(region1, region2);
+            put(region2);
+            munmap(ptr, size);
+        }
+    }
+};
+
+UCS_MT_TEST_F(test_rcache_lockless, get_put_unmap, 6) {
+    test_get_put_unmap();
+}
+
+UCS_TEST_SKIP_COND_F(test_rcache_lockless, hit_rate,
+                     RUNNING_ON_VALGRIND || !ucs::perf_retry_count) {
+    const unsigned total_count = 1000000 / ucs::test_time_multiplier();
+
+    for (unsigned num_threads = 1; num_threads <= 16; num_threads *= 2) {
+        double locked_rate   = measure(0, num_threads,
+                                       total_count / num_threads);
+        double lockless_rate = measure(UCS_RCACHE_FLAG_LOCKLESS_GET,
+                                       num_threads, total_count / num_threads);
+        UCS_TEST_MESSAGE << num_threads << " threads: locked "
+                         << (locked_rate / 1e6) << " Mops/sec, lockless "
+                         << (lockless_rate / 1e6) << " Mops/sec";
+    }
+}
+
+class test_rcache_front_cache : public test_rcache_lockless {
+protected:
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache_lockless::rcache_params();
+        params.flags              |= UCS_RCACHE_FLAG_FRONT_CACHE;
+        return params;
+    }
+
+    uint64_t front_hits() const
+    {
+        uint64_t total = 0;
+
+        for (unsigned i = 0; i < UCS_RCACHE_NUM_READER_SLOTS; ++i) {
+            total += m_rcache->readers.slots[i].front_hits;
+        }
+        return total;
+    }
+};
+
+UCS_TEST_F(test_rcache_front_cache, hit_after_unmap) {
+    static const size_t size = 16 * UCS_KBYTE;
+    region *region1, *region2;
+    uint32_t id;
+    void *ptr;
+
+    ptr     = alloc_pages(size, PROT_READ | PROT_WRITE);
+    region1 = get(ptr, size);
+    id      = region1->id;
+    put(region1);
+
+    /* Same address and length - served from the front cache */
+    region2 = get(ptr, size);
+    EXPECT_EQ(region1, region2);
+    EXPECT_EQ(1u, front_hits());
+    put(region2);
+
+    /* Unmapping the memory must invalidate the front cache entry */
+    munmap(ptr, size);
+    ptr = mmap(ptr, size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    ASSERT_NE(MAP_FAILED, ptr);
+
+    region2 = get(ptr, size);
+    EXPECT_NE(id, region2->id);
+    EXPECT_EQ(1u, front_hits());
+    put(region2);
+
+    munmap(ptr, size);
+}
+
+UCS_MT_TEST_F(test_rcache_front_cache, get_put_unmap, 6) {
+    test_get_put_unmap();
+}
+
+class test_rcache_async : public test_rcache {
+protected:
+    test_rcache_async() : m_reg_delay_us(0)
+    {
+    }
+
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache::rcache_params();
+        params.flags              |= UCS_RCACHE_FLAG_ASYNC_REG;
+        return params;
+    }
+
+    virtual ucs_status_t mem_reg(region *region)
+    {
+        usleep(m_reg_delay_us);
+        return test_rcache::mem_reg(region);
+    }
+
+    region *get_async(void *address, size_t length, ucs_status_t exp_status)
+    {
+        ucs_rcache_region_t *r;
+        ucs_status_t status;
+
+        status = ucs_rcache_get_async(m_rcache, address, length,
+                                      UCS_PGT_ADDR_ALIGN,
+                                      PROT_READ | PROT_WRITE, NULL, 0, &r);
+        EXPECT_EQ(exp_status, status);
+        return ucs_derived_of(r, struct region);
+    }
+
+    ucs_status_t wait_status(region *r)
+    {
+        ucs_time_t deadline = ucs_get_time() + ucs_time_from_sec(10.0);
+        ucs_status_t status;
+
+        while ((status = ucs_rcache_region_status(m_rcache, &r->super)) ==
+               UCS_INPROGRESS) {
+            if (ucs_get_time() > deadline) {
+                break;
+            }
+            sched_yield();
+        }
+
+        return status;
+    }
+
+    volatile unsigned m_reg_delay_us;
+};
+
+UCS_TEST_F(test_rcache_async, get_async) {
+    static const size_t size = 64 * UCS_KBYTE;
+    region *region1, *region2, *region3;
+    void *ptr;
+
+    m_reg_delay_us = 100000;
+    ptr            = alloc_pages(size, PROT_READ | PROT_WRITE);
+
+    /* The registration is completed by the helper thread */
+    region1 = get_async(ptr, size, UCS_INPROGRESS);
+    EXPECT_EQ(0u, m_reg_count);
+
+    /* Pending region is shared with other asynchronous lookups */
+    region2 = get_async(ptr, size, UCS_INPROGRESS);
+    EXPECT_EQ(region1, region2);
+
+    EXPECT_EQ(UCS_OK, wait_status(region1));
+    EXPECT_EQ(1u, m_reg_count);
+    EXPECT_EQ(uint32_t(MAGIC), region1->magic);
+
+    /* Registered region is found by both lookup types */
+    region3 = get(ptr, size);
+    EXPECT_EQ(region1, region3);
+    put(region3);
+    region3 = get_async(ptr, size, UCS_OK);
+    EXPECT_EQ(region1, region3);
+    put(region3);
+
+    put(region2);
+    put(region1);
+    munmap(ptr, size);
+}
+
+UCS_TEST_F(test_rcache_async, get_waits_for_pending) {
+    static const size_t size = 64 * UCS_KBYTE;
+    region *region1, *region2;
+    void *ptr;
+
+    m_reg_delay_us = 100000;
+    ptr            = alloc_pages(size, PROT_READ | PROT_WRITE);
+
+    region1 = get_async(ptr, size, UCS_INPROGRESS);
+
+    /* Synchronous lookup waits for the pending registration */
+    region2 = get(ptr, size);
+    EXPECT_EQ(region1, region2);
+    EXPECT_EQ(UCS_OK, ucs_rcache_region_status(m_rcache, &region1->super));
+    EXPECT_EQ(1u, m_reg_count);
+
+    put(region2);
+    put(region1);
+    munmap(ptr, size);
+}
+
+UCS_TEST_F(test_rcache_async, unmap_pending) {
+    static const size_t size = 64 * UCS_KBYTE;
+    static const unsigned count = 8;
+    std::vector<void*> ptrs;
+    region *r;
+
+    m_reg_delay_us = 10000;
+
+    /* Release regions while their registrations are still queued or in
+     * progress; they must be deregistered only after registration is done */
+    for (unsigned i = 0; i < count; ++i) {
+        ptrs.push_back(alloc_pages(size, PROT_READ | PROT_WRITE));
+        r = get_async(ptrs.back(), size, UCS_INPROGRESS);
+        put(r);
+    }
+
+    for (unsigned i = 0; i < count; i += 2) {
+        munmap(ptrs[i], size);
+    }
+
+    /* Trigger processing of the unmap events */
+    r = get(ptrs[1], size);
+    put(r);
+
+    /* Remaining regions are destroyed with the cache */
+    m_rcache.reset();
+    EXPECT_EQ(0u, m_reg_count);
+
+    for (unsigned i = 1; i < count; i += 2) {
+        munmap(ptrs[i], size);
+    }
+}
+
+class test_rcache_prefetch : public test_rcache {
+protected:
+    static const size_t CHUNK_SIZE = 64 * UCS_KBYTE;
+
+    test_rcache_prefetch() : m_num_regs(0)
+    {
+    }
+
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache::rcache_params();
+        params.prefetch_budget     = 4 * CHUNK_SIZE;
+        return params;
+    }
+
+    virtual ucs_status_t mem_reg(region *region)
+    {
+        ucs_status_t status = test_rcache::mem_reg(region);
+
+        if (status == UCS_OK) {
+            ++m_num_regs;
+        }
+        return status;
+    }
+
+    /* Register the buffer chunk by chunk, as a streaming workload does */
+    void walk(void *ptr, unsigned num_chunks)
+    {
+        region *r;
+
+        for (unsigned i = 0; i < num_chunks; ++i) {
+            r = get(UCS_PTR_BYTE_OFFSET(ptr, i * CHUNK_SIZE), CHUNK_SIZE);
+            put(r);
+        }
+    }
+
+    size_t distribution_sum(size_t ucs_rcache_distribution_t::*field)
+    {
+        size_t total = 0;
+
+        for (size_t i = 0; i < ucs_rcache_distribution_get_num_bins(); ++i) {
+            total += m_rcache->distribution[i].*field;
+        }
+        return total;
+    }
+
+    uint64_t prefetch_hits()
+    {
+        uint64_t total = 0;
+
+        for (size_t i = 0; i < ucs_rcache_distribution_get_num_bins(); ++i) {
+            total += m_rcache->distribution[i].prefetch_hits;
+        }
+        return total;
+    }
+
+    unsigned m_num_regs;
+};
+
+UCS_TEST_F(test_rcache_prefetch, sequential) {
+    static const unsigned num_chunks = 16;
+    size_t size                      = num_chunks * CHUNK_SIZE;
+    void *ptr                        = alloc_pages(size, PROT_READ | PROT_WRITE);
+
+    /* The second miss starts the sequence, and every miss after it registers
+     * 4 chunks ahead: chunks 0, 1, 6 and 11 are registered */
+    walk(ptr, num_chunks);
+    EXPECT_EQ(4u, m_num_regs);
+    EXPECT_EQ(3u, distribution_sum(&ucs_rcache_distribution_t::prefetch_count));
+    EXPECT_EQ(12u, prefetch_hits());
+
+    /* Walking the buffer again hits the same regions */
+    walk(ptr, num_chunks);
+    EXPECT_EQ(4u, m_num_regs);
+
+    munmap(ptr, size);
+}
+
+UCS_TEST_F(test_rcache_prefetch, inaccessible_ahead) {
+    static const unsigned num_chunks = 8;
+    size_t size                      = (num_chunks + 1) * CHUNK_SIZE;
+    void *ptr                        = alloc_pages(size, PROT_READ | PROT_WRITE);
+
+    /* Memory after the buffer cannot be registered, so it is not prefetched */
+    mprotect(UCS_PTR_BYTE_OFFSET(ptr, num_chunks * CHUNK_SIZE), CHUNK_SIZE,
+             PROT_NONE);
+
+    walk(ptr, num_chunks);
+    EXPECT_EQ(4u, m_num_regs);
+    EXPECT_EQ(1u, distribution_sum(&ucs_rcache_distribution_t::prefetch_count));
+    EXPECT_EQ(4u, prefetch_hits());
+
+    munmap(ptr, size);
+}
+
+class test_rcache_inv_budget : public test_rcache {
+protected:
+    static const size_t   CHUNK_SIZE = 64 * UCS_KBYTE;
+    static const unsigned INV_BUDGET = 2;
+
+    test_rcache_inv_budget() : m_num_deregs_inline(0)
+    {
+    }
+
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache::rcache_params();
+        /* Do not trigger cleanup by the async thread on unmap events */
+        params.max_unreleased      = SIZE_MAX;
+        params.inv_budget          = INV_BUDGET;
+        return params;
+    }
+
+    virtual void init()
+    {
+        m_thread = pthread_self();
+        test_rcache::init();
+    }
+
+    virtual void mem_dereg(region *region)
+    {
+        if (pthread_equal(pthread_self(), m_thread)) {
+            ++m_num_deregs_inline;
+        }
+        test_rcache::mem_dereg(region);
+    }
+
+    unsigned long num_inv_stalls()
+    {
+        unsigned long total = 0;
+
+        for (unsigned i = 0; i < UCS_RCACHE_INV_STALL_NUM_BINS; ++i) {
+            total += m_rcache->inv_stalls[i];
+        }
+        return total;
+    }
+
+    pthread_t         m_thread;
+    volatile unsigned m_num_deregs_inline;
+};
+
+const unsigned test_rcache_inv_budget::INV_BUDGET;
+
+UCS_TEST_F(test_rcache_inv_budget, deferred_dereg) {
+    static const unsigned num_chunks = 16;
+    size_t size                      = num_chunks * CHUNK_SIZE;
+    void *ptr                        = alloc_pages(size, PROT_READ | PROT_WRITE);
+    void *ptr2                       = alloc_pages(CHUNK_SIZE,
+                                                   PROT_READ | PROT_WRITE);
+    region *r;
+
+    for (unsigned i = 0; i < num_chunks; ++i) {
+        r = get(UCS_PTR_BYTE_OFFSET(ptr, i * CHUNK_SIZE), CHUNK_SIZE);
+        put(r);
+    }
+    EXPECT_EQ(num_chunks, m_reg_count);
+
+    /* The regions are removed from the page table by the unmap event, and
+     * deregistered by the following get operations */
+    munmap(ptr, size);
+    EXPECT_EQ(num_chunks, m_reg_count);
+    EXPECT_EQ(0ul, num_inv_stalls());
+
+    r = get(ptr2, CHUNK_SIZE);
+    EXPECT_EQ(INV_BUDGET, m_num_deregs_inline);
+    EXPECT_EQ(1ul, num_inv_stalls());
+
+    /* The async thread deregisters the rest */
+    ucs_time_t deadline = ucs_get_time() + ucs_time_from_sec(10.0);
+    while ((m_reg_count > 1) && (ucs_get_time() < deadline)) {
+        usleep(1000);
+    }
+    EXPECT_EQ(1u, m_reg_count);
+
+    put(r);
+    munmap(ptr2, CHUNK_SIZE);
+}
+
 class test_rcache_no_register : public test_rcache {
 protected:
     bool m_fail_reg;
@@ -257,3 +257,106 @@ UCS_TEST_F(twheel, delayed_sweep) {
     GTEST_FAIL() << "Timers were not triggered after timeout";
 }
 
+
+class twheel_levels : public ucs::test {
+protected:
+    struct test_timer {
+        ucs_wtimer_t timer;
+        uint64_t     expected_tick;
+        uint64_t     fired_tick;
+        uint64_t     *current_tick;
+    };
+
+    virtual void init()
+    {
+        ucs::test::init();
+        m_start = ucs_get_time();
+        m_tick  = 0;
+        ASSERT_UCS_OK(ucs_twheel_init(&m_wheel, ucs_time_from_usec(1),
+                                      m_start));
+    }
+
+    virtual void cleanup()
+    {
+        ucs_twheel_cleanup(&m_wheel);
+        ucs::test::cleanup();
+    }
+
+    static void timer_func(ucs_wtimer_t *self)
+    {
+        test_timer *t = ucs_container_of(self, test_timer, timer);
+        t->fired_tick = *t->current_tick;
+    }
+
+    void add_timer(test_timer *t, uint64_t ticks)
+    {
+        ucs_wtimer_init(&t->timer, timer_func);
+        t->expected_tick = m_tick + ticks;
+        t->fired_tick    = 0;
+        t->current_tick  = &m_tick;
+        ASSERT_UCS_OK(ucs_wtimer_add(&m_wheel, &t->timer,
+                                     ticks * m_wheel.res));
+    }
+
+    void sweep_to(uint64_t tick)
+    {
+        m_tick = tick;
+        ucs_twheel_sweep(&m_wheel, m_start + (tick * m_wheel.res));
+    }
+
+    ucs_twheel_t m_wheel;
+    ucs_time_t   m_start;
+    uint64_t     m_tick;
+};
+
+UCS_TEST_F(twheel_levels, cascade) {
+    static const unsigned num_timers = 2000;
+    std::vector<test_timer> timers(num_timers);
+    uint64_t max_tick = 0;
+
+    for (unsigned i = 0; i < num_timers; ++i) {
+        /* Spread the timers across all levels */
+        uint64_t ticks = 1 + (ucs::rand() % (1ul << (4 + (i % 4) * 6)));
+        add_timer(&timers[i], ticks);
+        max_tick = std::max(max_tick, timers[i].expected_tick);
+    }
+
+    /* Advance by a varying number of ticks, to jump over some slots */
+    for (uint64_t tick = 1; tick <= max_tick; tick += 1 + (tick % 7)) {
+        sweep_to(tick);
+    }
+    sweep_to(max_tick);
+
+    EXPECT_TRUE(ucs_twheel_is_empty(&m_wheel));
+    EXPECT_GT(m_wheel.num_cascades, 0ul);
+    for (unsigned i = 0; i < num_timers; ++i) {
+        /* A timer fires at the first sweep which reaches its tick */
+        EXPECT_GE(timers[i].fired_tick, timers[i].expected_tick) << i;
+        EXPECT_LE(timers[i].fired_tick, timers[i].expected_tick + 7) << i;
+    }
+}
+
+UCS_TEST_F(twheel_levels, remove) {
+    static const unsigned num_timers = 1000;
+    std::vector<test_timer> timers(num_timers);
+
+    for (unsigned i = 0; i < num_timers; ++i) {
+        add_timer(&timers[i], 1 + (i * 97));
+    }
+
+    for (unsigned i = 0; i < num_timers; i += 2) {
+        ucs_wtimer_remove(&m_wheel, &timers[i].timer);
+    }
+    EXPECT_EQ(num_timers / 2, m_wheel.count);
+
+    sweep_to(num_timers * 97);
+
+    EXPECT_TRUE(ucs_twheel_is_empty(&m_wheel));
+    for (unsigned i = 0; i < num_timers; ++i) {
+        if (i % 2) {
+            EXPECT_NE(0ul, timers[i].fired_tick) << i;
+        } else {
+            EXPECT_EQ(0ul, timers[i].fired_tick) << i;
+        }
+    }
+}
@@ -8,8 +8,11 @@
 
 extern "C" {
 #include <ucs/arch/atomic.h>
+#include <ucs/time/time.h>
 }
 
+#include <pthread.h>
+
 class test_many2one_am : public uct_test {
 public:
     static const uint8_t  AM_ID = 15;
@@ -98,76 +101,221 @@ public:
         }
     }
 
-    static const size_t NUM_SENDERS = 10;
+    void test_am_bcopy() {
+        const unsigned num_sends = 1000 / ucs::test_time_multiplier();
+        ucs_status_t status;
 
-protected:
-    volatile uint32_t             m_am_count;
-    std::vector<receive_desc_t*>  m_backlog;
-    entity                       *m_receiver;
-};
+        ucs::ptr_vector<mapped_buffer> buffers;
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            entity *sender = create_entity(0);
+            mapped_buffer *buffer = new mapped_buffer(
+                    sender->iface_attr().cap.am.max_bcopy, 0, *sender);
+            sender->connect(0, *m_receiver, i);
+            m_entities.push_back(sender);
+            buffers.push_back(buffer);
+        }
 
+        m_am_count = 0;
 
-UCS_TEST_SKIP_COND_P(test_many2one_am, am_bcopy,
-                     !check_caps(UCT_IFACE_FLAG_AM_BCOPY |
-                                 UCT_IFACE_FLAG_CB_SYNC))
-{
-    const unsigned num_sends = 1000 / ucs::test_time_multiplier();
-    ucs_status_t status;
-
-    ucs::ptr_vector<mapped_buffer> buffers;
-    for (unsigned i = 0; i < NUM_SENDERS; ++i) {
-        entity *sender = create_entity(0);
-        mapped_buffer *buffer = new mapped_buffer(
-                            sender->iface_attr().cap.am.max_bcopy, 0, *sender);
-        sender->connect(0, *m_receiver, i);
-        m_entities.push_back(sender);
-        buffers.push_back(buffer);
-    }
+        status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
+                                          am_handler, (void*)this, 0);
+        ASSERT_UCS_OK(status);
 
-    m_am_count = 0;
+        for (unsigned i = 0; i < num_sends; ++i) {
+            unsigned sender_num = ucs::rand() % NUM_SENDERS;
 
-    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID, am_handler,
-                                      (void*)this, 0);
-    ASSERT_UCS_OK(status);
+            mapped_buffer& buffer = buffers.at(sender_num);
+            buffer.pattern_fill(i);
 
-    for (unsigned i = 0; i < num_sends; ++i) {
-        unsigned sender_num = ucs::rand() % NUM_SENDERS;
+            ssize_t packed_len;
+            for (;;) {
+                const entity& sender = ent(sender_num + 1);
+                packed_len = uct_ep_am_bcopy(sender.ep(0), AM_ID,
+                                             mapped_buffer::pack,
+                                             (void*)&buffer, 0);
+                if (packed_len != UCS_ERR_NO_RESOURCE) {
+                    break;
+                }
+                sender.progress();
+                m_receiver->progress();
+            }
+            if (packed_len < 0) {
+                ASSERT_UCS_OK((ucs_status_t)packed_len);
+            }
+        }
 
-        mapped_buffer& buffer = buffers.at(sender_num);
-        buffer.pattern_fill(i);
+        while (m_am_count < num_sends) {
+            progress();
+        }
 
-        ssize_t packed_len;
-        for (;;) {
-            const entity& sender = ent(sender_num + 1);
-            packed_len = uct_ep_am_bcopy(sender.ep(0), AM_ID,
-                                         mapped_buffer::pack,
-                                         (void*)&buffer, 0);
-            if (packed_len != UCS_ERR_NO_RESOURCE) {
-                break;
-            }
-            sender.progress();
-            m_receiver->progress();
+        status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
+                                          NULL, NULL, 0);
+        ASSERT_UCS_OK(status);
+
+        check_backlog();
+
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            ent(i + 1).flush();
         }
-        if (packed_len < 0) {
-            ASSERT_UCS_OK((ucs_status_t)packed_len);
+
+        buffers.clear();
+    }
+
+    static ucs_status_t seq_am_handler(void *arg, void *data, size_t length,
+                                       unsigned flags) {
+        test_many2one_am *self = reinterpret_cast<test_many2one_am*>(arg);
+        uint64_t header        = *reinterpret_cast<uint64_t*>(data);
+        unsigned sender_index  = header >> 32;
+        unsigned seq           = header & UINT32_MAX;
+
+        EXPECT_EQ(sizeof(header), length);
+        EXPECT_LT(sender_index, self->m_next_seq.size());
+        if (sender_index < self->m_next_seq.size()) {
+            /* messages of every sender must arrive in order */
+            EXPECT_EQ(self->m_next_seq[sender_index], seq)
+                    << "sender " << sender_index;
+            self->m_next_seq[sender_index] = seq + 1;
         }
+
+        ucs_atomic_add32(&self->m_am_count, 1);
+        return UCS_OK;
     }
 
-    while (m_am_count < num_sends) {
-        progress();
+    struct sender_arg {
+        const entity *sender;
+        unsigned     index;
+        unsigned     num_sends;
+    };
+
+    static void *sender_thread(void *arg) {
+        const sender_arg *sarg = reinterpret_cast<const sender_arg*>(arg);
+        uint64_t header;
+        ucs_status_t status;
+
+        for (unsigned i = 0; i < sarg->num_sends; ++i) {
+            header = (static_cast<uint64_t>(sarg->index) << 32) | i;
+            do {
+                status = uct_ep_am_short(sarg->sender->ep(0), AM_ID, header,
+                                         NULL, 0);
+                if (status == UCS_ERR_NO_RESOURCE) {
+                    sarg->sender->progress();
+                }
+            } while (status == UCS_ERR_NO_RESOURCE);
+            EXPECT_UCS_OK(status);
+        }
+
+        return NULL;
     }
 
-    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
-                                      NULL, NULL, 0);
-    ASSERT_UCS_OK(status);
+    /* Send short messages by every sender from a separate thread to the same
+     * receiver, check that all of them arrive in order and report the rate */
+    void test_am_short_rate() {
+        const unsigned num_sends = 20000 / ucs::test_time_multiplier();
+        std::vector<sender_arg> args(NUM_SENDERS);
+        std::vector<pthread_t> threads(NUM_SENDERS);
+        ucs_status_t status;
+
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            entity *sender = create_entity(0);
+            sender->connect(0, *m_receiver, i);
+            m_entities.push_back(sender);
+            args[i].sender    = sender;
+            args[i].index     = i;
+            args[i].num_sends = num_sends;
+        }
+
+        m_am_count = 0;
+        m_next_seq.assign(NUM_SENDERS, 0);
+        status     = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
+                                              seq_am_handler, (void*)this, 0);
+        ASSERT_UCS_OK(status);
+
+        ucs_time_t start_time = ucs_get_time();
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            pthread_create(&threads[i], NULL, sender_thread, &args[i]);
+        }
+
+        while (m_am_count < (NUM_SENDERS * num_sends)) {
+            m_receiver->progress();
+        }
+
+        double elapsed = ucs_time_to_sec(ucs_get_time() - start_time);
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            pthread_join(threads[i], NULL);
+        }
+
+        UCS_TEST_MESSAGE << NUM_SENDERS << " senders to 1 receiver: "
+                         << (NUM_SENDERS * num_sends / elapsed / 1e6)
+                         << " Mpps";
+
+        /* no duplicate or extra messages */
+        short_progress_loop();
+        EXPECT_EQ(NUM_SENDERS * num_sends, m_am_count);
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            EXPECT_EQ(num_sends, m_next_seq[i]) << "sender " << i;
+        }
 
-    check_backlog();
+        status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID, NULL,
+                                          NULL, 0);
+        ASSERT_UCS_OK(status);
 
-    for (unsigned i = 0; i < NUM_SENDERS; ++i) {
-        ent(i + 1).flush();
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            ent(i + 1).flush();
+        }
     }
 
-    buffers.clear();
+    static const size_t NUM_SENDERS = 10;
+
+protected:
+    volatile uint32_t             m_am_count;
+    std::vector<receive_desc_t*>  m_backlog;
+    std::vector<unsigned>         m_next_seq;
+    entity                       *m_receiver;
+};
+
+
+UCS_TEST_SKIP_COND_P(test_many2one_am, am_bcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_BCOPY |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    test_am_bcopy();
+}
+
+UCS_TEST_SKIP_COND_P(test_many2one_am, am_bcopy_fifo_batch,
+                     !has_mm() ||
+                     !check_caps(UCT_IFACE_FLAG_AM_BCOPY |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "MM_FIFO_BATCH_RECV=y")
+{
+    test_am_bcopy();
+}
+
+UCS_TEST_SKIP_COND_P(test_many2one_am, am_bcopy_spsc_rings,
+                     !has_mm() ||
+                     !check_caps(UCT_IFACE_FLAG_AM_BCOPY |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "MM_SPSC_RINGS=4")
+{
+    /* some of the senders use per-sender rings, and others use the shared
+     * FIFO */
+    test_am_bcopy();
+}
+
+UCS_TEST_SKIP_COND_P(test_many2one_am, am_short_rate_shared_fifo,
+                     !has_mm() ||
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    test_am_short_rate();
+}
+
+UCS_TEST_SKIP_COND_P(test_many2one_am, am_short_rate_spsc_rings,
+                     !has_mm() ||
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "MM_SPSC_RINGS=16")
+{
+    test_am_short_rate();
 }
 
 UCT_INSTANTIATE_NO_SELF_TEST_CASE(test_many2one_am)
@@ -9,6 +9,11 @@
 #include <string>
 #include <vector>
 
+extern "C" {
+#include <ucs/sys/io_uring.h>
+#include <uct/tcp/tcp.h>
+}
+
 class uct_p2p_am_test : public uct_p2p_test
 {
 public:
@@ -618,6 +623,34 @@ UCS_TEST_SKIP_COND_P(uct_p2p_am_test, am_zcopy,
                     TEST_UCT_FLAG_DIR_SEND_TO_RECV);
 }
 
+UCS_TEST_SKIP_COND_P(uct_p2p_am_test, am_zcopy_msg_zerocopy,
+                     !has_transport("tcp") ||
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP),
+                     "TCP_ZCOPY_THRESH=0") {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_am_test::am_zcopy),
+                    0ul,
+                    sender().iface_attr().cap.am.max_zcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_am_test, am_bcopy_io_uring,
+                     !has_transport("tcp") || !ucs_io_uring_is_supported() ||
+                     !check_caps(UCT_IFACE_FLAG_AM_BCOPY,
+                                 UCT_IFACE_FLAG_AM_DUP),
+                     "TCP_IO_URING=y") {
+    uct_tcp_iface_t *iface = ucs_derived_of(receiver().iface(),
+                                            uct_tcp_iface_t);
+
+    ASSERT_TRUE(iface->io_uring.ops != NULL);
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_am_test::am_bcopy),
+                    sizeof(uint64_t),
+                    sender().iface_attr().cap.am.max_bcopy,
+                    TEST_UCT_FLAG_DIR_SEND_TO_RECV);
+    /* io_uring must not fall back to epoll during the test */
+    EXPECT_TRUE(iface->io_uring.ops != NULL);
+}
+
 UCT_INSTANTIATE_TEST_CASE(uct_p2p_am_test)
 
 const unsigned uct_p2p_am_misc::RX_MAX_BUFS  = 1024; /* due to hard coded 'grow'
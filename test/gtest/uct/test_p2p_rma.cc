@@ -118,6 +118,26 @@ UCS_TEST_SKIP_COND_P(uct_p2p_rma_test, put_zcopy,
                     TEST_UCT_FLAG_SEND_ZCOPY);
 }
 
+UCS_TEST_SKIP_COND_P(uct_p2p_rma_test, put_zcopy_msg_zerocopy,
+                     !has_transport("tcp") ||
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY),
+                     "TCP_ZCOPY_THRESH=0") {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    sender().iface_attr().cap.put.min_zcopy,
+                    sender().iface_attr().cap.put.max_zcopy,
+                    TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+UCS_TEST_SKIP_COND_P(uct_p2p_rma_test, put_zcopy_stripe,
+                     !has_transport("tcp") ||
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY),
+                     "TCP_CONN_PER_EP=4", "TCP_STRIPE_THRESH=1k") {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    sender().iface_attr().cap.put.min_zcopy,
+                    sender().iface_attr().cap.put.max_zcopy,
+                    TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
 UCS_TEST_SKIP_COND_P(uct_p2p_rma_test, get_short,
                      !check_caps(UCT_IFACE_FLAG_GET_SHORT)) {
     test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::get_short),